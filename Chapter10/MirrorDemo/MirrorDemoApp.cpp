@@ -1,5 +1,7 @@
 #include "MirrorDemoApp.h"
 
+#include <algorithm>
+#include <format>
 #include <fstream>
 #include <numbers>
 #include <span>
@@ -9,6 +11,10 @@
 #include "Core/Data/Color.h"
 #include "Core/Data/Path.h"
 #include "Core/Data/SphericalCoord.h"
+#include "Core/Rendering/MeshBuffer.h"
+#include "Core/Rendering/MeshOptimizer.h"
+#include "Core/Rendering/MeshWelder.h"
+#include "Core/Rendering/MeshSimplifier.h"
 #include "Core/Rendering/Vertex.h"
 #include "Shaders/MirrorDemoShaderPass.h"
 
@@ -16,6 +22,12 @@ using namespace DirectX;
 
 namespace
 {
+    // 원본 삼각형 수에 대한 해골 LOD 비율
+    constexpr std::array SkullLodTriangleRatios = {0.5f, 0.25f, 0.1f};
+
+    // 단순화 오차가 이 픽셀 수 이하로 보이면 더 거친 LOD를 사용한다.
+    constexpr float SkullLodPixelErrorThreshold = 1.0f;
+
     constexpr float InvSqrt3 = std::numbers::inv_sqrt3_v<float>;
     constexpr float InvSqrt2 = 1.0f / std::numbers::sqrt2_v<float>;
 
@@ -178,8 +190,9 @@ void MirrorDemoApp::Render()
     shaderPass->SetUseTexture(false);
     shaderPass->UpdateCBuffer(immediateContext.Get());
 
+    const Submesh& skullSubmesh = SelectSkullLod(XMLoadFloat4x4(&skullWorldMatrix));
     immediateContext->IASetVertexBuffers(0, 1, skullVertexBuffer.GetAddressOf(), std::array{static_cast<UINT>(sizeof(Vertex::PNT))}.data(), std::array{0u}.data());
-    immediateContext->IASetIndexBuffer(skullIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    immediateContext->IASetIndexBuffer(skullIndexBuffer.Get(), skullSubmesh.indexFormat, 0);
     immediateContext->DrawIndexed(skullSubmesh.indexCount, skullSubmesh.startIndexLocation, skullSubmesh.baseVertexLocation);
 
     // 방 렌더링
@@ -227,11 +240,13 @@ void MirrorDemoApp::Render()
 
     shaderPass->UpdateCBuffer(immediateContext.Get());
 
+    // 반사된 해골은 거울 너머에 있는 것처럼 보이므로 반사된 위치의 거리로 LOD를 따로 고른다.
+    const Submesh& reflectedSkullSubmesh = SelectSkullLod(XMLoadFloat4x4(&skullWorldMatrix) * reflectionMatrix);
     immediateContext->IASetVertexBuffers(0, 1, skullVertexBuffer.GetAddressOf(), std::array{static_cast<UINT>(sizeof(Vertex::PNT))}.data(), std::array{0u}.data());
-    immediateContext->IASetIndexBuffer(skullIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    immediateContext->IASetIndexBuffer(skullIndexBuffer.Get(), reflectedSkullSubmesh.indexFormat, 0);
     immediateContext->RSSetState(counterClockwiseRasterizerState.Get());
     immediateContext->OMSetDepthStencilState(renderReflectionDepthStencilState.Get(), 1);
-    immediateContext->DrawIndexed(skullSubmesh.indexCount, skullSubmesh.startIndexLocation, skullSubmesh.baseVertexLocation);
+    immediateContext->DrawIndexed(reflectedSkullSubmesh.indexCount, reflectedSkullSubmesh.startIndexLocation, reflectedSkullSubmesh.baseVertexLocation);
 
     shaderPass->SetLights(directionalLights);
     immediateContext->RSSetState(nullptr);
@@ -290,7 +305,7 @@ void MirrorDemoApp::RenderObject(
     constexpr UINT stride = sizeof(Vertex::PNT);
     constexpr UINT offset = 0;
     immediateContext->IASetVertexBuffers(0, 1, &vertexBufferPtr, &stride, &offset);
-    immediateContext->IASetIndexBuffer(indexBufferPtr, DXGI_FORMAT_R32_UINT, 0);
+    immediateContext->IASetIndexBuffer(indexBufferPtr, submesh.indexFormat, 0);
     immediateContext->PSSetShaderResources(0, 1, std::array{diffuseMapSRV}.data());
 
     immediateContext->DrawIndexed(submesh.indexCount, submesh.startIndexLocation, submesh.baseVertexLocation);
@@ -330,15 +345,70 @@ void MirrorDemoApp::CreateSkullGeometry()
         ifs >> indices[currentIndex] >> indices[currentIndex + 1] >> indices[currentIndex + 2];
     }
 
-    skullSubmesh = Submesh(indices.size(), 0, 0);
+    // 파일은 같은 위치의 정점을 법선만 달리해 여러 번 저장하며 대부분은 실제 주름이다. 법선까지 같은 정점만 합치고 합친 정점의 법선은 다시 만든다.
+    const MeshWelder::WeldStatistics weldStatistics = MeshWelder::Weld(vertices, indices, &Vertex::PNT::position, &Vertex::PNT::normal);
+    MeshWelder::RecomputeNormals(vertices, indices, &Vertex::PNT::position, &Vertex::PNT::normal);
+    OutputDebugString(std::format(L"skull weld vertices {} -> {} ({} -> {} bytes), removed triangles {}\n",
+                                  weldStatistics.sourceVertexCount, weldStatistics.weldedVertexCount, sizeof(Vertex::PNT) * weldStatistics.sourceVertexCount,
+                                  sizeof(Vertex::PNT) * weldStatistics.weldedVertexCount, weldStatistics.removedTriangleCount).c_str());
+
+    // 해골은 거울 안팎으로 두 번 그리므로 캐시 효율을 조금 양보하더라도 바깥쪽 면이 먼저 그려지도록 삼각형 순서를 바꾼다.
+#if MESH_LOAD_DIAGNOSTICS
+    const MeshOptimizer::OverdrawStatistics overdrawBefore = MeshOptimizer::AnalyzeOverdraw(indices, MakeVertexView(std::span<const Vertex::PNT>(vertices), &Vertex::PNT::position));
+#endif
+    MeshOptimizer::Optimize(vertices, indices, &Vertex::PNT::position);
+#if MESH_LOAD_DIAGNOSTICS
+    const MeshOptimizer::OverdrawStatistics overdrawAfter = MeshOptimizer::AnalyzeOverdraw(indices, MakeVertexView(std::span<const Vertex::PNT>(vertices), &Vertex::PNT::position));
+    OutputDebugString(std::format(L"skull overdraw {:.3f} -> {:.3f}, ACMR {:.3f}\n", overdrawBefore.overdraw, overdrawAfter.overdraw,
+                                  MeshOptimizer::AnalyzeVertexCache(indices, vertices.size()).acmr).c_str());
+#endif
+
+    // 단순화된 LOD는 원본 정점을 그대로 쓰므로 인덱스만 원본 뒤에 이어 붙인다.
+    const VertexView vertexView = MakeVertexView(std::span<const Vertex::PNT>(vertices), &Vertex::PNT::position, &Vertex::PNT::normal);
+    const std::vector<MeshSimplifier::LodLevel> lodLevels = MeshSimplifier::BuildLodChain(vertexView, indices, SkullLodTriangleRatios);
+
+    const DXGI_FORMAT indexFormat = MeshBuffer::GetIndexFormat(vertices.size());
+    skullLodSubmeshes.clear();
+    skullLodErrors.clear();
+    skullLodSubmeshes.emplace_back(indices.size(), 0, 0, indexFormat).bounds = Bounds::Compute(vertexView);
+    skullLodErrors.push_back(0.0f);
+
+    for (const MeshSimplifier::LodLevel& lodLevel : lodLevels)
+    {
+        skullLodSubmeshes.emplace_back(lodLevel.indices.size(), indices.size(), 0, indexFormat).bounds = Bounds::Compute(vertexView, lodLevel.indices);
+        skullLodErrors.push_back(lodLevel.error);
+        indices.insert(indices.end(), lodLevel.indices.begin(), lodLevel.indices.end());
+    }
 
     const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(Vertex::PNT) * vertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
     const D3D11_SUBRESOURCE_DATA vertexInitData{.pSysMem = vertices.data()};
     device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &skullVertexBuffer);
 
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{.pSysMem = indices.data()};
-    device->CreateBuffer(&indexBufferDesc, &indexInitData, &skullIndexBuffer);
+    MeshBuffer::CreateIndexBuffer(device.Get(), indices, indexFormat, &skullIndexBuffer);
+}
+
+const Submesh& MirrorDemoApp::SelectSkullLod(FXMMATRIX worldMatrix) const
+{
+    // 월드 공간 오차를 원근 투영해 픽셀 단위로 바꾼다. 크기 변환은 가장 큰 축 배율로 보수적으로 반영한다.
+    const float worldScale = std::max({
+        XMVectorGetX(XMVector3Length(worldMatrix.r[0])),
+        XMVectorGetX(XMVector3Length(worldMatrix.r[1])),
+        XMVectorGetX(XMVector3Length(worldMatrix.r[2]))
+    });
+    const float distance = XMVectorGetX(XMVector3Length(worldMatrix.r[3] - XMLoadFloat3(&eyePosition)));
+    const float pixelsPerWorldUnit = projectionMatrix._22 * 0.5f * static_cast<float>(clientHeight) / std::max(distance, 1.0e-3f);
+
+    size_t lodIndex = 0;
+    for (size_t i = 1; i < skullLodSubmeshes.size(); ++i)
+    {
+        if (skullLodErrors[i] * worldScale * pixelsPerWorldUnit > SkullLodPixelErrorThreshold)
+        {
+            break;
+        }
+        lodIndex = i;
+    }
+
+    return skullLodSubmeshes[lodIndex];
 }
 
 void MirrorDemoApp::CreateRoomGeometry()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "Core/Engine/SphericalCamera.h"
 #include "Core/Light/Light.h"
@@ -31,6 +32,9 @@ private:
     void CreateSkullGeometry();
     void CreateRoomGeometry();
 
+    // 해골의 단순화 오차가 화면에서 1픽셀 이하가 되는 가장 거친 LOD를 고른다.
+    const Submesh& SelectSkullLod(DirectX::FXMMATRIX worldMatrix) const;
+
     void InitTexture();
 
     std::unique_ptr<MirrorDemoShaderPass> shaderPass;
@@ -47,7 +51,10 @@ private:
     DirectX::XMFLOAT4X4 skullWorldMatrix;
     DirectX::XMFLOAT3 skullTranslation;
     Material skullMaterial;
-    Submesh skullSubmesh;
+
+    // 0번이 원본이며 뒤로 갈수록 삼각형 수가 줄어든다. 모든 LOD가 정점 버퍼와 인덱스 버퍼 하나를 공유한다.
+    std::vector<Submesh> skullLodSubmeshes;
+    std::vector<float> skullLodErrors;
 
     ComPtr<ID3D11Buffer> roomVertexBuffer;
     DirectX::XMFLOAT4X4 roomWorldMatrix;
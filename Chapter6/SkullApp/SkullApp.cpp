@@ -1,9 +1,14 @@
 #include "SkullApp.h"
 
 #include "Data/Path.h"
+#include "Rendering/MeshBuffer.h"
+#include "Rendering/MeshletBuilder.h"
+#include "Rendering/MeshOptimizer.h"
+#include "Rendering/MeshWelder.h"
 #include "Rendering/VertexTypes.h"
 #include "Utilities/Utility.h"
 
+#include <format>
 #include <fstream>
 #include <vector>
 
@@ -48,10 +53,11 @@ SkullApp::SkullApp()
 
 void SkullApp::Update(float deltaSeconds)
 {
-    const XMVECTOR eyePosition = SphericalCoord::SphericalToCartesian(GetCameraSphericalCoord());
+    const XMVECTOR cameraPosition = SphericalCoord::SphericalToCartesian(GetCameraSphericalCoord());
     const XMVECTOR focusPosition = XMVectorZero();
     const XMVECTOR upDirection = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-    XMStoreFloat4x4(&viewMatrix, XMMatrixLookAtLH(eyePosition, focusPosition, upDirection));
+    XMStoreFloat4x4(&viewMatrix, XMMatrixLookAtLH(cameraPosition, focusPosition, upDirection));
+    XMStoreFloat3(&eyePosition, cameraPosition);
 }
 
 void SkullApp::Render()
@@ -59,12 +65,36 @@ void SkullApp::Render()
     immediateContext->ClearRenderTargetView(renderTargetView.Get(), Colors::White);
     immediateContext->ClearDepthStencilView(depthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 
+    const XMMATRIX worldMatrix = XMLoadFloat4x4(&skullWolrdMatrix);
+    const XMMATRIX worldViewProjectionMatrix = worldMatrix * XMLoadFloat4x4(&viewMatrix) * XMLoadFloat4x4(&projectionMatrix);
+
     D3D11_MAPPED_SUBRESOURCE mapped;
     immediateContext->Map(objectCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    XMStoreFloat4x4(static_cast<XMFLOAT4X4*>(mapped.pData), XMLoadFloat4x4(&skullWolrdMatrix) * XMLoadFloat4x4(&viewMatrix) * XMLoadFloat4x4(&projectionMatrix));
+    XMStoreFloat4x4(static_cast<XMFLOAT4X4*>(mapped.pData), worldViewProjectionMatrix);
     immediateContext->Unmap(objectCB.Get(), 0);
 
-    immediateContext->DrawIndexed(skullIndexCount, 0, 0);
+    // 카메라를 메시 공간으로 옮겨 묶음의 경계 구, 법선 원뿔과 비교한다.
+    XMVECTOR determinant;
+    const XMVECTOR localEyePosition = XMVector3TransformCoord(XMLoadFloat3(&eyePosition), XMMatrixInverse(&determinant, worldMatrix));
+    MeshletBuilder::Cull(skullMeshlets, worldViewProjectionMatrix, localEyePosition, visibleSkullMeshlets);
+
+    // 인덱스 구간이 이어지는 묶음은 한 번에 그린다.
+    for (size_t i = 0; i < visibleSkullMeshlets.size();)
+    {
+        const MeshletBuilder::Meshlet& firstMeshlet = skullMeshlets.meshlets[visibleSkullMeshlets[i]];
+        UINT triangleCount = firstMeshlet.triangleCount;
+
+        size_t next = i + 1;
+        while (next < visibleSkullMeshlets.size() && visibleSkullMeshlets[next] == visibleSkullMeshlets[next - 1] + 1)
+        {
+            triangleCount += skullMeshlets.meshlets[visibleSkullMeshlets[next]].triangleCount;
+            ++next;
+        }
+
+        immediateContext->DrawIndexed(triangleCount * 3, firstMeshlet.triangleOffset * 3, 0);
+        i = next;
+    }
+
     swapChain->Present(0, 0);
 }
 
@@ -94,14 +124,30 @@ void SkullApp::LoadSkullMesh()
 
     ifs >> ignore >> ignore >> ignore;
 
-    skullIndexCount = triangleCount * 3;
-    std::vector<UINT> skullIndices(skullIndexCount);
+    std::vector<UINT> skullIndices(triangleCount * 3);
     for (UINT i = 0; i < triangleCount; ++i)
     {
         const UINT currentIndex = i * 3;
         ifs >> skullIndices[currentIndex] >> skullIndices[currentIndex + 1] >> skullIndices[currentIndex + 2];
     }
 
+    // 파일은 같은 위치의 정점을 법선만 달리해 여러 번 저장한다. 여기서는 법선을 쓰지 않으므로 위치만 비교해 합친다.
+    const MeshWelder::WeldStatistics weldStatistics = MeshWelder::Weld(skullVertices, skullIndices, &Vertex::position);
+    OutputDebugString(std::format(L"skull weld vertices {} -> {} ({} -> {} bytes), removed triangles {}\n",
+                                  weldStatistics.sourceVertexCount, weldStatistics.weldedVertexCount, sizeof(Vertex) * weldStatistics.sourceVertexCount,
+                                  sizeof(Vertex) * weldStatistics.weldedVertexCount, weldStatistics.removedTriangleCount).c_str());
+
+    // 파일의 삼각형 순서는 정점 캐시를 고려하지 않았으므로 버퍼를 만들기 전에 다시 배치한다.
+    MeshOptimizer::Optimize(skullVertices, skullIndices);
+#if MESH_LOAD_DIAGNOSTICS
+    const MeshOptimizer::VertexCacheStatistics statistics = MeshOptimizer::AnalyzeVertexCache(skullIndices, skullVertices.size());
+    OutputDebugString(std::format(L"skull ACMR {:.3f}, ATVR {:.3f}\n", statistics.acmr, statistics.atvr).c_str());
+#endif
+
+    // 보이지 않는 영역을 묶음 단위로 건너뛸 수 있도록 인덱스 버퍼를 묶음 순서로 다시 만든다.
+    skullMeshlets = MeshletBuilder::Build(skullVertices, skullIndices);
+    skullIndices = MeshletBuilder::BuildIndexBuffer(skullMeshlets);
+
     const CD3D11_BUFFER_DESC skullVertexBufferDesc(static_cast<UINT>(sizeof(Vertex) * skullVertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
     const D3D11_SUBRESOURCE_DATA skullVertexBufferInitData{skullVertices.data()};
     device->CreateBuffer(&skullVertexBufferDesc, &skullVertexBufferInitData, &skullVertexBuffer);
@@ -110,10 +156,9 @@ void SkullApp::LoadSkullMesh()
     constexpr UINT offset = 0;
     immediateContext->IASetVertexBuffers(0, 1, skullVertexBuffer.GetAddressOf(), &stride, &offset);
 
-    const CD3D11_BUFFER_DESC skullIndexBufferDesc(static_cast<UINT>(sizeof(UINT) * skullIndices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA skullIndexBufferInitData{skullIndices.data()};
-    device->CreateBuffer(&skullIndexBufferDesc, &skullIndexBufferInitData, &skullIndexBuffer);
-    immediateContext->IASetIndexBuffer(skullIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    const DXGI_FORMAT skullIndexFormat = MeshBuffer::GetIndexFormat(skullVertices.size());
+    MeshBuffer::CreateIndexBuffer(device.Get(), skullIndices, skullIndexFormat, &skullIndexBuffer);
+    immediateContext->IASetIndexBuffer(skullIndexBuffer.Get(), skullIndexFormat, 0);
 
     XMStoreFloat4x4(&skullWolrdMatrix, XMMatrixTranslation(0.0f, -2.5f, 0.0f));
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/SphericalCamera.h"
+#include "Rendering/MeshletBuilder.h"
 
 class SkullApp : public SphericalCamera
 {
@@ -32,9 +33,13 @@ private:
     ComPtr<ID3D11Buffer> skullVertexBuffer;
     ComPtr<ID3D11Buffer> skullIndexBuffer;
 
+    XMFLOAT3 eyePosition{};
     XMFLOAT4X4 viewMatrix{};
     XMFLOAT4X4 projectionMatrix{};
     
     XMFLOAT4X4 skullWolrdMatrix{};
-    UINT skullIndexCount;
+
+    // 인덱스 버퍼는 묶음 순서로 배치되어 있어 보이는 묶음의 인덱스 구간만 그린다.
+    MeshletBuilder::MeshletData skullMeshlets;
+    std::vector<UINT> visibleSkullMeshlets;
 };
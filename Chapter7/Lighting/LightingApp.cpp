@@ -6,7 +6,9 @@
 #include "Core/Common/Timer.h"
 #include "Core/Data/Path.h"
 #include "Core/Data/SphericalCoord.h"
+#include "Core/Rendering/MeshBuffer.h"
 #include "Core/Rendering/VertexTypes.h"
+#include "Core/Utilities/HillHeightField.h"
 #include "Core/Utilities/Utility.h"
 #include "Shaders/BasicShaderPass.h"
 
@@ -114,7 +116,7 @@ void LightingApp::Update(float deltaSeconds)
     Vertex* vertices = static_cast<Vertex*>(mapped.pData);
     for (UINT i = 0; i < waves.VertexCount(); ++i)
     {
-        vertices[i].position = waves[static_cast<int>(i)];
+        vertices[i].position = waves.Interpolated(i);
         vertices[i].normal = waves.Normal(static_cast<int>(i));
     }
 
@@ -122,7 +124,7 @@ void LightingApp::Update(float deltaSeconds)
 
     pointLight.position.x = 70.0f * std::cos(0.2f * static_cast<float>(timer->GetTotalSeconds()));
     pointLight.position.z = 70.0f * std::sin(0.2f * static_cast<float>(timer->GetTotalSeconds()));
-    pointLight.position.y = std::max(GetHeight(pointLight.position.x, pointLight.position.z), -3.0f) + 10.0f;
+    pointLight.position.y = std::max(HillHeightField::GetHeight(pointLight.position.x, pointLight.position.z), -3.0f) + 10.0f;
 
     spotLight.position = eyePosition;
     XMStoreFloat3(&spotLight.direction, XMVector3Normalize(focusPosition - cameraPosition));
@@ -134,13 +136,13 @@ void LightingApp::Render()
     immediateContext->ClearDepthStencilView(depthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 
     const XMMATRIX viewProjectionMatrix = XMLoadFloat4x4(&viewMatrix) * XMLoadFloat4x4(&projectionMatrix);
-    RenderObject(landVertexBuffer.Get(), landIndexBuffer.Get(), XMLoadFloat4x4(&landWorldMatrix), viewProjectionMatrix, landMaterial, gridSubmesh.indexCount);
-    RenderObject(wavesVertexBuffer.Get(), wavesIndexBuffer.Get(), XMLoadFloat4x4(&wavesWorldMatrix), viewProjectionMatrix, wavesMaterial, wavesSubmesh.indexCount);
+    RenderObject(landVertexBuffer.Get(), landIndexBuffer.Get(), XMLoadFloat4x4(&landWorldMatrix), viewProjectionMatrix, landMaterial, gridSubmesh);
+    RenderObject(wavesVertexBuffer.Get(), wavesIndexBuffer.Get(), XMLoadFloat4x4(&wavesWorldMatrix), viewProjectionMatrix, wavesMaterial, wavesSubmesh);
 
     swapChain->Present(0, 0);
 }
 
-void LightingApp::RenderObject(ID3D11Buffer* vertexBufferPtr, ID3D11Buffer* indexBufferPtr, FXMMATRIX worldMatrix, CXMMATRIX viewProjectionMatrix, const Material& material, UINT indexCount)
+void LightingApp::RenderObject(ID3D11Buffer* vertexBufferPtr, ID3D11Buffer* indexBufferPtr, FXMMATRIX worldMatrix, CXMMATRIX viewProjectionMatrix, const Material& material, const Submesh& submesh)
 {
     basicShader->SetMatrix(worldMatrix, viewProjectionMatrix);
     basicShader->SetMaterial(material);
@@ -151,9 +153,9 @@ void LightingApp::RenderObject(ID3D11Buffer* vertexBufferPtr, ID3D11Buffer* inde
     constexpr UINT stride = sizeof(Vertex);
     constexpr UINT offset = 0;
     immediateContext->IASetVertexBuffers(0, 1, &vertexBufferPtr, &stride, &offset);
-    immediateContext->IASetIndexBuffer(indexBufferPtr, DXGI_FORMAT_R32_UINT, 0);
+    immediateContext->IASetIndexBuffer(indexBufferPtr, submesh.indexFormat, 0);
 
-    immediateContext->DrawIndexed(indexCount, 0, 0);
+    immediateContext->DrawIndexed(submesh.indexCount, 0, 0);
 }
 
 bool LightingApp::CreateGeometry()
@@ -174,24 +176,23 @@ bool LightingApp::CreateGeometry()
 bool LightingApp::CreateLandGeometry()
 {
     const GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(160.0f, 160.0f, 50, 50);
-    gridSubmesh = Submesh(grid.indices.size(), 0, 0);
+    gridSubmesh = Submesh(grid.indices.size(), 0, 0, grid.GetIndexFormat());
 
     std::vector<Vertex> vertices(grid.vertices.size());
     for (size_t i = 0; i < vertices.size(); ++i)
     {
-        XMFLOAT3 position = grid.vertices[i].position;
-        position.y = GetHeight(position.x, position.z);
-        vertices[i].position = position;
-        vertices[i].normal = GetHillNormal(position.x, position.z);
+        vertices[i].position = grid.vertices[i].position;
     }
+    HillHeightField::Apply(std::span(vertices));
+
+    // 높이를 바꿨으므로 평평한 격자의 범위 대신 실제 정점으로 다시 계산한다.
+    gridSubmesh.bounds = Bounds::Compute(MakeVertexView(std::span<const Vertex>(vertices), &Vertex::position));
 
     const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(Vertex) * vertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
     const D3D11_SUBRESOURCE_DATA vertexInitData{vertices.data()};
     CHECK_HR(device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &landVertexBuffer), L"Failed to create land vertex buffer", false);
 
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * gridSubmesh.indexCount), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{grid.indices.data()};
-    CHECK_HR(device->CreateBuffer(&indexBufferDesc, &indexInitData, &landIndexBuffer), L"Failed to create land index buffer", false);
+    CHECK_HR(MeshBuffer::CreateIndexBuffer(device.Get(), grid.indices, gridSubmesh.indexFormat, &landIndexBuffer), L"Failed to create land index buffer", false);
 
     return true;
 }
@@ -204,6 +205,7 @@ bool LightingApp::CreateWaveGeometry()
 
     std::vector<UINT> indices(waves.TriangleCount() * 3);
     wavesSubmesh.indexCount = static_cast<UINT>(indices.size());
+    wavesSubmesh.indexFormat = MeshBuffer::GetIndexFormat(waves.VertexCount());
 
     int k = 0;
     for (UINT i = 0; i < wavesRowCount - 1; ++i)
@@ -228,9 +230,7 @@ bool LightingApp::CreateWaveGeometry()
     const CD3D11_BUFFER_DESC vertexBufferDesc(sizeof(Vertex) * waves.VertexCount(), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
     CHECK_HR(device->CreateBuffer(&vertexBufferDesc, nullptr, &wavesVertexBuffer), L"Failed to create wave vertex buffer", false);
 
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{indices.data()};
-    CHECK_HR(device->CreateBuffer(&indexBufferDesc, &indexInitData, &wavesIndexBuffer), L"Failed to create wave index buffer", false);
+    CHECK_HR(MeshBuffer::CreateIndexBuffer(device.Get(), indices, wavesSubmesh.indexFormat, &wavesIndexBuffer), L"Failed to create wave index buffer", false);
 
     return true;
 }
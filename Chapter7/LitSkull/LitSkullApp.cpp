@@ -1,13 +1,22 @@
 #include "LitSkullApp.h"
 
 #include <bitset>
+#include <format>
 #include <fstream>
 #include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
 
+#include "Core/Common/GeometryCache.h"
 #include "Core/Common/GeometryGenerator.h"
 #include "Core/Data/Color.h"
 #include "Core/Data/Path.h"
+#include "Core/Rendering/MeshBuffer.h"
+#include "Core/Rendering/MeshOptimizer.h"
+#include "Core/Rendering/MeshWelder.h"
 #include "Core/Rendering/Vertex.h"
+#include "Core/Rendering/VertexQuantizer.h"
 #include "Shaders/ShaderPass.h"
 
 using namespace DirectX;
@@ -146,60 +155,54 @@ void LitSkullApp::Render()
     immediateContext->ClearRenderTargetView(renderTargetView.Get(), LinearColors::Silver);
     immediateContext->ClearDepthStencilView(depthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 
-    RenderObject(XMLoadFloat4x4(&skullWorldMatrix), RenderAssetMap[ObjectType::Skull].material, RenderAssetMap[ObjectType::Skull].submesh);
-    RenderObject(XMLoadFloat4x4(&boxWorldMatrix), RenderAssetMap[ObjectType::Box].material, RenderAssetMap[ObjectType::Box].submesh);
-    RenderObject(XMLoadFloat4x4(&gridWorldMatrix), RenderAssetMap[ObjectType::Grid].material, RenderAssetMap[ObjectType::Grid].submesh);
+    packedShaderPass->Bind(immediateContext.Get());
+    immediateContext->IASetVertexBuffers(0, 1, skullVertexBuffer.GetAddressOf(), std::array{static_cast<UINT>(sizeof(Vertex::PackedPN))}.data(), std::array{0u}.data());
+    immediateContext->IASetIndexBuffer(skullIndexBuffer.Get(), RenderAssetMap[ObjectType::Skull].submesh.indexFormat, 0);
+    RenderObject(*packedShaderPass, XMLoadFloat4x4(&skullWorldMatrix), RenderAssetMap[ObjectType::Skull].material, RenderAssetMap[ObjectType::Skull].submesh);
+
+    // 도형은 모두 한 버퍼에 있으므로 한 번만 바인딩한다.
+    shaderPass->Bind(immediateContext.Get());
+    shapeBatcher.Bind(immediateContext.Get());
+    RenderObject(*shaderPass, XMLoadFloat4x4(&boxWorldMatrix), RenderAssetMap[ObjectType::Box].material, RenderAssetMap[ObjectType::Box].submesh);
+    RenderObject(*shaderPass, XMLoadFloat4x4(&gridWorldMatrix), RenderAssetMap[ObjectType::Grid].material, RenderAssetMap[ObjectType::Grid].submesh);
     
     for (size_t i = 0; i < sphereWorldMatrices.size(); ++i)
     {
-        RenderObject(XMLoadFloat4x4(&sphereWorldMatrices[i]), RenderAssetMap[ObjectType::Sphere].material, RenderAssetMap[ObjectType::Sphere].submesh);
+        RenderObject(*shaderPass, XMLoadFloat4x4(&sphereWorldMatrices[i]), RenderAssetMap[ObjectType::Sphere].material, RenderAssetMap[ObjectType::Sphere].submesh);
     }
     
     for (size_t i = 0; i < cylinderMatrices.size(); ++i)
     {
-        RenderObject(XMLoadFloat4x4(&cylinderMatrices[i]), RenderAssetMap[ObjectType::Cylinder].material, RenderAssetMap[ObjectType::Cylinder].submesh);
+        RenderObject(*shaderPass, XMLoadFloat4x4(&cylinderMatrices[i]), RenderAssetMap[ObjectType::Cylinder].material, RenderAssetMap[ObjectType::Cylinder].submesh);
     }
 
     swapChain->Present(0, 0);
 }
 
-void LitSkullApp::RenderObject(FXMMATRIX worldMatrix, const Material& material, const Submesh& submesh)
+void LitSkullApp::RenderObject(ShaderPass& renderShaderPass, FXMMATRIX worldMatrix, const Material& material, const Submesh& submesh)
 {
-    shaderPass->SetMatrix(worldMatrix, XMLoadFloat4x4(&viewMatrix), XMLoadFloat4x4(&projectionMatrix));
-    shaderPass->SetMaterial(material);
-    shaderPass->SetEyePosition(eyePosition);
-    shaderPass->SetDirectionalLights(DirectionalLights);
-    shaderPass->SetActiveDirectionalLightCount(activeLightCount);
-    shaderPass->UpdateCBuffer(immediateContext.Get());
+    renderShaderPass.SetMatrix(worldMatrix, XMLoadFloat4x4(&viewMatrix), XMLoadFloat4x4(&projectionMatrix));
+    renderShaderPass.SetMaterial(material);
+    renderShaderPass.SetEyePosition(eyePosition);
+    renderShaderPass.SetDirectionalLights(DirectionalLights);
+    renderShaderPass.SetActiveDirectionalLightCount(activeLightCount);
+    renderShaderPass.UpdateCBuffer(immediateContext.Get());
     immediateContext->DrawIndexed(submesh.indexCount, submesh.startIndexLocation, submesh.baseVertexLocation);
 }
 
 void LitSkullApp::InitShaderPass()
 {
     shaderPass = std::make_unique<ShaderPass>(device.Get());
-    shaderPass->Bind(immediateContext.Get());
+    packedShaderPass = std::make_unique<ShaderPass>(device.Get(), L"Chapter7LitSkullPackedPass", Vertex::PackedPN::Desc);
 }
 
 void LitSkullApp::InitGeometryBuffer()
 {
-    std::vector<Vertex::PN> vertices;
-    std::vector<UINT> indices;
-
-    InitSkullBuffer(vertices, indices);
-    InitShapeBuffer(vertices, indices);
-
-    const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(Vertex::PN) * vertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA vertexInitData{.pSysMem = vertices.data()};
-    device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &vertexBuffer);
-    immediateContext->IASetVertexBuffers(0, 1, std::array{vertexBuffer.Get()}.data(), std::array{static_cast<UINT>(sizeof(Vertex::PN))}.data(), std::array{0u}.data());
-
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{.pSysMem = indices.data()};
-    device->CreateBuffer(&indexBufferDesc, &indexInitData, &indexBuffer);
-    immediateContext->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    InitSkullBuffer();
+    InitShapeBuffer();
 }
 
-void LitSkullApp::InitSkullBuffer(std::vector<Vertex::PN>& inoutVertices, std::vector<UINT>& inoutIndices)
+void LitSkullApp::InitSkullBuffer()
 {
     std::ifstream ifs(Path::GetModelPath(L"skull.txt").c_str());
 
@@ -227,35 +230,85 @@ void LitSkullApp::InitSkullBuffer(std::vector<Vertex::PN>& inoutVertices, std::v
         ifs >> indices[currentIndex] >> indices[currentIndex + 1] >> indices[currentIndex + 2];
     }
 
-    RenderAssetMap[ObjectType::Skull].submesh = Submesh(indices.size(), inoutIndices.size(), inoutVertices.size());
-    inoutVertices.insert(inoutVertices.end(), vertices.begin(), vertices.end());
-    inoutIndices.insert(inoutIndices.end(), indices.begin(), indices.end());
+    // 파일은 같은 위치의 정점을 법선만 달리해 여러 번 저장하며 대부분은 실제 주름이다. 법선까지 같은 정점만 합치고 합친 정점의 법선은 다시 만든다.
+    const MeshWelder::WeldStatistics weldStatistics = MeshWelder::Weld(vertices, indices, &Vertex::PN::position, &Vertex::PN::normal);
+    MeshWelder::RecomputeNormals(vertices, indices, &Vertex::PN::position, &Vertex::PN::normal);
+    OutputDebugString(std::format(L"skull weld vertices {} -> {} ({} -> {} bytes), removed triangles {}\n",
+                                  weldStatistics.sourceVertexCount, weldStatistics.weldedVertexCount, sizeof(Vertex::PN) * weldStatistics.sourceVertexCount,
+                                  sizeof(Vertex::PN) * weldStatistics.weldedVertexCount, weldStatistics.removedTriangleCount).c_str());
+
+    // 해골은 픽셀마다 조명 세 개를 계산하므로 캐시 효율을 조금 양보하더라도 바깥쪽 면이 먼저 그려지도록 삼각형 순서를 바꾼다.
+#if MESH_LOAD_DIAGNOSTICS
+    const MeshOptimizer::OverdrawStatistics overdrawBefore = MeshOptimizer::AnalyzeOverdraw(indices, MakeVertexView(std::span<const Vertex::PN>(vertices), &Vertex::PN::position));
+#endif
+    MeshOptimizer::Optimize(vertices, indices, &Vertex::PN::position);
+#if MESH_LOAD_DIAGNOSTICS
+    const MeshOptimizer::OverdrawStatistics overdrawAfter = MeshOptimizer::AnalyzeOverdraw(indices, MakeVertexView(std::span<const Vertex::PN>(vertices), &Vertex::PN::position));
+    OutputDebugString(std::format(L"skull overdraw {:.3f} -> {:.3f}, ACMR {:.3f}\n", overdrawBefore.overdraw, overdrawAfter.overdraw,
+                                  MeshOptimizer::AnalyzeVertexCache(indices, vertices.size()).acmr).c_str());
+#endif
+
+    // 위치는 해골의 AABB 기준 16비트, 법선은 팔면체 16비트로 압축해 정점당 24바이트를 12바이트로 줄인다.
+    const VertexView vertexView = MakeVertexView(std::span<const Vertex::PN>(vertices), &Vertex::PN::position, &Vertex::PN::normal);
+    const VertexQuantizer::QuantizationInfo quantizationInfo = VertexQuantizer::ComputeQuantizationInfo(vertexView);
+
+    std::vector<Vertex::PackedPN> packedVertices;
+    VertexQuantizer::Encode(vertexView, quantizationInfo, packedVertices);
+    packedShaderPass->SetPositionDecode(quantizationInfo.extent, quantizationInfo.minimum);
+
+#if MESH_LOAD_DIAGNOSTICS
+    const VertexQuantizer::QuantizationError error = VertexQuantizer::MeasureError(vertexView, {}, VertexQuantizer::Decode(packedVertices, quantizationInfo));
+    OutputDebugString(std::format(L"skull vertices {} -> {} bytes, max position error {:.6f} (bound {:.6f}), max normal error {:.4f} deg\n",
+                                  sizeof(Vertex::PN) * vertices.size(), sizeof(Vertex::PackedPN) * packedVertices.size(),
+                                  error.position, quantizationInfo.GetMaxPositionError(), XMConvertToDegrees(error.normalAngle)).c_str());
+#endif
+
+    const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(Vertex::PackedPN) * packedVertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
+    const D3D11_SUBRESOURCE_DATA vertexInitData{.pSysMem = packedVertices.data()};
+    device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &skullVertexBuffer);
+
+    const DXGI_FORMAT indexFormat = MeshBuffer::GetIndexFormat(vertices.size());
+    MeshBuffer::CreateIndexBuffer(device.Get(), indices, indexFormat, &skullIndexBuffer);
+    RenderAssetMap[ObjectType::Skull].submesh = Submesh(indices.size(), 0, 0, indexFormat);
+    RenderAssetMap[ObjectType::Skull].submesh.bounds = Bounds::Compute(vertexView);
 }
 
-void LitSkullApp::InitShapeBuffer(std::vector<Vertex::PN>& inoutVertices, std::vector<UINT>& inoutIndices)
+void LitSkullApp::InitShapeBuffer()
 {
-    auto addMeshData = [&](ObjectType objectType, const GeometryGenerator::MeshData& meshData)
+    // 같은 인자의 도형은 캐시에서 공유하고, 처음 실행할 때 만든 결과는 파일로 저장해 다음 실행에 다시 쓴다.
+    GeometryCache& geometryCache = GeometryCache::GetInstance();
+    const std::filesystem::path cachePath = Path::GetCachePath(L"Geometry.bin");
+    geometryCache.Load(cachePath);
+
+    // toPN의 변환을 바꾸면 파일에 저장된 이전 결과를 쓰지 않도록 올린다.
+    constexpr uint32_t pnLayoutRevision = 1;
+    auto toPN = [](const GeometryGenerator::Vertex& vertex)
+    {
+        return Vertex::PN{.position = vertex.position, .normal = vertex.normal};
+    };
+
+    std::vector<std::pair<ObjectType, MeshBatcherBase::MeshId>> meshIds;
+    auto addMesh = [&](ObjectType objectType, const GeometryCache::Key& key)
     {
-        std::vector<Vertex::PN> vertices(meshData.vertices.size());
-        for (int i = 0; i < vertices.size(); ++i)
-        {
-            vertices[i].position = meshData.vertices[i].position;
-            vertices[i].normal = meshData.vertices[i].normal;
-        }
-
-        std::vector<UINT> indices(meshData.indices.size());
-        for (int i = 0; i < indices.size(); ++i)
-        {
-            indices[i] = meshData.indices[i];
-        }
-
-        RenderAssetMap[objectType].submesh = Submesh(indices.size(), inoutIndices.size(), inoutVertices.size());
-        inoutVertices.insert(inoutVertices.end(), vertices.begin(), vertices.end());
-        inoutIndices.insert(inoutIndices.end(), indices.begin(), indices.end());
+        const std::shared_ptr<const GeometryCache::Mesh<Vertex::PN>> mesh = geometryCache.GetMesh<Vertex::PN>(key, "PN", pnLayoutRevision, toPN);
+        meshIds.emplace_back(objectType, shapeBatcher.Append(mesh->vertices, mesh->indices));
     };
 
-    addMeshData(ObjectType::Box, GeometryGenerator::CreateBox(1.0f, 1.0f, 1.0f));
-    addMeshData(ObjectType::Grid, GeometryGenerator::CreateGrid(20.0f, 30.0f, 60, 40));
-    addMeshData(ObjectType::Sphere, GeometryGenerator::CreateGeodesicSphere(0.5f, 3));
-    addMeshData(ObjectType::Cylinder, GeometryGenerator::CreateCylinder(0.5f, 0.3f, 3.0f, 20, 20));
+    addMesh(ObjectType::Box, GeometryCache::MakeBoxKey(1.0f, 1.0f, 1.0f));
+    addMesh(ObjectType::Grid, GeometryCache::MakeGridKey(20.0f, 30.0f, 60, 40));
+    addMesh(ObjectType::Sphere, GeometryCache::MakeGeodesicSphereKey(0.5f, 3));
+    addMesh(ObjectType::Cylinder, GeometryCache::MakeCylinderKey(0.5f, 0.3f, 3.0f, 20, 20));
+
+    // 이후로 도형을 추가하거나 제거하지 않으므로 구간을 한 번만 받아 둔다.
+    shapeBatcher.Commit(device.Get(), immediateContext.Get());
+    for (const auto& [objectType, meshId] : meshIds)
+    {
+        RenderAssetMap[objectType].submesh = shapeBatcher.GetSubmesh(meshId);
+    }
+
+    geometryCache.Save(cachePath);
+
+    const GeometryCache::Statistics statistics = geometryCache.GetStatistics();
+    OutputDebugString(std::format(L"geometry cache hit {} (disk {}), miss {}, generated {:.2f} ms, saved {:.2f} ms\n",
+                                  statistics.hitCount, statistics.diskHitCount, statistics.missCount, statistics.generationMilliseconds, statistics.savedMilliseconds).c_str());
 }
@@ -2,6 +2,7 @@
 
 #include "Core/Engine/SphericalCamera.h"
 #include "Core/Light/Light.h"
+#include "Core/Rendering/MeshBatcher.h"
 #include "Core/Rendering/Submesh.h"
 
 #include <array>
@@ -41,16 +42,19 @@ protected:
     void Update(float deltaSeconds) override;
     void Render() override;
 
-    void RenderObject(DirectX::XMMATRIX worldMatrix, const Material& material, const Submesh& submesh);
+    void RenderObject(ShaderPass& renderShaderPass, DirectX::XMMATRIX worldMatrix, const Material& material, const Submesh& submesh);
 
 private:
     void InitShaderPass();
     void InitGeometryBuffer();
-    void InitSkullBuffer(std::vector<Vertex::PN>& inoutVertices, std::vector<UINT>& inoutIndices);
-    void InitShapeBuffer(std::vector<Vertex::PN>& inoutVertices, std::vector<UINT>& inoutIndices);
+    void InitSkullBuffer();
+    void InitShapeBuffer();
 
     std::unique_ptr<ShaderPass> shaderPass;
 
+    // 해골은 Vertex::PackedPN(12바이트)으로 압축해 따로 그린다.
+    std::unique_ptr<ShaderPass> packedShaderPass;
+
     DirectX::XMFLOAT3 eyePosition{};
     DirectX::XMFLOAT4X4 viewMatrix{};
     DirectX::XMFLOAT4X4 projectionMatrix{};
@@ -61,8 +65,7 @@ private:
     ComPtr<ID3D11Buffer> skullVertexBuffer;
     ComPtr<ID3D11Buffer> skullIndexBuffer;
 
-    ComPtr<ID3D11Buffer> vertexBuffer;
-    ComPtr<ID3D11Buffer> indexBuffer;
+    MeshBatcher<Vertex::PN> shapeBatcher;
 
     DirectX::XMFLOAT4X4 skullWorldMatrix{};
     DirectX::XMFLOAT4X4 boxWorldMatrix{};
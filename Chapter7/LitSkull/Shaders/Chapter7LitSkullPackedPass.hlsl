@@ -0,0 +1,21 @@
+#include "Chapter7/LitSkull/Shaders/Chapter7LitSkullCommon.hlsli"
+#include "Core/Shaders/HLSL/VertexDecode.hlsli"
+
+// Vertex::PackedPN
+struct VertexIn
+{
+    float4 packedPositionOS : POSITION;
+    float2 packedNormalOS : NORMAL;
+};
+
+VertexOut VS_Main(VertexIn input)
+{
+    const float3 positionOS = DecodePosition(input.packedPositionOS, positionDecodeScale.xyz, positionDecodeOffset.xyz);
+    const float3 normalOS = DecodeOctahedral(input.packedNormalOS);
+
+    VertexOut output;
+    output.positionWS = mul(float4(positionOS, 1.0f), worldMatrix).xyz;
+    output.positionCS = mul(float4(positionOS, 1.0f), wvpMatrix);
+    output.normalWS = mul(normalOS, (float3x3)worldInverseTransposeMatrix);
+    return output;
+}
@@ -6,9 +6,11 @@
 
 using namespace DirectX;
 
-ShaderPass::ShaderPass(ID3D11Device* device)
-    : ShaderPassBase(device, L"Chapter7LitSkullPass_vs", L"Chapter7LitSkullPass_ps", Vertex::PN::Desc)
+ShaderPass::ShaderPass(ID3D11Device* device, const std::wstring& shaderName, const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElementDescs)
+    : ShaderPassBase(device, shaderName + L"_vs", shaderName + L"_ps", inputElementDescs)
 {
+    SetPositionDecode(XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT3(0.0f, 0.0f, 0.0f));
+
     const CD3D11_BUFFER_DESC renderDateCBufferDesc(sizeof(RenderData), D3D11_BIND_CONSTANT_BUFFER, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
     device->CreateBuffer(&renderDateCBufferDesc, nullptr, &renderDataCBuffer);
 
@@ -47,6 +49,13 @@ void ShaderPass::SetMaterial(const Material& material)
     renderDataDirty = true;
 }
 
+void ShaderPass::SetPositionDecode(const DirectX::XMFLOAT3& scale, const DirectX::XMFLOAT3& offset)
+{
+    renderData.positionDecodeScale = XMFLOAT4(scale.x, scale.y, scale.z, 0.0f);
+    renderData.positionDecodeOffset = XMFLOAT4(offset.x, offset.y, offset.z, 0.0f);
+    renderDataDirty = true;
+}
+
 void ShaderPass::SetDirectionalLights(const std::array<DirectionalLight, 3>& directionalLights)
 {
     std::ranges::copy(directionalLights, lightData.directionalLights);
@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/Light/Light.h"
+#include "Core/Rendering/Vertex.h"
 #include "Core/Shaders/ShaderPass/ShaderPassBase.h"
 
 class ShaderPass final : public ShaderPassBase
@@ -10,6 +11,8 @@ class ShaderPass final : public ShaderPassBase
         DirectX::XMFLOAT4X4 worldInverseTransposeMatrix;
         DirectX::XMFLOAT4X4 wvpMatrix;
         Material material;
+        DirectX::XMFLOAT4 positionDecodeScale;
+        DirectX::XMFLOAT4 positionDecodeOffset;
     };
 
     struct LightData
@@ -22,7 +25,8 @@ class ShaderPass final : public ShaderPassBase
     DECLARE_SHADER(ShaderPass, ShaderPassBase)
 
 public:
-    ShaderPass(ID3D11Device* device);
+    // shaderName은 Shaders 폴더의 *Pass.hlsl 파일 이름이다. 압축 정점은 Chapter7LitSkullPackedPass와 Vertex::PackedPN::Desc를 쓴다.
+    ShaderPass(ID3D11Device* device, const std::wstring& shaderName = L"Chapter7LitSkullPass", const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElementDescs = Vertex::PN::Desc);
     ~ShaderPass();
 
     void Bind(ID3D11DeviceContext* context) override;
@@ -31,6 +35,9 @@ public:
 
     void SetMatrix(DirectX::FXMMATRIX worldMatrix, DirectX::CXMMATRIX viewMatrix, DirectX::CXMMATRIX projectionMatrix);
     void SetMaterial(const Material& material);
+
+    // 압축 정점의 위치 복원 값(QuantizationInfo의 extent와 minimum)
+    void SetPositionDecode(const DirectX::XMFLOAT3& scale, const DirectX::XMFLOAT3& offset);
     
     void SetDirectionalLights(const std::array<DirectionalLight, 3>& directionalLights);
     void SetEyePosition(const DirectX::XMFLOAT3& eyePosition);
@@ -7,6 +7,7 @@
 #include "Core/Common/Timer.h"
 #include "Core/Data/Color.h"
 #include "Core/Data/Path.h"
+#include "Core/Rendering/MeshBuffer.h"
 #include "Core/Rendering/Vertex.h"
 #include "Shaders/CrateShaderPass.h"
 
@@ -133,19 +134,16 @@ void CrateApp::Render()
 
 void CrateApp::InitGeometry()
 {
-    const auto [boxVertices, boxIndices] = GeometryGenerator::CreateBox(1.0f, 1.0f, 1.0f);
-
-    std::vector<Vertex::PNT> vertices(boxVertices.size());
-    for (size_t i = 0; i < vertices.size(); ++i)
+    // 상자는 컴파일 타임에 Vertex::PNT로 변환해 두고 그대로 업로드한다.
+    static constexpr auto boxMesh = GeometryGenerator::ConvertStaticMesh(StaticGeometry::UnitBox, [](const GeometryGenerator::Vertex& vertex)
     {
-        vertices[i].position = boxVertices[i].position;
-        vertices[i].normal = boxVertices[i].normal;
-        vertices[i].tex = boxVertices[i].texC;
-    }
+        return Vertex::PNT{vertex.position, vertex.normal, vertex.texC};
+    });
 
-    std::vector<UINT> indices;
-    indices.insert(indices.end(), boxIndices.begin(), boxIndices.end());
+    const std::span<const Vertex::PNT> vertices = boxMesh.vertices;
+    const std::span<const UINT> indices = boxMesh.indices;
     indexCount = static_cast<UINT>(indices.size());
+    constexpr DXGI_FORMAT indexFormat = MeshBuffer::GetIndexFormat(boxMesh.vertices.size());
 
     const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(Vertex::PNT) * vertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
     const D3D11_SUBRESOURCE_DATA vertexInitData{.pSysMem = vertices.data()};
@@ -156,10 +154,8 @@ void CrateApp::InitGeometry()
         std::array{static_cast<UINT>(sizeof(Vertex::PNT))}.data(), std::array{0u}.data()
     );
 
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{.pSysMem = indices.data()};
-    device->CreateBuffer(&indexBufferDesc, &indexInitData, &indexBuffer);
-    immediateContext->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    MeshBuffer::CreateIndexBuffer(device.Get(), indices, indexFormat, &indexBuffer);
+    immediateContext->IASetIndexBuffer(indexBuffer.Get(), indexFormat, 0);
 }
 
 void CrateApp::InitTexture()
@@ -10,7 +10,9 @@
 #include "Core/Data/Color.h"
 #include "Core/Data/Path.h"
 #include "Core/Data/SphericalCoord.h"
+#include "Core/Rendering/MeshBuffer.h"
 #include "Core/Rendering/Vertex.h"
+#include "Core/Utilities/HillHeightField.h"
 #include "Core/Utilities/Utility.h"
 #include "Shaders/TexturedHillsAndWavesShaderPass.h"
 
@@ -117,7 +119,7 @@ void TexturedHillsAndWavesApp::Update(float deltaSeconds)
     Vertex::PNT* waveVertices = static_cast<Vertex::PNT*>(mapped.pData);
     for (UINT i = 0; i < waves.VertexCount(); ++i)
     {
-        waveVertices[i].position = waves[i];
+        waveVertices[i].position = waves.Interpolated(i);
         waveVertices[i].normal = waves.Normal(i);
         waveVertices[i].tex.x = 0.5f + waves[i].x / waves.Width();
         waveVertices[i].tex.y = 0.5f - waves[i].z / waves.Depth();
@@ -127,7 +129,7 @@ void TexturedHillsAndWavesApp::Update(float deltaSeconds)
 
     pointLight.position.x = 70.0f * std::cos(0.2f * static_cast<float>(timer->GetTotalSeconds()));
     pointLight.position.z = 70.0f * std::sin(0.2f * static_cast<float>(timer->GetTotalSeconds()));
-    pointLight.position.y = std::max(GetHeight(pointLight.position.x, pointLight.position.z), -3.0f) + 10.0f;
+    pointLight.position.y = std::max(HillHeightField::GetHeight(pointLight.position.x, pointLight.position.z), -3.0f) + 10.0f;
 
     spotLight.position = eyePosition;
     XMStoreFloat3(&spotLight.direction, XMVector3Normalize(focusPosition - cameraPosition));
@@ -144,12 +146,12 @@ void TexturedHillsAndWavesApp::Render()
     RenderObject(
         hillsVertexBuffer.Get(), hillsIndexBuffer.Get(),
         XMLoadFloat4x4(&hillsWorldMatrix), viewProjectionMatrix, XMLoadFloat4x4(&hillsUVMatrix),
-        hillsDiffuseMapSRV.Get(), hillsMaterial, hillsSubmesh.indexCount
+        hillsDiffuseMapSRV.Get(), hillsMaterial, hillsSubmesh
     );
     RenderObject(
         wavesVertexBuffer.Get(), wavesIndexBuffer.Get(),
         XMLoadFloat4x4(&wavesWorldMatrix), viewProjectionMatrix, XMLoadFloat4x4(&wavesUVMatrix),
-        wavesDiffuseMapSRV.Get(), wavesMaterial, wavesSubmesh.indexCount
+        wavesDiffuseMapSRV.Get(), wavesMaterial, wavesSubmesh
     );
 
     swapChain->Present(0, 0);
@@ -158,7 +160,7 @@ void TexturedHillsAndWavesApp::Render()
 void TexturedHillsAndWavesApp::RenderObject(
     ID3D11Buffer* vertexBufferPtr, ID3D11Buffer* indexBufferPtr,
     FXMMATRIX worldMatrix, CXMMATRIX viewProjectionMatrix, CXMMATRIX uvMatrix,
-    ID3D11ShaderResourceView* diffuseMapSRV, const Material& material, UINT indexCount
+    ID3D11ShaderResourceView* diffuseMapSRV, const Material& material, const Submesh& submesh
 )
 {
     basicShader->SetMatrix(worldMatrix, viewProjectionMatrix);
@@ -171,10 +173,10 @@ void TexturedHillsAndWavesApp::RenderObject(
     constexpr UINT stride = sizeof(Vertex::PNT);
     constexpr UINT offset = 0;
     immediateContext->IASetVertexBuffers(0, 1, &vertexBufferPtr, &stride, &offset);
-    immediateContext->IASetIndexBuffer(indexBufferPtr, DXGI_FORMAT_R32_UINT, 0);
+    immediateContext->IASetIndexBuffer(indexBufferPtr, submesh.indexFormat, 0);
     immediateContext->PSSetShaderResources(0, 1, std::array{diffuseMapSRV}.data());
 
-    immediateContext->DrawIndexed(indexCount, 0, 0);
+    immediateContext->DrawIndexed(submesh.indexCount, 0, 0);
 }
 
 void TexturedHillsAndWavesApp::CreateGeometry()
@@ -185,27 +187,22 @@ void TexturedHillsAndWavesApp::CreateGeometry()
 
 void TexturedHillsAndWavesApp::CreateLandGeometry()
 {
-    const auto [meshVertices, meshIndices] = GeometryGenerator::CreateGrid(160.0f, 160.0f, 50, 50);
-    hillsSubmesh = Submesh(meshIndices.size(), 0, 0);
+    const GeometryGenerator::MeshSize meshSize = GeometryGenerator::GetGridSize(50, 50);
+    hillsSubmesh = Submesh(meshSize.indexCount, 0, 0, MeshBuffer::GetIndexFormat(meshSize.vertexCount));
 
-    std::vector<Vertex::PNT> vertices(meshVertices.size());
-    std::ranges::transform(meshVertices, vertices.begin(), [](const GeometryGenerator::Vertex& vertex)
+    std::vector<Vertex::PNT> vertices(meshSize.vertexCount);
+    std::vector<UINT> indices(meshSize.indexCount);
+    GeometryGenerator::CreateGrid(160.0f, 160.0f, 50, 50, std::span(vertices), std::span(indices), [](const GeometryGenerator::Vertex& vertex)
     {
-        return Vertex::PNT
-        {
-            .position = XMFLOAT3(vertex.position.x, GetHeight(vertex.position.x, vertex.position.z), vertex.position.z),
-            .normal = GetHillNormal(vertex.position.x, vertex.position.z),
-            .tex = vertex.texC
-        };
+        return Vertex::PNT{.position = vertex.position, .tex = vertex.texC};
     });
+    HillHeightField::Apply(std::span(vertices));
 
     const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(Vertex::PNT) * vertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
     const D3D11_SUBRESOURCE_DATA vertexInitData{vertices.data()};
     device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &hillsVertexBuffer);
 
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * hillsSubmesh.indexCount), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{meshIndices.data()};
-    device->CreateBuffer(&indexBufferDesc, &indexInitData, &hillsIndexBuffer);
+    MeshBuffer::CreateIndexBuffer(device.Get(), indices, hillsSubmesh.indexFormat, &hillsIndexBuffer);
 }
 
 void TexturedHillsAndWavesApp::CreateWaveGeometry()
@@ -216,6 +213,7 @@ void TexturedHillsAndWavesApp::CreateWaveGeometry()
 
     std::vector<UINT> indices(waves.TriangleCount() * 3);
     wavesSubmesh.indexCount = static_cast<UINT>(indices.size());
+    wavesSubmesh.indexFormat = MeshBuffer::GetIndexFormat(waves.VertexCount());
 
     int k = 0;
     for (UINT i = 0; i < wavesRowCount - 1; ++i)
@@ -240,9 +238,7 @@ void TexturedHillsAndWavesApp::CreateWaveGeometry()
     const CD3D11_BUFFER_DESC vertexBufferDesc(sizeof(Vertex::PNT) * waves.VertexCount(), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
     device->CreateBuffer(&vertexBufferDesc, nullptr, &wavesVertexBuffer);
 
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{indices.data()};
-    device->CreateBuffer(&indexBufferDesc, &indexInitData, &wavesIndexBuffer);
+    MeshBuffer::CreateIndexBuffer(device.Get(), indices, wavesSubmesh.indexFormat, &wavesIndexBuffer);
 }
 
 void TexturedHillsAndWavesApp::InitTexture()
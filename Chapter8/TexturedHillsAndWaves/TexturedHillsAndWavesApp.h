@@ -22,7 +22,7 @@ protected:
     virtual void Update(float deltaSeconds) override;
     virtual void Render() override;
 
-    void RenderObject(ID3D11Buffer* vertexBufferPtr, ID3D11Buffer* indexBufferPtr, DirectX::FXMMATRIX worldMatrix, DirectX::CXMMATRIX viewProjectionMatrix, DirectX::CXMMATRIX uvMatrix, ID3D11ShaderResourceView* diffuseMapSRV, const Material& material, UINT indexCount);
+    void RenderObject(ID3D11Buffer* vertexBufferPtr, ID3D11Buffer* indexBufferPtr, DirectX::FXMMATRIX worldMatrix, DirectX::CXMMATRIX viewProjectionMatrix, DirectX::CXMMATRIX uvMatrix, ID3D11ShaderResourceView* diffuseMapSRV, const Material& material, const Submesh& submesh);
 
 private:
     void CreateGeometry();
@@ -31,15 +31,6 @@ private:
 
     void InitTexture();
 
-    static float GetHeight(float x, float z) { return 0.3f * (z * std::sin(0.1f * x) + x * std::cos(0.1f * z)); }
-
-    static DirectX::XMFLOAT3 GetHillNormal(float x, float z)
-    {
-        DirectX::XMFLOAT3 n(-0.03f * z * std::cos(0.1f * x) - 0.3f * std::cos(0.1f * z), 1.0f, -0.3f * std::sin(0.1f * x) + 0.03f * x * std::sin(0.1f * z));
-        XMStoreFloat3(&n, DirectX::XMVector3Normalize(XMLoadFloat3(&n)));
-        return n;
-    }
-
     std::unique_ptr<TexturedHillsAndWavesShaderPass> basicShader;
     ComPtr<ID3D11SamplerState> samplerState;
 
@@ -6,6 +6,7 @@
 #include "Core/Common/Timer.h"
 #include "Data/SphericalCoord.h"
 #include "Exercise/Chapter6.hpp"
+#include "Rendering/MeshBuffer.h"
 #include "Utilities/Utility.h"
 
 BoxApp::BoxApp()
@@ -105,7 +106,7 @@ void BoxApp::Render()
     constexpr UINT strides[] = {sizeof(Chapter6::PositionVertex), sizeof(Chapter6::ColorVertex)};
     constexpr UINT offsets[] = {0, 0};
     immediateContext->IASetVertexBuffers(0, 2, vertexBuffers, strides, offsets);
-    immediateContext->IASetIndexBuffer(boxIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    immediateContext->IASetIndexBuffer(boxIndexBuffer.Get(), boxIndexFormat, 0);
 
     // WVP 행렬
     // constant buffer 업데이트
@@ -192,9 +193,8 @@ void BoxApp::CreateGeometryBuffers()
     CHECK_HR(device->CreateBuffer(&colorBufferDesc, &colorVertexInitData, &boxColorVertexBuffer), L"색상 버텍스 버퍼 생성에 실패했습니다.");
 
     // 인덱스 버퍼 생성
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * boxIndices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{boxIndices.data()};
-    CHECK_HR(device->CreateBuffer(&indexBufferDesc, &indexInitData, &boxIndexBuffer), L"인덱스 버퍼 생성에 실패했습니다.");
+    boxIndexFormat = MeshBuffer::GetIndexFormat(boxIndices);
+    CHECK_HR(MeshBuffer::CreateIndexBuffer(device.Get(), boxIndices, boxIndexFormat, &boxIndexBuffer), L"인덱스 버퍼 생성에 실패했습니다.");
 }
 
 void BoxApp::CreateShaders()
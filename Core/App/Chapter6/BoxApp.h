@@ -50,4 +50,5 @@ private:
     POINT lastMousePosition{};
 
     std::vector<UINT> boxIndices;
+    DXGI_FORMAT boxIndexFormat = DXGI_FORMAT_R32_UINT;
 };
@@ -60,23 +60,22 @@ void Exercise::Render()
 
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-    constexpr UINT strid = sizeof(VertexWithColor);
-    constexpr UINT offset = 0;
-    immediateContext->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &strid, &offset);
-    immediateContext->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    meshBatcher.Bind(immediateContext.Get());
 
-    auto drawObject = [&](const XMFLOAT4X4& inWorldMatrix, const Submesh& inSubmesh)
+    auto drawObject = [&](const XMFLOAT4X4& inWorldMatrix, MeshBatcherBase::MeshId meshId)
     {
+        const Submesh submesh = meshBatcher.GetSubmesh(meshId);
+
         D3D11_MAPPED_SUBRESOURCE mapped;
         CHECK_HR(immediateContext->Map(wvpMatrixBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped), L"");
         XMStoreFloat4x4(static_cast<XMFLOAT4X4*>(mapped.pData), XMLoadFloat4x4(&inWorldMatrix) * XMLoadFloat4x4(&viewMatrix) * XMLoadFloat4x4(&projectionMatrix));
         immediateContext->Unmap(wvpMatrixBuffer.Get(), 0);
 
-        immediateContext->DrawIndexed(inSubmesh.indexCount, inSubmesh.startIndexLocation, inSubmesh.baseVertexLocation);
+        immediateContext->DrawIndexed(submesh.indexCount, submesh.startIndexLocation, submesh.baseVertexLocation);
     };
 
-    drawObject(pyramidWorldMatrix, pyramidSubmesh);
-    drawObject(boxWorldMatrix, boxSubmesh);
+    drawObject(pyramidWorldMatrix, pyramidMeshId);
+    drawObject(boxWorldMatrix, boxMeshId);
 
     swapChain->Present(0, 0);
 }
@@ -130,32 +129,14 @@ void Exercise::CreateGeometry()
     };
 
     const GeometryGenerator::MeshData boxMesh = GeometryGenerator::CreateBox(2.0f, 2.0f, 2.0f);
-    std::vector<VertexWithColor> boxVertices(boxMesh.vertices.size());
-    for (size_t i = 0; i < boxVertices.size(); ++i)
-    {
-        boxVertices[i].position = boxMesh.vertices[i].position;
-        boxVertices[i].color = Color(255, 0, 255);
-    }
-
-    std::vector<VertexWithColor> vertices;
-    vertices.insert(vertices.end(), pyramidVertices.begin(), pyramidVertices.end());
-    vertices.insert(vertices.end(), boxVertices.begin(), boxVertices.end());
 
-    std::vector<UINT> indices;
-    indices.insert(indices.end(), pyramidIndices.begin(), pyramidIndices.end());
-    indices.insert(indices.end(), boxMesh.indices.begin(), boxMesh.indices.end());
-
-    pyramidSubmesh = Submesh{pyramidIndices.size(), 0, 0};
-    boxSubmesh = Submesh{boxMesh.indices.size(), pyramidSubmesh.startIndexLocation + pyramidIndices.size(), pyramidSubmesh.baseVertexLocation + pyramidVertices.size()};
+    pyramidMeshId = meshBatcher.Append(pyramidVertices, pyramidIndices);
+    boxMeshId = meshBatcher.Append(boxMesh, [](const GeometryGenerator::Vertex& vertex)
+    {
+        return VertexWithColor{vertex.position, Color(255, 0, 255)};
+    });
+    CHECK_HR(meshBatcher.Commit(device.Get(), immediateContext.Get()), L"");
 
     XMStoreFloat4x4(&pyramidWorldMatrix, XMMatrixTranslation(-1.5f, 0.0f, 0.0f));
     XMStoreFloat4x4(&boxWorldMatrix, XMMatrixTranslation(1.5f, 0.0f, 0.0f));
-
-    const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(VertexWithColor) * vertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA vertexBufferInitData{vertices.data()};
-    CHECK_HR(device->CreateBuffer(&vertexBufferDesc, &vertexBufferInitData, &vertexBuffer), L"");
-
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexBufferInitData{indices.data()};
-    CHECK_HR(device->CreateBuffer(&indexBufferDesc, &indexBufferInitData, &indexBuffer), L"");
 }
@@ -3,7 +3,8 @@
 #include <array>
 
 #include "Core/Engine/SphericalCamera.h"
-#include "Rendering/Submesh.h"
+#include "Rendering/MeshBatcher.h"
+#include "Rendering/VertexTypes.h"
 
 class Exercise : public SphericalCamera
 {
@@ -33,8 +34,7 @@ private:
 
     ComPtr<ID3D11Buffer> wvpMatrixBuffer;
 
-    ComPtr<ID3D11Buffer> vertexBuffer;
-    ComPtr<ID3D11Buffer> indexBuffer;
+    MeshBatcher<VertexWithColor> meshBatcher;
 
     DirectX::XMFLOAT4X4 viewMatrix;
     DirectX::XMFLOAT4X4 projectionMatrix;
@@ -42,8 +42,8 @@ private:
     std::array<DirectX::XMFLOAT3, 8> pointPositions{};
 
     DirectX::XMFLOAT4X4 boxWorldMatrix{};
-    Submesh boxSubmesh{};
+    MeshBatcherBase::MeshId boxMeshId = 0;
 
     DirectX::XMFLOAT4X4 pyramidWorldMatrix{};
-    Submesh pyramidSubmesh{};
+    MeshBatcherBase::MeshId pyramidMeshId = 0;
 };
@@ -2,6 +2,8 @@
 
 #include "Common/GeometryGenerator.h"
 #include "Data/SphericalCoord.h"
+#include "Rendering/MeshBuffer.h"
+#include "Utilities/HillHeightField.h"
 #include "Utilities/Utility.h"
 
 #include <algorithm>
@@ -9,6 +11,31 @@
 
 using namespace DirectX;
 
+namespace
+{
+    XMFLOAT4 GetHeightColor(float height)
+    {
+        if (height < -10.0f)
+        {
+            return XMFLOAT4(1.0f, 0.96f, 0.62f, 1.0f);
+        }
+        if (height < 5.0f)
+        {
+            return XMFLOAT4(0.48f, 0.77f, 0.46f, 1.0f);
+        }
+        if (height < 12.0f)
+        {
+            return XMFLOAT4(0.1f, 0.48f, 0.19f, 1.0f);
+        }
+        if (height < 20.0f)
+        {
+            return XMFLOAT4(0.45f, 0.39f, 0.34f, 1.0f);
+        }
+
+        return XMFLOAT4(0.48f, 0.96f, 0.62f, 1.0f);
+    }
+}
+
 HillApp::HillApp()
 {
     const XMMATRIX identityMatrix = XMMatrixIdentity();
@@ -24,7 +51,7 @@ bool HillApp::Init(HINSTANCE inInstanceHandle)
         return false;
     }
 
-    CreateGeometryBuffers();
+    CreateTerrain();
     CreateShaders();
 
     return true;
@@ -35,7 +62,7 @@ void HillApp::OnResize()
     Super::OnResize();
 
     // 창의 크기가 수정되었으므로 종횡비를 갱신
-    const XMMATRIX newProjectionMatrix = XMMatrixPerspectiveFovLH(0.25f * XM_PI, GetAspectRatio(), 1.0f, 1000.0f);
+    const XMMATRIX newProjectionMatrix = XMMatrixPerspectiveFovLH(FieldOfView, GetAspectRatio(), 1.0f, 1000.0f);
     XMStoreFloat4x4(&projectionMatrix, newProjectionMatrix);
 }
 
@@ -69,7 +96,7 @@ void HillApp::OnMouseMove(WPARAM buttonState, int x, int y)
         constexpr float zoomSpeed = 0.2f; // 1픽셀당 0.2만큼 근접 or 멀어짐
         const float dx = zoomSpeed * static_cast<float>(currentMousePosition.x - lastMousePosition.x);
 
-        radius = std::clamp(radius - (dx), 100.0f, 600.0f);
+        radius = std::clamp(radius - (dx), 20.0f, 600.0f);
     }
 
     lastMousePosition = currentMousePosition;
@@ -83,13 +110,20 @@ void HillApp::Update(float deltaSeconds)
     const XMVECTOR upDirection = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
     const XMMATRIX newViewMatrix = XMMatrixLookAtLH(cameraPosition, targetPosition, upDirection);
     XMStoreFloat4x4(&viewMatrix, newViewMatrix);
+
+    // 카메라에 맞춰 청크를 고르고, 더 세밀한 청크가 필요하면 프레임마다 조금씩 만든다.
+    terrain->Update(cameraPosition, newViewMatrix * XMLoadFloat4x4(&projectionMatrix), static_cast<float>(clientHeight), FieldOfView);
+    for (const uint64_t chunkId : terrain->GetEvictedChunkIds())
+    {
+        chunkBuffers.erase(chunkId);
+    }
 }
 
 void HillApp::Render()
 {
     Super::Render();
 
-    if (!immediateContext || !renderTargetView || !depthStencilView || !inputLayout || !vertexBuffer || !indexBuffer || !constantBuffer || !vertexShader || !pixelShader)
+    if (!immediateContext || !renderTargetView || !depthStencilView || !inputLayout || !terrain || !constantBuffer || !vertexShader || !pixelShader)
     {
         return;
     }
@@ -102,11 +136,6 @@ void HillApp::Render()
     immediateContext->IASetInputLayout(inputLayout.Get());
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-    constexpr UINT stride = sizeof(VertexWithLinearColor);
-    constexpr UINT offset = 0;
-    immediateContext->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
-    immediateContext->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-
     // WVP 행렬
     const XMMATRIX wvpMatrix = XMLoadFloat4x4(&worldMatrix) * XMLoadFloat4x4(&viewMatrix) * XMLoadFloat4x4(&projectionMatrix);
 
@@ -131,57 +160,62 @@ void HillApp::Render()
      *
      * 따라서 99%의 경우 DrawIndexed를 사용한다.
      */
-    // 셰이더 호출
-    immediateContext->DrawIndexed(indexCount, 0, 0);
+    // 셰이더 호출. 청크마다 자기 버퍼를 쓴다.
+    constexpr UINT stride = sizeof(VertexWithLinearColor);
+    constexpr UINT offset = 0;
+    for (const TerrainQuadtree::Chunk* chunk : terrain->GetSelectedChunks())
+    {
+        const ChunkBuffer& chunkBuffer = GetChunkBuffer(*chunk);
+        immediateContext->IASetVertexBuffers(0, 1, chunkBuffer.vertexBuffer.GetAddressOf(), &stride, &offset);
+        immediateContext->IASetIndexBuffer(chunkBuffer.indexBuffer.Get(), chunkBuffer.indexFormat, 0);
+        immediateContext->DrawIndexed(chunkBuffer.indexCount, 0, 0);
+    }
 
     swapChain->Present(0, 0);
 }
 
-void HillApp::CreateGeometryBuffers()
+void HillApp::CreateTerrain()
 {
-    GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(160.0f, 160.0f, 50, 50);
+    // 예전의 50x50 격자와 같은 160x160 범위를 가장 세밀한 단계에서 512x512 셀까지 나눈다.
+    TerrainQuadtree::Desc desc;
+    desc.size = 160.0f;
+    desc.levelCount = 5;
+    desc.chunkCellCount = 32;
+
+    terrain = std::make_unique<TerrainQuadtree>(&HillHeightField::GetHeights, desc);
+}
 
-    std::vector<VertexWithLinearColor> vertices(grid.vertices.size());
-    for (size_t i = 0; i < grid.vertices.size(); ++i)
+const HillApp::ChunkBuffer& HillApp::GetChunkBuffer(const TerrainQuadtree::Chunk& chunk)
+{
+    const auto [found, isInserted] = chunkBuffers.try_emplace(chunk.id);
+    ChunkBuffer& chunkBuffer = found->second;
+    if (!isInserted)
     {
-        XMFLOAT3 position = grid.vertices[i].position;
-        position.y = GetHeight(position.x, position.z);
-        vertices[i].position = position;
+        return chunkBuffer;
+    }
 
-        if (position.y < -10.0f)
-        {
-            vertices[i].linearColor = XMFLOAT4(1.0f, 0.96f, 0.62f, 1.0f);
-        }
-        else if (position.y < 5.0f)
-        {
-            vertices[i].linearColor = XMFLOAT4(0.48f, 0.77f, 0.46f, 1.0f);
-        }
-        else if (position.y < 12.0f)
-        {
-            vertices[i].linearColor = XMFLOAT4(0.1f, 0.48f, 0.19f, 1.0f);
-        }
-        else if (position.y < 20.0f)
-        {
-            vertices[i].linearColor = XMFLOAT4(0.45f, 0.39f, 0.34f, 1.0f);
-        }
-        else
-        {
-            vertices[i].linearColor = XMFLOAT4(0.48f, 0.96f, 0.62f, 1.0f);
-        }
+    const GeometryGenerator::MeshData& mesh = chunk.mesh;
+
+    std::vector<VertexWithLinearColor> vertices(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+        vertices[i].position = mesh.vertices[i].position;
+        vertices[i].linearColor = GetHeightColor(mesh.vertices[i].position.y);
     }
 
     // 버텍스 버퍼 생성
     const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(VertexWithLinearColor) * vertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
     const D3D11_SUBRESOURCE_DATA vertexInitData{vertices.data()};
-    CHECK_HR(device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &vertexBuffer), L"버텍스 버퍼 생성에 실패했습니다.");
+    CHECK_HR(device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &chunkBuffer.vertexBuffer), L"버텍스 버퍼 생성에 실패했습니다.");
 
     // 인덱스 버퍼 생성
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * grid.indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{grid.indices.data()};
-    CHECK_HR(device->CreateBuffer(&indexBufferDesc, &indexInitData, &indexBuffer), L"인덱스 버퍼 생성에 실패했습니다.");
+    chunkBuffer.indexFormat = mesh.GetIndexFormat();
+    CHECK_HR(MeshBuffer::CreateIndexBuffer(device.Get(), mesh.indices, chunkBuffer.indexFormat, &chunkBuffer.indexBuffer), L"인덱스 버퍼 생성에 실패했습니다.");
 
     // 인덱스 카운트 업데이트
-    indexCount = static_cast<UINT>(grid.indices.size());
+    chunkBuffer.indexCount = static_cast<UINT>(mesh.indices.size());
+
+    return chunkBuffer;
 }
 
 void HillApp::CreateShaders()
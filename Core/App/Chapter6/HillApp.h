@@ -1,6 +1,10 @@
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+
 #include "Core/Engine/EngineBase.h"
+#include "Rendering/TerrainQuadtree.h"
 #include "Rendering/VertexTypes.h"
 
 class HillApp : public EngineBase
@@ -10,8 +14,6 @@ class HillApp : public EngineBase
 public:
     ~HillApp() override = default;
 
-    static float GetHeight(float x, float z) { return 0.3f * (z * std::sin(0.1f * x) + x * std::cos(0.1f * z)); }
-
     bool Init(HINSTANCE inInstanceHandle) override;
     void OnResize() override;
     void OnMouseDown(WPARAM buttonState, int x, int y) override;
@@ -25,12 +27,24 @@ protected:
     virtual void Render() override;
 
 private:
-    void CreateGeometryBuffers();
+    struct ChunkBuffer
+    {
+        ComPtr<ID3D11Buffer> vertexBuffer;
+        ComPtr<ID3D11Buffer> indexBuffer;
+        UINT indexCount = 0;
+        DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT;
+    };
+
+    static constexpr float FieldOfView = 0.25f * DirectX::XM_PI;
+
+    void CreateTerrain();
     void CreateShaders();
 
-    ComPtr<ID3D11Buffer> vertexBuffer;
-    ComPtr<ID3D11Buffer> indexBuffer;
-    UINT indexCount = 0;
+    // 청크 버퍼는 처음 그릴 때 만들고, 지형이 청크를 버리면 함께 지운다.
+    const ChunkBuffer& GetChunkBuffer(const TerrainQuadtree::Chunk& chunk);
+
+    std::unique_ptr<TerrainQuadtree> terrain;
+    std::unordered_map<uint64_t, ChunkBuffer> chunkBuffers;
 
     ComPtr<ID3D11VertexShader> vertexShader;
     ComPtr<ID3D11PixelShader> pixelShader;
@@ -3,8 +3,10 @@
 #include <algorithm>
 #include <d3dcompiler.h>
 
+#include "Common/GeometryCache.h"
 #include "Common/GeometryGenerator.h"
 #include "Data/SphericalCoord.h"
+#include "Rendering/MeshBuffer.h"
 #include "Rendering/VertexTypes.h"
 #include "Utilities/Utility.h"
 
@@ -157,15 +159,21 @@ void MultiDrawApp::Render()
 
 void MultiDrawApp::CreateGeometryBuffers()
 {
-    const GeometryGenerator::MeshData box = GeometryGenerator::CreateBox(1.0f, 1.0f, 1.0f);
-    const GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(20.0f, 30.0f, 60, 40);
-    const GeometryGenerator::MeshData sphere = GeometryGenerator::CreateGeodesicSphere(0.5f, 3);
-    const GeometryGenerator::MeshData cylinder = GeometryGenerator::CreateCylinder(0.5f, 0.3f, 3.0f, 20, 20);
+    // 다른 앱과 같은 인자의 도형이므로 한 프로세스에서는 한 번만 생성된다.
+    GeometryCache& geometryCache = GeometryCache::GetInstance();
+    const GeometryGenerator::MeshData& box = *geometryCache.GetMesh(GeometryCache::MakeBoxKey(1.0f, 1.0f, 1.0f));
+    const GeometryGenerator::MeshData& grid = *geometryCache.GetMesh(GeometryCache::MakeGridKey(20.0f, 30.0f, 60, 40));
+    const GeometryGenerator::MeshData& sphere = *geometryCache.GetMesh(GeometryCache::MakeGeodesicSphereKey(0.5f, 3));
+    const GeometryGenerator::MeshData& cylinder = *geometryCache.GetMesh(GeometryCache::MakeCylinderKey(0.5f, 0.3f, 3.0f, 20, 20));
 
     boxSubmesh = Submesh(box.indices.size(), 0, 0);
     gridSubmesh = Submesh(grid.indices.size(), box.indices.size(), box.vertices.size());
     sphereSubmesh = Submesh(sphere.indices.size(), gridSubmesh.startIndexLocation + grid.indices.size(), gridSubmesh.baseVertexLocation + grid.vertices.size());
     cylinderSubmesh = Submesh(cylinder.indices.size(), sphereSubmesh.startIndexLocation + sphere.indices.size(), sphereSubmesh.baseVertexLocation + sphere.vertices.size());
+    boxSubmesh.bounds = box.ComputeBounds();
+    gridSubmesh.bounds = grid.ComputeBounds();
+    sphereSubmesh.bounds = sphere.ComputeBounds();
+    cylinderSubmesh.bounds = cylinder.ComputeBounds();
 
     std::vector<VertexWithLinearColor> vertices(box.vertices.size() + grid.vertices.size() + sphere.vertices.size() + cylinder.vertices.size());
 
@@ -198,9 +206,14 @@ void MultiDrawApp::CreateGeometryBuffers()
     CHECK_HR(device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &vertexBuffer), L"버텍스 버퍼 생성에 실패했습니다.");
 
     // 인덱스 버퍼 생성
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{indices.data()};
-    CHECK_HR(device->CreateBuffer(&indexBufferDesc, &indexInitData, &indexBuffer), L"인덱스 버퍼 생성에 실패했습니다.");
+    // 모든 도형이 baseVertexLocation으로 구분되어 하나의 인덱스 버퍼를 쓰므로 인덱스 형식도 같다.
+    const DXGI_FORMAT indexFormat = MeshBuffer::GetIndexFormat(indices);
+    for (Submesh* submesh : {&boxSubmesh, &gridSubmesh, &sphereSubmesh, &cylinderSubmesh})
+    {
+        submesh->indexFormat = indexFormat;
+    }
+
+    CHECK_HR(MeshBuffer::CreateIndexBuffer(device.Get(), indices, indexFormat, &indexBuffer), L"인덱스 버퍼 생성에 실패했습니다.");
 
     // 인덱스 카운트 업데이트
     indexCount = static_cast<UINT>(indices.size());
@@ -259,7 +272,7 @@ void MultiDrawApp::BindShader()
     constexpr UINT stride = sizeof(VertexWithLinearColor);
     constexpr UINT offset = 0;
     immediateContext->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
-    immediateContext->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    immediateContext->IASetIndexBuffer(indexBuffer.Get(), boxSubmesh.indexFormat, 0);
 
     // constant buffer 연결
     immediateContext->VSSetConstantBuffers(0, 1, constantBuffer.GetAddressOf());
@@ -13,8 +13,6 @@ class MultiDrawApp : public EngineBase
 public:
     ~MultiDrawApp() override = default;
 
-    static float GetHeight(float x, float z) { return 0.3f * (z * std::sin(0.1f * x) + x * std::cos(0.1f * z)); }
-
     bool Init(HINSTANCE inInstanceHandle) override;
     void OnResize() override;
     void OnMouseDown(WPARAM buttonState, int x, int y) override;
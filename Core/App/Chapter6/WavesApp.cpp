@@ -6,6 +6,8 @@
 #include "Common/GeometryGenerator.h"
 #include "Common/Timer.h"
 #include "Data/SphericalCoord.h"
+#include "Rendering/MeshBuffer.h"
+#include "Utilities/HillHeightField.h"
 #include "Utilities/Utility.h"
 
 using namespace DirectX;
@@ -118,7 +120,7 @@ void WavesApp::Update(float deltaSeconds)
     VertexWithLinearColor* vertices = static_cast<VertexWithLinearColor*>(mappedData.pData);
     for (UINT i = 0; i < waves.VertexCount(); ++i)
     {
-        vertices[i].position = waves[static_cast<int>(i)];
+        vertices[i].position = waves.Interpolated(i);
         vertices[i].linearColor = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
     }
 
@@ -131,7 +133,7 @@ void WavesApp::Render()
     immediateContext->ClearDepthStencilView(depthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 
     const XMMATRIX vpMatrix = XMLoadFloat4x4(&viewMatrix) * XMLoadFloat4x4(&projectionMatrix);
-    auto renderObject = [&](ID3D11Buffer* vertexBufferPtr, ID3D11Buffer* indexBufferPtr, const XMFLOAT4X4& worldMatrix, UINT indexCount, bool bUseWireframe = false)
+    auto renderObject = [&](ID3D11Buffer* vertexBufferPtr, ID3D11Buffer* indexBufferPtr, const XMFLOAT4X4& worldMatrix, const Submesh& submesh, bool bUseWireframe = false)
     {
         immediateContext->RSSetState(bUseWireframe ? wireframeRasterizerState.Get() : nullptr);
 
@@ -146,13 +148,13 @@ void WavesApp::Render()
         constexpr UINT stride = sizeof(VertexWithLinearColor);
         constexpr UINT offset = 0;
         immediateContext->IASetVertexBuffers(0, 1, &vertexBufferPtr, &stride, &offset);
-        immediateContext->IASetIndexBuffer(indexBufferPtr, DXGI_FORMAT_R32_UINT, 0);
+        immediateContext->IASetIndexBuffer(indexBufferPtr, submesh.indexFormat, 0);
 
-        immediateContext->DrawIndexed(indexCount, 0, 0);
+        immediateContext->DrawIndexed(submesh.indexCount, 0, 0);
     };
 
-    renderObject(landVertexBuffer.Get(), landIndexBuffer.Get(), landWorldMatrix, gridSubmesh.indexCount);
-    renderObject(wavesVertexBuffer.Get(), wavesIndexBuffer.Get(), wavesWorldMatrix, wavesSubmesh.indexCount, true);
+    renderObject(landVertexBuffer.Get(), landIndexBuffer.Get(), landWorldMatrix, gridSubmesh);
+    renderObject(wavesVertexBuffer.Get(), wavesIndexBuffer.Get(), wavesWorldMatrix, wavesSubmesh, true);
 
     swapChain->Present(0, 0);
 }
@@ -223,14 +225,18 @@ bool WavesApp::CreateGeometryBuffers()
 bool WavesApp::CreateLandGeometryBuffer()
 {
     const GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(160.0f, 160.0f, 50, 50);
-    gridSubmesh = Submesh(grid.indices.size(), 0, 0);
+    gridSubmesh = Submesh(grid.indices.size(), 0, 0, grid.GetIndexFormat());
 
     std::vector<VertexWithLinearColor> vertices(grid.vertices.size());
     for (size_t i = 0; i < vertices.size(); ++i)
     {
-        XMFLOAT3 position = grid.vertices[i].position;
-        position.y = GetHeight(position.x, position.z);
-        vertices[i].position = position;
+        vertices[i].position = grid.vertices[i].position;
+    }
+    HillHeightField::Apply(std::span(vertices));
+
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        const XMFLOAT3& position = vertices[i].position;
 
         if (position.y < -10.0f) // 모래 사장(밝은 노란색)
         {
@@ -254,13 +260,14 @@ bool WavesApp::CreateLandGeometryBuffer()
         }
     }
 
+    // 높이를 바꿨으므로 평평한 격자의 범위 대신 실제 정점으로 다시 계산한다.
+    gridSubmesh.bounds = Bounds::Compute(MakeVertexView(std::span<const VertexWithLinearColor>(vertices), &VertexWithLinearColor::position));
+
     const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(sizeof(VertexWithLinearColor) * vertices.size()), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
     const D3D11_SUBRESOURCE_DATA vertexInitData{vertices.data()};
     CHECK_HR(device->CreateBuffer(&vertexBufferDesc, &vertexInitData, &landVertexBuffer), L"Failed to create land vertext buffer", false);
 
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * gridSubmesh.indexCount), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{grid.indices.data()};
-    CHECK_HR(device->CreateBuffer(&indexBufferDesc, &indexInitData, &landIndexBuffer), L"Failed to create land index buffer", false);
+    CHECK_HR(MeshBuffer::CreateIndexBuffer(device.Get(), grid.indices, gridSubmesh.indexFormat, &landIndexBuffer), L"Failed to create land index buffer", false);
 
     return true;
 }
@@ -273,6 +280,7 @@ bool WavesApp::CreateWaveGeometryBuffer()
 
     std::vector<UINT> indices(waves.TriangleCount() * 3);
     wavesSubmesh.indexCount = static_cast<UINT>(indices.size());
+    wavesSubmesh.indexFormat = MeshBuffer::GetIndexFormat(waves.VertexCount());
 
     int k = 0;
     for (UINT i = 0; i < wavesRowCount - 1; ++i)
@@ -297,9 +305,7 @@ bool WavesApp::CreateWaveGeometryBuffer()
     const CD3D11_BUFFER_DESC vertexBufferDesc(sizeof(VertexWithLinearColor) * waves.VertexCount(), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
     CHECK_HR(device->CreateBuffer(&vertexBufferDesc, nullptr, &wavesVertexBuffer), L"Failed to create wave vertex buffer", false);
 
-    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(sizeof(UINT) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
-    const D3D11_SUBRESOURCE_DATA indexInitData{indices.data()};
-    CHECK_HR(device->CreateBuffer(&indexBufferDesc, &indexInitData, &wavesIndexBuffer), L"Falied to create wave index buffer", false);
+    CHECK_HR(MeshBuffer::CreateIndexBuffer(device.Get(), indices, wavesSubmesh.indexFormat, &wavesIndexBuffer), L"Falied to create wave index buffer", false);
 
     return true;
 }
@@ -32,8 +32,6 @@ private:
     bool CreateLandGeometryBuffer();
     bool CreateWaveGeometryBuffer();
 
-    static float GetHeight(float x, float z) { return 0.3f * (z * std::sin(0.1f * x) + x * std::cos(0.1f * z)); }
-
     ComPtr<ID3D11InputLayout> inputLayout;
     ComPtr<ID3D11VertexShader> vertexShader;
     ComPtr<ID3D11PixelShader> pixelShader;
@@ -0,0 +1,261 @@
+#include "GeometryCache.h"
+
+#include <bit>
+#include <fstream>
+
+namespace
+{
+    // 파일 머리말. 파일 형식이 바뀌면 FileVersion을 올려 이전 파일을 무시하게 한다.
+    // 생성 결과가 바뀌는 경우는 머리말에 함께 기록하는 GeometryGenerator::OutputRevision을 올린다.
+    constexpr uint32_t FileMagic = 0x434F4547; // "GEOC"
+    constexpr uint32_t FileVersion = 2;
+
+    template <typename T>
+    void Write(std::ofstream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void WriteSpan(std::ofstream& stream, std::span<const T> values)
+    {
+        stream.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+    }
+
+    template <typename T>
+    bool Read(std::ifstream& stream, T& outValue)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&outValue), sizeof(T)));
+    }
+
+    // 깨진 파일의 개수로 큰 메모리를 잡지 않도록 파일에 남은 크기를 넘는 개수는 읽지 않는다.
+    template <typename Container>
+    bool ReadContainer(std::ifstream& stream, uint64_t fileSize, uint64_t count, Container& outValues)
+    {
+        const std::streamoff position = stream.tellg();
+        if (position < 0 || count > (fileSize - static_cast<uint64_t>(position)) / sizeof(typename Container::value_type))
+        {
+            return false;
+        }
+
+        outValues.resize(count);
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(outValues.data()), static_cast<std::streamsize>(count * sizeof(typename Container::value_type))));
+    }
+}
+
+GeometryCache& GeometryCache::GetInstance()
+{
+    static GeometryCache instance;
+    return instance;
+}
+
+std::shared_ptr<const GeometryGenerator::MeshData> GeometryCache::GetMesh(const Key& key)
+{
+    return FindOrCreate<GeometryGenerator::MeshData>({key, {}}, [&key]()
+    {
+        return Generate(key);
+    });
+}
+
+GeometryCache::Statistics GeometryCache::GetStatistics() const
+{
+    std::lock_guard lock(mutex);
+
+    Statistics statistics;
+    statistics.hitCount = hitCount;
+    statistics.diskHitCount = diskHitCount;
+    statistics.missCount = missCount;
+    statistics.generationMilliseconds = generationMilliseconds;
+    statistics.savedMilliseconds = savedMilliseconds;
+
+    return statistics;
+}
+
+bool GeometryCache::Load(const std::filesystem::path& filePath)
+{
+    std::ifstream stream(filePath, std::ios::binary | std::ios::ate);
+    if (!stream)
+    {
+        return false;
+    }
+
+    const uint64_t fileSize = static_cast<uint64_t>(stream.tellg());
+    stream.seekg(0);
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t generatorRevision = 0;
+    uint64_t entryCount = 0;
+    if (!Read(stream, magic) || !Read(stream, version) || !Read(stream, generatorRevision) || !Read(stream, entryCount) ||
+        magic != FileMagic || version != FileVersion || generatorRevision != GeometryGenerator::OutputRevision)
+    {
+        return false;
+    }
+
+    // 중간에 잘린 파일이면 아무것도 반영하지 않도록 임시로 모은 뒤 한 번에 넣는다.
+    std::vector<std::pair<EntryKey, DiskEntry>> loadedEntries;
+    for (uint64_t i = 0; i < entryCount; ++i)
+    {
+        EntryKey entryKey;
+        uint32_t layoutLength = 0;
+        if (!Read(stream, entryKey.key.shape) || !Read(stream, entryKey.key.parameters) || !Read(stream, layoutLength))
+        {
+            return false;
+        }
+
+        if (!ReadContainer(stream, fileSize, layoutLength, entryKey.layout))
+        {
+            return false;
+        }
+
+        DiskEntry diskEntry;
+        uint32_t vertexStride = 0;
+        uint64_t vertexByteCount = 0;
+        uint64_t indexCount = 0;
+        if (!Read(stream, vertexStride) || !Read(stream, vertexByteCount) || !Read(stream, indexCount) || !Read(stream, diskEntry.generationMilliseconds) ||
+            !ReadContainer(stream, fileSize, vertexByteCount, diskEntry.vertexBytes) || !ReadContainer(stream, fileSize, indexCount, diskEntry.indices))
+        {
+            return false;
+        }
+        diskEntry.vertexStride = vertexStride;
+
+        loadedEntries.emplace_back(std::move(entryKey), std::move(diskEntry));
+    }
+
+    std::lock_guard lock(mutex);
+    for (auto& [entryKey, diskEntry] : loadedEntries)
+    {
+        if (!entries.contains(entryKey))
+        {
+            diskEntries.insert_or_assign(std::move(entryKey), std::move(diskEntry));
+        }
+    }
+
+    return true;
+}
+
+bool GeometryCache::Save(const std::filesystem::path& filePath)
+{
+    std::lock_guard lock(mutex);
+    if (!isDirty)
+    {
+        return true;
+    }
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(filePath.parent_path(), errorCode);
+
+    // 저장 중에 종료되어도 이전 파일이 깨지지 않도록 임시 파일에 쓴 뒤 교체한다.
+    std::filesystem::path temporaryPath = filePath;
+    temporaryPath += L".tmp";
+    {
+        std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!stream)
+        {
+            return false;
+        }
+
+        Write(stream, FileMagic);
+        Write(stream, FileVersion);
+        Write(stream, static_cast<uint32_t>(GeometryGenerator::OutputRevision));
+        Write(stream, static_cast<uint64_t>(entries.size() + diskEntries.size()));
+
+        auto writeEntry = [&stream](const EntryKey& entryKey, size_t vertexStride, std::span<const std::byte> vertexBytes, std::span<const UINT> indices, double generationMilliseconds)
+        {
+            Write(stream, entryKey.key.shape);
+            Write(stream, entryKey.key.parameters);
+            Write(stream, static_cast<uint32_t>(entryKey.layout.size()));
+            stream.write(entryKey.layout.data(), static_cast<std::streamsize>(entryKey.layout.size()));
+
+            Write(stream, static_cast<uint32_t>(vertexStride));
+            Write(stream, static_cast<uint64_t>(vertexBytes.size()));
+            Write(stream, static_cast<uint64_t>(indices.size()));
+            Write(stream, generationMilliseconds);
+            WriteSpan(stream, vertexBytes);
+            WriteSpan(stream, indices);
+        };
+
+        for (const auto& [entryKey, entry] : entries)
+        {
+            writeEntry(entryKey, entry.vertexStride, entry.vertexBytes, entry.indices, entry.generationMilliseconds);
+        }
+        for (const auto& [entryKey, diskEntry] : diskEntries)
+        {
+            writeEntry(entryKey, diskEntry.vertexStride, diskEntry.vertexBytes, diskEntry.indices, diskEntry.generationMilliseconds);
+        }
+
+        if (!stream)
+        {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, filePath, errorCode);
+    if (errorCode)
+    {
+        return false;
+    }
+
+    isDirty = false;
+    return true;
+}
+
+void GeometryCache::Clear()
+{
+    std::lock_guard lock(mutex);
+    entries.clear();
+    diskEntries.clear();
+    isDirty = false;
+}
+
+size_t GeometryCache::EntryKeyHash::operator()(const EntryKey& entryKey) const
+{
+    // FNV-1a. float 인자는 비트 패턴으로 섞되, operator==에서 같은 -0과 +0은 같은 값이 되도록 +0으로 맞춘다.
+    uint64_t hash = 14695981039346656037ull;
+    auto combine = [&hash](uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (value >> (i * 8)) & 0xffu;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    combine(static_cast<uint32_t>(entryKey.key.shape));
+    for (const float parameter : entryKey.key.parameters)
+    {
+        combine(std::bit_cast<uint32_t>(parameter == 0.0f ? 0.0f : parameter));
+    }
+    for (const char character : entryKey.layout)
+    {
+        combine(static_cast<uint8_t>(character));
+    }
+
+    return static_cast<size_t>(hash);
+}
+
+GeometryGenerator::MeshData GeometryCache::Generate(const Key& key)
+{
+    const std::array<float, 5>& parameters = key.parameters;
+    auto toCount = [](float parameter)
+    {
+        return static_cast<UINT>(parameter);
+    };
+
+    switch (key.shape)
+    {
+    case Shape::Box:
+        return GeometryGenerator::CreateBox(parameters[0], parameters[1], parameters[2]);
+    case Shape::Sphere:
+        return GeometryGenerator::CreateSphere(parameters[0], toCount(parameters[1]), toCount(parameters[2]));
+    case Shape::GeodesicSphere:
+        return GeometryGenerator::CreateGeodesicSphere(parameters[0], toCount(parameters[1]));
+    case Shape::Cylinder:
+        return GeometryGenerator::CreateCylinder(parameters[0], parameters[1], parameters[2], toCount(parameters[3]), toCount(parameters[4]));
+    case Shape::Grid:
+        return GeometryGenerator::CreateGrid(parameters[0], parameters[1], toCount(parameters[2]), toCount(parameters[3]));
+    }
+
+    assert(false && "알 수 없는 모양입니다.");
+    return {};
+}
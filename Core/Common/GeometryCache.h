@@ -0,0 +1,279 @@
+#pragma once
+
+#include <d3d11.h>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+
+// GeometryGenerator로 만든 메시를 (모양, 생성 인자, 정점 레이아웃)으로 구분해 보관하고 불변 메시를 공유 포인터로 돌려준다.
+// 같은 프로세스에서 같은 인자로 다시 요청하면 새로 생성하지 않으며, Save/Load로 다음 실행에도 재사용할 수 있다.
+// 여러 스레드에서 동시에 호출해도 안전하다.
+class GeometryCache
+{
+public:
+    enum class Shape : uint32_t
+    {
+        Box,
+        Sphere,
+        GeodesicSphere,
+        Cylinder,
+        Grid
+    };
+
+    // 모양과 생성 인자. 정수 인자도 float로 담는다. (2^24 이하의 정수는 손실 없이 표현된다)
+    struct Key
+    {
+        Shape shape = Shape::Box;
+        std::array<float, 5> parameters{};
+
+        bool operator==(const Key&) const = default;
+    };
+
+    // GeometryGenerator::Vertex가 아닌 정점 레이아웃으로 변환한 메시
+    template <typename VertexType>
+    struct Mesh
+    {
+        std::vector<VertexType> vertices;
+        std::vector<UINT> indices;
+
+        [[nodiscard]]
+        DXGI_FORMAT GetIndexFormat() const { return MeshBuffer::GetIndexFormat(vertices.size()); }
+    };
+
+    struct Statistics
+    {
+        // 메모리에 있던 메시를 돌려준 횟수, 디스크에서 읽은 메시를 돌려준 횟수, 새로 생성한 횟수
+        size_t hitCount = 0;
+        size_t diskHitCount = 0;
+        size_t missCount = 0;
+
+        // 생성에 쓴 시간과, 캐시 덕분에 생성하지 않아도 된 시간(해당 메시를 처음 생성할 때 걸린 시간의 합)
+        double generationMilliseconds = 0.0;
+        double savedMilliseconds = 0.0;
+    };
+
+    // 여러 앱이 한 프로세스에서 실행되어도 같은 캐시를 쓰도록 프로세스 전역 인스턴스를 제공한다.
+    [[nodiscard]]
+    static GeometryCache& GetInstance();
+
+    [[nodiscard]]
+    static Key MakeBoxKey(float width, float height, float depth) { return {Shape::Box, {width, height, depth}}; }
+
+    [[nodiscard]]
+    static Key MakeSphereKey(float radius, UINT sliceCount, UINT stackCount) { return {Shape::Sphere, {radius, static_cast<float>(sliceCount), static_cast<float>(stackCount)}}; }
+
+    [[nodiscard]]
+    static Key MakeGeodesicSphereKey(float radius, UINT subdivisionCount) { return {Shape::GeodesicSphere, {radius, static_cast<float>(subdivisionCount)}}; }
+
+    [[nodiscard]]
+    static Key MakeCylinderKey(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount)
+    {
+        return {Shape::Cylinder, {bottomRadius, topRadius, height, static_cast<float>(sliceCount), static_cast<float>(stackCount)}};
+    }
+
+    [[nodiscard]]
+    static Key MakeGridKey(float width, float depth, UINT rowVertexCount, UINT columnVertexCount)
+    {
+        return {Shape::Grid, {width, depth, static_cast<float>(rowVertexCount), static_cast<float>(columnVertexCount)}};
+    }
+
+    // GeometryGenerator::Vertex 레이아웃의 메시
+    [[nodiscard]]
+    std::shared_ptr<const GeometryGenerator::MeshData> GetMesh(const Key& key);
+
+    // converter로 정점 레이아웃을 바꾼 메시. layout은 converter를 구분하는 이름이다.
+    // 파일에 저장된 결과는 layout, VertexType, layoutRevision이 모두 같을 때만 쓰므로 converter의 변환을 바꾸면 layoutRevision을 올려야 한다.
+    template <typename VertexType, typename Converter>
+    [[nodiscard]]
+    std::shared_ptr<const Mesh<VertexType>> GetMesh(const Key& key, std::string_view layout, uint32_t layoutRevision, Converter&& converter);
+
+    [[nodiscard]]
+    Statistics GetStatistics() const;
+
+    // 파일에 저장된 메시를 읽어 둔다. 실제 변환은 처음 요청될 때 한다.
+    // 형식이 맞지 않거나 깨진 파일, 다른 GeometryGenerator::OutputRevision으로 만든 파일이면 false를 반환하고 무시한다.
+    bool Load(const std::filesystem::path& filePath);
+
+    // 메모리의 메시와 아직 요청되지 않은 읽어 둔 메시를 모두 저장한다. Load 이후 새로 생성한 메시가 없으면 아무것도 하지 않는다.
+    bool Save(const std::filesystem::path& filePath);
+
+    void Clear();
+
+private:
+    struct EntryKey
+    {
+        Key key;
+
+        // GeometryGenerator::Vertex 레이아웃이면 비어 있고, 아니면 MakeLayoutIdentity로 만든 converter 식별자이다.
+        std::string layout;
+
+        bool operator==(const EntryKey&) const = default;
+    };
+
+    struct EntryKeyHash
+    {
+        size_t operator()(const EntryKey& entryKey) const;
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<const void> mesh;
+        const std::type_info* meshType = nullptr;
+
+        // 저장할 때 정점 형식을 몰라도 쓸 수 있도록 mesh 안의 데이터를 바이트로 가리킨다.
+        size_t vertexStride = 0;
+        std::span<const std::byte> vertexBytes;
+        std::span<const UINT> indices;
+
+        double generationMilliseconds = 0.0;
+    };
+
+    // 파일에서 읽었지만 아직 정점 형식이 정해지지 않은 메시
+    struct DiskEntry
+    {
+        size_t vertexStride = 0;
+        std::vector<std::byte> vertexBytes;
+        std::vector<UINT> indices;
+        double generationMilliseconds = 0.0;
+    };
+
+    template <typename VertexType>
+    static std::string MakeLayoutIdentity(std::string_view layout, uint32_t layoutRevision);
+
+    template <typename MeshType, typename Create>
+    std::shared_ptr<const MeshType> FindOrCreate(EntryKey entryKey, Create&& create);
+
+    template <typename MeshType>
+    static Entry MakeEntry(std::shared_ptr<const MeshType> mesh, double generationMilliseconds);
+
+    static GeometryGenerator::MeshData Generate(const Key& key);
+
+    mutable std::mutex mutex;
+    std::unordered_map<EntryKey, Entry, EntryKeyHash> entries;
+    std::unordered_map<EntryKey, DiskEntry, EntryKeyHash> diskEntries;
+    bool isDirty = false;
+
+    std::atomic<size_t> hitCount = 0;
+    std::atomic<size_t> diskHitCount = 0;
+    std::atomic<size_t> missCount = 0;
+    double generationMilliseconds = 0.0;
+    double savedMilliseconds = 0.0;
+};
+
+template <typename VertexType, typename Converter>
+std::shared_ptr<const GeometryCache::Mesh<VertexType>> GeometryCache::GetMesh(const Key& key, std::string_view layout, uint32_t layoutRevision, Converter&& converter)
+{
+    return FindOrCreate<Mesh<VertexType>>({key, MakeLayoutIdentity<VertexType>(layout, layoutRevision)}, [&]()
+    {
+        const std::shared_ptr<const GeometryGenerator::MeshData> source = GetMesh(key);
+
+        Mesh<VertexType> mesh;
+        mesh.vertices.reserve(source->vertices.size());
+        for (const GeometryGenerator::Vertex& vertex : source->vertices)
+        {
+            mesh.vertices.push_back(converter(vertex));
+        }
+        mesh.indices = source->indices;
+
+        return mesh;
+    });
+}
+
+template <typename VertexType>
+std::string GeometryCache::MakeLayoutIdentity(std::string_view layout, uint32_t layoutRevision)
+{
+    // 이름이 같아도 정점 형식이나 변환이 바뀌면 다른 키가 되도록 형식 이름과 변환 판을 붙인다.
+    std::string identity(layout);
+    identity += '|';
+    identity += typeid(VertexType).name();
+    identity += '|';
+    identity += std::to_string(layoutRevision);
+    return identity;
+}
+
+template <typename MeshType, typename Create>
+std::shared_ptr<const MeshType> GeometryCache::FindOrCreate(EntryKey entryKey, Create&& create)
+{
+    using VertexType = typename decltype(MeshType::vertices)::value_type;
+    static_assert(std::is_trivially_copyable_v<VertexType>, "파일에 그대로 저장할 수 있도록 정점 형식은 trivially copyable이어야 합니다.");
+
+    {
+        std::lock_guard lock(mutex);
+
+        if (const auto found = entries.find(entryKey); found != entries.end())
+        {
+            assert(*found->second.meshType == typeid(MeshType) && "같은 layout 이름에 다른 정점 형식을 사용했습니다.");
+
+            ++hitCount;
+            savedMilliseconds += found->second.generationMilliseconds;
+            return std::static_pointer_cast<const MeshType>(found->second.mesh);
+        }
+
+        if (const auto found = diskEntries.find(entryKey); found != diskEntries.end() && found->second.vertexStride == sizeof(VertexType))
+        {
+            DiskEntry& diskEntry = found->second;
+
+            auto mesh = std::make_shared<MeshType>();
+            mesh->vertices.resize(diskEntry.vertexBytes.size() / sizeof(VertexType));
+            std::memcpy(mesh->vertices.data(), diskEntry.vertexBytes.data(), mesh->vertices.size() * sizeof(VertexType));
+            mesh->indices = std::move(diskEntry.indices);
+
+            ++diskHitCount;
+            savedMilliseconds += diskEntry.generationMilliseconds;
+            entries.emplace(entryKey, MakeEntry<MeshType>(mesh, diskEntry.generationMilliseconds));
+            diskEntries.erase(found);
+            return mesh;
+        }
+    }
+
+    // 생성은 잠금 밖에서 한다. converter가 다른 메시를 요청할 수 있고, 서로 다른 메시는 동시에 생성될 수 있어야 한다.
+    const auto startTime = std::chrono::steady_clock::now();
+    auto mesh = std::make_shared<const MeshType>(create());
+    const double elapsedMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::lock_guard lock(mutex);
+    ++missCount;
+    generationMilliseconds += elapsedMilliseconds;
+
+    // 다른 스레드가 같은 메시를 먼저 넣었으면 그 결과를 공유한다.
+    const auto [found, isInserted] = entries.try_emplace(std::move(entryKey), MakeEntry<MeshType>(mesh, elapsedMilliseconds));
+    if (isInserted)
+    {
+        // 파일에서 읽은 같은 키의 메시가 정점 크기가 달라 쓰이지 않았다면 새로 만든 것으로 대체한다.
+        diskEntries.erase(found->first);
+        isDirty = true;
+    }
+    return std::static_pointer_cast<const MeshType>(found->second.mesh);
+}
+
+template <typename MeshType>
+GeometryCache::Entry GeometryCache::MakeEntry(std::shared_ptr<const MeshType> mesh, double generationMilliseconds)
+{
+    using VertexType = typename decltype(MeshType::vertices)::value_type;
+
+    Entry entry;
+    entry.meshType = &typeid(MeshType);
+    entry.vertexStride = sizeof(VertexType);
+    entry.vertexBytes = std::as_bytes(std::span(mesh->vertices));
+    entry.indices = mesh->indices;
+    entry.generationMilliseconds = generationMilliseconds;
+    entry.mesh = std::move(mesh);
+
+    return entry;
+}
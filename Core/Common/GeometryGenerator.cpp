@@ -2,223 +2,430 @@
 
 #include "Utilities/Utility.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstdint>
 #include <vector>
 #include <cmath>
 #include <iostream>
 
 using namespace DirectX;
 
-GeometryGenerator::MeshData GeometryGenerator::CreateBox(float width, float height, float depth)
+namespace
 {
-    MeshData meshData;
+    // 변(정점 인덱스 쌍) -> 중점 인덱스를 저장하는 개방 주소법 해시 테이블
+    // 분할 단계마다 크기가 정해져 있으므로 std::unordered_map처럼 노드를 할당하지 않고 배열 하나만 사용한다.
+    class EdgeMidpointCache
+    {
+    public:
+        static constexpr UINT InvalidIndex = UINT_MAX;
 
-    const float halfWidth = 0.5f * width;
-    const float halfHeight = 0.5f * height;
-    const float halfDepth = 0.5f * depth;
+        explicit EdgeMidpointCache(size_t edgeCount)
+        {
+            // 적재율을 50% 이하로 유지한다.
+            size_t capacity = 16;
+            while (capacity < edgeCount * 2)
+            {
+                capacity <<= 1;
+            }
 
-    meshData.vertices =
-    {
-        // 정면
-        Vertex(XMFLOAT3(-halfWidth, -halfHeight, -halfDepth), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f)),
-        Vertex(XMFLOAT3(-halfWidth, +halfHeight, -halfDepth), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f)),
-        Vertex(XMFLOAT3(+halfWidth, +halfHeight, -halfDepth), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 0.0f)),
-        Vertex(XMFLOAT3(+halfWidth, -halfHeight, -halfDepth), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f)),
-
-        // 후면
-        Vertex(XMFLOAT3(-halfWidth, -halfHeight, +halfDepth), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f)),
-        Vertex(XMFLOAT3(+halfWidth, -halfHeight, +halfDepth), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f)),
-        Vertex(XMFLOAT3(+halfWidth, +halfHeight, +halfDepth), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f)),
-        Vertex(XMFLOAT3(-halfWidth, +halfHeight, +halfDepth), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 0.0f)),
-
-        // 윗면
-        Vertex(XMFLOAT3(-halfWidth, +halfHeight, -halfDepth), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f)),
-        Vertex(XMFLOAT3(-halfWidth, +halfHeight, +halfDepth), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f)),
-        Vertex(XMFLOAT3(+halfWidth, +halfHeight, +halfDepth), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 0.0f)),
-        Vertex(XMFLOAT3(+halfWidth, +halfHeight, -halfDepth), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f)),
-
-        // 아랫면
-        Vertex(XMFLOAT3(-halfWidth, -halfHeight, -halfDepth), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f)),
-        Vertex(XMFLOAT3(+halfWidth, -halfHeight, -halfDepth), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f)),
-        Vertex(XMFLOAT3(+halfWidth, -halfHeight, +halfDepth), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f)),
-        Vertex(XMFLOAT3(-halfWidth, -halfHeight, +halfDepth), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 0.0f)),
-
-        // 좌측면
-        Vertex(XMFLOAT3(-halfWidth, -halfHeight, +halfDepth), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(0.0f, 1.0f)),
-        Vertex(XMFLOAT3(-halfWidth, +halfHeight, +halfDepth), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(0.0f, 0.0f)),
-        Vertex(XMFLOAT3(-halfWidth, +halfHeight, -halfDepth), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(1.0f, 0.0f)),
-        Vertex(XMFLOAT3(-halfWidth, -halfHeight, -halfDepth), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(1.0f, 1.0f)),
-
-        // 우측면
-        Vertex(XMFLOAT3(+halfWidth, -halfHeight, -halfDepth), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT2(0.0f, 1.0f)),
-        Vertex(XMFLOAT3(+halfWidth, +halfHeight, -halfDepth), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT2(0.0f, 0.0f)),
-        Vertex(XMFLOAT3(+halfWidth, +halfHeight, +halfDepth), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT2(1.0f, 0.0f)),
-        Vertex(XMFLOAT3(+halfWidth, -halfHeight, +halfDepth), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT2(1.0f, 1.0f))
-    };
+            keys.assign(capacity, EmptyKey);
+            values.assign(capacity, InvalidIndex);
+            mask = capacity - 1;
+        }
 
-    meshData.indices =
-    {
-        // 정면
-        0, 1, 2,
-        0, 2, 3,
+        // 변에 해당하는 슬롯을 반환한다. 처음 찾는 변이면 값이 InvalidIndex인 슬롯을 새로 만든다.
+        UINT& FindOrAdd(UINT i0, UINT i1)
+        {
+            // 방향과 상관없이 같은 변이 되도록 작은 인덱스를 상위 비트에 둔다.
+            const uint64_t key = (static_cast<uint64_t>(std::min(i0, i1)) << 32) | std::max(i0, i1);
 
-        // 후면
-        4, 5, 6,
-        4, 6, 7,
+            size_t slot = Hash(key) & mask;
+            while (keys[slot] != key && keys[slot] != EmptyKey)
+            {
+                slot = (slot + 1) & mask;
+            }
 
-        // 윗면
-        8, 9, 10,
-        8, 10, 11,
+            keys[slot] = key;
+            return values[slot];
+        }
 
-        // 아랫면
-        12, 13, 14,
-        12, 14, 15,
+    private:
+        static constexpr uint64_t EmptyKey = UINT64_MAX;
 
-        // 좌측면
-        16, 17, 18,
-        16, 18, 19,
+        static size_t Hash(uint64_t key)
+        {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdull;
+            key ^= key >> 33;
+            return static_cast<size_t>(key);
+        }
 
-        // 우측면
-        20, 21, 22,
-        20, 22, 23
+        std::vector<uint64_t> keys;
+        std::vector<UINT> values;
+        size_t mask = 0;
     };
 
-    return meshData;
-}
+    // 변환 없이 GeometryGenerator::Vertex를 그대로 기록할 때 사용한다.
+    constexpr auto Identity = [](const GeometryGenerator::Vertex& vertex) { return vertex; };
 
-GeometryGenerator::MeshData GeometryGenerator::CreateSphere(float radius, UINT sliceCount, UINT stackCount)
-{
-    MeshData meshData;
+    // 미리 계산한 크기만큼 MeshData를 할당한 뒤 span 버전 생성 함수로 채운다.
+    template <typename Fill>
+    GeometryGenerator::MeshData CreateMeshData(GeometryGenerator::MeshSize meshSize, Fill&& fill)
+    {
+        GeometryGenerator::MeshData meshData;
+        meshData.vertices.resize(meshSize.vertexCount);
+        meshData.indices.resize(meshSize.indexCount);
 
-    const Vertex topVertex(XMFLOAT3(0.0f, radius, 0.0f), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f));
-    const Vertex bottomVertex(XMFLOAT3(0.0f, -radius, 0.0f), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f));
+        fill(std::span(meshData.vertices), std::span(meshData.indices));
 
-    constexpr UINT poleVertexCount = 2;
-    const UINT sideVertexCount = (stackCount - 1) * (sliceCount + 1);
-    meshData.vertices.reserve(poleVertexCount + sideVertexCount);
-    meshData.vertices.push_back(topVertex);
+        return meshData;
+    }
 
-    const float phiStep = XM_PI / static_cast<float>(stackCount);
-    const float thetaStep = XM_2PI / static_cast<float>(sliceCount);
+    // 암시적 곡면을 다각형화할 때 작업 하나가 맡는 블록의 축별 셀 수
+    constexpr int ImplicitBrickCellCount = 32;
 
-    for (UINT i = 1; i <= stackCount - 1; ++i)
+    // 다른 블록이 소유한 정점을 가리키는 임시 인덱스. 하위 비트는 ImplicitBrick::foreignCells의 번호이다.
+    constexpr UINT ForeignVertexFlag = 0x80000000u;
+
+    // 셀의 12개 변. 꼭짓점 번호는 x, y, z 오프셋을 각각 1, 2, 4 비트로 쓴다.
+    constexpr std::array<std::array<UINT, 2>, 12> CellEdgeCorners =
+    {{
+        {0, 1}, {2, 3}, {4, 5}, {6, 7},
+        {0, 2}, {1, 3}, {4, 6}, {5, 7},
+        {0, 4}, {1, 5}, {2, 6}, {3, 7}
+    }};
+
+    // 셀 범위 [cellBegin, cellBegin + cellCount)를 처리한 결과. 정점은 그 셀이 속한 블록이 소유한다.
+    struct ImplicitBrick
     {
-        const float phi = static_cast<float>(i) * phiStep;
-        const float sinPhi = std::sin(phi);
-        const float cosPhi = std::cos(phi);
+        std::array<int, 3> cellBegin{};
+        std::array<int, 3> cellCount{};
+
+        std::vector<GeometryGenerator::Vertex> vertices;
+        std::vector<UINT> indices;
+
+        // ForeignVertexFlag가 붙은 인덱스가 가리키는 셀의 전역 격자 좌표
+        std::vector<std::array<int, 3>> foreignCells;
 
-        for (UINT j = 0; j <= sliceCount; ++j)
+        // 축별 마지막 셀 층에 있는 셀의 지역 정점 번호. 뒤쪽 블록이 경계 너머의 정점을 찾을 때 쓴다.
+        std::array<std::vector<UINT>, 3> lastLayerVertices;
+
+        UINT vertexBase = 0;
+        UINT indexBase = 0;
+
+        [[nodiscard]]
+        UINT FindLastLayerVertex(const std::array<int, 3>& cell) const
         {
-            const float theta = static_cast<float>(j) * thetaStep;
-            const float sinTheta = std::sin(theta);
-            const float cosTheta = std::cos(theta);
+            const int x = cell[0] - cellBegin[0];
+            const int y = cell[1] - cellBegin[1];
+            const int z = cell[2] - cellBegin[2];
 
-            Vertex vertex;
+            if (x == cellCount[0] - 1)
+            {
+                return lastLayerVertices[0][z * cellCount[1] + y];
+            }
+            if (y == cellCount[1] - 1)
+            {
+                return lastLayerVertices[1][z * cellCount[0] + x];
+            }
 
-            vertex.position = XMFLOAT3(radius * sinPhi * cosTheta, radius * cosPhi, radius * sinPhi * sinTheta);
+            assert(z == cellCount[2] - 1);
+            return lastLayerVertices[2][y * cellCount[0] + x];
+        }
+    };
 
-            XMStoreFloat3(&vertex.normal, XMVector3Normalize(XMLoadFloat3(&vertex.position)));
+    void PolygonizeBrick(ImplicitBrick& brick, const std::function<void(int, int, int, std::span<float>)>& sampler,
+                         const XMFLOAT3& minimum, const XMFLOAT3& maximum, const XMFLOAT3& cellSize, float isoLevel)
+    {
+        const std::array<int, 3>& begin = brick.cellBegin;
+        const std::array<int, 3>& count = brick.cellCount;
 
-            vertex.tangentU = XMFLOAT3(-radius * sinPhi * sinTheta, 0.0f, radius * sinPhi * cosTheta);
-            XMStoreFloat3(&vertex.tangentU, XMVector3Normalize(XMLoadFloat3(&vertex.tangentU)));
+        // 셀 꼭짓점은 격자점 [0, count], 꼭짓점의 기울기는 한 칸 바깥까지 필요하므로 [-1, count + 1]을 샘플링한다.
+        const int sampleRowSize = count[0] + 3;
+        const int sampleLayerSize = sampleRowSize * (count[1] + 3);
+        std::vector<float> samples(static_cast<size_t>(sampleLayerSize) * (count[2] + 3));
 
-            vertex.texC = XMFLOAT2(theta / XM_2PI, phi / XM_PI);
+        const auto sampleIndex = [&](int x, int y, int z)
+        {
+            return static_cast<size_t>(z + 1) * sampleLayerSize + static_cast<size_t>(y + 1) * sampleRowSize + static_cast<size_t>(x + 1);
+        };
 
-            meshData.vertices.push_back(vertex);
+        for (int z = -1; z <= count[2] + 1; ++z)
+        {
+            for (int y = -1; y <= count[1] + 1; ++y)
+            {
+                sampler(begin[0] - 1, begin[1] + y, begin[2] + z, std::span(samples).subspan(sampleIndex(-1, y, z), sampleRowSize));
+            }
         }
-    }
 
-    meshData.vertices.push_back(bottomVertex);
+        // 격자점마다 안쪽인지 표시한다. 블록 안 격자점의 부호가 모두 같으면 만들 면이 없으므로,
+        // 표면에서 떨어진 대부분의 블록은 샘플링만 하고 끝난다.
+        std::vector<uint8_t> insideFlags(samples.size());
+        size_t insideCount = 0;
+        for (int z = 0; z <= count[2]; ++z)
+        {
+            for (int y = 0; y <= count[1]; ++y)
+            {
+                const size_t rowBegin = sampleIndex(0, y, z);
+                for (size_t i = rowBegin; i <= rowBegin + count[0]; ++i)
+                {
+                    insideFlags[i] = samples[i] < isoLevel ? 1 : 0;
+                    insideCount += insideFlags[i];
+                }
+            }
+        }
 
-    const UINT capIndexCount = sliceCount * 3 * 2;
-    const UINT sideIndexCount = sliceCount * (stackCount - 2) * 6;
-    meshData.indices.reserve(capIndexCount + sideIndexCount);
-    for (UINT i = 1; i <= sliceCount; ++i)
-    {
-        meshData.indices.push_back(0);
-        meshData.indices.push_back(i + 1);
-        meshData.indices.push_back(i);
-    }
+        if (insideCount == 0 || insideCount == static_cast<size_t>(count[0] + 1) * (count[1] + 1) * (count[2] + 1))
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                brick.lastLayerVertices[axis].assign(static_cast<size_t>(count[(axis + 1) % 3]) * count[(axis + 2) % 3], UINT_MAX);
+            }
+            return;
+        }
 
-    const UINT ringVertexCount = sliceCount + 1;
-    for (UINT i = 0; i < stackCount - 2; ++i)
-    {
-        for (UINT j = 0; j < sliceCount; ++j)
+        // 셀 꼭짓점과 축 방향 이웃까지의 샘플 오프셋
+        const std::array<size_t, 3> axisOffsets{1, static_cast<size_t>(sampleRowSize), static_cast<size_t>(sampleLayerSize)};
+        std::array<size_t, 8> cornerOffsets;
+        for (UINT corner = 0; corner < 8; ++corner)
         {
-            constexpr UINT topOffsetIndex = 1;
-            const UINT currentIndex = topOffsetIndex + i * ringVertexCount + j;
-            const UINT nextIndex = currentIndex + 1;
-            const UINT bottomIndex = currentIndex + ringVertexCount;
-            const UINT bottomNextIndex = bottomIndex + 1;
+            cornerOffsets[corner] = (corner & 1) * axisOffsets[0] + ((corner >> 1) & 1) * axisOffsets[1] + ((corner >> 2) & 1) * axisOffsets[2];
+        }
+
+        const XMVECTOR gradientScale = XMVectorSet(0.5f / cellSize.x, 0.5f / cellSize.y, 0.5f / cellSize.z, 0.0f);
+        const auto getGradient = [&](int x, int y, int z)
+        {
+            const XMVECTOR difference = XMVectorSet(samples[sampleIndex(x + 1, y, z)] - samples[sampleIndex(x - 1, y, z)],
+                                                    samples[sampleIndex(x, y + 1, z)] - samples[sampleIndex(x, y - 1, z)],
+                                                    samples[sampleIndex(x, y, z + 1)] - samples[sampleIndex(x, y, z - 1)], 0.0f);
+            return XMVectorMultiply(difference, gradientScale);
+        };
 
-            meshData.indices.push_back(currentIndex);
-            meshData.indices.push_back(nextIndex);
-            meshData.indices.push_back(bottomIndex);
+        const XMVECTOR minimumVector = XMLoadFloat3(&minimum);
+        const XMVECTOR cellSizeVector = XMLoadFloat3(&cellSize);
+        const XMVECTOR texScale = XMVectorSet(1.0f / (maximum.x - minimum.x), 0.0f, 1.0f / (maximum.z - minimum.z), 0.0f);
 
-            meshData.indices.push_back(bottomIndex);
-            meshData.indices.push_back(nextIndex);
-            meshData.indices.push_back(bottomNextIndex);
+        // 부호가 바뀌는 셀마다 정점 하나를 둔다. 위치와 법선은 셀 변과 등위면의 교점, 교점의 기울기를 평균한 값이다.
+        std::vector<UINT> cellVertices(static_cast<size_t>(count[0]) * count[1] * count[2], UINT_MAX);
+        const auto cellIndex = [&](int x, int y, int z) { return (static_cast<size_t>(z) * count[1] + y) * count[0] + x; };
+
+        for (int z = 0; z < count[2]; ++z)
+        {
+            for (int y = 0; y < count[1]; ++y)
+            {
+                for (int x = 0; x < count[0]; ++x)
+                {
+                    const size_t baseSample = sampleIndex(x, y, z);
+                    UINT insideMask = 0;
+                    for (UINT corner = 0; corner < 8; ++corner)
+                    {
+                        insideMask |= static_cast<UINT>(insideFlags[baseSample + cornerOffsets[corner]]) << corner;
+                    }
+
+                    if (insideMask == 0 || insideMask == 0xff)
+                    {
+                        continue;
+                    }
+
+                    std::array<float, 8> corners;
+                    for (UINT corner = 0; corner < 8; ++corner)
+                    {
+                        corners[corner] = samples[baseSample + cornerOffsets[corner]];
+                    }
+
+                    XMVECTOR positionSum = XMVectorZero();
+                    XMVECTOR gradientSum = XMVectorZero();
+                    UINT crossingCount = 0;
+                    for (const auto& [corner0, corner1] : CellEdgeCorners)
+                    {
+                        if ((((insideMask >> corner0) ^ (insideMask >> corner1)) & 1) == 0)
+                        {
+                            continue;
+                        }
+
+                        const float t = (isoLevel - corners[corner0]) / (corners[corner1] - corners[corner0]);
+                        const XMVECTOR offset0 = XMVectorSet(static_cast<float>(corner0 & 1), static_cast<float>((corner0 >> 1) & 1), static_cast<float>((corner0 >> 2) & 1), 0.0f);
+                        const XMVECTOR offset1 = XMVectorSet(static_cast<float>(corner1 & 1), static_cast<float>((corner1 >> 1) & 1), static_cast<float>((corner1 >> 2) & 1), 0.0f);
+                        const XMVECTOR gradient0 = getGradient(x + (corner0 & 1), y + ((corner0 >> 1) & 1), z + ((corner0 >> 2) & 1));
+                        const XMVECTOR gradient1 = getGradient(x + (corner1 & 1), y + ((corner1 >> 1) & 1), z + ((corner1 >> 2) & 1));
+
+                        positionSum = XMVectorAdd(positionSum, XMVectorLerp(offset0, offset1, t));
+                        gradientSum = XMVectorAdd(gradientSum, XMVectorLerp(gradient0, gradient1, t));
+                        ++crossingCount;
+                    }
+
+                    const XMVECTOR cell = XMVectorSet(static_cast<float>(begin[0] + x), static_cast<float>(begin[1] + y), static_cast<float>(begin[2] + z), 0.0f);
+                    const XMVECTOR position = XMVectorMultiplyAdd(XMVectorAdd(cell, XMVectorScale(positionSum, 1.0f / static_cast<float>(crossingCount))), cellSizeVector, minimumVector);
+                    const XMVECTOR normal = XMVector3Equal(gradientSum, XMVectorZero()) ? XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f) : XMVector3Normalize(gradientSum);
+
+                    // uv는 상자의 xz 평면에 투영하고, 접선은 u가 커지는 x축을 접평면에 투영한 방향이다.
+                    XMVECTOR tangent = XMVectorSubtract(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMVectorScale(normal, XMVectorGetX(normal)));
+                    tangent = XMVectorGetX(XMVector3LengthSq(tangent)) > 1.0e-6f ? XMVector3Normalize(tangent) : XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+
+                    const XMVECTOR texC = XMVectorMultiply(XMVectorSubtract(position, minimumVector), texScale);
+
+                    GeometryGenerator::Vertex vertex;
+                    XMStoreFloat3(&vertex.position, position);
+                    XMStoreFloat3(&vertex.normal, normal);
+                    XMStoreFloat3(&vertex.tangentU, tangent);
+                    vertex.texC = XMFLOAT2(XMVectorGetX(texC), 1.0f - XMVectorGetZ(texC));
+
+                    cellVertices[cellIndex(x, y, z)] = static_cast<UINT>(brick.vertices.size());
+                    brick.vertices.push_back(vertex);
+                }
+            }
         }
-    }
 
-    const UINT bottomIndex = static_cast<UINT>(meshData.vertices.size() - 1);
+        brick.lastLayerVertices[0].resize(static_cast<size_t>(count[1]) * count[2]);
+        brick.lastLayerVertices[1].resize(static_cast<size_t>(count[0]) * count[2]);
+        brick.lastLayerVertices[2].resize(static_cast<size_t>(count[0]) * count[1]);
+        for (int z = 0; z < count[2]; ++z)
+        {
+            for (int y = 0; y < count[1]; ++y)
+            {
+                brick.lastLayerVertices[0][z * count[1] + y] = cellVertices[cellIndex(count[0] - 1, y, z)];
+            }
+            for (int x = 0; x < count[0]; ++x)
+            {
+                brick.lastLayerVertices[1][z * count[0] + x] = cellVertices[cellIndex(x, count[1] - 1, z)];
+            }
+        }
+        for (int y = 0; y < count[1]; ++y)
+        {
+            for (int x = 0; x < count[0]; ++x)
+            {
+                brick.lastLayerVertices[2][y * count[0] + x] = cellVertices[cellIndex(x, y, count[2] - 1)];
+            }
+        }
 
-    const UINT bottomCapStartOffsetIndex = bottomIndex - ringVertexCount;
+        const auto findVertex = [&](const std::array<int, 3>& cell)
+        {
+            if (cell[0] >= 0 && cell[1] >= 0 && cell[2] >= 0)
+            {
+                assert(cellVertices[cellIndex(cell[0], cell[1], cell[2])] != UINT_MAX);
+                return cellVertices[cellIndex(cell[0], cell[1], cell[2])];
+            }
 
-    for (UINT i = 0; i < sliceCount; ++i)
-    {
-        meshData.indices.push_back(bottomIndex);
-        meshData.indices.push_back(bottomCapStartOffsetIndex + i);
-        meshData.indices.push_back(bottomCapStartOffsetIndex + i + 1);
+            brick.foreignCells.push_back({begin[0] + cell[0], begin[1] + cell[1], begin[2] + cell[2]});
+            return ForeignVertexFlag | static_cast<UINT>(brick.foreignCells.size() - 1);
+        };
+
+        // 부호가 바뀌는 격자 변마다 변을 둘러싼 네 셀의 정점으로 사각형을 만든다.
+        // 변은 아래쪽 끝점이 이 블록에 있을 때 이 블록이 처리하며, 둘러싼 셀 중 아래쪽 셀은 앞 블록에 있을 수 있다.
+        for (int z = 0; z < count[2]; ++z)
+        {
+            for (int y = 0; y < count[1]; ++y)
+            {
+                for (int x = 0; x < count[0]; ++x)
+                {
+                    const std::array<int, 3> point{x, y, z};
+                    const size_t pointSample = sampleIndex(x, y, z);
+                    const bool isInside = insideFlags[pointSample] != 0;
+
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        const int u = (axis + 1) % 3;
+                        const int w = (axis + 2) % 3;
+
+                        // 상자 경계에 놓인 변은 둘러싼 셀이 모자라므로 면을 만들지 않는다.
+                        if (begin[u] + point[u] == 0 || begin[w] + point[w] == 0)
+                        {
+                            continue;
+                        }
+
+                        if (isInside == (insideFlags[pointSample + axisOffsets[axis]] != 0))
+                        {
+                            continue;
+                        }
+
+                        std::array<int, 3> cell0 = point;
+                        --cell0[u];
+                        --cell0[w];
+                        std::array<int, 3> cell1 = point;
+                        --cell1[w];
+                        std::array<int, 3> cell3 = point;
+                        --cell3[u];
+
+                        std::array<UINT, 4> quad{findVertex(cell0), findVertex(cell1), findVertex(point), findVertex(cell3)};
+
+                        // 시계 방향이 앞면이 되도록, 변의 바깥쪽 끝에서 볼 때의 순서를 맞춘다.
+                        if (!isInside)
+                        {
+                            std::swap(quad[1], quad[3]);
+                        }
+
+                        brick.indices.insert(brick.indices.end(), {quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]});
+                    }
+                }
+            }
+        }
     }
 
-    return meshData;
+    // 반지름이 1인 측지구. 숫자는 분할 횟수이다. 컴파일 타임 계산이 길어 이 파일에서만 만들고, 밖에서는 GetStaticGeodesicSphere로 읽는다.
+    constexpr auto UnitGeodesicSphere0 = GeometryGenerator::CreateStaticGeodesicSphere<0>(1.0f);
+    constexpr auto UnitGeodesicSphere1 = GeometryGenerator::CreateStaticGeodesicSphere<1>(1.0f);
+    constexpr auto UnitGeodesicSphere2 = GeometryGenerator::CreateStaticGeodesicSphere<2>(1.0f);
 }
 
-GeometryGenerator::MeshData GeometryGenerator::CreateGeodesicSphere(float radius, UINT subdivisionCount)
+Bounds GeometryGenerator::MeshData::ComputeBounds() const
 {
-    MeshData meshData;
+    return Bounds::Compute(MakeVertexView(std::span<const Vertex>(vertices), &Vertex::position));
+}
 
-    // 최대 분할은 5회로 제한한다. 5회만 되어도 이미 2만 폴리곤이 사용되므로 이 이상은 무의미하다.
-    subdivisionCount = std::min(subdivisionCount, 5u);
+GeometryGenerator::MeshData GeometryGenerator::CreateBox(float width, float height, float depth)
+{
+    return CreateMeshData(GetBoxSize(), [&](std::span<Vertex> vertices, std::span<UINT> indices)
+    {
+        CreateBox(width, height, depth, vertices, indices, Identity);
+    });
+}
 
-    // 정이십면체를 테셀레이션해 구를 근사한다. 아래는 상수로 초기화하는 정이십면체이다.
-    constexpr size_t icosahedronVertexCount = 12;
-    constexpr size_t icosahedronIndexCount = 20ull * 3ull;
+GeometryGenerator::MeshData GeometryGenerator::CreateSphere(float radius, UINT sliceCount, UINT stackCount)
+{
+    return CreateMeshData(GetSphereSize(sliceCount, stackCount), [&](std::span<Vertex> vertices, std::span<UINT> indices)
+    {
+        CreateSphere(radius, sliceCount, stackCount, vertices, indices, Identity);
+    });
+}
 
-    constexpr float X = 0.525731f;
-    constexpr float Z = 0.850651f;
+GeometryGenerator::MeshData GeometryGenerator::CreateGeodesicSphere(float radius, UINT subdivisionCount)
+{
+    MeshData meshData;
 
-    constexpr std::array<XMFLOAT3, icosahedronVertexCount> icosahedronVertices =
-    {
-        XMFLOAT3(-X, 0.0f, Z), XMFLOAT3(X, 0.0f, Z),
-        XMFLOAT3(-X, 0.0f, -Z), XMFLOAT3(X, 0.0f, -Z),
-        XMFLOAT3(0.0f, Z, X), XMFLOAT3(0.0f, Z, -X),
-        XMFLOAT3(0.0f, -Z, X), XMFLOAT3(0.0f, -Z, -X),
-        XMFLOAT3(Z, X, 0.0f), XMFLOAT3(-Z, X, 0.0f),
-        XMFLOAT3(Z, -X, 0.0f), XMFLOAT3(-Z, -X, 0.0f)
-    };
+    // 10회만 되어도 천만 개가 넘는 정점을 사용하므로 이 이상은 무의미하다.
+    subdivisionCount = std::min(subdivisionCount, 10u);
 
-    constexpr std::array<UINT, icosahedronIndexCount> icosahedronIndices =
+    // 분할 횟수가 적으면 컴파일 타임에 만든 단위 구를 복사해 반지름만 곱한다.
+    if (subdivisionCount <= MaxStaticGeodesicSubdivisionCount)
     {
-        1, 4, 0, 4, 9, 0, 4, 5, 9, 8, 5, 4, 1, 8, 4,
-        1, 10, 8, 10, 3, 8, 8, 3, 5, 3, 2, 5, 3, 7, 2,
-        3, 10, 7, 10, 6, 7, 6, 11, 7, 6, 0, 11, 6, 1, 0,
-        10, 1, 6, 11, 0, 9, 2, 11, 9, 5, 2, 9, 11, 2, 7
-    };
+        const MeshView unitSphere = GetStaticGeodesicSphere(subdivisionCount);
+        meshData.vertices.assign(unitSphere.vertices.begin(), unitSphere.vertices.end());
+        meshData.indices.assign(unitSphere.indices.begin(), unitSphere.indices.end());
 
-    meshData.vertices.resize(icosahedronVertexCount);
-    meshData.indices.resize(icosahedronIndexCount);
+        for (Vertex& vertex : meshData.vertices)
+        {
+            XMStoreFloat3(&vertex.position, XMVectorScale(XMLoadFloat3(&vertex.position), radius));
+        }
 
-    for (UINT i = 0; i < icosahedronVertexCount; ++i)
-    {
-        meshData.vertices[i].position = icosahedronVertices[i];
+        return meshData;
     }
 
-    for (UINT i = 0; i < icosahedronIndexCount; ++i)
+    // 분할마다 재할당되지 않도록 최종 정점 수만큼 미리 예약한다.
+    meshData.vertices.reserve(GetGeodesicSphereSize(subdivisionCount).vertexCount);
+
+    // 정이십면체를 테셀레이션해 구를 근사한다.
+    meshData.vertices.resize(IcosahedronPositions.size());
+    std::ranges::transform(IcosahedronPositions, meshData.vertices.begin(), [](const XMFLOAT3& position)
     {
-        meshData.indices[i] = icosahedronIndices[i];
-    }
+        Vertex vertex{};
+        vertex.position = position;
+        return vertex;
+    });
+    meshData.indices.assign(IcosahedronIndices.begin(), IcosahedronIndices.end());
 
     for (UINT i = 0; i < subdivisionCount; ++i)
     {
@@ -226,197 +433,295 @@ GeometryGenerator::MeshData GeometryGenerator::CreateGeodesicSphere(float radius
     }
 
     // 구 표면으로 정규화
-    for (UINT i = 0; i < meshData.vertices.size(); ++i)
+    for (Vertex& vertex : meshData.vertices)
     {
-        const XMVECTOR normal = XMVector3Normalize(XMLoadFloat3(&meshData.vertices[i].position));
-        const XMVECTOR position = radius * normal;
-
-        XMStoreFloat3(&meshData.vertices[i].position, position);
-        XMStoreFloat3(&meshData.vertices[i].normal, normal);
-
-        // 구면 좌표를 통해 텍스처 좌표를 구한다.
-        const float theta = Math::AngleFromXY(meshData.vertices[i].position.x, meshData.vertices[i].position.z);
-
-        const float phi = std::acos(meshData.vertices[i].position.y / radius);
-
-        meshData.vertices[i].texC.x = theta / XM_2PI;
-        meshData.vertices[i].texC.y = phi / XM_PI;
-
-        // 세타에 대한 P의 편미분
-        meshData.vertices[i].tangentU.x = -radius * std::sin(phi) * std::sin(theta);
-        meshData.vertices[i].tangentU.y = 0.0f;
-        meshData.vertices[i].tangentU.z = radius * std::sin(phi) * std::cos(theta);
-
-        const XMVECTOR tangent = XMLoadFloat3(&meshData.vertices[i].tangentU);
-        XMStoreFloat3(&meshData.vertices[i].tangentU, XMVector3Normalize(tangent));
+        vertex = GetGeodesicVertex(vertex.position, radius);
     }
 
     return meshData;
 }
 
+GeometryGenerator::MeshView GeometryGenerator::GetStaticGeodesicSphere(UINT subdivisionCount)
+{
+    switch (subdivisionCount)
+    {
+    case 0:
+        return {UnitGeodesicSphere0.vertices, UnitGeodesicSphere0.indices};
+    case 1:
+        return {UnitGeodesicSphere1.vertices, UnitGeodesicSphere1.indices};
+    default:
+        assert(subdivisionCount == MaxStaticGeodesicSubdivisionCount);
+        return {UnitGeodesicSphere2.vertices, UnitGeodesicSphere2.indices};
+    }
+}
+
 GeometryGenerator::MeshData GeometryGenerator::CreateCylinder(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount)
 {
-    MeshData meshData;
+    return CreateMeshData(GetCylinderSize(sliceCount, stackCount), [&](std::span<Vertex> vertices, std::span<UINT> indices)
+    {
+        CreateCylinder(bottomRadius, topRadius, height, sliceCount, stackCount, vertices, indices, Identity);
+    });
+}
 
-    const float stackHeight = height / static_cast<float>(stackCount);
-    const float radiusStep = (topRadius - bottomRadius) / static_cast<float>(stackCount);
-    const UINT ringCount = stackCount + 1;
+GeometryGenerator::MeshData GeometryGenerator::CreateGrid(float width, float depth, UINT rowVertexCount, UINT columnVertexCount)
+{
+    return CreateMeshData(GetGridSize(rowVertexCount, columnVertexCount), [&](std::span<Vertex> vertices, std::span<UINT> indices)
+    {
+        CreateGrid(width, depth, rowVertexCount, columnVertexCount, vertices, indices, Identity);
+    });
+}
 
-    const float dTheta = XM_2PI / static_cast<float>(sliceCount);
-    const float dRadius = bottomRadius - topRadius;
+GeometryGenerator::MeshData GeometryGenerator::PolygonizeImplicitSurface(const DensityRowSampler& sampler, const XMFLOAT3& minimum, const XMFLOAT3& maximum, UINT resolution, float isoLevel)
+{
+    const XMFLOAT3 cellSize((maximum.x - minimum.x) / static_cast<float>(resolution), (maximum.y - minimum.y) / static_cast<float>(resolution), (maximum.z - minimum.z) / static_cast<float>(resolution));
 
-    const UINT sideVertexCount = (sliceCount + 1) * ringCount;
-    const UINT capVertexCount = (sliceCount + 2) * 2;
-    meshData.vertices.reserve(sideVertexCount + capVertexCount);
+    const int cellCount = static_cast<int>(resolution);
+    const int brickCountPerAxis = (cellCount + ImplicitBrickCellCount - 1) / ImplicitBrickCellCount;
 
-    for (UINT i = 0; i < ringCount; ++i)
+    std::vector<ImplicitBrick> bricks(static_cast<size_t>(brickCountPerAxis) * brickCountPerAxis * brickCountPerAxis);
+    for (size_t brickIndex = 0; brickIndex < bricks.size(); ++brickIndex)
     {
-        const float currentHeight = -0.5f * height + static_cast<float>(i) * stackHeight;
-        const float currentRadius = bottomRadius + static_cast<float>(i) * radiusStep;
-
-        for (UINT j = 0; j <= sliceCount; ++j) // 시작점과 끝점을 같은 버텍스로 써버리면 텍스처 보간에 문제가 생기니 끝점을 시작점 위치에 하나 더 생성하고 uv좌표만 다르게 해준다. 
+        const std::array<int, 3> brickCoord{static_cast<int>(brickIndex % brickCountPerAxis), static_cast<int>(brickIndex / brickCountPerAxis % brickCountPerAxis), static_cast<int>(brickIndex / brickCountPerAxis / brickCountPerAxis)};
+        for (int axis = 0; axis < 3; ++axis)
         {
-            Vertex vertex;
-
-            const float cos = std::cos(static_cast<float>(j) * dTheta);
-            const float sin = std::sin(static_cast<float>(j) * dTheta);
-            vertex.position = XMFLOAT3(currentRadius * cos, currentHeight, currentRadius * sin);
-
-            vertex.texC = XMFLOAT2(static_cast<float>(j) / static_cast<float>(sliceCount), 1.0f - static_cast<float>(i) / static_cast<float>(stackCount));
-            vertex.tangentU = XMFLOAT3(-sin, 0.0f, cos);
-
-            XMFLOAT3 bitangent(dRadius * cos, -height, dRadius * sin);
-
-            const XMVECTOR t = XMLoadFloat3(&vertex.tangentU);
-            const XMVECTOR b = XMLoadFloat3(&bitangent);
-            const XMVECTOR n = XMVector3Normalize(XMVector3Cross(t, b));
-            XMStoreFloat3(&vertex.normal, n);
+            bricks[brickIndex].cellBegin[axis] = brickCoord[axis] * ImplicitBrickCellCount;
+            bricks[brickIndex].cellCount[axis] = std::min(ImplicitBrickCellCount, cellCount - bricks[brickIndex].cellBegin[axis]);
+        }
+    }
 
-            meshData.vertices.push_back(vertex);
+    // 표면이 지나는 블록에 일이 몰리므로 구간을 미리 나누지 않고 스레드마다 다음 블록을 가져간다.
+    std::atomic<size_t> nextBrickIndex = 0;
+    Parallel::ForRange(0, Parallel::GetWorkerCount(), 1, [&](size_t, size_t)
+    {
+        for (size_t brickIndex = nextBrickIndex++; brickIndex < bricks.size(); brickIndex = nextBrickIndex++)
+        {
+            PolygonizeBrick(bricks[brickIndex], sampler, minimum, maximum, cellSize, isoLevel);
         }
+    });
+
+    // 블록 순서대로 정점과 인덱스를 이어 붙인다.
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (ImplicitBrick& brick : bricks)
+    {
+        brick.vertexBase = static_cast<UINT>(vertexCount);
+        brick.indexBase = static_cast<UINT>(indexCount);
+        vertexCount += brick.vertices.size();
+        indexCount += brick.indices.size();
     }
 
-    const UINT sideIndexCount = sliceCount * stackCount * 6;
-    const UINT capIndexCount = sliceCount * 3 * 2;
-    meshData.indices.reserve(sideIndexCount + capIndexCount);
+    MeshData meshData;
+    meshData.vertices.resize(vertexCount);
+    meshData.indices.resize(indexCount);
 
-    for (UINT i = 0; i < ringCount - 1; ++i)
+    Parallel::For(0, bricks.size(), 1, [&](size_t brickIndex)
     {
-        for (UINT j = 0; j < sliceCount; ++j)
-        {
-            const UINT currentIndex = i * (sliceCount + 1) + j;
-            const UINT topIndex = currentIndex + (sliceCount + 1);
-            const UINT topNextIndex = topIndex + 1;
-            const UINT nextIndex = currentIndex + 1;
+        const ImplicitBrick& brick = bricks[brickIndex];
+        std::ranges::copy(brick.vertices, meshData.vertices.begin() + brick.vertexBase);
 
-            meshData.indices.push_back(currentIndex);
-            meshData.indices.push_back(topIndex);
-            meshData.indices.push_back(topNextIndex);
+        for (size_t i = 0; i < brick.indices.size(); ++i)
+        {
+            const UINT index = brick.indices[i];
+            UINT globalIndex = brick.vertexBase + index;
+            if ((index & ForeignVertexFlag) != 0)
+            {
+                const std::array<int, 3>& cell = brick.foreignCells[index & ~ForeignVertexFlag];
+                const ImplicitBrick& owner = bricks[(static_cast<size_t>(cell[2] / ImplicitBrickCellCount) * brickCountPerAxis + cell[1] / ImplicitBrickCellCount) * brickCountPerAxis + cell[0] / ImplicitBrickCellCount];
+                globalIndex = owner.vertexBase + owner.FindLastLayerVertex(cell);
+            }
 
-            meshData.indices.push_back(currentIndex);
-            meshData.indices.push_back(topNextIndex);
-            meshData.indices.push_back(nextIndex);
+            meshData.indices[brick.indexBase + i] = globalIndex;
         }
-    }
+    });
 
-    auto AddCap = [&](float radius, bool isTop)
-    {
-        const UINT StartIndexOffset = static_cast<UINT>(meshData.vertices.size());
-        const float y = isTop ? height * 0.5f : height * -0.5f;
+    return meshData;
+}
 
-        const XMFLOAT3 normal = isTop ? XMFLOAT3(0.0f, 1.0f, 0.0f) : XMFLOAT3(0.0f, -1.0f, 0.0f);
-        constexpr XMFLOAT3 tangentU = XMFLOAT3(1.0f, 0.0f, 0.0f);
+GeometryGenerator::SliceBlock GeometryGenerator::CreateSliceBlock(UINT sliceCount, UINT sliceBegin)
+{
+    // 마지막 조각의 끝점(theta = 2pi)까지 포함한다. Capacity가 4의 배수이므로 4개씩 채워도 배열을 넘지 않는다.
+    SliceBlock sliceBlock;
+    sliceBlock.sliceBegin = sliceBegin;
+    sliceBlock.count = std::min(SliceBlock::Capacity, sliceCount + 1 - sliceBegin);
 
-        for (UINT i = 0; i <= sliceCount; ++i)
-        {
-            Vertex vertex;
+    const float thetaStep = XM_2PI / static_cast<float>(sliceCount);
+    const float du = 1.0f / static_cast<float>(sliceCount);
 
-            const float x = radius * std::cos(static_cast<float>(i) * dTheta);
-            const float z = radius * std::sin(static_cast<float>(i) * dTheta);
-            vertex.position = XMFLOAT3(x, y, z);
+    const XMVECTOR laneOffset = XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f);
+    for (UINT j = 0; j < sliceBlock.count; j += 4)
+    {
+        const XMVECTOR slice = XMVectorAdd(XMVectorReplicate(static_cast<float>(sliceBegin + j)), laneOffset);
 
-            vertex.normal = normal;
-            vertex.tangentU = tangentU;
+        XMVECTOR sinTheta;
+        XMVECTOR cosTheta;
+        XMVectorSinCos(&sinTheta, &cosTheta, XMVectorScale(slice, thetaStep));
 
-            const float u = x * 0.5f / radius + 0.5f;
-            const float v = z * 0.5f / radius + 0.5f;
-            vertex.texC = XMFLOAT2(u, v);
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&sliceBlock.sinTheta[j]), sinTheta);
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&sliceBlock.cosTheta[j]), cosTheta);
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&sliceBlock.u[j]), XMVectorScale(slice, du));
+    }
 
-            meshData.vertices.push_back(vertex);
-        }
+    // 이음매의 양 끝 정점은 위치가 정확히 같아야 하므로 근사 오차가 남지 않도록 직접 맞춘다.
+    if (sliceBegin == 0)
+    {
+        sliceBlock.sinTheta[0] = 0.0f;
+        sliceBlock.cosTheta[0] = 1.0f;
+    }
 
-        Vertex centerVertex;
-        centerVertex.position = XMFLOAT3(0.0f, y, 0.0f);
-        centerVertex.normal = normal;
-        centerVertex.tangentU = tangentU;
-        centerVertex.texC = XMFLOAT2(0.5f, 0.5f);
-        meshData.vertices.push_back(centerVertex);
+    if (sliceCount - sliceBegin < sliceBlock.count)
+    {
+        const UINT last = sliceCount - sliceBegin;
+        sliceBlock.sinTheta[last] = 0.0f;
+        sliceBlock.cosTheta[last] = 1.0f;
+        sliceBlock.u[last] = 1.0f;
+    }
 
-        const UINT centerIndex = static_cast<UINT>(meshData.vertices.size() - 1);
+    return sliceBlock;
+}
 
-        if (isTop)
+void GeometryGenerator::WriteRing(float radius, float y, float normalRadius, float normalY, float v, const SliceBlock& sliceBlock, std::span<Vertex> outRing)
+{
+    static_assert(sizeof(Vertex) == sizeof(float) * 11, "Vertex는 float 11개가 연속으로 놓여 있어야 합니다.");
+
+    const XMVECTOR radiusVector = XMVectorReplicate(radius);
+    const XMVECTOR yVector = XMVectorReplicate(y);
+    const XMVECTOR normalRadiusVector = XMVectorReplicate(normalRadius);
+    const XMVECTOR normalYVector = XMVectorReplicate(normalY);
+    const XMVECTOR vVector = XMVectorReplicate(v);
+    const XMVECTOR zero = XMVectorZero();
+
+    const size_t vertexCount = outRing.size();
+    size_t j = 0;
+    for (; j + 4 <= vertexCount; j += 4)
+    {
+        const XMVECTOR sinTheta = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&sliceBlock.sinTheta[j]));
+        const XMVECTOR cosTheta = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&sliceBlock.cosTheta[j]));
+        const XMVECTOR u = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&sliceBlock.u[j]));
+
+        // 정점 4개의 각 성분을 SoA로 계산한 뒤, 4x4 전치 세 번으로 정점별 float 11개(위치, 법선, 접선, uv) 순서로 바꿔 기록한다.
+        const XMMATRIX block0 = XMMatrixTranspose(XMMATRIX(
+            XMVectorMultiply(radiusVector, cosTheta), yVector, XMVectorMultiply(radiusVector, sinTheta),
+            XMVectorMultiply(normalRadiusVector, cosTheta)));
+        const XMMATRIX block1 = XMMatrixTranspose(XMMATRIX(
+            normalYVector, XMVectorMultiply(normalRadiusVector, sinTheta),
+            XMVectorNegate(sinTheta), zero));
+        const XMMATRIX block2 = XMMatrixTranspose(XMMATRIX(cosTheta, u, vVector, zero));
+
+        for (size_t k = 0; k < 4; ++k)
         {
-            for (UINT i = 0; i < sliceCount; ++i)
-            {
-                meshData.indices.push_back(centerIndex);
-                meshData.indices.push_back(StartIndexOffset + i + 1);
-                meshData.indices.push_back(StartIndexOffset + i);
-            }
+            float* out = &outRing[j + k].position.x;
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(out), block0.r[k]);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(out + 4), block1.r[k]);
+            XMStoreFloat3(reinterpret_cast<XMFLOAT3*>(out + 8), block2.r[k]);
         }
-        else
-        {
-            for (UINT i = 0; i < sliceCount; ++i)
-            {
-                meshData.indices.push_back(centerIndex);
-                meshData.indices.push_back(StartIndexOffset + i);
-                meshData.indices.push_back(StartIndexOffset + i + 1);
-            }
-        }
-    };
+    }
 
-    AddCap(topRadius, true);
-    AddCap(bottomRadius, false);
+    for (; j < vertexCount; ++j)
+    {
+        const float sinTheta = sliceBlock.sinTheta[j];
+        const float cosTheta = sliceBlock.cosTheta[j];
 
-    return meshData;
+        outRing[j] = Vertex(radius * cosTheta, y, radius * sinTheta,
+                            normalRadius * cosTheta, normalY, normalRadius * sinTheta,
+                            -sinTheta, 0.0f, cosTheta,
+                            sliceBlock.u[j], v);
+    }
 }
 
-GeometryGenerator::MeshData GeometryGenerator::CreateGrid(float width, float depth, UINT rowVertexCount, UINT columnVertexCount)
+void GeometryGenerator::WriteBoxIndices(std::span<UINT> outIndices)
 {
-    MeshData meshData;
+    std::ranges::copy(BoxIndices, outIndices.begin());
+}
 
-    const UINT widthCellCount = columnVertexCount - 1;
-    const UINT depthCellCount = rowVertexCount - 1;
+void GeometryGenerator::WriteSphereIndices(UINT sliceCount, UINT stackCount, std::span<UINT> outIndices)
+{
+    size_t index = 0;
+    for (UINT i = 1; i <= sliceCount; ++i)
+    {
+        outIndices[index++] = 0;
+        outIndices[index++] = i + 1;
+        outIndices[index++] = i;
+    }
 
-    const UINT vertexCount = rowVertexCount * columnVertexCount;
-    const UINT triangleCount = 2 * widthCellCount * depthCellCount;
+    const UINT ringVertexCount = sliceCount + 1;
+    for (UINT i = 0; i < stackCount - 2; ++i)
+    {
+        for (UINT j = 0; j < sliceCount; ++j)
+        {
+            constexpr UINT topOffsetIndex = 1;
+            const UINT currentIndex = topOffsetIndex + i * ringVertexCount + j;
+            const UINT nextIndex = currentIndex + 1;
+            const UINT bottomIndex = currentIndex + ringVertexCount;
+            const UINT bottomNextIndex = bottomIndex + 1;
 
-    const float halfWidth = 0.5f * width;
-    const float halfDepth = 0.5f * depth;
+            outIndices[index++] = currentIndex;
+            outIndices[index++] = nextIndex;
+            outIndices[index++] = bottomIndex;
 
-    const float dx = width / static_cast<float>(widthCellCount);
-    const float dz = depth / static_cast<float>(depthCellCount);
+            outIndices[index++] = bottomIndex;
+            outIndices[index++] = nextIndex;
+            outIndices[index++] = bottomNextIndex;
+        }
+    }
 
-    const float du = 1.0f / static_cast<float>(widthCellCount);
-    const float dv = 1.0f / static_cast<float>(depthCellCount);
+    const UINT bottomIndex = GetSphereSize(sliceCount, stackCount).vertexCount - 1;
 
-    meshData.vertices.resize(vertexCount);
-    for (UINT i = 0; i < rowVertexCount; ++i)
+    const UINT bottomCapStartOffsetIndex = bottomIndex - ringVertexCount;
+
+    for (UINT i = 0; i < sliceCount; ++i)
     {
-        const float z = halfDepth - static_cast<float>(i) * dz;
-        for (UINT j = 0; j < columnVertexCount; ++j)
+        outIndices[index++] = bottomIndex;
+        outIndices[index++] = bottomCapStartOffsetIndex + i;
+        outIndices[index++] = bottomCapStartOffsetIndex + i + 1;
+    }
+}
+
+void GeometryGenerator::WriteCylinderIndices(UINT sliceCount, UINT stackCount, std::span<UINT> outIndices)
+{
+    size_t index = 0;
+    for (UINT i = 0; i < stackCount; ++i)
+    {
+        for (UINT j = 0; j < sliceCount; ++j)
         {
-            const float x = -halfWidth + static_cast<float>(j) * dx;
+            const UINT currentIndex = i * (sliceCount + 1) + j;
+            const UINT topIndex = currentIndex + (sliceCount + 1);
+            const UINT topNextIndex = topIndex + 1;
+            const UINT nextIndex = currentIndex + 1;
 
-            Vertex& vertex = meshData.vertices[i * columnVertexCount + j];
-            vertex.position = XMFLOAT3(x, 0.0f, z);
-            vertex.normal = XMFLOAT3(0.0f, 1.0f, 0.0f);
-            vertex.tangentU = XMFLOAT3(1.0f, 0.0f, 0.0f);
-            vertex.texC = XMFLOAT2(static_cast<float>(j) * du, static_cast<float>(i) * dv);
+            outIndices[index++] = currentIndex;
+            outIndices[index++] = topIndex;
+            outIndices[index++] = topNextIndex;
+
+            outIndices[index++] = currentIndex;
+            outIndices[index++] = topNextIndex;
+            outIndices[index++] = nextIndex;
         }
     }
 
-    meshData.indices.reserve(triangleCount * 3);
-    for (UINT i = 0; i < rowVertexCount - 1; ++i)
+    // 옆면 정점 뒤에 윗면, 아랫면 순으로 (테두리 sliceCount + 1개 + 중심 1개)씩 정점이 놓인다.
+    const UINT topCapStartIndex = (sliceCount + 1) * (stackCount + 1);
+    const UINT topCenterIndex = topCapStartIndex + sliceCount + 1;
+    for (UINT i = 0; i < sliceCount; ++i)
+    {
+        outIndices[index++] = topCenterIndex;
+        outIndices[index++] = topCapStartIndex + i + 1;
+        outIndices[index++] = topCapStartIndex + i;
+    }
+
+    const UINT bottomCapStartIndex = topCenterIndex + 1;
+    const UINT bottomCenterIndex = bottomCapStartIndex + sliceCount + 1;
+    for (UINT i = 0; i < sliceCount; ++i)
+    {
+        outIndices[index++] = bottomCenterIndex;
+        outIndices[index++] = bottomCapStartIndex + i;
+        outIndices[index++] = bottomCapStartIndex + i + 1;
+    }
+}
+
+void GeometryGenerator::WriteGridIndices(UINT cellRowBegin, UINT cellRowEnd, UINT columnVertexCount, std::span<UINT> outIndices)
+{
+    size_t index = static_cast<size_t>(cellRowBegin) * (columnVertexCount - 1) * 6;
+    for (UINT i = cellRowBegin; i < cellRowEnd; ++i)
     {
         for (UINT j = 0; j < columnVertexCount - 1; ++j)
         {
@@ -425,30 +730,50 @@ GeometryGenerator::MeshData GeometryGenerator::CreateGrid(float width, float dep
             const UINT bottomIndex = currentIndex + columnVertexCount;
             const UINT bottomNextIndex = bottomIndex + 1;
 
-            meshData.indices.push_back(currentIndex);
-            meshData.indices.push_back(nextIndex);
-            meshData.indices.push_back(bottomIndex);
+            outIndices[index++] = currentIndex;
+            outIndices[index++] = nextIndex;
+            outIndices[index++] = bottomIndex;
 
-            meshData.indices.push_back(bottomIndex);
-            meshData.indices.push_back(nextIndex);
-            meshData.indices.push_back(bottomNextIndex);
+            outIndices[index++] = bottomIndex;
+            outIndices[index++] = nextIndex;
+            outIndices[index++] = bottomNextIndex;
         }
     }
-
-    return meshData;
 }
 
 void GeometryGenerator::Subdivide(MeshData& meshData)
 {
-    // 기존 데이터 백업
-    MeshData inputCopy = meshData;
+    const size_t triangleCount = meshData.indices.size() / 3;
 
-    // 초기화
-    meshData.vertices.resize(0);
-    meshData.indices.resize(0);
+    // 닫힌 삼각형 메시는 변의 수가 삼각형 수의 1.5배이므로 새로 생기는 중점도 그만큼이다.
+    const size_t edgeCount = triangleCount * 3 / 2;
+    meshData.vertices.reserve(meshData.vertices.size() + edgeCount);
 
-    const UINT triangleCount = static_cast<UINT>(inputCopy.indices.size() / 3);
-    for (UINT i = 0; i < triangleCount; ++i)
+    // 인접한 두 삼각형이 같은 변의 중점을 공유하도록 변(두 정점 인덱스)을 키로 중점 인덱스를 캐싱한다.
+    EdgeMidpointCache midpointCache(edgeCount);
+    auto getMidpoint = [&](UINT i0, UINT i1)
+    {
+        UINT& midpointIndex = midpointCache.FindOrAdd(i0, i1);
+        if (midpointIndex == EdgeMidpointCache::InvalidIndex)
+        {
+            const XMFLOAT3 p0 = meshData.vertices[i0].position;
+            const XMFLOAT3 p1 = meshData.vertices[i1].position;
+
+            Vertex midpoint;
+            midpoint.position = XMFLOAT3((p0.x + p1.x) * 0.5f, (p0.y + p1.y) * 0.5f, (p0.z + p1.z) * 0.5f);
+
+            midpointIndex = static_cast<UINT>(meshData.vertices.size());
+            meshData.vertices.push_back(midpoint);
+        }
+
+        return midpointIndex;
+    };
+
+    // 정점은 그대로 두고 중점만 뒤에 덧붙이므로 인덱스만 교체하면 된다.
+    const std::vector<UINT> inputIndices = std::move(meshData.indices);
+    meshData.indices.resize(inputIndices.size() * 4);
+
+    for (size_t i = 0; i < triangleCount; ++i)
     {
         //       v1
         //       *
@@ -460,38 +785,32 @@ void GeometryGenerator::Subdivide(MeshData& meshData)
         // *-----*-----*
         // v0    m2     v2
 
-        Vertex v0 = inputCopy.vertices[inputCopy.indices[i * 3 + 0]];
-        Vertex v1 = inputCopy.vertices[inputCopy.indices[i * 3 + 1]];
-        Vertex v2 = inputCopy.vertices[inputCopy.indices[i * 3 + 2]];
-
-        // 중점 생성
-        Vertex m0, m1, m2;
-        m0.position = XMFLOAT3((v0.position.x + v1.position.x) * 0.5f, (v0.position.y + v1.position.y) * 0.5f, (v0.position.z + v1.position.z) * 0.5f);
-        m1.position = XMFLOAT3((v1.position.x + v2.position.x) * 0.5f, (v1.position.y + v2.position.y) * 0.5f, (v1.position.z + v2.position.z) * 0.5f);
-        m2.position = XMFLOAT3((v0.position.x + v2.position.x) * 0.5f, (v0.position.y + v2.position.y) * 0.5f, (v0.position.z + v2.position.z) * 0.5f);
-
-        // 분할된 버텍스와 인덱스를 추가
-        meshData.vertices.push_back(v0); // 0
-        meshData.vertices.push_back(v1); // 1
-        meshData.vertices.push_back(v2); // 2
-        meshData.vertices.push_back(m0); // 3
-        meshData.vertices.push_back(m1); // 4
-        meshData.vertices.push_back(m2); // 5
-
-        meshData.indices.push_back(i * 6 + 0);
-        meshData.indices.push_back(i * 6 + 3);
-        meshData.indices.push_back(i * 6 + 5);
-
-        meshData.indices.push_back(i * 6 + 3);
-        meshData.indices.push_back(i * 6 + 4);
-        meshData.indices.push_back(i * 6 + 5);
-
-        meshData.indices.push_back(i * 6 + 5);
-        meshData.indices.push_back(i * 6 + 4);
-        meshData.indices.push_back(i * 6 + 2);
-
-        meshData.indices.push_back(i * 6 + 3);
-        meshData.indices.push_back(i * 6 + 1);
-        meshData.indices.push_back(i * 6 + 4);
+        const UINT v0 = inputIndices[i * 3 + 0];
+        const UINT v1 = inputIndices[i * 3 + 1];
+        const UINT v2 = inputIndices[i * 3 + 2];
+
+        // 중점 생성 혹은 재사용
+        const UINT m0 = getMidpoint(v0, v1);
+        const UINT m1 = getMidpoint(v1, v2);
+        const UINT m2 = getMidpoint(v0, v2);
+
+        // 분할된 삼각형의 인덱스를 기록
+        UINT* outIndices = &meshData.indices[i * 12];
+
+        outIndices[0] = v0;
+        outIndices[1] = m0;
+        outIndices[2] = m2;
+
+        outIndices[3] = m0;
+        outIndices[4] = m1;
+        outIndices[5] = m2;
+
+        outIndices[6] = m2;
+        outIndices[7] = m1;
+        outIndices[8] = v2;
+
+        outIndices[9] = m0;
+        outIndices[10] = v1;
+        outIndices[11] = m1;
     }
 }
@@ -2,8 +2,20 @@
 
 #include <d3d11.h>
 #include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <span>
+#include <type_traits>
 #include <vector>
 
+#include "Core/Rendering/Bounds.h"
+#include "Core/Rendering/MeshBuffer.h"
+#include "Core/Utilities/Parallel.h"
+#include "Core/Utilities/Utility.h"
+
 class GeometryGenerator
 {
 public:
@@ -11,12 +23,12 @@ public:
     {
         Vertex() = default;
 
-        Vertex(const DirectX::XMFLOAT3& p, const DirectX::XMFLOAT3& n, const DirectX::XMFLOAT3& t, const DirectX::XMFLOAT2& uv) : position(p), normal(n), tangentU(t), texC(uv) {}
+        constexpr Vertex(const DirectX::XMFLOAT3& p, const DirectX::XMFLOAT3& n, const DirectX::XMFLOAT3& t, const DirectX::XMFLOAT2& uv) : position(p), normal(n), tangentU(t), texC(uv) {}
 
-        Vertex(float px, float py, float pz,
-               float nx, float ny, float nz,
-               float tx, float ty, float tz,
-               float u, float v)
+        constexpr Vertex(float px, float py, float pz,
+                         float nx, float ny, float nz,
+                         float tx, float ty, float tz,
+                         float u, float v)
             : position(px, py, pz), normal(nx, ny, nz),
               tangentU(tx, ty, tz), texC(u, v) {}
 
@@ -30,8 +42,44 @@ public:
     {
         std::vector<Vertex> vertices;
         std::vector<UINT> indices;
+
+        // 인덱스는 항상 UINT로 생성하고, 업로드할 때 이 형식에 맞춰 16비트로 줄인다.
+        [[nodiscard]]
+        DXGI_FORMAT GetIndexFormat() const { return MeshBuffer::GetIndexFormat(vertices.size()); }
+
+        // 범위는 모든 메시에 필요하지 않고 큰 메시에서는 생성만큼 비싸므로 생성할 때 구하지 않는다. 컬링에 쓸 메시만 불러서 저장해 둔다.
+        [[nodiscard]]
+        Bounds ComputeBounds() const;
+    };
+
+    // 메시를 생성하기 전에 필요한 버퍼 크기를 알 수 있도록 정점/인덱스 개수를 미리 계산한다.
+    struct MeshSize
+    {
+        UINT vertexCount;
+        UINT indexCount;
+    };
+
+    // 정점/인덱스 수가 컴파일 타임에 정해지는 메시. std::array에 담기므로 힙 할당 없이 그대로 불변 버퍼의 초기 데이터로 쓸 수 있다.
+    template <size_t VertexCount, size_t IndexCount, typename VertexType = Vertex>
+    struct StaticMeshData
+    {
+        std::array<VertexType, VertexCount> vertices;
+        std::array<UINT, IndexCount> indices;
+    };
+
+    // 정적 메시처럼 다른 곳에 있는 정점/인덱스를 복사하지 않고 가리킨다.
+    struct MeshView
+    {
+        std::span<const Vertex> vertices;
+        std::span<const UINT> indices;
     };
 
+    // Create* 함수가 같은 인자로 만드는 정점이나 인덱스가 바뀌면 반드시 올린다. GeometryCache가 디스크에 저장한 이전 결과를 버리는 기준이다.
+    static constexpr UINT OutputRevision = 1;
+
+    // 이 횟수 이하로 분할한 측지구는 컴파일 타임에 만든 단위 구(GetStaticGeodesicSphere)를 복사해 생성한다.
+    static constexpr UINT MaxStaticGeodesicSubdivisionCount = 2;
+
     [[nodiscard]]
     static MeshData CreateBox(float width, float height, float depth);
 
@@ -47,6 +95,598 @@ public:
     [[nodiscard]]
     static MeshData CreateGrid(float width, float depth, UINT rowVertexCount, UINT columnVertexCount);
 
+    // 스칼라 함수 density(const XMFLOAT3&)의 isoLevel 등위면을 다각형화한다. 값이 isoLevel보다 작은 쪽이 안쪽이고 법선은 기울기 방향이므로
+    // 부호 거리 함수는 그대로, 메타볼처럼 안쪽이 큰 밀도 함수는 부호를 뒤집어 넘긴다.
+    // [minimum, maximum] 상자를 축마다 resolution개의 셀로 나누고, 부호가 바뀌는 셀마다 정점 하나를 두는 dual contouring(surface nets)으로 면을 만든다.
+    // 상자를 블록으로 나눠 여러 스레드에서 처리하므로 density는 동시에 호출해도 안전해야 한다. 상자 경계에서 잘린 면은 열린 채로 남는다.
+    template <typename DensityFunction>
+    [[nodiscard]]
+    static MeshData CreateImplicitSurface(DensityFunction&& density, const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum, UINT resolution, float isoLevel = 0.0f);
+
+    [[nodiscard]]
+    static constexpr MeshSize GetBoxSize() { return {24, 36}; }
+
+    [[nodiscard]]
+    static constexpr MeshSize GetSphereSize(UINT sliceCount, UINT stackCount) { return {(stackCount - 1) * (sliceCount + 1) + 2, sliceCount * (stackCount - 1) * 6}; }
+
+    // 중점을 공유하므로 n회 분할한 구의 정점 수는 10 * 4^n + 2개이다.
+    // 10회만 되어도 천만 개가 넘는 정점을 사용하므로 그 이상은 10회로 제한한다.
+    [[nodiscard]]
+    static constexpr MeshSize GetGeodesicSphereSize(UINT subdivisionCount)
+    {
+        const UINT scale = 1u << (2 * std::min(subdivisionCount, 10u));
+        return {10 * scale + 2, 60 * scale};
+    }
+
+    [[nodiscard]]
+    static constexpr MeshSize GetCylinderSize(UINT sliceCount, UINT stackCount) { return {(sliceCount + 1) * (stackCount + 1) + (sliceCount + 2) * 2, sliceCount * stackCount * 6 + sliceCount * 3 * 2}; }
+
+    [[nodiscard]]
+    static constexpr MeshSize GetGridSize(UINT rowVertexCount, UINT columnVertexCount) { return {rowVertexCount * columnVertexCount, (rowVertexCount - 1) * (columnVertexCount - 1) * 6}; }
+
+    // 아래 함수들은 중간 MeshData 없이 호출자가 제공한 버퍼(벡터, 매핑된 버퍼 메모리 등)에 바로 기록한다.
+    // converter는 GeometryGenerator::Vertex를 받아 원하는 정점 레이아웃(VertexType)으로 변환하며, 버퍼 크기는 Get*Size()로 구한다.
+    template <typename VertexType, typename Converter>
+    static void CreateBox(float width, float height, float depth, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter);
+
+    template <typename VertexType, typename Converter>
+    static void CreateSphere(float radius, UINT sliceCount, UINT stackCount, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter);
+
+    // 분할 횟수가 MaxStaticGeodesicSubdivisionCount 이하면 정적 테이블에서 바로 변환하고, 그보다 많으면 분할 과정에서 이전 단계의 정점을 다시 읽어야 하므로 내부적으로 MeshData를 한 번 생성한다.
+    template <typename VertexType, typename Converter>
+    static void CreateGeodesicSphere(float radius, UINT subdivisionCount, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter);
+
+    template <typename VertexType, typename Converter>
+    static void CreateCylinder(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter);
+
+    // 행 단위로 나눠 여러 스레드에서 생성하므로 converter는 여러 스레드에서 동시에 호출해도 안전해야 한다.
+    // 지형처럼 높이를 적용할 때는 converter 안에서 높이 함수를 호출하면 같은 패스에서 처리된다.
+    template <typename VertexType, typename Converter>
+    static void CreateGrid(float width, float depth, UINT rowVertexCount, UINT columnVertexCount, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter);
+
+    // 아래 함수들은 상수 식에서 호출하면 컴파일 타임에 메시 전체를 계산한다. 분할이 많은 측지구는 MSVC의 기본 constexpr 평가 한도를 넘으므로
+    // 그런 프로젝트에는 /constexpr:steps를 늘려야 한다. 단위 상자는 StaticGeometry에, 단위 측지구는 GetStaticGeodesicSphere에 미리 만들어 두었다.
+    [[nodiscard]]
+    static constexpr StaticMeshData<24, 36> CreateStaticBox(float width, float height, float depth);
+
+    // 0회 분할은 정이십면체이다.
+    template <UINT SubdivisionCount>
+    [[nodiscard]]
+    static constexpr auto CreateStaticGeodesicSphere(float radius);
+
+    // subdivisionCount <= MaxStaticGeodesicSubdivisionCount인 반지름 1의 측지구를 가리킨다.
+    [[nodiscard]]
+    static MeshView GetStaticGeodesicSphere(UINT subdivisionCount);
+
+    // 정적 메시를 원하는 정점 레이아웃으로 바꾼다. converter가 constexpr이면 변환 결과도 컴파일 타임에 만들 수 있다.
+    template <size_t VertexCount, size_t IndexCount, typename Converter>
+    [[nodiscard]]
+    static constexpr auto ConvertStaticMesh(const StaticMeshData<VertexCount, IndexCount>& meshData, Converter&& converter);
+
 private:
+    // 연속한 조각(slice) Capacity개까지의 sin, cos, u 값. 모든 고리(ring)가 같은 묶음을 공유하므로 조각마다 한 번만 계산한다.
+    // 조각 수와 상관없이 스택에 둘 수 있도록 크기를 고정하고, SIMD로 4개씩 읽을 수 있도록 4의 배수로 둔다.
+    struct SliceBlock
+    {
+        static constexpr UINT Capacity = 64;
+
+        // 첫 조각 번호와 조각 수. 고리 끝에 uv만 다르게 한 번 더 넣는 정점(sliceCount번)까지 조각으로 센다.
+        UINT sliceBegin = 0;
+        UINT count = 0;
+
+        std::array<float, Capacity> sinTheta;
+        std::array<float, Capacity> cosTheta;
+        std::array<float, Capacity> u;
+    };
+
+    // 정이십면체. 측지구는 이 메시를 분할해 만든다.
+    static constexpr float IcosahedronX = 0.525731f;
+    static constexpr float IcosahedronZ = 0.850651f;
+
+    static constexpr std::array<DirectX::XMFLOAT3, 12> IcosahedronPositions =
+    {
+        DirectX::XMFLOAT3(-IcosahedronX, 0.0f, IcosahedronZ), DirectX::XMFLOAT3(IcosahedronX, 0.0f, IcosahedronZ),
+        DirectX::XMFLOAT3(-IcosahedronX, 0.0f, -IcosahedronZ), DirectX::XMFLOAT3(IcosahedronX, 0.0f, -IcosahedronZ),
+        DirectX::XMFLOAT3(0.0f, IcosahedronZ, IcosahedronX), DirectX::XMFLOAT3(0.0f, IcosahedronZ, -IcosahedronX),
+        DirectX::XMFLOAT3(0.0f, -IcosahedronZ, IcosahedronX), DirectX::XMFLOAT3(0.0f, -IcosahedronZ, -IcosahedronX),
+        DirectX::XMFLOAT3(IcosahedronZ, IcosahedronX, 0.0f), DirectX::XMFLOAT3(-IcosahedronZ, IcosahedronX, 0.0f),
+        DirectX::XMFLOAT3(IcosahedronZ, -IcosahedronX, 0.0f), DirectX::XMFLOAT3(-IcosahedronZ, -IcosahedronX, 0.0f)
+    };
+
+    static constexpr std::array<UINT, 60> IcosahedronIndices =
+    {
+        1, 4, 0, 4, 9, 0, 4, 5, 9, 8, 5, 4, 1, 8, 4,
+        1, 10, 8, 10, 3, 8, 8, 3, 5, 3, 2, 5, 3, 7, 2,
+        3, 10, 7, 10, 6, 7, 6, 11, 7, 6, 0, 11, 6, 1, 0,
+        10, 1, 6, 11, 0, 9, 2, 11, 9, 5, 2, 9, 11, 2, 7
+    };
+
+    static constexpr std::array<UINT, 36> BoxIndices =
+    {
+        // 정면
+        0, 1, 2,
+        0, 2, 3,
+
+        // 후면
+        4, 5, 6,
+        4, 6, 7,
+
+        // 윗면
+        8, 9, 10,
+        8, 10, 11,
+
+        // 아랫면
+        12, 13, 14,
+        12, 14, 15,
+
+        // 좌측면
+        16, 17, 18,
+        16, 18, 19,
+
+        // 우측면
+        20, 21, 22,
+        20, 22, 23
+    };
+
     static void Subdivide(MeshData& meshData);
+
+    // 분할이 끝난 정점 위치를 구 표면으로 옮기고 법선, 접선, 구면 좌표 uv를 채운다.
+    [[nodiscard]]
+    static constexpr Vertex GetGeodesicVertex(const DirectX::XMFLOAT3& position, float radius);
+
+    [[nodiscard]]
+    static SliceBlock CreateSliceBlock(UINT sliceCount, UINT sliceBegin);
+
+    // y축을 감싸는 고리에서 sliceBlock의 조각에 해당하는 정점 sliceBlock.count개를 4개씩 계산한다.
+    // 위치는 (radius * cos, y, radius * sin), 법선은 (normalRadius * cos, normalY, normalRadius * sin), 접선은 (-sin, 0, cos)이다.
+    static void WriteRing(float radius, float y, float normalRadius, float normalY, float v, const SliceBlock& sliceBlock, std::span<Vertex> outRing);
+
+    // WriteRing의 결과를 converter로 바꿔 outVertices의 앞쪽에 기록한다.
+    // VertexType이 Vertex면 outVertices에 바로 계산한 뒤 제자리에서 변환하고, 아니면 스택의 묶음 하나 크기 버퍼를 거친다.
+    template <typename VertexType, typename Converter>
+    static void WriteConvertedRing(float radius, float y, float normalRadius, float normalY, float v, const SliceBlock& sliceBlock, std::span<VertexType> outVertices, Converter&& converter);
+
+    [[nodiscard]]
+    static constexpr std::array<Vertex, 24> GetBoxVertices(float width, float height, float depth);
+
+    static void WriteBoxIndices(std::span<UINT> outIndices);
+    static void WriteSphereIndices(UINT sliceCount, UINT stackCount, std::span<UINT> outIndices);
+    static void WriteCylinderIndices(UINT sliceCount, UINT stackCount, std::span<UINT> outIndices);
+
+    // [cellRowBegin, cellRowEnd) 행의 셀 인덱스를 outIndices의 해당 행 위치에 기록한다. 행마다 위치가 정해져 있으므로 여러 스레드가 나눠 기록할 수 있다.
+    static void WriteGridIndices(UINT cellRowBegin, UINT cellRowEnd, UINT columnVertexCount, std::span<UINT> outIndices);
+
+    // 격자 좌표 (xBegin + i, y, z)의 값을 outDensities[i]에 채운다. 기울기를 구하려고 상자 밖 한 칸(-1, resolution + 1)도 요청한다.
+    using DensityRowSampler = std::function<void(int xBegin, int y, int z, std::span<float> outDensities)>;
+
+    [[nodiscard]]
+    static MeshData PolygonizeImplicitSurface(const DensityRowSampler& sampler, const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum, UINT resolution, float isoLevel);
 };
+
+constexpr std::array<GeometryGenerator::Vertex, 24> GeometryGenerator::GetBoxVertices(float width, float height, float depth)
+{
+    using namespace DirectX;
+
+    const float halfWidth = 0.5f * width;
+    const float halfHeight = 0.5f * height;
+    const float halfDepth = 0.5f * depth;
+
+    return
+    {
+        // 정면
+        Vertex(XMFLOAT3(-halfWidth, -halfHeight, -halfDepth), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f)),
+        Vertex(XMFLOAT3(-halfWidth, +halfHeight, -halfDepth), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f)),
+        Vertex(XMFLOAT3(+halfWidth, +halfHeight, -halfDepth), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 0.0f)),
+        Vertex(XMFLOAT3(+halfWidth, -halfHeight, -halfDepth), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f)),
+
+        // 후면
+        Vertex(XMFLOAT3(-halfWidth, -halfHeight, +halfDepth), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f)),
+        Vertex(XMFLOAT3(+halfWidth, -halfHeight, +halfDepth), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f)),
+        Vertex(XMFLOAT3(+halfWidth, +halfHeight, +halfDepth), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f)),
+        Vertex(XMFLOAT3(-halfWidth, +halfHeight, +halfDepth), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 0.0f)),
+
+        // 윗면
+        Vertex(XMFLOAT3(-halfWidth, +halfHeight, -halfDepth), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f)),
+        Vertex(XMFLOAT3(-halfWidth, +halfHeight, +halfDepth), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f)),
+        Vertex(XMFLOAT3(+halfWidth, +halfHeight, +halfDepth), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 0.0f)),
+        Vertex(XMFLOAT3(+halfWidth, +halfHeight, -halfDepth), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f)),
+
+        // 아랫면
+        Vertex(XMFLOAT3(-halfWidth, -halfHeight, -halfDepth), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f)),
+        Vertex(XMFLOAT3(+halfWidth, -halfHeight, -halfDepth), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f)),
+        Vertex(XMFLOAT3(+halfWidth, -halfHeight, +halfDepth), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f)),
+        Vertex(XMFLOAT3(-halfWidth, -halfHeight, +halfDepth), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 0.0f)),
+
+        // 좌측면
+        Vertex(XMFLOAT3(-halfWidth, -halfHeight, +halfDepth), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(0.0f, 1.0f)),
+        Vertex(XMFLOAT3(-halfWidth, +halfHeight, +halfDepth), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(0.0f, 0.0f)),
+        Vertex(XMFLOAT3(-halfWidth, +halfHeight, -halfDepth), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(1.0f, 0.0f)),
+        Vertex(XMFLOAT3(-halfWidth, -halfHeight, -halfDepth), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(1.0f, 1.0f)),
+
+        // 우측면
+        Vertex(XMFLOAT3(+halfWidth, -halfHeight, -halfDepth), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT2(0.0f, 1.0f)),
+        Vertex(XMFLOAT3(+halfWidth, +halfHeight, -halfDepth), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT2(0.0f, 0.0f)),
+        Vertex(XMFLOAT3(+halfWidth, +halfHeight, +halfDepth), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT2(1.0f, 0.0f)),
+        Vertex(XMFLOAT3(+halfWidth, -halfHeight, +halfDepth), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT2(1.0f, 1.0f))
+    };
+}
+
+constexpr GeometryGenerator::StaticMeshData<24, 36> GeometryGenerator::CreateStaticBox(float width, float height, float depth)
+{
+    return {GetBoxVertices(width, height, depth), BoxIndices};
+}
+
+constexpr GeometryGenerator::Vertex GeometryGenerator::GetGeodesicVertex(const DirectX::XMFLOAT3& position, float radius)
+{
+    using namespace DirectX;
+
+    const float length = Math::Sqrt(position.x * position.x + position.y * position.y + position.z * position.z);
+    const XMFLOAT3 normal(position.x / length, position.y / length, position.z / length);
+
+    // 구면 좌표를 통해 텍스처 좌표를 구한다.
+    float theta = Math::Atan2(normal.z, normal.x);
+    theta = theta < 0.0f ? theta + XM_2PI : theta;
+    const float phi = Math::Acos(normal.y);
+
+    // 세타에 대한 P의 편미분 방향은 (-sin(theta), 0, cos(theta))이다. 극점에서는 정의되지 않으므로 x축을 쓴다.
+    const float xzLength = Math::Sqrt(normal.x * normal.x + normal.z * normal.z);
+    const XMFLOAT3 tangentU = xzLength > 0.0f ? XMFLOAT3(-normal.z / xzLength, 0.0f, normal.x / xzLength) : XMFLOAT3(1.0f, 0.0f, 0.0f);
+
+    return Vertex(XMFLOAT3(radius * normal.x, radius * normal.y, radius * normal.z), normal, tangentU, XMFLOAT2(theta / XM_2PI, phi / XM_PI));
+}
+
+template <UINT SubdivisionCount>
+constexpr auto GeometryGenerator::CreateStaticGeodesicSphere(float radius)
+{
+    using namespace DirectX;
+
+    constexpr MeshSize meshSize = GetGeodesicSphereSize(SubdivisionCount);
+    static_assert(SubdivisionCount <= 10, "10회를 넘는 분할은 지원하지 않습니다.");
+
+    StaticMeshData<meshSize.vertexCount, meshSize.indexCount> meshData{};
+
+    std::array<XMFLOAT3, meshSize.vertexCount> positions{};
+    for (size_t i = 0; i < IcosahedronPositions.size(); ++i)
+    {
+        positions[i] = IcosahedronPositions[i];
+    }
+    for (size_t i = 0; i < IcosahedronIndices.size(); ++i)
+    {
+        meshData.indices[i] = IcosahedronIndices[i];
+    }
+
+    UINT vertexCount = static_cast<UINT>(IcosahedronPositions.size());
+    size_t triangleCount = IcosahedronIndices.size() / 3;
+
+    for (UINT level = 0; level < SubdivisionCount; ++level)
+    {
+        // 실행 중의 Subdivide와 같은 순서로 중점을 덧붙인다.
+        // 변은 작은 정점 인덱스 쪽에 (큰 정점 인덱스, 중점 인덱스)로 기록하며, 측지구에서 한 정점의 이웃은 6개를 넘지 않는다.
+        std::array<std::array<UINT, 6>, meshSize.vertexCount> edgeEnds{};
+        std::array<std::array<UINT, 6>, meshSize.vertexCount> edgeMidpoints{};
+        std::array<UINT, meshSize.vertexCount> edgeCounts{};
+
+        auto getMidpoint = [&](UINT i0, UINT i1)
+        {
+            const UINT minIndex = std::min(i0, i1);
+            const UINT maxIndex = std::max(i0, i1);
+            for (UINT i = 0; i < edgeCounts[minIndex]; ++i)
+            {
+                if (edgeEnds[minIndex][i] == maxIndex)
+                {
+                    return edgeMidpoints[minIndex][i];
+                }
+            }
+
+            const XMFLOAT3 p0 = positions[i0];
+            const XMFLOAT3 p1 = positions[i1];
+            positions[vertexCount] = XMFLOAT3((p0.x + p1.x) * 0.5f, (p0.y + p1.y) * 0.5f, (p0.z + p1.z) * 0.5f);
+
+            edgeEnds[minIndex][edgeCounts[minIndex]] = maxIndex;
+            edgeMidpoints[minIndex][edgeCounts[minIndex]] = vertexCount;
+            ++edgeCounts[minIndex];
+
+            return vertexCount++;
+        };
+
+        // 정점은 그대로 두고 중점만 뒤에 덧붙이므로 인덱스만 교체하면 된다.
+        const std::array<UINT, meshSize.indexCount> inputIndices = meshData.indices;
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            const UINT v0 = inputIndices[i * 3 + 0];
+            const UINT v1 = inputIndices[i * 3 + 1];
+            const UINT v2 = inputIndices[i * 3 + 2];
+
+            const UINT m0 = getMidpoint(v0, v1);
+            const UINT m1 = getMidpoint(v1, v2);
+            const UINT m2 = getMidpoint(v0, v2);
+
+            const std::array<UINT, 12> subdividedIndices = {v0, m0, m2, m0, m1, m2, m2, m1, v2, m0, v1, m1};
+            for (size_t j = 0; j < subdividedIndices.size(); ++j)
+            {
+                meshData.indices[i * 12 + j] = subdividedIndices[j];
+            }
+        }
+
+        triangleCount *= 4;
+    }
+
+    for (UINT i = 0; i < vertexCount; ++i)
+    {
+        meshData.vertices[i] = GetGeodesicVertex(positions[i], radius);
+    }
+
+    return meshData;
+}
+
+template <size_t VertexCount, size_t IndexCount, typename Converter>
+constexpr auto GeometryGenerator::ConvertStaticMesh(const StaticMeshData<VertexCount, IndexCount>& meshData, Converter&& converter)
+{
+    using VertexType = std::decay_t<std::invoke_result_t<Converter&, const Vertex&>>;
+
+    StaticMeshData<VertexCount, IndexCount, VertexType> convertedMeshData{};
+    for (size_t i = 0; i < VertexCount; ++i)
+    {
+        convertedMeshData.vertices[i] = converter(meshData.vertices[i]);
+    }
+    convertedMeshData.indices = meshData.indices;
+
+    return convertedMeshData;
+}
+
+// 자주 쓰는 단위 크기 기본 도형. 컴파일 타임에 계산되어 실행 파일의 읽기 전용 데이터에 들어가므로 시작할 때 CPU 비용이나 힙 할당이 없다.
+namespace StaticGeometry
+{
+    inline constexpr GeometryGenerator::StaticMeshData<24, 36> UnitBox = GeometryGenerator::CreateStaticBox(1.0f, 1.0f, 1.0f);
+}
+
+template <typename VertexType, typename Converter>
+void GeometryGenerator::CreateBox(float width, float height, float depth, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter)
+{
+    assert(outVertices.size() >= GetBoxSize().vertexCount && outIndices.size() >= GetBoxSize().indexCount);
+
+    const std::array<Vertex, 24> vertices = GetBoxVertices(width, height, depth);
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        outVertices[i] = converter(vertices[i]);
+    }
+
+    WriteBoxIndices(outIndices);
+}
+
+template <typename VertexType, typename Converter>
+void GeometryGenerator::CreateSphere(float radius, UINT sliceCount, UINT stackCount, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter)
+{
+    using namespace DirectX;
+
+    const MeshSize meshSize = GetSphereSize(sliceCount, stackCount);
+    assert(outVertices.size() >= meshSize.vertexCount && outIndices.size() >= meshSize.indexCount);
+
+    const Vertex topVertex(XMFLOAT3(0.0f, radius, 0.0f), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f));
+    const Vertex bottomVertex(XMFLOAT3(0.0f, -radius, 0.0f), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f));
+
+    outVertices[0] = converter(topVertex);
+
+    const float phiStep = XM_PI / static_cast<float>(stackCount);
+    const UINT ringVertexCount = sliceCount + 1;
+
+    // 조각 묶음 하나를 모든 고리에 적용한 뒤 다음 묶음으로 넘어간다. 힙 할당 없이 sin, cos는 조각마다 한 번만 계산된다.
+    for (UINT sliceBegin = 0; sliceBegin < ringVertexCount; sliceBegin += SliceBlock::Capacity)
+    {
+        const SliceBlock sliceBlock = CreateSliceBlock(sliceCount, sliceBegin);
+        for (UINT i = 1; i <= stackCount - 1; ++i)
+        {
+            const float phi = static_cast<float>(i) * phiStep;
+            const float sinPhi = std::sin(phi);
+            const float cosPhi = std::cos(phi);
+
+            // 구의 법선은 단위 구 위의 위치와 같으므로 정규화할 필요가 없다.
+            const size_t ringBegin = 1 + static_cast<size_t>(i - 1) * ringVertexCount + sliceBegin;
+            WriteConvertedRing(radius * sinPhi, radius * cosPhi, sinPhi, cosPhi, phi / XM_PI, sliceBlock, outVertices.subspan(ringBegin), converter);
+        }
+    }
+
+    outVertices[1 + static_cast<size_t>(stackCount - 1) * ringVertexCount] = converter(bottomVertex);
+
+    WriteSphereIndices(sliceCount, stackCount, outIndices);
+}
+
+template <typename VertexType, typename Converter>
+void GeometryGenerator::CreateGeodesicSphere(float radius, UINT subdivisionCount, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter)
+{
+    const MeshSize meshSize = GetGeodesicSphereSize(subdivisionCount);
+    assert(outVertices.size() >= meshSize.vertexCount && outIndices.size() >= meshSize.indexCount);
+
+    if (subdivisionCount <= MaxStaticGeodesicSubdivisionCount)
+    {
+        const MeshView unitSphere = GetStaticGeodesicSphere(subdivisionCount);
+        for (size_t i = 0; i < unitSphere.vertices.size(); ++i)
+        {
+            Vertex vertex = unitSphere.vertices[i];
+            vertex.position = DirectX::XMFLOAT3(vertex.position.x * radius, vertex.position.y * radius, vertex.position.z * radius);
+            outVertices[i] = converter(vertex);
+        }
+
+        std::ranges::copy(unitSphere.indices, outIndices.begin());
+        return;
+    }
+
+    const MeshData meshData = CreateGeodesicSphere(radius, subdivisionCount);
+    for (size_t i = 0; i < meshData.vertices.size(); ++i)
+    {
+        outVertices[i] = converter(meshData.vertices[i]);
+    }
+
+    std::ranges::copy(meshData.indices, outIndices.begin());
+}
+
+template <typename VertexType, typename Converter>
+void GeometryGenerator::CreateCylinder(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter)
+{
+    using namespace DirectX;
+
+    const MeshSize meshSize = GetCylinderSize(sliceCount, stackCount);
+    assert(outVertices.size() >= meshSize.vertexCount && outIndices.size() >= meshSize.indexCount);
+
+    const float stackHeight = height / static_cast<float>(stackCount);
+    const float radiusStep = (topRadius - bottomRadius) / static_cast<float>(stackCount);
+    const UINT ringCount = stackCount + 1;
+
+    const float dRadius = bottomRadius - topRadius;
+
+    // 옆면의 법선은 접선 (-sin, 0, cos)와 종접선 (dRadius * cos, -height, dRadius * sin)의 외적인 (height * cos, dRadius, height * sin)을 정규화한 값이다.
+    const float inverseSlantLength = 1.0f / std::sqrt(height * height + dRadius * dRadius);
+    const float normalRadius = height * inverseSlantLength;
+    const float normalY = dRadius * inverseSlantLength;
+
+    // 시작점과 끝점을 같은 버텍스로 써버리면 텍스처 보간에 문제가 생기니 끝점을 시작점 위치에 하나 더 생성하고 uv좌표만 다르게 해준다.
+    const UINT ringVertexCount = sliceCount + 1;
+
+    // 뚜껑마다 고리 정점 뒤에 중심 정점이 하나 붙는다.
+    const size_t topCapBegin = static_cast<size_t>(ringCount) * ringVertexCount;
+    const size_t bottomCapBegin = topCapBegin + ringVertexCount + 1;
+
+    constexpr XMFLOAT3 capTangentU = XMFLOAT3(1.0f, 0.0f, 0.0f);
+    auto WriteCap = [&](float radius, bool isTop, const SliceBlock& sliceBlock, size_t capBegin)
+    {
+        const float y = isTop ? height * 0.5f : height * -0.5f;
+        const XMFLOAT3 normal = isTop ? XMFLOAT3(0.0f, 1.0f, 0.0f) : XMFLOAT3(0.0f, -1.0f, 0.0f);
+
+        for (UINT k = 0; k < sliceBlock.count; ++k)
+        {
+            Vertex vertex;
+
+            const float cos = sliceBlock.cosTheta[k];
+            const float sin = sliceBlock.sinTheta[k];
+            vertex.position = XMFLOAT3(radius * cos, y, radius * sin);
+
+            vertex.normal = normal;
+            vertex.tangentU = capTangentU;
+            vertex.texC = XMFLOAT2(cos * 0.5f + 0.5f, sin * 0.5f + 0.5f);
+
+            outVertices[capBegin + sliceBlock.sliceBegin + k] = converter(vertex);
+        }
+    };
+
+    // 조각 묶음 하나를 모든 고리와 두 뚜껑에 적용한 뒤 다음 묶음으로 넘어간다. 힙 할당 없이 sin, cos는 조각마다 한 번만 계산된다.
+    for (UINT sliceBegin = 0; sliceBegin < ringVertexCount; sliceBegin += SliceBlock::Capacity)
+    {
+        const SliceBlock sliceBlock = CreateSliceBlock(sliceCount, sliceBegin);
+        for (UINT i = 0; i < ringCount; ++i)
+        {
+            const float currentHeight = -0.5f * height + static_cast<float>(i) * stackHeight;
+            const float currentRadius = bottomRadius + static_cast<float>(i) * radiusStep;
+
+            const size_t ringBegin = static_cast<size_t>(i) * ringVertexCount + sliceBegin;
+            WriteConvertedRing(currentRadius, currentHeight, normalRadius, normalY, 1.0f - static_cast<float>(i) / static_cast<float>(stackCount), sliceBlock,
+                               outVertices.subspan(ringBegin), converter);
+        }
+
+        WriteCap(topRadius, true, sliceBlock, topCapBegin);
+        WriteCap(bottomRadius, false, sliceBlock, bottomCapBegin);
+    }
+
+    for (const bool isTop : {true, false})
+    {
+        Vertex centerVertex;
+        centerVertex.position = XMFLOAT3(0.0f, isTop ? height * 0.5f : height * -0.5f, 0.0f);
+        centerVertex.normal = isTop ? XMFLOAT3(0.0f, 1.0f, 0.0f) : XMFLOAT3(0.0f, -1.0f, 0.0f);
+        centerVertex.tangentU = capTangentU;
+        centerVertex.texC = XMFLOAT2(0.5f, 0.5f);
+        outVertices[(isTop ? topCapBegin : bottomCapBegin) + ringVertexCount] = converter(centerVertex);
+    }
+
+    WriteCylinderIndices(sliceCount, stackCount, outIndices);
+}
+
+template <typename VertexType, typename Converter>
+void GeometryGenerator::WriteConvertedRing(float radius, float y, float normalRadius, float normalY, float v, const SliceBlock& sliceBlock, std::span<VertexType> outVertices, Converter&& converter)
+{
+    if constexpr (std::is_same_v<VertexType, Vertex>)
+    {
+        const std::span<Vertex> ring = outVertices.first(sliceBlock.count);
+        WriteRing(radius, y, normalRadius, normalY, v, sliceBlock, ring);
+        for (Vertex& vertex : ring)
+        {
+            vertex = converter(vertex);
+        }
+    }
+    else
+    {
+        std::array<Vertex, SliceBlock::Capacity> ring;
+        WriteRing(radius, y, normalRadius, normalY, v, sliceBlock, std::span(ring).first(sliceBlock.count));
+        for (UINT k = 0; k < sliceBlock.count; ++k)
+        {
+            outVertices[k] = converter(ring[k]);
+        }
+    }
+}
+
+template <typename VertexType, typename Converter>
+void GeometryGenerator::CreateGrid(float width, float depth, UINT rowVertexCount, UINT columnVertexCount, std::span<VertexType> outVertices, std::span<UINT> outIndices, Converter&& converter)
+{
+    using namespace DirectX;
+
+    const MeshSize meshSize = GetGridSize(rowVertexCount, columnVertexCount);
+    assert(outVertices.size() >= meshSize.vertexCount && outIndices.size() >= meshSize.indexCount);
+
+    const UINT widthCellCount = columnVertexCount - 1;
+    const UINT depthCellCount = rowVertexCount - 1;
+
+    const float halfWidth = 0.5f * width;
+    const float halfDepth = 0.5f * depth;
+
+    const float dx = width / static_cast<float>(widthCellCount);
+    const float dz = depth / static_cast<float>(depthCellCount);
+
+    const float du = 1.0f / static_cast<float>(widthCellCount);
+    const float dv = 1.0f / static_cast<float>(depthCellCount);
+
+    // 작업 하나가 적어도 수천 개의 정점을 처리하도록 행을 묶는다.
+    const size_t minRowsPerTask = std::max<size_t>(1, 16384 / columnVertexCount);
+
+    Parallel::ForRange(0, rowVertexCount, minRowsPerTask, [&](size_t rowBegin, size_t rowEnd)
+    {
+        for (UINT i = static_cast<UINT>(rowBegin); i < static_cast<UINT>(rowEnd); ++i)
+        {
+            const float z = halfDepth - static_cast<float>(i) * dz;
+            for (UINT j = 0; j < columnVertexCount; ++j)
+            {
+                const float x = -halfWidth + static_cast<float>(j) * dx;
+
+                Vertex vertex;
+                vertex.position = XMFLOAT3(x, 0.0f, z);
+                vertex.normal = XMFLOAT3(0.0f, 1.0f, 0.0f);
+                vertex.tangentU = XMFLOAT3(1.0f, 0.0f, 0.0f);
+                vertex.texC = XMFLOAT2(static_cast<float>(j) * du, static_cast<float>(i) * dv);
+
+                outVertices[i * columnVertexCount + j] = converter(vertex);
+            }
+        }
+
+        // 마지막 정점 행에는 아래쪽 셀이 없다.
+        WriteGridIndices(static_cast<UINT>(rowBegin), static_cast<UINT>(std::min<size_t>(rowEnd, depthCellCount)), columnVertexCount, outIndices);
+    });
+}
+
+template <typename DensityFunction>
+GeometryGenerator::MeshData GeometryGenerator::CreateImplicitSurface(DensityFunction&& density, const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum, UINT resolution, float isoLevel)
+{
+    using namespace DirectX;
+
+    assert(resolution > 0);
+
+    const XMFLOAT3 cellSize((maximum.x - minimum.x) / static_cast<float>(resolution), (maximum.y - minimum.y) / static_cast<float>(resolution), (maximum.z - minimum.z) / static_cast<float>(resolution));
+
+    // 이웃 블록이 같은 격자점에서 같은 값을 얻도록 위치는 항상 격자 좌표에서 바로 계산한다.
+    return PolygonizeImplicitSurface([&density, &minimum, &cellSize](int xBegin, int y, int z, std::span<float> outDensities)
+    {
+        const float py = minimum.y + static_cast<float>(y) * cellSize.y;
+        const float pz = minimum.z + static_cast<float>(z) * cellSize.z;
+        for (size_t i = 0; i < outDensities.size(); ++i)
+        {
+            const float px = minimum.x + static_cast<float>(xBegin + static_cast<int>(i)) * cellSize.x;
+            outDensities[i] = static_cast<float>(density(XMFLOAT3(px, py, pz)));
+        }
+    }, minimum, maximum, resolution, isoLevel);
+}
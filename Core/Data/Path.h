@@ -33,4 +33,11 @@ namespace Path
     {
         return Detail::GetExePath().parent_path() / L"Textures" / fileName;
     }
+
+    // 실행 중에 만든 데이터(GeometryCache 등)를 다음 실행을 위해 저장하는 위치
+    [[nodiscard]]
+    inline std::filesystem::path GetCachePath(const std::wstring& fileName)
+    {
+        return Detail::GetExePath().parent_path() / L"Cache" / fileName;
+    }
 }
@@ -0,0 +1,415 @@
+#include "Bounds.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "Utilities/Parallel.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // 한 작업이 맡는 최소 정점 수. 이보다 작은 메시는 호출 스레드에서 바로 처리한다.
+    constexpr size_t MinVertexRangeSize = 16384;
+
+    // Ritter 구를 다듬을 때 반지름을 줄였다가 다시 키우는 횟수와 줄이는 비율
+    constexpr UINT SphereRefinementCount = 8;
+    constexpr float SphereShrinkRatio = 0.95f;
+
+    // 초기 구의 지름을 찾을 때 양 끝점을 비교하는 방향. 세 축과 정육면체의 네 대각선이다.
+    constexpr std::array<XMFLOAT3, 7> ExtremeDirections =
+    {
+        XMFLOAT3(1.0f, 0.0f, 0.0f),
+        XMFLOAT3(0.0f, 1.0f, 0.0f),
+        XMFLOAT3(0.0f, 0.0f, 1.0f),
+        XMFLOAT3(1.0f, 1.0f, 1.0f),
+        XMFLOAT3(1.0f, 1.0f, -1.0f),
+        XMFLOAT3(1.0f, -1.0f, 1.0f),
+        XMFLOAT3(1.0f, -1.0f, -1.0f),
+    };
+
+    struct Sphere
+    {
+        XMVECTOR center;
+        float radius;
+    };
+
+    // 방향마다 투영이 가장 작은/큰 정점. 같은 값이면 앞선 정점을 남긴다.
+    struct Extremes
+    {
+        std::array<float, ExtremeDirections.size()> minProjections;
+        std::array<float, ExtremeDirections.size()> maxProjections;
+        std::array<size_t, ExtremeDirections.size()> minIndices{};
+        std::array<size_t, ExtremeDirections.size()> maxIndices{};
+
+        Extremes()
+        {
+            minProjections.fill(FLT_MAX);
+            maxProjections.fill(-FLT_MAX);
+        }
+    };
+
+    // 정점 수에 비례해 나눌 구간 수. 구간은 정점 수로만 정해지므로 스레드 수와 무관하게 같은 결과가 나온다.
+    size_t GetRangeCount(size_t vertexCount)
+    {
+        return std::max<size_t>(1, vertexCount / MinVertexRangeSize);
+    }
+
+    // [begin, end) 정점의 AABB. 누적값 네 쌍을 번갈아 써서 min/max가 앞의 결과를 기다리지 않도록 한다.
+    void ComputeBoxRange(const StridedView<XMFLOAT3>& positions, size_t begin, size_t end, XMVECTOR& outMinimum, XMVECTOR& outMaximum)
+    {
+        std::array<XMVECTOR, 4> minimums;
+        std::array<XMVECTOR, 4> maximums;
+        minimums.fill(XMVectorReplicate(FLT_MAX));
+        maximums.fill(XMVectorReplicate(-FLT_MAX));
+
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+        {
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                const XMVECTOR position = XMLoadFloat3(&positions[i + lane]);
+                minimums[lane] = XMVectorMin(minimums[lane], position);
+                maximums[lane] = XMVectorMax(maximums[lane], position);
+            }
+        }
+
+        for (; i < end; ++i)
+        {
+            const XMVECTOR position = XMLoadFloat3(&positions[i]);
+            minimums[0] = XMVectorMin(minimums[0], position);
+            maximums[0] = XMVectorMax(maximums[0], position);
+        }
+
+        outMinimum = XMVectorMin(XMVectorMin(minimums[0], minimums[1]), XMVectorMin(minimums[2], minimums[3]));
+        outMaximum = XMVectorMax(XMVectorMax(maximums[0], maximums[1]), XMVectorMax(maximums[2], maximums[3]));
+    }
+
+    void ComputeBox(const VertexView& vertexView, XMVECTOR& outMinimum, XMVECTOR& outMaximum)
+    {
+        // 구간별 결과를 구간 번호 위치에 기록하므로 스레드 수와 무관하게 같은 결과가 나온다.
+        const size_t rangeCount = GetRangeCount(vertexView.vertexCount);
+        std::vector<XMFLOAT3> rangeMinimums(rangeCount, XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX));
+        std::vector<XMFLOAT3> rangeMaximums(rangeCount, XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+
+        Parallel::For(0, rangeCount, 1, [&](size_t range)
+        {
+            const size_t begin = vertexView.vertexCount * range / rangeCount;
+            const size_t end = vertexView.vertexCount * (range + 1) / rangeCount;
+
+            XMVECTOR minimum;
+            XMVECTOR maximum;
+            ComputeBoxRange(vertexView.positions, begin, end, minimum, maximum);
+            XMStoreFloat3(&rangeMinimums[range], minimum);
+            XMStoreFloat3(&rangeMaximums[range], maximum);
+        });
+
+        outMinimum = XMVectorReplicate(FLT_MAX);
+        outMaximum = XMVectorReplicate(-FLT_MAX);
+        for (size_t range = 0; range < rangeCount; ++range)
+        {
+            outMinimum = XMVectorMin(outMinimum, XMLoadFloat3(&rangeMinimums[range]));
+            outMaximum = XMVectorMax(outMaximum, XMLoadFloat3(&rangeMaximums[range]));
+        }
+    }
+
+    // 구 밖의 점을 만나면 그 점과 원래 구를 모두 감싸도록 구를 키운다.
+    void GrowSphere(Sphere& sphere, FXMVECTOR position)
+    {
+        const XMVECTOR offset = XMVectorSubtract(position, sphere.center);
+        const float distanceSquared = XMVectorGetX(XMVector3LengthSq(offset));
+        if (distanceSquared <= sphere.radius * sphere.radius)
+        {
+            return;
+        }
+
+        const float distance = std::sqrt(distanceSquared);
+        const float newRadius = 0.5f * (sphere.radius + distance);
+        sphere.center = XMVectorAdd(sphere.center, XMVectorScale(offset, (newRadius - sphere.radius) / distance));
+        sphere.radius = newRadius;
+    }
+
+    float GetMaxDistance(const VertexView& vertexView, FXMVECTOR center)
+    {
+        XMFLOAT3 storedCenter;
+        XMStoreFloat3(&storedCenter, center);
+
+        // 최댓값은 합치는 순서와 무관하므로 구간별 결과를 그대로 합친다.
+        const size_t rangeCount = GetRangeCount(vertexView.vertexCount);
+        std::vector<float> rangeMaxDistanceSquares(rangeCount, 0.0f);
+        Parallel::For(0, rangeCount, 1, [&](size_t range)
+        {
+            const XMVECTOR rangeCenter = XMLoadFloat3(&storedCenter);
+            XMVECTOR maxDistanceSquared = XMVectorZero();
+            for (size_t i = vertexView.vertexCount * range / rangeCount; i < vertexView.vertexCount * (range + 1) / rangeCount; ++i)
+            {
+                maxDistanceSquared = XMVectorMax(maxDistanceSquared, XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&vertexView.positions[i]), rangeCenter)));
+            }
+            rangeMaxDistanceSquares[range] = XMVectorGetX(maxDistanceSquared);
+        });
+
+        return std::sqrt(*std::ranges::max_element(rangeMaxDistanceSquares));
+    }
+
+    // [begin, end) 정점에서 방향마다 양 끝점을 찾는다.
+    Extremes FindExtremes(const StridedView<XMFLOAT3>& positions, size_t begin, size_t end)
+    {
+        std::array<XMVECTOR, ExtremeDirections.size()> directions;
+        for (size_t direction = 0; direction < ExtremeDirections.size(); ++direction)
+        {
+            directions[direction] = XMLoadFloat3(&ExtremeDirections[direction]);
+        }
+
+        Extremes extremes;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const XMVECTOR position = XMLoadFloat3(&positions[i]);
+            for (size_t direction = 0; direction < ExtremeDirections.size(); ++direction)
+            {
+                const float projection = XMVectorGetX(XMVector3Dot(position, directions[direction]));
+                if (projection < extremes.minProjections[direction])
+                {
+                    extremes.minProjections[direction] = projection;
+                    extremes.minIndices[direction] = i;
+                }
+                if (projection > extremes.maxProjections[direction])
+                {
+                    extremes.maxProjections[direction] = projection;
+                    extremes.maxIndices[direction] = i;
+                }
+            }
+        }
+
+        return extremes;
+    }
+
+    Sphere ComputeRitterSphere(const VertexView& vertexView)
+    {
+        const StridedView<XMFLOAT3>& positions = vertexView.positions;
+
+        // 여러 방향의 양 끝점 중 가장 멀리 떨어진 쌍을 지름으로 하는 구에서 시작한다.
+        // 구간별로 찾은 뒤 구간 순서대로 합치고, 같은 값이면 앞 구간을 남기므로 한 번에 찾은 결과와 같다.
+        const size_t rangeCount = GetRangeCount(vertexView.vertexCount);
+        std::vector<Extremes> rangeExtremes(rangeCount);
+        Parallel::For(0, rangeCount, 1, [&](size_t range)
+        {
+            rangeExtremes[range] = FindExtremes(positions, vertexView.vertexCount * range / rangeCount, vertexView.vertexCount * (range + 1) / rangeCount);
+        });
+
+        Extremes extremes;
+        for (const Extremes& range : rangeExtremes)
+        {
+            for (size_t direction = 0; direction < ExtremeDirections.size(); ++direction)
+            {
+                if (range.minProjections[direction] < extremes.minProjections[direction])
+                {
+                    extremes.minProjections[direction] = range.minProjections[direction];
+                    extremes.minIndices[direction] = range.minIndices[direction];
+                }
+                if (range.maxProjections[direction] > extremes.maxProjections[direction])
+                {
+                    extremes.maxProjections[direction] = range.maxProjections[direction];
+                    extremes.maxIndices[direction] = range.maxIndices[direction];
+                }
+            }
+        }
+
+        Sphere sphere{XMVectorZero(), -1.0f};
+        for (size_t direction = 0; direction < ExtremeDirections.size(); ++direction)
+        {
+            const XMVECTOR minPosition = XMLoadFloat3(&positions[extremes.minIndices[direction]]);
+            const XMVECTOR maxPosition = XMLoadFloat3(&positions[extremes.maxIndices[direction]]);
+            const float radius = 0.5f * XMVectorGetX(XMVector3Length(XMVectorSubtract(maxPosition, minPosition)));
+            if (radius > sphere.radius)
+            {
+                sphere = {XMVectorScale(XMVectorAdd(minPosition, maxPosition), 0.5f), radius};
+            }
+        }
+
+        for (size_t i = 0; i < vertexView.vertexCount; ++i)
+        {
+            GrowSphere(sphere, XMLoadFloat3(&positions[i]));
+        }
+
+        // 키우는 과정은 순서에 따라 결과가 달라지므로 한 스레드에서 진행한다.
+        // 구를 조금 줄인 뒤 다른 순서로 다시 키우면 처음 순서에 치우친 중심이 보정된다. 더 작아진 구만 남긴다.
+        Sphere bestSphere = sphere;
+        for (UINT refinement = 0; refinement < SphereRefinementCount; ++refinement)
+        {
+            sphere.radius *= SphereShrinkRatio;
+
+            const size_t start = vertexView.vertexCount * (refinement + 1) / (SphereRefinementCount + 1);
+            for (size_t i = 0; i < vertexView.vertexCount; ++i)
+            {
+                const size_t index = (refinement % 2 == 0) ? (start + i) % vertexView.vertexCount : (start + vertexView.vertexCount - i) % vertexView.vertexCount;
+                GrowSphere(sphere, XMLoadFloat3(&positions[index]));
+            }
+
+            if (sphere.radius < bestSphere.radius)
+            {
+                bestSphere = sphere;
+            }
+        }
+
+        return bestSphere;
+    }
+
+    Bounds ComputeBounds(const VertexView& vertexView)
+    {
+        Bounds bounds;
+        if (vertexView.vertexCount == 0 || !vertexView.positions.IsValid())
+        {
+            return bounds;
+        }
+
+        XMVECTOR minimum;
+        XMVECTOR maximum;
+        ComputeBox(vertexView, minimum, maximum);
+
+        const XMVECTOR boxCenter = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+        XMStoreFloat3(&bounds.boxCenter, boxCenter);
+        XMStoreFloat3(&bounds.boxExtents, XMVectorScale(XMVectorSubtract(maximum, minimum), 0.5f));
+
+        // 상자처럼 AABB 중심을 쓰는 편이 더 작은 경우도 있으므로 둘 중 작은 구를 고른다.
+        // 반지름은 고른 중심에서 가장 먼 정점까지의 거리로 다시 구해 부동소수점 오차로 정점이 빠지지 않게 한다.
+        const Sphere ritterSphere = ComputeRitterSphere(vertexView);
+        const float ritterRadius = GetMaxDistance(vertexView, ritterSphere.center);
+        const float boxCenterRadius = GetMaxDistance(vertexView, boxCenter);
+
+        const bool isRitterSmaller = ritterRadius < boxCenterRadius;
+        XMStoreFloat3(&bounds.sphereCenter, isRitterSmaller ? ritterSphere.center : boxCenter);
+        bounds.sphereRadius = isRitterSmaller ? ritterRadius : boxCenterRadius;
+
+        return bounds;
+    }
+}
+
+XMVECTOR Bounds::GetBoxMinimum() const
+{
+    return XMVectorSubtract(XMLoadFloat3(&boxCenter), XMLoadFloat3(&boxExtents));
+}
+
+XMVECTOR Bounds::GetBoxMaximum() const
+{
+    return XMVectorAdd(XMLoadFloat3(&boxCenter), XMLoadFloat3(&boxExtents));
+}
+
+Bounds XM_CALLCONV Bounds::Transform(FXMMATRIX transform) const
+{
+    if (IsEmpty())
+    {
+        return *this;
+    }
+
+    Bounds result;
+
+    // 새 반 크기는 각 축 반 크기에 행렬 행의 절댓값을 곱해 더한 것이다.
+    const XMVECTOR extents = XMLoadFloat3(&boxExtents);
+    XMVECTOR newExtents = XMVectorMultiply(XMVectorAbs(transform.r[0]), XMVectorSplatX(extents));
+    newExtents = XMVectorMultiplyAdd(XMVectorAbs(transform.r[1]), XMVectorSplatY(extents), newExtents);
+    newExtents = XMVectorMultiplyAdd(XMVectorAbs(transform.r[2]), XMVectorSplatZ(extents), newExtents);
+
+    XMStoreFloat3(&result.boxCenter, XMVector3Transform(XMLoadFloat3(&boxCenter), transform));
+    XMStoreFloat3(&result.boxExtents, newExtents);
+
+    // 비균등 배율에서도 구가 정점을 감싸도록 가장 큰 축 배율을 쓴다.
+    const XMVECTOR maxScaleSquared = XMVectorMax(XMVector3LengthSq(transform.r[0]), XMVectorMax(XMVector3LengthSq(transform.r[1]), XMVector3LengthSq(transform.r[2])));
+    XMStoreFloat3(&result.sphereCenter, XMVector3Transform(XMLoadFloat3(&sphereCenter), transform));
+    result.sphereRadius = sphereRadius * XMVectorGetX(XMVectorSqrt(maxScaleSquared));
+
+    return result;
+}
+
+Bounds Bounds::Compute(const VertexView& vertexView)
+{
+    return ComputeBounds(vertexView);
+}
+
+Bounds Bounds::ComputeFromBox(const VertexView& vertexView)
+{
+    Bounds bounds;
+    if (vertexView.vertexCount == 0 || !vertexView.positions.IsValid())
+    {
+        return bounds;
+    }
+
+    XMVECTOR minimum;
+    XMVECTOR maximum;
+    ComputeBox(vertexView, minimum, maximum);
+
+    const XMVECTOR extents = XMVectorScale(XMVectorSubtract(maximum, minimum), 0.5f);
+    XMStoreFloat3(&bounds.boxCenter, XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f));
+    XMStoreFloat3(&bounds.boxExtents, extents);
+
+    bounds.sphereCenter = bounds.boxCenter;
+    bounds.sphereRadius = XMVectorGetX(XMVector3Length(extents));
+
+    return bounds;
+}
+
+Bounds Bounds::Compute(const VertexView& vertexView, std::span<const UINT> indices)
+{
+    // 같은 정점을 여러 번 넣지 않도록 처음 나올 때만 모은다.
+    std::vector<bool> isUsed(vertexView.vertexCount, false);
+    std::vector<XMFLOAT3> positions;
+    for (const UINT index : indices)
+    {
+        if (!isUsed[index])
+        {
+            isUsed[index] = true;
+            positions.push_back(vertexView.positions[index]);
+        }
+    }
+
+    VertexView usedVertexView;
+    usedVertexView.vertexCount = positions.size();
+    usedVertexView.positions = {reinterpret_cast<const std::byte*>(positions.data()), sizeof(XMFLOAT3)};
+
+    return ComputeBounds(usedVertexView);
+}
+
+Bounds Bounds::Merge(const Bounds& lhs, const Bounds& rhs)
+{
+    if (lhs.IsEmpty())
+    {
+        return rhs;
+    }
+    if (rhs.IsEmpty())
+    {
+        return lhs;
+    }
+
+    Bounds result;
+
+    const XMVECTOR minimum = XMVectorMin(lhs.GetBoxMinimum(), rhs.GetBoxMinimum());
+    const XMVECTOR maximum = XMVectorMax(lhs.GetBoxMaximum(), rhs.GetBoxMaximum());
+    XMStoreFloat3(&result.boxCenter, XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f));
+    XMStoreFloat3(&result.boxExtents, XMVectorScale(XMVectorSubtract(maximum, minimum), 0.5f));
+
+    // 한 구가 다른 구를 품으면 그 구를 그대로 쓰고, 아니면 두 구의 양 끝을 지름으로 하는 구를 만든다.
+    const XMVECTOR lhsCenter = XMLoadFloat3(&lhs.sphereCenter);
+    const XMVECTOR offset = XMVectorSubtract(XMLoadFloat3(&rhs.sphereCenter), lhsCenter);
+    const float distance = XMVectorGetX(XMVector3Length(offset));
+
+    if (distance + rhs.sphereRadius <= lhs.sphereRadius)
+    {
+        result.sphereCenter = lhs.sphereCenter;
+        result.sphereRadius = lhs.sphereRadius;
+    }
+    else if (distance + lhs.sphereRadius <= rhs.sphereRadius)
+    {
+        result.sphereCenter = rhs.sphereCenter;
+        result.sphereRadius = rhs.sphereRadius;
+    }
+    else
+    {
+        const float radius = 0.5f * (distance + lhs.sphereRadius + rhs.sphereRadius);
+        XMStoreFloat3(&result.sphereCenter, XMVectorAdd(lhsCenter, XMVectorScale(offset, (radius - lhs.sphereRadius) / distance)));
+        result.sphereRadius = radius;
+    }
+
+    return result;
+}
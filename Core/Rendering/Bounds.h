@@ -0,0 +1,52 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <span>
+
+#include "Core/Rendering/VertexView.h"
+
+// 메시의 공간 범위. 컬링과 LOD 선택에 쓰도록 AABB와 경계 구를 함께 저장한다.
+// MeshData는 범위를 들고 있지 않으므로 컬링할 메시만 ComputeBounds로 한 번 계산해 두고, 프레임마다 월드 행렬로 Transform해서 쓴다.
+struct Bounds
+{
+    // AABB 중심과 축마다의 반 크기
+    DirectX::XMFLOAT3 boxCenter{};
+    DirectX::XMFLOAT3 boxExtents{};
+
+    DirectX::XMFLOAT3 sphereCenter{};
+
+    // 음수면 범위가 비어 있다.
+    float sphereRadius = -1.0f;
+
+    [[nodiscard]]
+    bool IsEmpty() const { return sphereRadius < 0.0f; }
+
+    [[nodiscard]]
+    DirectX::XMVECTOR GetBoxMinimum() const;
+
+    [[nodiscard]]
+    DirectX::XMVECTOR GetBoxMaximum() const;
+
+    // 변환한 AABB를 다시 감싸는 AABB(Arvo)와, 가장 큰 축 배율만큼 반지름을 늘린 경계 구를 돌려준다.
+    // 행렬의 3x3 부분만 보므로 정점을 다시 읽지 않고 상수 시간에 끝난다.
+    [[nodiscard]]
+    Bounds XM_CALLCONV Transform(DirectX::FXMMATRIX transform) const;
+
+    // AABB는 SIMD min/max로 구하고, 경계 구는 Ritter 알고리즘으로 구한 뒤 반지름을 줄였다가 다시 키우는 과정을 반복해 다듬는다.
+    // 정점이 많으면 AABB와 양 끝점 찾기, 반지름 계산은 구간을 나눠 병렬로 구한다. 구를 키우는 과정은 순차적이므로 정점 수의 열 배 정도가 든다.
+    [[nodiscard]]
+    static Bounds Compute(const VertexView& vertexView);
+
+    // AABB만 구하고 경계 구는 AABB를 감싸는 구로 둔다. 구가 조금 커지는 대신 병렬 min/max 한 번으로 끝난다.
+    [[nodiscard]]
+    static Bounds ComputeFromBox(const VertexView& vertexView);
+
+    // indices가 가리키는 정점만으로 계산한다. 정점 버퍼를 공유하는 Submesh에 쓴다.
+    [[nodiscard]]
+    static Bounds Compute(const VertexView& vertexView, std::span<const UINT> indices);
+
+    // 두 범위를 모두 감싸는 범위
+    [[nodiscard]]
+    static Bounds Merge(const Bounds& lhs, const Bounds& rhs);
+};
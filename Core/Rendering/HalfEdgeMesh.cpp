@@ -0,0 +1,199 @@
+#include "HalfEdgeMesh.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Utilities/Parallel.h"
+
+namespace
+{
+    // 한 작업이 맡는 최소 half-edge 수
+    constexpr size_t MinHalfEdgeRangeSize = 8192;
+}
+
+HalfEdgeMesh::HalfEdgeMesh(size_t inVertexCount, std::span<const UINT> triangleIndices)
+    : vertexCount(inVertexCount)
+{
+    assert(triangleIndices.size() % 3 == 0);
+
+    const size_t faceCount = triangleIndices.size() / 3;
+    faceOffsets.resize(faceCount + 1);
+    for (size_t face = 0; face <= faceCount; ++face)
+    {
+        faceOffsets[face] = static_cast<UINT>(face * 3);
+    }
+
+    Build(triangleIndices);
+}
+
+HalfEdgeMesh::HalfEdgeMesh(size_t inVertexCount, std::span<const UINT> indices, std::span<const UINT> faceSizes)
+    : vertexCount(inVertexCount)
+{
+    faceOffsets.resize(faceSizes.size() + 1, 0);
+    for (size_t face = 0; face < faceSizes.size(); ++face)
+    {
+        assert(faceSizes[face] >= 3);
+        faceOffsets[face + 1] = faceOffsets[face] + faceSizes[face];
+    }
+    assert(faceOffsets.back() == indices.size());
+
+    Build(indices);
+}
+
+void HalfEdgeMesh::Build(std::span<const UINT> indices)
+{
+    assert(std::ranges::all_of(indices, [this](UINT index) { return index < vertexCount; }));
+
+    const size_t halfEdgeCount = indices.size();
+    halfEdgeVertices.assign(indices.begin(), indices.end());
+
+    halfEdgeFaces.resize(halfEdgeCount);
+    for (size_t face = 0; face < GetFaceCount(); ++face)
+    {
+        std::fill(halfEdgeFaces.begin() + faceOffsets[face], halfEdgeFaces.begin() + faceOffsets[face + 1], static_cast<UINT>(face));
+    }
+
+    // 시작 정점별로 half-edge를 모은다. 정점 번호 순서로 채우므로 목록 안의 순서는 half-edge 번호 순서이다.
+    outgoingOffsets.assign(vertexCount + 1, 0);
+    for (const UINT vertex : halfEdgeVertices)
+    {
+        ++outgoingOffsets[vertex + 1];
+    }
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        outgoingOffsets[vertex + 1] += outgoingOffsets[vertex];
+    }
+
+    outgoingHalfEdges.resize(halfEdgeCount);
+    {
+        std::vector<UINT> writeOffsets(outgoingOffsets.begin(), outgoingOffsets.end() - 1);
+        for (size_t halfEdge = 0; halfEdge < halfEdgeCount; ++halfEdge)
+        {
+            outgoingHalfEdges[writeOffsets[halfEdgeVertices[halfEdge]]++] = static_cast<UINT>(halfEdge);
+        }
+    }
+
+    // a->b의 짝은 b에서 나가는 b->a이다. 양쪽 방향이 정확히 하나씩일 때만 짝을 맺는다.
+    halfEdgeTwins.resize(halfEdgeCount);
+    Parallel::ForRange(0, halfEdgeCount, MinHalfEdgeRangeSize, [this](size_t begin, size_t end)
+    {
+        for (size_t halfEdge = begin; halfEdge < end; ++halfEdge)
+        {
+            const UINT origin = GetOrigin(static_cast<UINT>(halfEdge));
+            const UINT target = GetTarget(static_cast<UINT>(halfEdge));
+
+            UINT sameDirectionCount = 0;
+            for (const UINT other : GetOutgoingHalfEdges(origin))
+            {
+                sameDirectionCount += GetTarget(other) == target ? 1 : 0;
+            }
+
+            UINT twin = InvalidIndex;
+            UINT oppositeCount = 0;
+            for (const UINT other : GetOutgoingHalfEdges(target))
+            {
+                if (GetTarget(other) == origin)
+                {
+                    twin = other;
+                    ++oppositeCount;
+                }
+            }
+
+            halfEdgeTwins[halfEdge] = (sameDirectionCount == 1 && oppositeCount == 1 && origin != target) ? twin : InvalidIndex;
+        }
+    });
+
+    // 짝이 있는 변은 번호가 작은 half-edge가 변 번호를 정한다.
+    halfEdgeEdges.resize(halfEdgeCount);
+    edgeHalfEdges.clear();
+    edgeHalfEdges.reserve(halfEdgeCount / 2 + 1);
+    for (size_t halfEdge = 0; halfEdge < halfEdgeCount; ++halfEdge)
+    {
+        const UINT twin = halfEdgeTwins[halfEdge];
+        if (twin == InvalidIndex || halfEdge < twin)
+        {
+            halfEdgeEdges[halfEdge] = static_cast<UINT>(edgeHalfEdges.size());
+            edgeHalfEdges.push_back(static_cast<UINT>(halfEdge));
+        }
+    }
+    for (size_t halfEdge = 0; halfEdge < halfEdgeCount; ++halfEdge)
+    {
+        const UINT twin = halfEdgeTwins[halfEdge];
+        if (twin != InvalidIndex && twin < halfEdge)
+        {
+            halfEdgeEdges[halfEdge] = halfEdgeEdges[twin];
+        }
+    }
+}
+
+UINT HalfEdgeMesh::GetNext(UINT halfEdge) const
+{
+    const UINT face = halfEdgeFaces[halfEdge];
+    return halfEdge + 1 == faceOffsets[face + 1] ? faceOffsets[face] : halfEdge + 1;
+}
+
+UINT HalfEdgeMesh::GetPrev(UINT halfEdge) const
+{
+    const UINT face = halfEdgeFaces[halfEdge];
+    return halfEdge == faceOffsets[face] ? faceOffsets[face + 1] - 1 : halfEdge - 1;
+}
+
+UINT HalfEdgeMesh::FindEdge(UINT vertex0, UINT vertex1) const
+{
+    for (const UINT halfEdge : GetOutgoingHalfEdges(vertex0))
+    {
+        if (GetTarget(halfEdge) == vertex1)
+        {
+            return halfEdgeEdges[halfEdge];
+        }
+    }
+
+    for (const UINT halfEdge : GetOutgoingHalfEdges(vertex1))
+    {
+        if (GetTarget(halfEdge) == vertex0)
+        {
+            return halfEdgeEdges[halfEdge];
+        }
+    }
+
+    return InvalidIndex;
+}
+
+std::span<const UINT> HalfEdgeMesh::GetOutgoingHalfEdges(UINT vertex) const
+{
+    return std::span(outgoingHalfEdges).subspan(outgoingOffsets[vertex], outgoingOffsets[vertex + 1] - outgoingOffsets[vertex]);
+}
+
+bool HalfEdgeMesh::IsBoundaryVertex(UINT vertex) const
+{
+    // 경계 정점에는 짝이 없는 나가는 half-edge나 들어오는 half-edge가 있다.
+    return std::ranges::any_of(GetOutgoingHalfEdges(vertex), [this](UINT halfEdge)
+    {
+        return IsBoundary(halfEdge) || IsBoundary(GetPrev(halfEdge));
+    });
+}
+
+void HalfEdgeMesh::GetVertexRing(UINT vertex, std::vector<UINT>& outNeighbors, std::vector<UINT>& outEdges) const
+{
+    outNeighbors.clear();
+    outEdges.clear();
+
+    // 내부 변은 나가는 half-edge로 한 번씩 만나고, 들어오는 방향만 있는 경계 변은 이전 half-edge로 찾는다.
+    for (const UINT halfEdge : GetOutgoingHalfEdges(vertex))
+    {
+        outNeighbors.push_back(GetTarget(halfEdge));
+        outEdges.push_back(halfEdgeEdges[halfEdge]);
+
+        const UINT incoming = GetPrev(halfEdge);
+        if (IsBoundary(incoming))
+        {
+            outNeighbors.push_back(GetOrigin(incoming));
+            outEdges.push_back(halfEdgeEdges[incoming]);
+        }
+    }
+}
+
+bool HalfEdgeMesh::IsClosed() const
+{
+    return std::ranges::none_of(halfEdgeTwins, [](UINT twin) { return twin == InvalidIndex; });
+}
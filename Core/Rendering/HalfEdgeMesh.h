@@ -0,0 +1,112 @@
+#pragma once
+
+#include <d3d11.h>
+#include <span>
+#include <vector>
+
+// 인덱스 메시에서 만드는 인덱스 기반 half-edge 인접 구조. 위치는 들고 있지 않고 위상만 저장한다.
+// half-edge는 면의 꼭짓점 순서 그대로 번호를 매기므로 half-edge h의 시작 정점은 입력 인덱스 h와 같다.
+// 세 개 이상의 면이 공유하거나 방향이 어긋난 변은 짝을 맺지 않고 경계로 취급한다.
+class HalfEdgeMesh
+{
+public:
+    static constexpr UINT InvalidIndex = 0xffffffffu;
+
+    HalfEdgeMesh() = default;
+
+    // 삼각형 목록으로 만든다.
+    HalfEdgeMesh(size_t inVertexCount, std::span<const UINT> triangleIndices);
+
+    // 다각형 목록으로 만든다. i번째 면은 indices에서 faceSizes[i]개(3 이상)의 정점을 차례로 쓴다.
+    HalfEdgeMesh(size_t inVertexCount, std::span<const UINT> indices, std::span<const UINT> faceSizes);
+
+    [[nodiscard]]
+    size_t GetVertexCount() const { return vertexCount; }
+
+    [[nodiscard]]
+    size_t GetFaceCount() const { return faceOffsets.empty() ? 0 : faceOffsets.size() - 1; }
+
+    [[nodiscard]]
+    size_t GetHalfEdgeCount() const { return halfEdgeVertices.size(); }
+
+    [[nodiscard]]
+    size_t GetEdgeCount() const { return edgeHalfEdges.size(); }
+
+    // 면 f의 half-edge는 [GetFaceBegin(f), GetFaceBegin(f) + GetFaceSize(f)) 구간이다.
+    [[nodiscard]]
+    UINT GetFaceBegin(size_t face) const { return faceOffsets[face]; }
+
+    [[nodiscard]]
+    UINT GetFaceSize(size_t face) const { return faceOffsets[face + 1] - faceOffsets[face]; }
+
+    // 면은 모두 정점이 세 개 이상이므로 half-edge 수로 판단할 수 있다.
+    [[nodiscard]]
+    bool IsTriangleMesh() const { return GetHalfEdgeCount() == GetFaceCount() * 3; }
+
+    [[nodiscard]]
+    UINT GetOrigin(UINT halfEdge) const { return halfEdgeVertices[halfEdge]; }
+
+    [[nodiscard]]
+    UINT GetTarget(UINT halfEdge) const { return halfEdgeVertices[GetNext(halfEdge)]; }
+
+    [[nodiscard]]
+    UINT GetFace(UINT halfEdge) const { return halfEdgeFaces[halfEdge]; }
+
+    // 반대 방향 half-edge. 경계면 InvalidIndex이다.
+    [[nodiscard]]
+    UINT GetTwin(UINT halfEdge) const { return halfEdgeTwins[halfEdge]; }
+
+    [[nodiscard]]
+    UINT GetEdge(UINT halfEdge) const { return halfEdgeEdges[halfEdge]; }
+
+    [[nodiscard]]
+    UINT GetNext(UINT halfEdge) const;
+
+    [[nodiscard]]
+    UINT GetPrev(UINT halfEdge) const;
+
+    [[nodiscard]]
+    bool IsBoundary(UINT halfEdge) const { return halfEdgeTwins[halfEdge] == InvalidIndex; }
+
+    // 변을 대표하는 half-edge. 경계 변이면 유일한 half-edge이다.
+    [[nodiscard]]
+    UINT GetEdgeHalfEdge(size_t edge) const { return edgeHalfEdges[edge]; }
+
+    [[nodiscard]]
+    bool IsBoundaryEdge(size_t edge) const { return IsBoundary(edgeHalfEdges[edge]); }
+
+    // 두 정점을 잇는 변. 없으면 InvalidIndex이다.
+    [[nodiscard]]
+    UINT FindEdge(UINT vertex0, UINT vertex1) const;
+
+    // 정점에서 나가는 half-edge
+    [[nodiscard]]
+    std::span<const UINT> GetOutgoingHalfEdges(UINT vertex) const;
+
+    [[nodiscard]]
+    bool IsBoundaryVertex(UINT vertex) const;
+
+    // 정점에 닿은 변과 그 변의 반대쪽 정점. 닫힌 매니폴드라면 결과 수가 valence와 같다.
+    void GetVertexRing(UINT vertex, std::vector<UINT>& outNeighbors, std::vector<UINT>& outEdges) const;
+
+    [[nodiscard]]
+    bool IsClosed() const;
+
+private:
+    void Build(std::span<const UINT> indices);
+
+    size_t vertexCount = 0;
+
+    // 면 f의 첫 half-edge 번호. 마지막 원소는 half-edge 수이다.
+    std::vector<UINT> faceOffsets;
+
+    std::vector<UINT> halfEdgeVertices;
+    std::vector<UINT> halfEdgeFaces;
+    std::vector<UINT> halfEdgeTwins;
+    std::vector<UINT> halfEdgeEdges;
+    std::vector<UINT> edgeHalfEdges;
+
+    // 정점별로 나가는 half-edge 목록(CSR)
+    std::vector<UINT> outgoingOffsets;
+    std::vector<UINT> outgoingHalfEdges;
+};
@@ -0,0 +1,238 @@
+#include "MeshBatcher.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Rendering/MeshBuffer.h"
+
+namespace
+{
+    // 처음 만드는 버퍼의 최소 용량. 작은 메시를 하나씩 추가할 때 버퍼를 매번 다시 만들지 않도록 한다.
+    constexpr size_t MinVertexCapacity = 4096;
+    constexpr size_t MinIndexCapacity = 4096 * 3;
+
+    size_t GetGrownCapacity(size_t requiredCount, size_t currentCapacity, size_t minCapacity)
+    {
+        return std::max({requiredCount, currentCapacity * 2, minCapacity});
+    }
+
+    // buffer의 [beginByte, beginByte + data.size()) 구간을 data로 덮어쓴다.
+    void UpdateBufferRange(ID3D11DeviceContext* immediateContext, ID3D11Buffer* buffer, size_t beginByte, std::span<const std::byte> data)
+    {
+        const D3D11_BOX box{static_cast<UINT>(beginByte), 0, 0, static_cast<UINT>(beginByte + data.size()), 1, 1};
+        immediateContext->UpdateSubresource(buffer, 0, &box, data.data(), 0, 0);
+    }
+}
+
+MeshBatcherBase::MeshBatcherBase(UINT inVertexStride)
+    : vertexStride(inVertexStride)
+{
+    assert(vertexStride > 0);
+}
+
+MeshBatcherBase::MeshId MeshBatcherBase::AppendBytes(std::span<const std::byte> vertices, size_t vertexCount, std::span<const UINT> meshIndices, const Bounds& bounds)
+{
+    assert(vertices.size() == vertexCount * vertexStride);
+    assert(std::ranges::all_of(meshIndices, [vertexCount](UINT index) { return index < vertexCount; }));
+
+    Mesh mesh;
+    mesh.vertexOffset = GetVertexCount();
+    mesh.vertexCount = vertexCount;
+    mesh.indexOffset = indices.size();
+    mesh.indexCount = meshIndices.size();
+    mesh.bounds = bounds;
+
+    vertexBytes.insert(vertexBytes.end(), vertices.begin(), vertices.end());
+    indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+    meshes.push_back(mesh);
+
+    if (MeshBuffer::GetIndexFormat(vertexCount) == DXGI_FORMAT_R32_UINT)
+    {
+        indexFormat = DXGI_FORMAT_R32_UINT;
+    }
+
+    return static_cast<MeshId>(meshes.size() - 1);
+}
+
+void MeshBatcherBase::Remove(MeshId meshId)
+{
+    assert(Contains(meshId));
+
+    // 데이터는 Compact까지 그대로 남으므로 인덱스 형식도 그때까지 유지한다.
+    Mesh& mesh = meshes[meshId];
+    mesh.isRemoved = true;
+    removedVertexCount += mesh.vertexCount;
+}
+
+void MeshBatcherBase::Compact()
+{
+    // 이미 압축된 제거 메시는 구간이 비어 있다.
+    const bool hasRemovedRange = std::ranges::any_of(meshes, [](const Mesh& mesh)
+    {
+        return mesh.isRemoved && (mesh.vertexCount > 0 || mesh.indexCount > 0);
+    });
+    if (!hasRemovedRange)
+    {
+        return;
+    }
+
+    std::vector<std::byte> compactedVertexBytes;
+    std::vector<UINT> compactedIndices;
+    compactedVertexBytes.reserve(vertexBytes.size() - removedVertexCount * vertexStride);
+    compactedIndices.reserve(indices.size());
+
+    for (Mesh& mesh : meshes)
+    {
+        if (mesh.isRemoved)
+        {
+            mesh = Mesh{.isRemoved = true};
+            continue;
+        }
+
+        const auto vertexBegin = vertexBytes.begin() + static_cast<ptrdiff_t>(mesh.vertexOffset * vertexStride);
+        const auto indexBegin = indices.begin() + static_cast<ptrdiff_t>(mesh.indexOffset);
+
+        mesh.vertexOffset = compactedVertexBytes.size() / vertexStride;
+        mesh.indexOffset = compactedIndices.size();
+
+        compactedVertexBytes.insert(compactedVertexBytes.end(), vertexBegin, vertexBegin + static_cast<ptrdiff_t>(mesh.vertexCount * vertexStride));
+        compactedIndices.insert(compactedIndices.end(), indexBegin, indexBegin + static_cast<ptrdiff_t>(mesh.indexCount));
+    }
+
+    vertexBytes = std::move(compactedVertexBytes);
+    indices = std::move(compactedIndices);
+    removedVertexCount = 0;
+    UpdateIndexFormat();
+
+    // 구간이 모두 옮겨졌으므로 다음 Commit에서 처음부터 다시 올린다.
+    committedVertexCount = 0;
+    committedIndexCount = 0;
+}
+
+void MeshBatcherBase::Clear()
+{
+    vertexBytes.clear();
+    indices.clear();
+    meshes.clear();
+    removedVertexCount = 0;
+    indexFormat = DXGI_FORMAT_R16_UINT;
+
+    // GPU 버퍼는 용량을 재사용하도록 남겨 둔다.
+    committedVertexCount = 0;
+    committedIndexCount = 0;
+}
+
+Submesh MeshBatcherBase::GetSubmesh(MeshId meshId) const
+{
+    assert(Contains(meshId));
+
+    const Mesh& mesh = meshes[meshId];
+    Submesh submesh(mesh.indexCount, mesh.indexOffset, mesh.vertexOffset, indexFormat);
+    submesh.bounds = mesh.bounds;
+    return submesh;
+}
+
+bool MeshBatcherBase::Contains(MeshId meshId) const
+{
+    return meshId < meshes.size() && !meshes[meshId].isRemoved;
+}
+
+HRESULT MeshBatcherBase::Commit(ID3D11Device* device, ID3D11DeviceContext* immediateContext)
+{
+    if (const HRESULT result = CommitVertices(device, immediateContext); FAILED(result))
+    {
+        return result;
+    }
+
+    return CommitIndices(device, immediateContext);
+}
+
+void MeshBatcherBase::Bind(ID3D11DeviceContext* immediateContext) const
+{
+    assert(committedVertexCount == GetVertexCount() && committedIndexCount == indices.size() && "Bind 전에 Commit을 호출해야 합니다.");
+
+    constexpr UINT offset = 0;
+    immediateContext->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &vertexStride, &offset);
+    immediateContext->IASetIndexBuffer(indexBuffer.Get(), committedIndexFormat, 0);
+}
+
+void MeshBatcherBase::UpdateIndexFormat()
+{
+    const bool needsIndex32 = std::ranges::any_of(meshes, [](const Mesh& mesh)
+    {
+        return !mesh.isRemoved && MeshBuffer::GetIndexFormat(mesh.vertexCount) == DXGI_FORMAT_R32_UINT;
+    });
+    indexFormat = needsIndex32 ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+}
+
+HRESULT MeshBatcherBase::CommitVertices(ID3D11Device* device, ID3D11DeviceContext* immediateContext)
+{
+    const size_t vertexCount = GetVertexCount();
+
+    if (vertexCount > vertexCapacity)
+    {
+        const size_t newCapacity = GetGrownCapacity(vertexCount, vertexCapacity, MinVertexCapacity);
+        const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(newCapacity * vertexStride), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_DEFAULT);
+
+        ComPtr<ID3D11Buffer> newVertexBuffer;
+        if (const HRESULT result = device->CreateBuffer(&vertexBufferDesc, nullptr, &newVertexBuffer); FAILED(result))
+        {
+            return result;
+        }
+
+        vertexBuffer = std::move(newVertexBuffer);
+        vertexCapacity = newCapacity;
+        committedVertexCount = 0;
+    }
+
+    // 추가된 뒷부분만 올린다.
+    if (vertexCount > committedVertexCount)
+    {
+        const std::span<const std::byte> appendedBytes = std::span(vertexBytes).subspan(committedVertexCount * vertexStride);
+        UpdateBufferRange(immediateContext, vertexBuffer.Get(), committedVertexCount * vertexStride, appendedBytes);
+    }
+    committedVertexCount = vertexCount;
+
+    return S_OK;
+}
+
+HRESULT MeshBatcherBase::CommitIndices(ID3D11Device* device, ID3D11DeviceContext* immediateContext)
+{
+    const size_t indexCount = indices.size();
+    const UINT indexStride = MeshBuffer::GetIndexStride(indexFormat);
+
+    // 인덱스 형식이 바뀌면 요소 크기가 달라지므로 버퍼를 새로 만든다.
+    if (indexCount > indexCapacity || indexFormat != committedIndexFormat)
+    {
+        const size_t newCapacity = indexFormat != committedIndexFormat ? std::max(indexCount, MinIndexCapacity) : GetGrownCapacity(indexCount, indexCapacity, MinIndexCapacity);
+        const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(newCapacity * indexStride), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_DEFAULT);
+
+        ComPtr<ID3D11Buffer> newIndexBuffer;
+        if (const HRESULT result = device->CreateBuffer(&indexBufferDesc, nullptr, &newIndexBuffer); FAILED(result))
+        {
+            return result;
+        }
+
+        indexBuffer = std::move(newIndexBuffer);
+        indexCapacity = newCapacity;
+        committedIndexCount = 0;
+        committedIndexFormat = indexFormat;
+    }
+
+    if (indexCount > committedIndexCount)
+    {
+        const std::span<const UINT> appendedIndices = std::span(indices).subspan(committedIndexCount);
+        if (indexFormat == DXGI_FORMAT_R16_UINT)
+        {
+            const std::vector<uint16_t> appendedIndices16 = MeshBuffer::ToIndex16(appendedIndices);
+            UpdateBufferRange(immediateContext, indexBuffer.Get(), committedIndexCount * indexStride, std::as_bytes(std::span(appendedIndices16)));
+        }
+        else
+        {
+            UpdateBufferRange(immediateContext, indexBuffer.Get(), committedIndexCount * indexStride, std::as_bytes(appendedIndices));
+        }
+    }
+    committedIndexCount = indexCount;
+
+    return S_OK;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <wrl/client.h>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/Bounds.h"
+#include "Core/Rendering/Submesh.h"
+
+// 여러 메시를 정점/인덱스 버퍼 한 쌍에 이어 담는다. 버퍼를 한 번만 바인딩하고 메시마다 Submesh로 그릴 수 있다.
+// 인덱스는 메시 안에서의 값을 그대로 두고 baseVertexLocation으로 구분하므로, 메시마다 정점이 65536개 이하면 16비트 인덱스를 쓴다.
+// 제거한 메시의 구간은 Compact를 호출할 때 메워지며, 메시 번호는 압축해도 바뀌지 않는다.
+class MeshBatcherBase
+{
+public:
+    // Append가 돌려주는 메시 번호
+    using MeshId = UINT;
+
+    explicit MeshBatcherBase(UINT inVertexStride);
+    virtual ~MeshBatcherBase() = default;
+
+    MeshBatcherBase(const MeshBatcherBase&) = delete;
+    MeshBatcherBase& operator=(const MeshBatcherBase&) = delete;
+
+    void Remove(MeshId meshId);
+
+    // 제거된 메시가 차지하던 구간을 뒤의 메시로 메운다. 다음 Commit에서 버퍼 전체를 다시 올린다.
+    void Compact();
+
+    void Clear();
+
+    // 현재 구간과 인덱스 형식, 메시 범위. 압축하거나 메시를 추가하면 바뀔 수 있으므로 보관하지 말고 그릴 때마다 가져온다.
+    [[nodiscard]]
+    Submesh GetSubmesh(MeshId meshId) const;
+
+    [[nodiscard]]
+    bool Contains(MeshId meshId) const;
+
+    // 바뀐 부분을 GPU 버퍼에 올린다. 용량이 부족하면 두 배씩 키운 버퍼를 새로 만든다.
+    HRESULT Commit(ID3D11Device* device, ID3D11DeviceContext* immediateContext);
+
+    // 정점 버퍼를 0번 슬롯에, 인덱스 버퍼를 현재 인덱스 형식으로 바인딩한다.
+    void Bind(ID3D11DeviceContext* immediateContext) const;
+
+    [[nodiscard]]
+    DXGI_FORMAT GetIndexFormat() const { return indexFormat; }
+
+    // 제거되어 버려진 구간까지 포함한 크기
+    [[nodiscard]]
+    size_t GetVertexCount() const { return vertexBytes.size() / vertexStride; }
+
+    [[nodiscard]]
+    size_t GetIndexCount() const { return indices.size(); }
+
+    [[nodiscard]]
+    size_t GetRemovedVertexCount() const { return removedVertexCount; }
+
+    // CPU에 모아 둔 정점과 인덱스. Compact 전까지는 제거된 메시의 구간도 남아 있다.
+    [[nodiscard]]
+    std::span<const std::byte> GetVertexBytes() const { return vertexBytes; }
+
+    [[nodiscard]]
+    std::span<const UINT> GetIndices() const { return indices; }
+
+protected:
+    MeshId AppendBytes(std::span<const std::byte> vertices, size_t vertexCount, std::span<const UINT> meshIndices, const Bounds& bounds);
+
+private:
+    template <typename T>
+    using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+    struct Mesh
+    {
+        size_t vertexOffset = 0;
+        size_t vertexCount = 0;
+        size_t indexOffset = 0;
+        size_t indexCount = 0;
+        Bounds bounds;
+        bool isRemoved = false;
+    };
+
+    void UpdateIndexFormat();
+    HRESULT CommitVertices(ID3D11Device* device, ID3D11DeviceContext* immediateContext);
+    HRESULT CommitIndices(ID3D11Device* device, ID3D11DeviceContext* immediateContext);
+
+    UINT vertexStride = 0;
+
+    std::vector<std::byte> vertexBytes;
+    std::vector<UINT> indices;
+    std::vector<Mesh> meshes;
+    size_t removedVertexCount = 0;
+    DXGI_FORMAT indexFormat = DXGI_FORMAT_R16_UINT;
+
+    ComPtr<ID3D11Buffer> vertexBuffer;
+    ComPtr<ID3D11Buffer> indexBuffer;
+
+    // GPU 버퍼의 용량과 이미 올라간 양. 용량과 양은 정점/인덱스 개수 단위이다.
+    size_t vertexCapacity = 0;
+    size_t indexCapacity = 0;
+    size_t committedVertexCount = 0;
+    size_t committedIndexCount = 0;
+    DXGI_FORMAT committedIndexFormat = DXGI_FORMAT_UNKNOWN;
+};
+
+template <typename VertexType>
+class MeshBatcher final : public MeshBatcherBase
+{
+public:
+    MeshBatcher() : MeshBatcherBase(sizeof(VertexType)) {}
+
+    // VertexType에 XMFLOAT3 position이 있으면 메시 범위도 계산해 Submesh에 담는다.
+    MeshId Append(std::span<const VertexType> vertices, std::span<const UINT> meshIndices)
+    {
+        Bounds bounds;
+        if constexpr (requires { requires std::same_as<decltype(VertexType::position), DirectX::XMFLOAT3>; })
+        {
+            bounds = Bounds::Compute(MakeVertexView(vertices, &VertexType::position));
+        }
+
+        return AppendBytes(std::as_bytes(vertices), vertices.size(), meshIndices, bounds);
+    }
+
+    // GeometryGenerator의 정점을 converter로 VertexType으로 바꿔 추가한다.
+    template <typename Converter>
+    MeshId Append(const GeometryGenerator::MeshData& meshData, Converter&& converter)
+    {
+        std::vector<VertexType> vertices;
+        vertices.reserve(meshData.vertices.size());
+        for (const GeometryGenerator::Vertex& vertex : meshData.vertices)
+        {
+            vertices.push_back(converter(vertex));
+        }
+
+        return Append(vertices, meshData.indices);
+    }
+};
@@ -0,0 +1,37 @@
+#include "MeshBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+
+DXGI_FORMAT MeshBuffer::GetIndexFormat(std::span<const UINT> indices)
+{
+    const UINT maxIndex = indices.empty() ? 0 : std::ranges::max(indices);
+    return GetIndexFormat(static_cast<size_t>(maxIndex) + 1);
+}
+
+std::vector<uint16_t> MeshBuffer::ToIndex16(std::span<const UINT> indices)
+{
+    std::vector<uint16_t> indices16(indices.size());
+    std::ranges::transform(indices, indices16.begin(), [](UINT index)
+    {
+        assert(index < MaxIndex16VertexCount);
+        return static_cast<uint16_t>(index);
+    });
+
+    return indices16;
+}
+
+HRESULT MeshBuffer::CreateIndexBuffer(ID3D11Device* device, std::span<const UINT> indices, DXGI_FORMAT indexFormat, ID3D11Buffer** outIndexBuffer)
+{
+    const CD3D11_BUFFER_DESC indexBufferDesc(static_cast<UINT>(GetIndexStride(indexFormat) * indices.size()), D3D11_BIND_INDEX_BUFFER, D3D11_USAGE_IMMUTABLE);
+
+    if (indexFormat == DXGI_FORMAT_R16_UINT)
+    {
+        const std::vector<uint16_t> indices16 = ToIndex16(indices);
+        const D3D11_SUBRESOURCE_DATA indexInitData{indices16.data()};
+        return device->CreateBuffer(&indexBufferDesc, &indexInitData, outIndexBuffer);
+    }
+
+    const D3D11_SUBRESOURCE_DATA indexInitData{indices.data()};
+    return device->CreateBuffer(&indexBufferDesc, &indexInitData, outIndexBuffer);
+}
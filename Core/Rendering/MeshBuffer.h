@@ -0,0 +1,35 @@
+#pragma once
+
+#include <d3d11.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace MeshBuffer
+{
+    // 16비트 인덱스로 표현할 수 있는 최대 정점 수
+    constexpr size_t MaxIndex16VertexCount = 65536;
+
+    // 정점 수가 65536개 이하면 16비트 인덱스로 충분하다.
+    [[nodiscard]]
+    constexpr DXGI_FORMAT GetIndexFormat(size_t vertexCount)
+    {
+        return vertexCount <= MaxIndex16VertexCount ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    }
+
+    // 여러 메시를 baseVertexLocation으로 나눠 담은 버퍼처럼 정점 수만으로 판단할 수 없을 때는 가장 큰 인덱스 값으로 판단한다.
+    [[nodiscard]]
+    DXGI_FORMAT GetIndexFormat(std::span<const UINT> indices);
+
+    [[nodiscard]]
+    constexpr UINT GetIndexStride(DXGI_FORMAT indexFormat)
+    {
+        return indexFormat == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) : sizeof(UINT);
+    }
+
+    [[nodiscard]]
+    std::vector<uint16_t> ToIndex16(std::span<const UINT> indices);
+
+    // indices를 indexFormat 크기로 변환해 불변 인덱스 버퍼를 만든다.
+    HRESULT CreateIndexBuffer(ID3D11Device* device, std::span<const UINT> indices, DXGI_FORMAT indexFormat, ID3D11Buffer** outIndexBuffer);
+}
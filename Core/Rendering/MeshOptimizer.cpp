@@ -0,0 +1,591 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+#include "Utilities/Parallel.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // Forsyth 알고리즘에서 흉내 내는 LRU 캐시 크기와 점수 계수
+    constexpr UINT CacheSize = 32;
+    constexpr float CacheDecayPower = 1.5f;
+    constexpr float LastTriangleScore = 0.75f;
+    constexpr float ValenceBoostScale = 2.0f;
+    constexpr float ValenceBoostPower = 0.5f;
+    constexpr UINT MaxValence = 32;
+
+    struct ScoreTable
+    {
+        ScoreTable()
+        {
+            for (UINT i = 0; i < CacheSize; ++i)
+            {
+                // 방금 그린 삼각형의 세 정점은 같은 점수를 받아 특정 순서를 선호하지 않도록 한다.
+                if (i < 3)
+                {
+                    cacheScores[i] = LastTriangleScore;
+                }
+                else
+                {
+                    const float scale = 1.0f / static_cast<float>(CacheSize - 3);
+                    cacheScores[i] = std::pow(1.0f - static_cast<float>(i - 3) * scale, CacheDecayPower);
+                }
+            }
+
+            // 남은 삼각형이 적은 정점을 먼저 끝내도록 가산점을 준다.
+            valenceScores[0] = 0.0f;
+            for (UINT i = 1; i <= MaxValence; ++i)
+            {
+                valenceScores[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+            }
+        }
+
+        float GetScore(int cachePosition, UINT remainingValence) const
+        {
+            if (remainingValence == 0)
+            {
+                return -1.0f;
+            }
+
+            const float cacheScore = cachePosition >= 0 ? cacheScores[cachePosition] : 0.0f;
+            return cacheScore + valenceScores[std::min(remainingValence, MaxValence)];
+        }
+
+        std::array<float, CacheSize> cacheScores{};
+        std::array<float, MaxValence + 1> valenceScores{};
+    };
+
+    // 오버드로 묶음을 나눌 때 흉내 내는 FIFO 캐시 크기. AnalyzeVertexCache의 기본값과 같다.
+    constexpr UINT OverdrawCacheSize = 16;
+
+    // AnalyzeOverdraw가 그리는 가상 렌더 타깃의 한 변 픽셀 수
+    constexpr int OverdrawViewportSize = 256;
+
+    // 정점이 캐시에 들어간 시점을 기록해 FIFO 캐시를 흉내 낸다.
+    class FifoCacheSimulator
+    {
+    public:
+        FifoCacheSimulator(size_t vertexCount, UINT inCacheSize)
+            : cacheTimestamps(vertexCount, 0), cacheSize(inCacheSize), timestamp(inCacheSize + 1)
+        {
+        }
+
+        // 시점을 캐시 크기보다 멀리 옮겨 모든 정점이 캐시에서 밀려난 것으로 만든다.
+        void Flush()
+        {
+            timestamp += cacheSize + 1;
+        }
+
+        // 삼각형 하나를 그릴 때 생기는 캐시 미스 수
+        UINT AddTriangle(const UINT* triangle)
+        {
+            UINT missCount = 0;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                if (timestamp - cacheTimestamps[triangle[i]] > cacheSize)
+                {
+                    cacheTimestamps[triangle[i]] = timestamp++;
+                    ++missCount;
+                }
+            }
+
+            return missCount;
+        }
+
+    private:
+        std::vector<size_t> cacheTimestamps;
+        size_t cacheSize = 0;
+        size_t timestamp = 0;
+    };
+
+    // 캐시 순서를 유지한 채 삼각형을 묶음으로 나눈다. 반환값은 묶음의 시작 삼각형 번호이며 마지막 원소는 삼각형 수이다.
+    std::vector<size_t> BuildOverdrawClusters(std::span<const UINT> indices, size_t vertexCount, float threshold)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        FifoCacheSimulator cache(vertexCount, OverdrawCacheSize);
+
+        // 세 정점이 모두 미스인 삼각형 앞은 캐시가 이미 비워진 것과 같으므로 끊어도 캐시 효율이 떨어지지 않는다.
+        std::vector<size_t> hardBoundaries{0};
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            if (cache.AddTriangle(&indices[i * 3]) == 3 && i > 0)
+            {
+                hardBoundaries.push_back(i);
+            }
+        }
+        hardBoundaries.push_back(triangleCount);
+
+        std::vector<size_t> clusterBegins;
+        for (size_t boundary = 0; boundary + 1 < hardBoundaries.size(); ++boundary)
+        {
+            const size_t begin = hardBoundaries[boundary];
+            const size_t end = hardBoundaries[boundary + 1];
+
+            cache.Flush();
+            UINT missCount = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                missCount += cache.AddTriangle(&indices[i * 3]);
+            }
+            const float targetAcmr = threshold * static_cast<float>(missCount) / static_cast<float>(end - begin);
+
+            // 묶음마다 캐시가 비워진다고 보고, 지금까지의 ACMR이 목표 안으로 들어오면 다음 삼각형부터 새 묶음을 시작한다.
+            cache.Flush();
+            clusterBegins.push_back(begin);
+            UINT runningMissCount = 0;
+            size_t runningTriangleCount = 0;
+            for (size_t i = begin; i + 1 < end; ++i)
+            {
+                runningMissCount += cache.AddTriangle(&indices[i * 3]);
+                ++runningTriangleCount;
+
+                if (static_cast<float>(runningMissCount) <= targetAcmr * static_cast<float>(runningTriangleCount))
+                {
+                    clusterBegins.push_back(i + 1);
+                    cache.Flush();
+                    runningMissCount = 0;
+                    runningTriangleCount = 0;
+                }
+            }
+        }
+        clusterBegins.push_back(triangleCount);
+
+        return clusterBegins;
+    }
+
+    // 구 위에 황금각 나선으로 고르게 놓인 count개의 방향 중 index번째
+    XMVECTOR GetSphereDirection(size_t index, size_t count)
+    {
+        const float goldenAngle = XM_PI * (3.0f - std::sqrt(5.0f));
+        const float z = 1.0f - (2.0f * static_cast<float>(index) + 1.0f) / static_cast<float>(count);
+        const float radius = std::sqrt(std::max(0.0f, 1.0f - z * z));
+        const float angle = goldenAngle * static_cast<float>(index);
+        return XMVectorSet(radius * std::cos(angle), radius * std::sin(angle), z, 0.0f);
+    }
+
+    struct OverdrawCount
+    {
+        UINT coveredPixelCount = 0;
+        UINT shadedPixelCount = 0;
+    };
+
+    // viewDirection을 바라보는 직교 카메라로 경계 구가 화면을 채우도록 메시를 그린다.
+    OverdrawCount RasterizeOverdraw(std::span<const UINT> indices, const VertexView& vertexView, FXMVECTOR center, float boundingRadius, FXMVECTOR viewDirection)
+    {
+        // 왼손 좌표계 카메라 기저. 시선이 y축과 거의 나란하면 x축을 위쪽 기준으로 쓴다.
+        const XMVECTOR upReference = std::abs(XMVectorGetY(viewDirection)) < 0.99f ? XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f) : XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+        const XMVECTOR right = XMVector3Normalize(XMVector3Cross(upReference, viewDirection));
+        const XMVECTOR up = XMVector3Cross(viewDirection, right);
+
+        // 정점을 픽셀 좌표(y는 아래 방향)와 깊이로 옮긴다.
+        const float halfSize = 0.5f * static_cast<float>(OverdrawViewportSize);
+        const float scale = halfSize / boundingRadius;
+        std::vector<XMFLOAT3> screenPositions(vertexView.vertexCount);
+        for (size_t i = 0; i < vertexView.vertexCount; ++i)
+        {
+            const XMVECTOR offset = XMVectorSubtract(XMLoadFloat3(&vertexView.positions[i]), center);
+            screenPositions[i].x = halfSize + XMVectorGetX(XMVector3Dot(offset, right)) * scale;
+            screenPositions[i].y = halfSize - XMVectorGetX(XMVector3Dot(offset, up)) * scale;
+            screenPositions[i].z = XMVectorGetX(XMVector3Dot(offset, viewDirection));
+        }
+
+        std::vector<float> depthBuffer(static_cast<size_t>(OverdrawViewportSize) * OverdrawViewportSize, FLT_MAX);
+        OverdrawCount count;
+
+        auto edgeFunction = [](const XMFLOAT3& a, const XMFLOAT3& b, float x, float y)
+        {
+            return (b.x - a.x) * (y - a.y) - (x - a.x) * (b.y - a.y);
+        };
+
+        for (size_t triangle = 0; triangle + 2 < indices.size(); triangle += 3)
+        {
+            const XMFLOAT3& a = screenPositions[indices[triangle]];
+            const XMFLOAT3& b = screenPositions[indices[triangle + 1]];
+            const XMFLOAT3& c = screenPositions[indices[triangle + 2]];
+
+            // D3D11 기본 래스터라이저 상태처럼 화면에서 시계 방향인 면만 그린다.
+            const float area = edgeFunction(a, b, c.x, c.y);
+            if (area <= 0.0f)
+            {
+                continue;
+            }
+
+            const int minX = std::max(0, static_cast<int>(std::floor(std::min({a.x, b.x, c.x}))));
+            const int maxX = std::min(OverdrawViewportSize - 1, static_cast<int>(std::ceil(std::max({a.x, b.x, c.x}))));
+            const int minY = std::max(0, static_cast<int>(std::floor(std::min({a.y, b.y, c.y}))));
+            const int maxY = std::min(OverdrawViewportSize - 1, static_cast<int>(std::ceil(std::max({a.y, b.y, c.y}))));
+
+            for (int y = minY; y <= maxY; ++y)
+            {
+                const float sampleY = static_cast<float>(y) + 0.5f;
+                for (int x = minX; x <= maxX; ++x)
+                {
+                    const float sampleX = static_cast<float>(x) + 0.5f;
+                    const float weightA = edgeFunction(b, c, sampleX, sampleY);
+                    const float weightB = edgeFunction(c, a, sampleX, sampleY);
+                    const float weightC = edgeFunction(a, b, sampleX, sampleY);
+                    if (weightA < 0.0f || weightB < 0.0f || weightC < 0.0f)
+                    {
+                        continue;
+                    }
+
+                    // early-z처럼 깊이 테스트를 통과한 픽셀만 셰이딩된 것으로 센다.
+                    const float depth = (weightA * a.z + weightB * b.z + weightC * c.z) / area;
+                    float& storedDepth = depthBuffer[static_cast<size_t>(y) * OverdrawViewportSize + x];
+                    if (depth < storedDepth)
+                    {
+                        storedDepth = depth;
+                        ++count.shadedPixelCount;
+                    }
+                }
+            }
+        }
+
+        count.coveredPixelCount = static_cast<UINT>(std::ranges::count_if(depthBuffer, [](float depth) { return depth != FLT_MAX; }));
+        return count;
+    }
+}
+
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(std::span<const UINT> indices, size_t vertexCount, UINT cacheSize)
+{
+    VertexCacheStatistics statistics;
+    if (indices.empty())
+    {
+        return statistics;
+    }
+
+    // 각 정점이 캐시에 들어간 시점을 기록해 두면 FIFO 캐시를 배열 없이 흉내 낼 수 있다.
+    std::vector<size_t> cacheTimestamps(vertexCount, 0);
+    std::vector<bool> isUsed(vertexCount, false);
+    size_t timestamp = cacheSize + 1;
+    size_t usedVertexCount = 0;
+
+    for (const UINT index : indices)
+    {
+        if (timestamp - cacheTimestamps[index] > cacheSize)
+        {
+            cacheTimestamps[index] = timestamp++;
+            ++statistics.transformedVertexCount;
+        }
+
+        if (!isUsed[index])
+        {
+            isUsed[index] = true;
+            ++usedVertexCount;
+        }
+    }
+
+    statistics.acmr = static_cast<float>(statistics.transformedVertexCount) / static_cast<float>(indices.size() / 3);
+    statistics.atvr = static_cast<float>(statistics.transformedVertexCount) / static_cast<float>(usedVertexCount);
+
+    return statistics;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::span<UINT> inoutIndices, size_t vertexCount)
+{
+    static const ScoreTable scoreTable;
+
+    const size_t triangleCount = inoutIndices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // 정점마다 그 정점을 쓰는 삼각형 목록을 CSR 형태로 만든다. 삼각형이 추가될 때마다 목록 앞쪽의 유효 구간이 줄어든다.
+    std::vector<UINT> remainingValences(vertexCount, 0);
+    for (const UINT index : inoutIndices)
+    {
+        ++remainingValences[index];
+    }
+
+    std::vector<UINT> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + remainingValences[i];
+    }
+
+    std::vector<UINT> adjacentTriangles(inoutIndices.size());
+    {
+        std::vector<UINT> writeOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < inoutIndices.size(); ++i)
+        {
+            adjacentTriangles[writeOffsets[inoutIndices[i]]++] = static_cast<UINT>(i / 3);
+        }
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        vertexScores[i] = scoreTable.GetScore(-1, remainingValences[i]);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> isTriangleEmitted(triangleCount, false);
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+        triangleScores[i] = vertexScores[inoutIndices[i * 3]] + vertexScores[inoutIndices[i * 3 + 1]] + vertexScores[inoutIndices[i * 3 + 2]];
+    }
+
+    const std::vector<UINT> inputIndices(inoutIndices.begin(), inoutIndices.end());
+
+    // 정점이 캐시 밖으로 밀려날 때도 점수를 갱신해야 하므로 캐시 크기 + 3만큼 추적한다.
+    std::array<UINT, CacheSize + 3> cache{};
+    std::array<UINT, CacheSize + 3> nextCache{};
+    size_t cacheCount = 0;
+
+    size_t bestTriangle = std::distance(triangleScores.begin(), std::ranges::max_element(triangleScores));
+    size_t fallbackCursor = 0;
+
+    for (size_t outputTriangle = 0; outputTriangle < triangleCount; ++outputTriangle)
+    {
+        // 캐시 주변에 후보가 없으면 아직 그리지 않은 다음 삼각형부터 다시 시작한다.
+        if (bestTriangle == triangleCount)
+        {
+            while (isTriangleEmitted[fallbackCursor])
+            {
+                ++fallbackCursor;
+            }
+            bestTriangle = fallbackCursor;
+        }
+
+        const std::array<UINT, 3> triangle =
+        {
+            inputIndices[bestTriangle * 3], inputIndices[bestTriangle * 3 + 1], inputIndices[bestTriangle * 3 + 2]
+        };
+
+        inoutIndices[outputTriangle * 3 + 0] = triangle[0];
+        inoutIndices[outputTriangle * 3 + 1] = triangle[1];
+        inoutIndices[outputTriangle * 3 + 2] = triangle[2];
+        isTriangleEmitted[bestTriangle] = true;
+
+        // 그린 삼각형을 각 정점의 유효 목록에서 뺀다.
+        for (const UINT vertex : triangle)
+        {
+            UINT* begin = &adjacentTriangles[adjacencyOffsets[vertex]];
+            UINT* end = begin + remainingValences[vertex];
+            UINT* found = std::find(begin, end, static_cast<UINT>(bestTriangle));
+            if (found != end)
+            {
+                std::swap(*found, *(end - 1));
+                --remainingValences[vertex];
+            }
+        }
+
+        // 방금 그린 세 정점을 캐시 앞에 넣고 나머지를 뒤로 민다.
+        size_t nextCacheCount = 0;
+        for (const UINT vertex : triangle)
+        {
+            if (std::find(nextCache.begin(), nextCache.begin() + nextCacheCount, vertex) == nextCache.begin() + nextCacheCount)
+            {
+                nextCache[nextCacheCount++] = vertex;
+            }
+        }
+
+        for (size_t i = 0; i < cacheCount; ++i)
+        {
+            const UINT vertex = cache[i];
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+            {
+                if (nextCacheCount < nextCache.size())
+                {
+                    nextCache[nextCacheCount++] = vertex;
+                }
+                else
+                {
+                    cachePositions[vertex] = -1;
+                }
+            }
+        }
+
+        std::swap(cache, nextCache);
+        cacheCount = nextCacheCount;
+
+        // 캐시에 남은 정점과 그 정점을 쓰는 삼각형의 점수를 갱신하면서 다음에 그릴 삼각형을 고른다.
+        for (size_t i = 0; i < cacheCount; ++i)
+        {
+            const UINT vertex = cache[i];
+            cachePositions[vertex] = i < CacheSize ? static_cast<int>(i) : -1;
+
+            const float newScore = scoreTable.GetScore(cachePositions[vertex], remainingValences[vertex]);
+            const float deltaScore = newScore - vertexScores[vertex];
+            vertexScores[vertex] = newScore;
+
+            const UINT* adjacency = &adjacentTriangles[adjacencyOffsets[vertex]];
+            for (UINT j = 0; j < remainingValences[vertex]; ++j)
+            {
+                triangleScores[adjacency[j]] += deltaScore;
+            }
+        }
+
+        bestTriangle = triangleCount;
+        float bestScore = -1.0f;
+        for (size_t i = 0; i < std::min<size_t>(cacheCount, CacheSize); ++i)
+        {
+            const UINT vertex = cache[i];
+            const UINT* adjacency = &adjacentTriangles[adjacencyOffsets[vertex]];
+            for (UINT j = 0; j < remainingValences[vertex]; ++j)
+            {
+                const UINT candidate = adjacency[j];
+                if (triangleScores[candidate] > bestScore)
+                {
+                    bestScore = triangleScores[candidate];
+                    bestTriangle = candidate;
+                }
+            }
+        }
+
+        // 캐시 크기를 넘어 밀려난 정점은 캐시에서 제거한다.
+        cacheCount = std::min<size_t>(cacheCount, CacheSize);
+    }
+}
+
+MeshOptimizer::OverdrawStatistics MeshOptimizer::AnalyzeOverdraw(std::span<const UINT> indices, const VertexView& vertexView, UINT viewDirectionCount)
+{
+    assert(vertexView.positions.IsValid());
+
+    OverdrawStatistics statistics;
+    if (indices.size() < 3 || vertexView.vertexCount == 0 || viewDirectionCount == 0)
+    {
+        return statistics;
+    }
+
+    // 모든 시점에서 메시가 화면 안에 들어오도록 AABB 중심을 지나는 경계 구를 쓴다.
+    XMVECTOR minimum = XMVectorReplicate(FLT_MAX);
+    XMVECTOR maximum = XMVectorReplicate(-FLT_MAX);
+    for (size_t i = 0; i < vertexView.vertexCount; ++i)
+    {
+        const XMVECTOR position = XMLoadFloat3(&vertexView.positions[i]);
+        minimum = XMVectorMin(minimum, position);
+        maximum = XMVectorMax(maximum, position);
+    }
+
+    const XMVECTOR center = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+    float boundingRadius = 0.0f;
+    for (size_t i = 0; i < vertexView.vertexCount; ++i)
+    {
+        boundingRadius = std::max(boundingRadius, XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&vertexView.positions[i]), center))));
+    }
+    if (boundingRadius <= 0.0f)
+    {
+        return statistics;
+    }
+
+    std::vector<OverdrawCount> viewCounts(viewDirectionCount);
+    Parallel::For(0, viewDirectionCount, 1, [&](size_t view)
+    {
+        viewCounts[view] = RasterizeOverdraw(indices, vertexView, center, boundingRadius, GetSphereDirection(view, viewDirectionCount));
+    });
+
+    for (const OverdrawCount& viewCount : viewCounts)
+    {
+        statistics.coveredPixelCount += viewCount.coveredPixelCount;
+        statistics.shadedPixelCount += viewCount.shadedPixelCount;
+    }
+
+    if (statistics.coveredPixelCount > 0)
+    {
+        statistics.overdraw = static_cast<float>(statistics.shadedPixelCount) / static_cast<float>(statistics.coveredPixelCount);
+    }
+
+    return statistics;
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::span<UINT> inoutIndices, const VertexView& vertexView, float threshold)
+{
+    assert(vertexView.positions.IsValid());
+
+    const size_t triangleCount = inoutIndices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    const std::vector<size_t> clusterBegins = BuildOverdrawClusters(inoutIndices, vertexView.vertexCount, threshold);
+    const size_t clusterCount = clusterBegins.size() - 1;
+
+    // 묶음마다 넓이 가중 중심과 법선을 구한다. 외적의 길이가 넓이의 두 배이므로 외적을 그대로 더하면 넓이 가중 법선이 된다.
+    std::vector<XMFLOAT3> clusterCentroids(clusterCount);
+    std::vector<XMFLOAT3> clusterNormals(clusterCount);
+    XMVECTOR meshCentroidSum = XMVectorZero();
+    float meshAreaSum = 0.0f;
+
+    for (size_t cluster = 0; cluster < clusterCount; ++cluster)
+    {
+        XMVECTOR centroidSum = XMVectorZero();
+        XMVECTOR normalSum = XMVectorZero();
+        float areaSum = 0.0f;
+
+        for (size_t triangle = clusterBegins[cluster]; triangle < clusterBegins[cluster + 1]; ++triangle)
+        {
+            const XMVECTOR p0 = XMLoadFloat3(&vertexView.positions[inoutIndices[triangle * 3]]);
+            const XMVECTOR p1 = XMLoadFloat3(&vertexView.positions[inoutIndices[triangle * 3 + 1]]);
+            const XMVECTOR p2 = XMLoadFloat3(&vertexView.positions[inoutIndices[triangle * 3 + 2]]);
+
+            // 시계 방향 앞면 기준이므로 외적은 닫힌 메시의 바깥쪽을 향한다.
+            const XMVECTOR cross = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+            const float area = XMVectorGetX(XMVector3Length(cross));
+
+            centroidSum = XMVectorAdd(centroidSum, XMVectorScale(XMVectorAdd(XMVectorAdd(p0, p1), p2), area / 3.0f));
+            normalSum = XMVectorAdd(normalSum, cross);
+            areaSum += area;
+        }
+
+        meshCentroidSum = XMVectorAdd(meshCentroidSum, centroidSum);
+        meshAreaSum += areaSum;
+
+        XMStoreFloat3(&clusterCentroids[cluster], areaSum > 0.0f ? XMVectorScale(centroidSum, 1.0f / areaSum) : XMVectorZero());
+
+        const float normalLength = XMVectorGetX(XMVector3Length(normalSum));
+        XMStoreFloat3(&clusterNormals[cluster], normalLength > 0.0f ? XMVectorScale(normalSum, 1.0f / normalLength) : XMVectorZero());
+    }
+
+    const XMVECTOR meshCentroid = meshAreaSum > 0.0f ? XMVectorScale(meshCentroidSum, 1.0f / meshAreaSum) : XMVectorZero();
+
+    // 중심에서 멀고 바깥을 향하는 묶음일수록 다른 면을 가릴 가능성이 크므로 먼저 그린다.
+    std::vector<float> sortKeys(clusterCount);
+    for (size_t cluster = 0; cluster < clusterCount; ++cluster)
+    {
+        const XMVECTOR offset = XMVectorSubtract(XMLoadFloat3(&clusterCentroids[cluster]), meshCentroid);
+        sortKeys[cluster] = XMVectorGetX(XMVector3Dot(offset, XMLoadFloat3(&clusterNormals[cluster])));
+    }
+
+    std::vector<size_t> clusterOrder(clusterCount);
+    std::iota(clusterOrder.begin(), clusterOrder.end(), size_t{0});
+    std::ranges::stable_sort(clusterOrder, [&sortKeys](size_t lhs, size_t rhs) { return sortKeys[lhs] > sortKeys[rhs]; });
+
+    const std::vector<UINT> inputIndices(inoutIndices.begin(), inoutIndices.end());
+    size_t outputIndex = 0;
+    for (const size_t cluster : clusterOrder)
+    {
+        const size_t beginIndex = clusterBegins[cluster] * 3;
+        const size_t endIndex = clusterBegins[cluster + 1] * 3;
+        std::copy(inputIndices.begin() + static_cast<ptrdiff_t>(beginIndex), inputIndices.begin() + static_cast<ptrdiff_t>(endIndex), inoutIndices.begin() + static_cast<ptrdiff_t>(outputIndex));
+        outputIndex += endIndex - beginIndex;
+    }
+}
+
+size_t MeshOptimizer::BuildVertexFetchRemap(std::span<UINT> inoutIndices, size_t vertexCount, std::vector<UINT>& outRemap)
+{
+    outRemap.assign(vertexCount, InvalidIndex);
+
+    UINT nextVertex = 0;
+    for (UINT& index : inoutIndices)
+    {
+        if (outRemap[index] == InvalidIndex)
+        {
+            outRemap[index] = nextVertex++;
+        }
+
+        index = outRemap[index];
+    }
+
+    return nextVertex;
+}
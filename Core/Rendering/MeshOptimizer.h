@@ -0,0 +1,105 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <span>
+#include <vector>
+
+#include "Core/Rendering/VertexView.h"
+
+// 1로 정의하면 앱이 메시를 불러올 때 최적화한 뒤의 ACMR을 출력한다. 오버드로 최적화를 쓰는 LitSkull과 MirrorDemo는 최적화 전후의 오버드로를,
+// LitSkull은 정점 양자화 오차도 함께 출력한다.
+// Analyze 함수들은 메시 전체를 다시 훑거나 그리므로 기본으로는 끄고, 수치가 필요할 때는 CoreTests 벤치마크를 쓴다.
+#ifndef MESH_LOAD_DIAGNOSTICS
+#define MESH_LOAD_DIAGNOSTICS 0
+#endif
+
+// GPU에 올리기 전에 인덱스/정점 순서를 바꿔 post-transform 정점 캐시, 오버드로, 정점 fetch 효율을 높인다.
+// 디바이스 없이 CPU에서만 동작하므로 GeometryGenerator::MeshData나 파일에서 읽은 모델 데이터에 모두 쓸 수 있다.
+namespace MeshOptimizer
+{
+    constexpr UINT InvalidIndex = 0xffffffffu;
+
+    struct VertexCacheStatistics
+    {
+        UINT transformedVertexCount = 0;
+
+        // 삼각형당 정점 셰이더 실행 횟수 (Average Cache Miss Ratio). 0.5 ~ 3.0
+        float acmr = 0.0f;
+
+        // 실제 사용된 정점당 정점 셰이더 실행 횟수 (Average Transformed Vertex Ratio). 1.0이 최적
+        float atvr = 0.0f;
+    };
+
+    // OptimizeOverdraw가 기본으로 허용하는 ACMR 증가 비율
+    constexpr float DefaultOverdrawThreshold = 1.05f;
+
+    struct OverdrawStatistics
+    {
+        // 모든 시점에서 최종적으로 덮인 픽셀 수
+        UINT coveredPixelCount = 0;
+
+        // 깊이 테스트를 통과해 픽셀 셰이더가 실행된 횟수
+        UINT shadedPixelCount = 0;
+
+        // 덮인 픽셀당 픽셀 셰이더 실행 횟수. 1.0이 최적
+        float overdraw = 0.0f;
+    };
+
+    // 크기가 cacheSize인 FIFO 캐시를 흉내 내 인덱스 순서의 캐시 효율을 측정한다.
+    [[nodiscard]]
+    VertexCacheStatistics AnalyzeVertexCache(std::span<const UINT> indices, size_t vertexCount, UINT cacheSize = 16);
+
+    // Tom Forsyth의 선형 시간 알고리즘으로 삼각형 순서를 바꿔 최근 사용된 정점을 다시 쓰는 삼각형이 먼저 그려지도록 한다.
+    void OptimizeVertexCache(std::span<UINT> inoutIndices, size_t vertexCount);
+
+    // 구 위에 고르게 놓인 viewDirectionCount개의 방향에서 메시 전체를 직교 투영으로 그려 오버드로를 측정한다.
+    // 뒷면을 제거하고 인덱스 순서대로 깊이 테스트하는 GPU 동작을 CPU에서 흉내 내므로 디바이스 없이 순서를 비교할 수 있다.
+    [[nodiscard]]
+    OverdrawStatistics AnalyzeOverdraw(std::span<const UINT> indices, const VertexView& vertexView, UINT viewDirectionCount = 16);
+
+    // 정점 캐시 최적화 후에 호출해 삼각형을 묶음으로 나누고, 바깥쪽을 향하는 묶음이 먼저 그려지도록 묶음 순서를 바꾼다. (Sander et al. 2007)
+    // 묶음은 ACMR이 원래 값의 threshold배를 넘지 않는 범위에서 잘게 나누므로 threshold가 클수록 오버드로가 줄고 캐시 효율은 떨어진다.
+    // 닫힌 메시를 바깥에서 볼 때 효과가 있으며, vertexView에는 위치가 있어야 한다.
+    void OptimizeOverdraw(std::span<UINT> inoutIndices, const VertexView& vertexView, float threshold = DefaultOverdrawThreshold);
+
+    // 정점을 인덱스에서 처음 사용되는 순서로 다시 배치하는 재배치 표(이전 인덱스 -> 새 인덱스)를 만들고 인덱스를 갱신한다.
+    // 사용되지 않는 정점은 InvalidIndex가 되며, 반환값은 사용된 정점 수이다.
+    size_t BuildVertexFetchRemap(std::span<UINT> inoutIndices, size_t vertexCount, std::vector<UINT>& outRemap);
+
+    // 정점 캐시 최적화 후에 호출해 정점 버퍼도 인덱스가 처음 사용하는 순서로 다시 배치한다. 사용되지 않는 정점은 제거된다.
+    template <typename VertexType>
+    void OptimizeVertexFetch(std::vector<VertexType>& inoutVertices, std::span<UINT> inoutIndices)
+    {
+        std::vector<UINT> remap;
+        const size_t usedVertexCount = BuildVertexFetchRemap(inoutIndices, inoutVertices.size(), remap);
+
+        std::vector<VertexType> vertices(usedVertexCount);
+        for (size_t i = 0; i < inoutVertices.size(); ++i)
+        {
+            if (remap[i] != InvalidIndex)
+            {
+                vertices[remap[i]] = inoutVertices[i];
+            }
+        }
+
+        inoutVertices = std::move(vertices);
+    }
+
+    // 정점 캐시, 정점 fetch 순서로 최적화한다.
+    template <typename VertexType>
+    void Optimize(std::vector<VertexType>& inoutVertices, std::span<UINT> inoutIndices)
+    {
+        OptimizeVertexCache(inoutIndices, inoutVertices.size());
+        OptimizeVertexFetch(inoutVertices, inoutIndices);
+    }
+
+    // 정점 캐시, 오버드로, 정점 fetch 순서로 최적화한다. position은 정점 구조체의 위치 멤버이다.
+    template <typename VertexType>
+    void Optimize(std::vector<VertexType>& inoutVertices, std::span<UINT> inoutIndices, DirectX::XMFLOAT3 VertexType::* position, float overdrawThreshold = DefaultOverdrawThreshold)
+    {
+        OptimizeVertexCache(inoutIndices, inoutVertices.size());
+        OptimizeOverdraw(inoutIndices, MakeVertexView(std::span<const VertexType>(inoutVertices), position), overdrawThreshold);
+        OptimizeVertexFetch(inoutVertices, inoutIndices);
+    }
+}
@@ -0,0 +1,571 @@
+#include "MeshSimplifier.h"
+
+#include "Rendering/MeshOptimizer.h"
+#include "Utilities/Parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+using namespace DirectX;
+
+namespace
+{
+    // 경계 간선에 수직인 평면의 가중치. 경계가 안쪽으로 말려 들어가지 않도록 면 평면보다 크게 준다.
+    constexpr double BorderPlaneWeight = 10.0;
+
+    // 평면까지 거리 제곱의 합 (p^T A p + 2 b^T p + c)과 누적 가중치(면적)
+    struct Quadric
+    {
+        static Quadric FromPlane(const XMFLOAT3& normal, double distance, double weight)
+        {
+            const double nx = normal.x;
+            const double ny = normal.y;
+            const double nz = normal.z;
+
+            Quadric quadric;
+            quadric.a00 = weight * nx * nx;
+            quadric.a11 = weight * ny * ny;
+            quadric.a22 = weight * nz * nz;
+            quadric.a01 = weight * nx * ny;
+            quadric.a02 = weight * nx * nz;
+            quadric.a12 = weight * ny * nz;
+            quadric.b0 = weight * nx * distance;
+            quadric.b1 = weight * ny * distance;
+            quadric.b2 = weight * nz * distance;
+            quadric.c = weight * distance * distance;
+            quadric.weight = weight;
+            return quadric;
+        }
+
+        Quadric& operator+=(const Quadric& other)
+        {
+            a00 += other.a00;
+            a11 += other.a11;
+            a22 += other.a22;
+            a01 += other.a01;
+            a02 += other.a02;
+            a12 += other.a12;
+            b0 += other.b0;
+            b1 += other.b1;
+            b2 += other.b2;
+            c += other.c;
+            weight += other.weight;
+            return *this;
+        }
+
+        // 가중치로 나눈 평균 거리 제곱
+        [[nodiscard]]
+        double GetError(const XMFLOAT3& position) const
+        {
+            const double x = position.x;
+            const double y = position.y;
+            const double z = position.z;
+
+            const double error = a00 * x * x + a11 * y * y + a22 * z * z
+                + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                + 2.0 * (b0 * x + b1 * y + b2 * z)
+                + c;
+
+            return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+        }
+
+        double a00 = 0.0, a11 = 0.0, a22 = 0.0;
+        double a01 = 0.0, a02 = 0.0, a12 = 0.0;
+        double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+        double c = 0.0;
+        double weight = 0.0;
+    };
+
+    enum class VertexKind : uint8_t
+    {
+        Interior,
+        Border,
+        Locked
+    };
+
+    // 정점 -> 그 정점을 쓰는 삼각형 목록 (CSR)
+    class TriangleAdjacency
+    {
+    public:
+        void Build(std::span<const UINT> indices, size_t vertexCount)
+        {
+            offsets.assign(vertexCount + 1, 0);
+            for (const UINT index : indices)
+            {
+                ++offsets[index + 1];
+            }
+
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                offsets[i + 1] += offsets[i];
+            }
+
+            triangles.resize(indices.size());
+            std::vector<UINT> writeOffsets(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i)
+            {
+                triangles[writeOffsets[indices[i]]++] = static_cast<UINT>(i / 3);
+            }
+        }
+
+        [[nodiscard]]
+        std::span<const UINT> GetTriangles(UINT vertex) const
+        {
+            return std::span<const UINT>(triangles).subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+        }
+
+    private:
+        std::vector<UINT> offsets;
+        std::vector<UINT> triangles;
+    };
+
+    // 모든 LOD 단계가 공유하는 원본 메시 정보
+    struct SimplifierInput
+    {
+        std::vector<XMFLOAT3> positions;
+        std::vector<XMFLOAT3> normals;
+        std::vector<XMFLOAT2> texCoords;
+        std::vector<VertexKind> vertexKinds;
+        std::vector<Quadric> quadrics;
+
+        // 바운딩 박스의 대각선 길이
+        float meshScale = 0.0f;
+    };
+
+    XMVECTOR GetTriangleNormal(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2)
+    {
+        const XMVECTOR v0 = XMLoadFloat3(&p0);
+        return XMVector3Cross(XMVectorSubtract(XMLoadFloat3(&p1), v0), XMVectorSubtract(XMLoadFloat3(&p2), v0));
+    }
+
+    SimplifierInput CreateSimplifierInput(const VertexView& vertexView, std::span<const UINT> indices, const MeshSimplifier::Options& options)
+    {
+        const size_t vertexCount = vertexView.vertexCount;
+
+        SimplifierInput input;
+        input.positions.resize(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            input.positions[i] = vertexView.positions[i];
+        }
+
+        if (vertexView.normals.IsValid() && options.normalWeight > 0.0f)
+        {
+            input.normals.resize(vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                input.normals[i] = vertexView.normals[i];
+            }
+        }
+
+        if (vertexView.texCoords.IsValid() && options.texCoordWeight > 0.0f)
+        {
+            input.texCoords.resize(vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                input.texCoords[i] = vertexView.texCoords[i];
+            }
+        }
+
+        XMVECTOR minPosition = XMVectorReplicate(FLT_MAX);
+        XMVECTOR maxPosition = XMVectorReplicate(-FLT_MAX);
+        for (const UINT index : indices)
+        {
+            const XMVECTOR position = XMLoadFloat3(&input.positions[index]);
+            minPosition = XMVectorMin(minPosition, position);
+            maxPosition = XMVectorMax(maxPosition, position);
+        }
+        input.meshScale = indices.empty() ? 0.0f : XMVectorGetX(XMVector3Length(XMVectorSubtract(maxPosition, minPosition)));
+
+        input.vertexKinds.assign(vertexCount, VertexKind::Interior);
+
+        // 위치가 같은 정점이 여럿이면 속성이 갈라지는 이음매이다. 한쪽만 접으면 틈이 생기므로 고정한다.
+        {
+            struct PositionHash
+            {
+                size_t operator()(const std::array<uint32_t, 3>& key) const
+                {
+                    return (static_cast<size_t>(key[0]) * 73856093u) ^ (static_cast<size_t>(key[1]) * 19349663u) ^ (static_cast<size_t>(key[2]) * 83492791u);
+                }
+            };
+
+            std::unordered_map<std::array<uint32_t, 3>, UINT, PositionHash> firstVertexByPosition;
+            firstVertexByPosition.reserve(vertexCount);
+            for (const UINT index : indices)
+            {
+                std::array<uint32_t, 3> key;
+                std::memcpy(key.data(), &input.positions[index], sizeof(key));
+
+                const auto [it, isInserted] = firstVertexByPosition.try_emplace(key, index);
+                if (!isInserted && it->second != index)
+                {
+                    input.vertexKinds[index] = VertexKind::Locked;
+                    input.vertexKinds[it->second] = VertexKind::Locked;
+                }
+            }
+        }
+
+        input.quadrics.resize(vertexCount);
+
+        // 각 삼각형의 평면을 면적 가중치로 세 정점에 누적한다.
+        const size_t triangleCount = indices.size() / 3;
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            const UINT i0 = indices[i * 3 + 0];
+            const UINT i1 = indices[i * 3 + 1];
+            const UINT i2 = indices[i * 3 + 2];
+
+            const XMVECTOR normal = GetTriangleNormal(input.positions[i0], input.positions[i1], input.positions[i2]);
+            const float doubleArea = XMVectorGetX(XMVector3Length(normal));
+            if (doubleArea <= 0.0f)
+            {
+                continue;
+            }
+
+            XMFLOAT3 unitNormal;
+            XMStoreFloat3(&unitNormal, XMVectorScale(normal, 1.0f / doubleArea));
+            const double distance = -XMVectorGetX(XMVector3Dot(XMLoadFloat3(&unitNormal), XMLoadFloat3(&input.positions[i0])));
+
+            const Quadric quadric = Quadric::FromPlane(unitNormal, distance, 0.5 * doubleArea);
+            input.quadrics[i0] += quadric;
+            input.quadrics[i1] += quadric;
+            input.quadrics[i2] += quadric;
+        }
+
+        // 경계와 비다양체 간선을 찾는다. 정점 v에서 나가는 간선 v -> x에 대해 들어오는 간선 x -> v가 없으면 경계이다.
+        TriangleAdjacency adjacency;
+        adjacency.Build(indices, vertexCount);
+
+        std::vector<UINT> outgoing;
+        std::vector<UINT> incoming;
+        for (UINT vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            const std::span<const UINT> triangles = adjacency.GetTriangles(vertex);
+
+            outgoing.clear();
+            incoming.clear();
+            for (const UINT triangle : triangles)
+            {
+                const UINT* corners = &indices[triangle * 3];
+                const size_t corner = corners[0] == vertex ? 0 : (corners[1] == vertex ? 1 : 2);
+                outgoing.push_back(corners[(corner + 1) % 3]);
+                incoming.push_back(corners[(corner + 2) % 3]);
+            }
+
+            for (size_t i = 0; i < outgoing.size(); ++i)
+            {
+                const UINT next = outgoing[i];
+
+                // 같은 방향 간선이 두 번 나오면 세 개 이상의 삼각형이 공유하거나 감긴 방향이 뒤집힌 간선이다.
+                if (std::count(outgoing.begin(), outgoing.end(), next) > 1 || std::count(incoming.begin(), incoming.end(), incoming[i]) > 1)
+                {
+                    input.vertexKinds[vertex] = VertexKind::Locked;
+                }
+
+                if (std::find(incoming.begin(), incoming.end(), next) != incoming.end())
+                {
+                    continue;
+                }
+
+                // 경계 간선 vertex -> next. 양 끝 정점이 경계 바깥이나 안쪽으로 움직이지 않도록 간선에 수직인 평면을 더한다.
+                for (const UINT endpoint : {vertex, next})
+                {
+                    if (input.vertexKinds[endpoint] == VertexKind::Interior)
+                    {
+                        input.vertexKinds[endpoint] = options.lockBorder ? VertexKind::Locked : VertexKind::Border;
+                    }
+                }
+
+                const UINT* corners = &indices[triangles[i] * 3];
+                const XMVECTOR faceNormal = XMVector3Normalize(GetTriangleNormal(input.positions[corners[0]], input.positions[corners[1]], input.positions[corners[2]]));
+                const XMVECTOR p0 = XMLoadFloat3(&input.positions[vertex]);
+                const XMVECTOR edge = XMVectorSubtract(XMLoadFloat3(&input.positions[next]), p0);
+                const XMVECTOR edgeNormal = XMVector3Normalize(XMVector3Cross(edge, faceNormal));
+
+                XMFLOAT3 planeNormal;
+                XMStoreFloat3(&planeNormal, edgeNormal);
+                const double distance = -XMVectorGetX(XMVector3Dot(edgeNormal, p0));
+                const double weight = XMVectorGetX(XMVector3LengthSq(edge)) * BorderPlaneWeight;
+
+                const Quadric quadric = Quadric::FromPlane(planeNormal, distance, weight);
+                input.quadrics[vertex] += quadric;
+                input.quadrics[next] += quadric;
+            }
+        }
+
+        return input;
+    }
+
+    struct Collapse
+    {
+        double cost;
+        double positionError;
+        UINT vertex;
+        UINT target;
+        UINT removedTriangleCount;
+    };
+
+    // 정점 주변 삼각형에 쓰인 다른 정점들(1-ring)을 모은다.
+    void GatherRing(std::span<const UINT> indices, std::span<const UINT> triangles, UINT vertex, std::vector<UINT>& outRing)
+    {
+        outRing.clear();
+        for (const UINT triangle : triangles)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const UINT corner = indices[triangle * 3 + k];
+                if (corner != vertex && std::find(outRing.begin(), outRing.end(), corner) == outRing.end())
+                {
+                    outRing.push_back(corner);
+                }
+            }
+        }
+    }
+
+    // vertex를 target으로 옮겼을 때 뒤집히는 삼각형이 있는지 검사한다.
+    bool HasTriangleFlip(const SimplifierInput& input, std::span<const UINT> indices, std::span<const UINT> triangles, UINT vertex, UINT target)
+    {
+        for (const UINT triangle : triangles)
+        {
+            const UINT* corners = &indices[triangle * 3];
+            if (corners[0] == target || corners[1] == target || corners[2] == target)
+            {
+                continue;
+            }
+
+            std::array<XMFLOAT3, 3> positions = {input.positions[corners[0]], input.positions[corners[1]], input.positions[corners[2]]};
+            const XMVECTOR oldNormal = GetTriangleNormal(positions[0], positions[1], positions[2]);
+
+            for (size_t k = 0; k < 3; ++k)
+            {
+                if (corners[k] == vertex)
+                {
+                    positions[k] = input.positions[target];
+                }
+            }
+            const XMVECTOR newNormal = GetTriangleNormal(positions[0], positions[1], positions[2]);
+
+            if (XMVectorGetX(XMVector3Dot(oldNormal, newNormal)) <= 0.0f)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    double GetAttributeError(const SimplifierInput& input, UINT vertex, UINT target, const MeshSimplifier::Options& options)
+    {
+        if (input.normals.empty() && input.texCoords.empty())
+        {
+            return 0.0;
+        }
+
+        double attributeError = 0.0;
+        if (!input.normals.empty())
+        {
+            const float normalDistanceSquared = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&input.normals[vertex]), XMLoadFloat3(&input.normals[target]))));
+            attributeError += options.normalWeight * normalDistanceSquared;
+        }
+        if (!input.texCoords.empty())
+        {
+            const float texCoordDistanceSquared = XMVectorGetX(XMVector2LengthSq(XMVectorSubtract(XMLoadFloat2(&input.texCoords[vertex]), XMLoadFloat2(&input.texCoords[target]))));
+            attributeError += options.texCoordWeight * texCoordDistanceSquared;
+        }
+
+        const float moveDistanceSquared = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&input.positions[vertex]), XMLoadFloat3(&input.positions[target]))));
+        return attributeError * moveDistanceSquared;
+    }
+
+    MeshSimplifier::LodLevel SimplifyLevel(const SimplifierInput& input, std::span<const UINT> indices, size_t targetIndexCount, const MeshSimplifier::Options& options)
+    {
+        MeshSimplifier::LodLevel lodLevel;
+        lodLevel.indices.assign(indices.begin(), indices.end());
+
+        const size_t vertexCount = input.positions.size();
+        const size_t targetTriangleCount = targetIndexCount / 3;
+        const double maxErrorSquared = static_cast<double>(options.maxError) * options.maxError * input.meshScale * input.meshScale;
+
+        std::vector<Quadric> quadrics = input.quadrics;
+        double maxPositionError = 0.0;
+
+        TriangleAdjacency adjacency;
+        std::vector<Collapse> collapses;
+        std::vector<UINT> remap(vertexCount);
+        std::vector<bool> isLockedInPass(vertexCount);
+        std::vector<UINT> ring;
+        std::vector<UINT> targetRing;
+
+        // 한 번에 하나씩 접는 대신, 매 패스마다 모든 정점의 최선의 간선을 구해 비용 순으로 서로 겹치지 않는 것들을 한꺼번에 접는다.
+        while (lodLevel.indices.size() / 3 > targetTriangleCount)
+        {
+            const std::span<const UINT> currentIndices = lodLevel.indices;
+            adjacency.Build(currentIndices, vertexCount);
+
+            collapses.clear();
+            for (UINT vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                const VertexKind kind = input.vertexKinds[vertex];
+                const std::span<const UINT> triangles = adjacency.GetTriangles(vertex);
+                if (kind == VertexKind::Locked || triangles.empty())
+                {
+                    continue;
+                }
+
+                GatherRing(currentIndices, triangles, vertex, ring);
+
+                Collapse bestCollapse{DBL_MAX, 0.0, vertex, vertex, 0};
+                for (const UINT target : ring)
+                {
+                    // 간선을 공유하는 삼각형이 하나뿐이면 경계 간선이다. 경계 정점은 경계를 따라서만 움직인다.
+                    const UINT sharedTriangleCount = static_cast<UINT>(std::ranges::count_if(triangles, [&](UINT triangle)
+                    {
+                        const UINT* corners = &currentIndices[triangle * 3];
+                        return corners[0] == target || corners[1] == target || corners[2] == target;
+                    }));
+                    const bool isBorderEdge = sharedTriangleCount == 1;
+                    if (kind == VertexKind::Border && !isBorderEdge)
+                    {
+                        continue;
+                    }
+
+                    Quadric quadric = quadrics[vertex];
+                    quadric += quadrics[target];
+                    const double positionError = quadric.GetError(input.positions[target]);
+                    const double cost = positionError + GetAttributeError(input, vertex, target, options);
+                    if (cost >= bestCollapse.cost)
+                    {
+                        continue;
+                    }
+
+                    // 두 정점의 공통 이웃이 간선을 공유하는 삼각형의 나머지 정점뿐이어야 접은 뒤에도 다양체가 유지된다.
+                    GatherRing(currentIndices, adjacency.GetTriangles(target), target, targetRing);
+                    const size_t commonNeighborCount = std::ranges::count_if(ring, [&](UINT neighbor)
+                    {
+                        return std::find(targetRing.begin(), targetRing.end(), neighbor) != targetRing.end();
+                    });
+                    if (commonNeighborCount > sharedTriangleCount)
+                    {
+                        continue;
+                    }
+
+                    if (HasTriangleFlip(input, currentIndices, triangles, vertex, target))
+                    {
+                        continue;
+                    }
+
+                    bestCollapse = {cost, positionError, vertex, target, sharedTriangleCount};
+                }
+
+                if (bestCollapse.target != vertex)
+                {
+                    collapses.push_back(bestCollapse);
+                }
+            }
+
+            std::ranges::sort(collapses, [](const Collapse& lhs, const Collapse& rhs)
+            {
+                return lhs.cost != rhs.cost ? lhs.cost < rhs.cost : lhs.vertex < rhs.vertex;
+            });
+
+            for (UINT i = 0; i < vertexCount; ++i)
+            {
+                remap[i] = i;
+            }
+            std::fill(isLockedInPass.begin(), isLockedInPass.end(), false);
+
+            size_t triangleCount = currentIndices.size() / 3;
+            if (collapses.empty())
+            {
+                break;
+            }
+
+            // 간선 하나를 접으면 보통 삼각형 두 개가 없어지므로 목표까지 필요한 만큼의 저렴한 간선만 이번 패스에 접는다.
+            // 겹쳐서 건너뛴 간선은 다음 패스에서 다시 고려되므로 비싼 간선이 싼 간선보다 먼저 접히지 않는다.
+            const size_t requiredCollapseCount = std::max<size_t>((triangleCount - targetTriangleCount + 1) / 2, 1);
+            const double passCostLimit = collapses[std::min(requiredCollapseCount, collapses.size()) - 1].cost;
+
+            size_t collapseCount = 0;
+            for (const Collapse& collapse : collapses)
+            {
+                if (triangleCount <= targetTriangleCount || collapse.cost > passCostLimit || collapse.positionError > maxErrorSquared)
+                {
+                    break;
+                }
+
+                if (isLockedInPass[collapse.vertex] || isLockedInPass[collapse.target])
+                {
+                    continue;
+                }
+
+                remap[collapse.vertex] = collapse.target;
+                quadrics[collapse.target] += quadrics[collapse.vertex];
+                maxPositionError = std::max(maxPositionError, collapse.positionError);
+                triangleCount -= collapse.removedTriangleCount;
+                ++collapseCount;
+
+                // 주변 삼각형이 바뀌므로 같은 패스에서 1-ring의 정점은 더 이상 접지 않는다.
+                for (const UINT triangle : adjacency.GetTriangles(collapse.vertex))
+                {
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        isLockedInPass[currentIndices[triangle * 3 + k]] = true;
+                    }
+                }
+            }
+
+            if (collapseCount == 0)
+            {
+                break;
+            }
+
+            // 접힌 정점을 대상 정점으로 바꾸고 넓이가 없어진 삼각형을 제거한다.
+            size_t writeIndex = 0;
+            for (size_t i = 0; i < lodLevel.indices.size(); i += 3)
+            {
+                const UINT i0 = remap[lodLevel.indices[i + 0]];
+                const UINT i1 = remap[lodLevel.indices[i + 1]];
+                const UINT i2 = remap[lodLevel.indices[i + 2]];
+                if (i0 == i1 || i1 == i2 || i0 == i2)
+                {
+                    continue;
+                }
+
+                lodLevel.indices[writeIndex++] = i0;
+                lodLevel.indices[writeIndex++] = i1;
+                lodLevel.indices[writeIndex++] = i2;
+            }
+            lodLevel.indices.resize(writeIndex);
+        }
+
+        lodLevel.error = static_cast<float>(std::sqrt(maxPositionError));
+        return lodLevel;
+    }
+}
+
+MeshSimplifier::LodLevel MeshSimplifier::Simplify(const VertexView& vertexView, std::span<const UINT> indices, size_t targetIndexCount, const Options& options)
+{
+    const SimplifierInput input = CreateSimplifierInput(vertexView, indices, options);
+    return SimplifyLevel(input, indices, targetIndexCount, options);
+}
+
+std::vector<MeshSimplifier::LodLevel> MeshSimplifier::BuildLodChain(const VertexView& vertexView, std::span<const UINT> indices, std::span<const float> triangleRatios, const Options& options)
+{
+    const SimplifierInput input = CreateSimplifierInput(vertexView, indices, options);
+
+    std::vector<LodLevel> lodLevels(triangleRatios.size());
+    Parallel::For(0, triangleRatios.size(), 1, [&](size_t level)
+    {
+        const size_t targetTriangleCount = static_cast<size_t>(static_cast<float>(indices.size() / 3) * std::clamp(triangleRatios[level], 0.0f, 1.0f));
+
+        lodLevels[level] = SimplifyLevel(input, indices, targetTriangleCount * 3, options);
+        MeshOptimizer::OptimizeVertexCache(lodLevels[level].indices, vertexView.vertexCount);
+    });
+
+    return lodLevels;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <span>
+#include <vector>
+
+#include "Core/Rendering/VertexView.h"
+
+// 2차 오차 척도(Quadric Error Metric)로 간선을 접어 삼각형 수를 줄인다.
+// 정점은 항상 기존 정점 중 하나로 합쳐지므로 단순화된 메시는 원본 정점 버퍼를 그대로 공유하고 인덱스만 새로 만든다.
+// 디바이스 없이 CPU에서만 동작한다.
+namespace MeshSimplifier
+{
+    struct Options
+    {
+        // 속성 오차의 가중치. 속성 차이의 제곱에 정점이 움직인 거리의 제곱을 곱해 위치 오차와 같은 단위로 더한다.
+        float normalWeight = 1.0f;
+        float texCoordWeight = 1.0f;
+
+        // 메시 대각선 길이에 대한 비율. 오차가 이보다 큰 간선은 접지 않으므로 목표 삼각형 수에 도달하지 못할 수 있다.
+        float maxError = 1.0f;
+
+        // 열린 경계(삼각형 하나에만 속한 변)의 정점을 고정한다. false여도 경계 정점은 경계를 따라서만 접힌다.
+        bool lockBorder = false;
+    };
+
+    struct LodLevel
+    {
+        std::vector<UINT> indices;
+
+        // 원본 표면에서 벗어난 거리의 추정치(원본 좌표 단위). 화면에서의 오차로 LOD를 고를 때 사용한다.
+        float error = 0.0f;
+    };
+
+    // 인덱스 수가 targetIndexCount 이하가 될 때까지 단순화한다.
+    // 같은 위치에 속성만 다른 정점이 여럿 있는 이음매(seam)와 비다양체 간선에 닿은 정점은 구멍이 생기지 않도록 고정한다.
+    [[nodiscard]]
+    LodLevel Simplify(const VertexView& vertexView, std::span<const UINT> indices, size_t targetIndexCount, const Options& options = {});
+
+    // 원본 삼각형 수에 대한 비율(예: 0.5, 0.25, 0.1)마다 LOD를 만든다.
+    // 각 단계는 원본에서 독립적으로 단순화하므로 단계별로 병렬 생성하며, 결과 인덱스는 정점 캐시 순서로 최적화되어 있다.
+    [[nodiscard]]
+    std::vector<LodLevel> BuildLodChain(const VertexView& vertexView, std::span<const UINT> indices, std::span<const float> triangleRatios, const Options& options = {});
+}
@@ -0,0 +1,246 @@
+#include "MeshWelder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Utilities/Parallel.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // 한 작업 구간에 들어가는 최소 삼각형/정점 수. 너무 잘게 나누면 동기화 비용이 계산보다 커진다.
+    constexpr size_t MinTriangleRangeSize = 1024;
+    constexpr size_t MinVertexRangeSize = 2048;
+
+    constexpr UINT InvalidIndex = 0xffffffffu;
+
+    // 격자 좌표 세 개를 21비트씩 묶는다. 멀리 떨어진 칸이 같은 키가 되어도 실제 위치를 다시 비교하므로 결과는 같다.
+    uint64_t MakeCellKey(int64_t x, int64_t y, int64_t z)
+    {
+        constexpr uint64_t mask = (1ull << 21) - 1;
+        return (static_cast<uint64_t>(x) & mask) | ((static_cast<uint64_t>(y) & mask) << 21) | ((static_cast<uint64_t>(z) & mask) << 42);
+    }
+
+    // 삼각형의 단위 법선에 세 모서리 각도를 곱한 값. 세 각도는 XMVectorACos 한 번으로 함께 구한다.
+    void ComputeCornerNormals(const VertexView& vertexView, std::span<const UINT> indices, size_t triangle, std::span<XMFLOAT3> outCorners)
+    {
+        const XMVECTOR p0 = XMLoadFloat3(&vertexView.positions[indices[triangle * 3]]);
+        const XMVECTOR p1 = XMLoadFloat3(&vertexView.positions[indices[triangle * 3 + 1]]);
+        const XMVECTOR p2 = XMLoadFloat3(&vertexView.positions[indices[triangle * 3 + 2]]);
+
+        const XMVECTOR edge01 = XMVectorSubtract(p1, p0);
+        const XMVECTOR edge12 = XMVectorSubtract(p2, p1);
+        const XMVECTOR edge20 = XMVectorSubtract(p0, p2);
+
+        // 시계 방향이 앞면이므로 cross(p1 - p0, p2 - p0)가 바깥쪽이다. 넓이가 0이면 기여하지 않는다.
+        const XMVECTOR cross = XMVector3Cross(edge01, XMVectorNegate(edge20));
+        if (XMVectorGetX(XMVector3LengthSq(cross)) <= 1.0e-30f)
+        {
+            std::fill(outCorners.begin(), outCorners.end(), XMFLOAT3());
+            return;
+        }
+
+        const XMVECTOR faceNormal = XMVector3Normalize(cross);
+        const XMVECTOR direction01 = XMVector3Normalize(edge01);
+        const XMVECTOR direction12 = XMVector3Normalize(edge12);
+        const XMVECTOR direction20 = XMVector3Normalize(edge20);
+
+        // 모서리 k의 각도는 k에서 나가는 변과 k로 들어오는 변을 뒤집은 방향 사이의 각도이다.
+        const XMVECTOR dots = XMVectorSet(-XMVectorGetX(XMVector3Dot(direction01, direction20)),
+                                          -XMVectorGetX(XMVector3Dot(direction12, direction01)),
+                                          -XMVectorGetX(XMVector3Dot(direction20, direction12)), 0.0f);
+        const XMVECTOR angles = XMVectorACos(XMVectorClamp(dots, XMVectorNegate(XMVectorSplatOne()), XMVectorSplatOne()));
+
+        XMStoreFloat3(&outCorners[0], XMVectorMultiply(faceNormal, XMVectorSplatX(angles)));
+        XMStoreFloat3(&outCorners[1], XMVectorMultiply(faceNormal, XMVectorSplatY(angles)));
+        XMStoreFloat3(&outCorners[2], XMVectorMultiply(faceNormal, XMVectorSplatZ(angles)));
+    }
+}
+
+size_t MeshWelder::BuildWeldRemap(const VertexView& vertexView, const WeldSettings& settings, std::vector<UINT>& outRemap)
+{
+    const size_t vertexCount = vertexView.vertexCount;
+    outRemap.assign(vertexCount, InvalidIndex);
+    if (vertexCount == 0 || !vertexView.positions.IsValid())
+    {
+        return 0;
+    }
+
+    // 칸의 크기를 허용 오차의 두 배로 잡으면 허용 오차 안의 정점은 축마다 많아야 두 칸, 모두 여덟 칸 안에 있다.
+    const float tolerance = std::max(settings.positionTolerance, 0.0f);
+    const float cellSize = tolerance > 0.0f ? 2.0f * tolerance : 1.0f;
+    const float invCellSize = 1.0f / cellSize;
+    const float minNormalDot = std::cos(settings.normalAngleTolerance);
+    const bool compareNormals = vertexView.normals.IsValid();
+    const bool compareTexCoords = vertexView.texCoords.IsValid();
+
+    // 칸마다 대표 정점을 연결 리스트로 잇는다.
+    std::unordered_map<uint64_t, UINT> cellHeads;
+    cellHeads.reserve(vertexCount);
+    std::vector<UINT> representatives;
+    std::vector<UINT> nextInCell;
+    representatives.reserve(vertexCount);
+    nextInCell.reserve(vertexCount);
+
+    const auto isSameVertex = [&](UINT a, UINT b)
+    {
+        const XMFLOAT3& positionA = vertexView.positions[a];
+        const XMFLOAT3& positionB = vertexView.positions[b];
+        if (std::abs(positionA.x - positionB.x) > tolerance || std::abs(positionA.y - positionB.y) > tolerance || std::abs(positionA.z - positionB.z) > tolerance)
+        {
+            return false;
+        }
+
+        if (compareNormals)
+        {
+            const XMVECTOR normalA = XMVector3Normalize(XMLoadFloat3(&vertexView.normals[a]));
+            const XMVECTOR normalB = XMVector3Normalize(XMLoadFloat3(&vertexView.normals[b]));
+            if (XMVectorGetX(XMVector3Dot(normalA, normalB)) < minNormalDot)
+            {
+                return false;
+            }
+        }
+
+        if (compareTexCoords)
+        {
+            const XMFLOAT2& texCoordA = vertexView.texCoords[a];
+            const XMFLOAT2& texCoordB = vertexView.texCoords[b];
+            if (std::abs(texCoordA.x - texCoordB.x) > settings.texCoordTolerance || std::abs(texCoordA.y - texCoordB.y) > settings.texCoordTolerance)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        const XMFLOAT3& position = vertexView.positions[vertex];
+        const int64_t minimumX = static_cast<int64_t>(std::floor((position.x - tolerance) * invCellSize));
+        const int64_t minimumY = static_cast<int64_t>(std::floor((position.y - tolerance) * invCellSize));
+        const int64_t minimumZ = static_cast<int64_t>(std::floor((position.z - tolerance) * invCellSize));
+        const int64_t maximumX = static_cast<int64_t>(std::floor((position.x + tolerance) * invCellSize));
+        const int64_t maximumY = static_cast<int64_t>(std::floor((position.y + tolerance) * invCellSize));
+        const int64_t maximumZ = static_cast<int64_t>(std::floor((position.z + tolerance) * invCellSize));
+
+        // 여러 대표 정점과 맞으면 가장 먼저 나온 정점을 골라 칸을 도는 순서와 무관하게 한다.
+        UINT match = InvalidIndex;
+        for (int64_t z = minimumZ; z <= maximumZ; ++z)
+        {
+            for (int64_t y = minimumY; y <= maximumY; ++y)
+            {
+                for (int64_t x = minimumX; x <= maximumX; ++x)
+                {
+                    const auto cell = cellHeads.find(MakeCellKey(x, y, z));
+                    if (cell == cellHeads.end())
+                    {
+                        continue;
+                    }
+
+                    for (UINT candidate = cell->second; candidate != InvalidIndex; candidate = nextInCell[candidate])
+                    {
+                        if (candidate < match && isSameVertex(representatives[candidate], static_cast<UINT>(vertex)))
+                        {
+                            match = candidate;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (match != InvalidIndex)
+        {
+            outRemap[vertex] = match;
+            continue;
+        }
+
+        const UINT newVertex = static_cast<UINT>(representatives.size());
+        const uint64_t key = MakeCellKey(static_cast<int64_t>(std::floor(position.x * invCellSize)), static_cast<int64_t>(std::floor(position.y * invCellSize)),
+                                         static_cast<int64_t>(std::floor(position.z * invCellSize)));
+        const auto [cell, isInserted] = cellHeads.try_emplace(key, newVertex);
+        nextInCell.push_back(isInserted ? InvalidIndex : cell->second);
+        cell->second = newVertex;
+
+        representatives.push_back(static_cast<UINT>(vertex));
+        outRemap[vertex] = newVertex;
+    }
+
+    return representatives.size();
+}
+
+size_t MeshWelder::RemapIndices(std::vector<UINT>& inoutIndices, std::span<const UINT> remap)
+{
+    size_t writeIndex = 0;
+    for (size_t i = 0; i + 2 < inoutIndices.size(); i += 3)
+    {
+        const UINT a = remap[inoutIndices[i]];
+        const UINT b = remap[inoutIndices[i + 1]];
+        const UINT c = remap[inoutIndices[i + 2]];
+        if (a == b || b == c || c == a)
+        {
+            continue;
+        }
+
+        inoutIndices[writeIndex++] = a;
+        inoutIndices[writeIndex++] = b;
+        inoutIndices[writeIndex++] = c;
+    }
+
+    const size_t removedTriangleCount = (inoutIndices.size() - writeIndex) / 3;
+    inoutIndices.resize(writeIndex);
+    return removedTriangleCount;
+}
+
+void MeshWelder::ComputeAngleWeightedNormals(const VertexView& vertexView, std::span<const UINT> indices, std::span<XMFLOAT3> outNormals)
+{
+    const size_t vertexCount = std::min(vertexView.vertexCount, outNormals.size());
+    const size_t triangleCount = indices.size() / 3;
+    if (vertexCount == 0 || !vertexView.positions.IsValid())
+    {
+        return;
+    }
+
+    // 1. 삼각형마다 세 모서리의 기여분을 계산한다. 각 삼각형은 자기 모서리에만 쓰므로 병렬로 실행해도 겹치지 않는다.
+    std::vector<XMFLOAT3> cornerNormals(triangleCount * 3);
+    Parallel::For(0, triangleCount, MinTriangleRangeSize, [&](size_t triangle)
+    {
+        ComputeCornerNormals(vertexView, indices, triangle, std::span(cornerNormals).subspan(triangle * 3, 3));
+    });
+
+    // 2. 정점마다 자신을 쓰는 모서리 목록을 모서리 번호 순으로 만든다. (CSR)
+    std::vector<UINT> cornerOffsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        ++cornerOffsets[indices[i] + 1];
+    }
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        cornerOffsets[i + 1] += cornerOffsets[i];
+    }
+
+    std::vector<UINT> vertexCorners(triangleCount * 3);
+    {
+        std::vector<UINT> writeOffsets(cornerOffsets.begin(), cornerOffsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            vertexCorners[writeOffsets[indices[i]]++] = static_cast<UINT>(i);
+        }
+    }
+
+    // 3. 정점마다 정해진 순서대로 누적하고 정규화한다.
+    Parallel::For(0, vertexCount, MinVertexRangeSize, [&](size_t vertex)
+    {
+        XMVECTOR sum = XMVectorZero();
+        for (UINT i = cornerOffsets[vertex]; i < cornerOffsets[vertex + 1]; ++i)
+        {
+            sum = XMVectorAdd(sum, XMLoadFloat3(&cornerNormals[vertexCorners[i]]));
+        }
+
+        const XMVECTOR normal = XMVectorGetX(XMVector3LengthSq(sum)) > 1.0e-30f ? XMVector3Normalize(sum) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+        XMStoreFloat3(&outNormals[vertex], normal);
+    });
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <span>
+#include <vector>
+
+#include "Core/Rendering/VertexView.h"
+
+// 파일에서 읽은 메시처럼 같은 위치의 정점이 여러 번 저장된 경우 허용 오차 안의 정점을 공간 해시로 찾아 하나로 합친다.
+// 합친 뒤 법선을 다시 만들 수 있도록 모서리 각도로 가중한 정점 법선 계산도 함께 제공한다.
+namespace MeshWelder
+{
+    struct WeldSettings
+    {
+        // 위치의 각 성분 차이가 모두 이 값 이하여야 같은 정점으로 본다.
+        float positionTolerance = 1.0e-5f;
+
+        // vertexView에 법선이 있으면 두 법선 사이 각도(라디안)가 이 값 이하여야 합친다. 날카로운 모서리의 법선을 지킨다.
+        float normalAngleTolerance = DirectX::XMConvertToRadians(1.0f);
+
+        // vertexView에 텍스처 좌표가 있으면 각 성분 차이가 이 값 이하여야 합친다. UV 이음매를 지킨다.
+        float texCoordTolerance = 1.0e-5f;
+    };
+
+    struct WeldStatistics
+    {
+        size_t sourceVertexCount = 0;
+        size_t weldedVertexCount = 0;
+
+        // 합친 뒤 두 꼭짓점 이상이 같은 정점이 되어 지운 삼각형 수
+        size_t removedTriangleCount = 0;
+    };
+
+    // 정점마다 합쳐질 새 정점 번호를 담은 재배치 표(이전 인덱스 -> 새 인덱스)를 만든다. 반환값은 새 정점 수이다.
+    // 새 정점은 처음 나온 원본 정점 순서대로 번호를 매기므로 결과가 항상 같다.
+    size_t BuildWeldRemap(const VertexView& vertexView, const WeldSettings& settings, std::vector<UINT>& outRemap);
+
+    // 재배치 표로 인덱스를 고치고 퇴화한 삼각형을 지운다. 반환값은 지운 삼각형 수이다.
+    size_t RemapIndices(std::vector<UINT>& inoutIndices, std::span<const UINT> remap);
+
+    // 각 정점에 닿는 삼각형의 단위 법선을 그 모서리의 각도로 가중 평균한다. (Thürmer and Wüthrich 1998)
+    // 삼각형과 정점 단위로 나눠 병렬로 계산하며 누적 순서가 항상 같으므로 스레드 수와 무관하게 같은 결과가 나온다.
+    // 어떤 삼각형에도 쓰이지 않는 정점은 +y 방향이 된다.
+    void ComputeAngleWeightedNormals(const VertexView& vertexView, std::span<const UINT> indices, std::span<DirectX::XMFLOAT3> outNormals);
+
+    // 정점 벡터에 바로 적용한다. normal이 nullptr이면 위치만 비교한다.
+    template <typename VertexType>
+    WeldStatistics Weld(std::vector<VertexType>& inoutVertices, std::vector<UINT>& inoutIndices, DirectX::XMFLOAT3 VertexType::* position,
+                        DirectX::XMFLOAT3 VertexType::* normal = nullptr, const WeldSettings& settings = {})
+    {
+        WeldStatistics statistics;
+        statistics.sourceVertexCount = inoutVertices.size();
+
+        std::vector<UINT> remap;
+        statistics.weldedVertexCount = BuildWeldRemap(MakeVertexView(std::span<const VertexType>(inoutVertices), position, normal), settings, remap);
+
+        // 새 번호는 처음 나온 순서로 매기므로 항상 remap[i] <= i이다. 앞에서부터 옮겨도 아직 읽지 않은 정점을 덮어쓰지 않는다.
+        UINT nextVertex = 0;
+        for (size_t i = 0; i < inoutVertices.size(); ++i)
+        {
+            if (remap[i] == nextVertex)
+            {
+                inoutVertices[nextVertex++] = inoutVertices[i];
+            }
+        }
+
+        inoutVertices.resize(statistics.weldedVertexCount);
+        statistics.removedTriangleCount = RemapIndices(inoutIndices, remap);
+        return statistics;
+    }
+
+    // 위치와 인덱스로 normal 멤버를 다시 만든다.
+    template <typename VertexType>
+    void RecomputeNormals(std::vector<VertexType>& inoutVertices, std::span<const UINT> indices, DirectX::XMFLOAT3 VertexType::* position, DirectX::XMFLOAT3 VertexType::* normal)
+    {
+        std::vector<DirectX::XMFLOAT3> normals(inoutVertices.size());
+        ComputeAngleWeightedNormals(MakeVertexView(std::span<const VertexType>(inoutVertices), position), indices, normals);
+
+        for (size_t i = 0; i < inoutVertices.size(); ++i)
+        {
+            inoutVertices[i].*normal = normals[i];
+        }
+    }
+}
@@ -0,0 +1,344 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr uint8_t InvalidLocalIndex = 0xff;
+
+    MeshletBuilder::MeshletBounds ComputeBounds(const MeshletBuilder::MeshletData& meshletData, const MeshletBuilder::Meshlet& meshlet,
+                                                std::span<const XMFLOAT3> positions, std::span<const XMFLOAT3> triangleNormals, std::span<const UINT> meshletTriangles)
+    {
+        MeshletBuilder::MeshletBounds bounds;
+
+        // 경계 구: AABB 중심에서 가장 먼 정점까지의 거리
+        XMVECTOR minPosition = XMVectorReplicate(FLT_MAX);
+        XMVECTOR maxPosition = XMVectorReplicate(-FLT_MAX);
+        for (UINT i = 0; i < meshlet.vertexCount; ++i)
+        {
+            const XMVECTOR position = XMLoadFloat3(&positions[meshletData.vertices[meshlet.vertexOffset + i]]);
+            minPosition = XMVectorMin(minPosition, position);
+            maxPosition = XMVectorMax(maxPosition, position);
+        }
+
+        const XMVECTOR center = XMVectorScale(XMVectorAdd(minPosition, maxPosition), 0.5f);
+        XMVECTOR radiusSquared = XMVectorZero();
+        for (UINT i = 0; i < meshlet.vertexCount; ++i)
+        {
+            const XMVECTOR position = XMLoadFloat3(&positions[meshletData.vertices[meshlet.vertexOffset + i]]);
+            radiusSquared = XMVectorMax(radiusSquared, XMVector3LengthSq(XMVectorSubtract(position, center)));
+        }
+
+        XMStoreFloat3(&bounds.center, center);
+        bounds.radius = XMVectorGetX(XMVectorSqrt(radiusSquared));
+
+        // 법선 원뿔: 축은 삼각형 법선의 평균, 반각은 축과 가장 많이 벌어진 법선까지의 각도
+        XMVECTOR normalSum = XMVectorZero();
+        for (const UINT triangle : meshletTriangles)
+        {
+            normalSum = XMVectorAdd(normalSum, XMLoadFloat3(&triangleNormals[triangle]));
+        }
+
+        const float normalSumLength = XMVectorGetX(XMVector3Length(normalSum));
+        if (normalSumLength < 1.0e-6f)
+        {
+            return bounds;
+        }
+
+        const XMVECTOR axis = XMVectorScale(normalSum, 1.0f / normalSumLength);
+        float minAxisDot = 1.0f;
+        for (const UINT triangle : meshletTriangles)
+        {
+            const XMVECTOR normal = XMLoadFloat3(&triangleNormals[triangle]);
+            if (XMVectorGetX(XMVector3LengthSq(normal)) > 0.0f)
+            {
+                minAxisDot = std::min(minAxisDot, XMVectorGetX(XMVector3Dot(normal, axis)));
+            }
+        }
+
+        XMStoreFloat3(&bounds.coneAxis, axis);
+
+        // 반각이 90도 이상이면 어느 방향에서 보아도 앞면이 하나는 있으므로 원뿔 컬링을 하지 않는다.
+        if (minAxisDot > 0.0f)
+        {
+            bounds.coneCutoff = std::sqrt(1.0f - minAxisDot * minAxisDot);
+        }
+
+        return bounds;
+    }
+}
+
+MeshletBuilder::MeshletData MeshletBuilder::Build(std::span<const XMFLOAT3> positions, std::span<const UINT> indices)
+{
+    MeshletData meshletData;
+
+    const size_t vertexCount = positions.size();
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return meshletData;
+    }
+
+    // 넓이가 없는 삼각형의 법선은 0이 되어 원뿔 계산에서 빠진다.
+    std::vector<XMFLOAT3> triangleNormals(triangleCount);
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+        const XMVECTOR p0 = XMLoadFloat3(&positions[indices[i * 3 + 0]]);
+        const XMVECTOR p1 = XMLoadFloat3(&positions[indices[i * 3 + 1]]);
+        const XMVECTOR p2 = XMLoadFloat3(&positions[indices[i * 3 + 2]]);
+        const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+        const float length = XMVectorGetX(XMVector3Length(normal));
+        XMStoreFloat3(&triangleNormals[i], length > 0.0f ? XMVectorScale(normal, 1.0f / length) : XMVectorZero());
+    }
+
+    // 정점마다 그 정점을 쓰는 삼각형 목록 (CSR)
+    std::vector<UINT> adjacencyOffsets(vertexCount + 1, 0);
+    for (const UINT index : indices)
+    {
+        ++adjacencyOffsets[index + 1];
+    }
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+    }
+
+    std::vector<UINT> adjacentTriangles(indices.size());
+    {
+        std::vector<UINT> writeOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            adjacentTriangles[writeOffsets[indices[i]]++] = static_cast<UINT>(i / 3);
+        }
+    }
+
+    std::vector<bool> isTriangleEmitted(triangleCount, false);
+    std::vector<uint8_t> localIndices(vertexCount, InvalidLocalIndex);
+
+    Meshlet meshlet;
+    std::vector<UINT> meshletTriangles;
+    meshletTriangles.reserve(MaxTriangleCount);
+    XMVECTOR normalSum = XMVectorZero();
+
+    auto getNewVertexCount = [&](size_t triangle)
+    {
+        const UINT i0 = indices[triangle * 3 + 0];
+        const UINT i1 = indices[triangle * 3 + 1];
+        const UINT i2 = indices[triangle * 3 + 2];
+
+        UINT newVertexCount = localIndices[i0] == InvalidLocalIndex ? 1 : 0;
+        newVertexCount += localIndices[i1] == InvalidLocalIndex && i1 != i0 ? 1 : 0;
+        newVertexCount += localIndices[i2] == InvalidLocalIndex && i2 != i0 && i2 != i1 ? 1 : 0;
+        return newVertexCount;
+    };
+
+    auto addTriangle = [&](size_t triangle)
+    {
+        for (size_t k = 0; k < 3; ++k)
+        {
+            const UINT vertex = indices[triangle * 3 + k];
+            if (localIndices[vertex] == InvalidLocalIndex)
+            {
+                localIndices[vertex] = static_cast<uint8_t>(meshlet.vertexCount++);
+                meshletData.vertices.push_back(vertex);
+            }
+
+            meshletData.triangles.push_back(localIndices[vertex]);
+        }
+
+        ++meshlet.triangleCount;
+        isTriangleEmitted[triangle] = true;
+        meshletTriangles.push_back(static_cast<UINT>(triangle));
+        normalSum = XMVectorAdd(normalSum, XMLoadFloat3(&triangleNormals[triangle]));
+    };
+
+    auto finishMeshlet = [&]()
+    {
+        meshletData.bounds.push_back(ComputeBounds(meshletData, meshlet, positions, triangleNormals, meshletTriangles));
+        meshletData.meshlets.push_back(meshlet);
+
+        for (UINT i = 0; i < meshlet.vertexCount; ++i)
+        {
+            localIndices[meshletData.vertices[meshlet.vertexOffset + i]] = InvalidLocalIndex;
+        }
+
+        meshlet = {};
+        meshlet.vertexOffset = static_cast<UINT>(meshletData.vertices.size());
+        meshlet.triangleOffset = static_cast<UINT>(meshletData.triangles.size() / 3);
+        meshletTriangles.clear();
+        normalSum = XMVectorZero();
+    };
+
+    size_t seedCursor = 0;
+    while (true)
+    {
+        // 새 묶음은 아직 묶이지 않은 첫 삼각형에서 시작한다.
+        if (meshlet.triangleCount == 0)
+        {
+            while (seedCursor < triangleCount && isTriangleEmitted[seedCursor])
+            {
+                ++seedCursor;
+            }
+            if (seedCursor == triangleCount)
+            {
+                break;
+            }
+
+            addTriangle(seedCursor);
+            continue;
+        }
+
+        // 묶음의 정점을 공유하는 삼각형 중 새 정점이 적고 법선이 평균 방향에 가까운 것을 고른다.
+        const XMVECTOR axis = XMVector3Normalize(normalSum);
+        size_t bestTriangle = triangleCount;
+        float bestCost = FLT_MAX;
+        for (UINT i = 0; i < meshlet.vertexCount; ++i)
+        {
+            const UINT vertex = meshletData.vertices[meshlet.vertexOffset + i];
+            for (UINT j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1]; ++j)
+            {
+                const UINT candidate = adjacentTriangles[j];
+                if (isTriangleEmitted[candidate])
+                {
+                    continue;
+                }
+
+                const UINT newVertexCount = getNewVertexCount(candidate);
+                if (meshlet.vertexCount + newVertexCount > MaxVertexCount)
+                {
+                    continue;
+                }
+
+                const float normalSpread = 1.0f - XMVectorGetX(XMVector3Dot(XMLoadFloat3(&triangleNormals[candidate]), axis));
+                const float cost = static_cast<float>(newVertexCount) + normalSpread;
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestTriangle = candidate;
+                }
+            }
+        }
+
+        if (bestTriangle == triangleCount)
+        {
+            finishMeshlet();
+            continue;
+        }
+
+        addTriangle(bestTriangle);
+        if (meshlet.triangleCount == MaxTriangleCount)
+        {
+            finishMeshlet();
+        }
+    }
+
+    if (meshlet.triangleCount > 0)
+    {
+        finishMeshlet();
+    }
+
+    return meshletData;
+}
+
+std::vector<UINT> MeshletBuilder::BuildIndexBuffer(const MeshletData& meshletData)
+{
+    std::vector<UINT> indices;
+    indices.reserve(meshletData.triangles.size());
+
+    for (const Meshlet& meshlet : meshletData.meshlets)
+    {
+        for (UINT i = 0; i < meshlet.triangleCount * 3; ++i)
+        {
+            const uint8_t localIndex = meshletData.triangles[meshlet.triangleOffset * 3 + i];
+            indices.push_back(meshletData.vertices[meshlet.vertexOffset + localIndex]);
+        }
+    }
+
+    return indices;
+}
+
+MeshletBuilder::FrustumPlanes MeshletBuilder::ExtractFrustumPlanes(FXMMATRIX worldViewProjectionMatrix)
+{
+    // 클립 공간에서 -w <= x, y <= w, 0 <= z <= w를 만족하는 영역을 행렬의 열로 표현한다. (Gribb-Hartmann)
+    const XMMATRIX columns = XMMatrixTranspose(worldViewProjectionMatrix);
+    const std::array<XMVECTOR, 6> planes =
+    {
+        XMVectorAdd(columns.r[3], columns.r[0]),
+        XMVectorSubtract(columns.r[3], columns.r[0]),
+        XMVectorAdd(columns.r[3], columns.r[1]),
+        XMVectorSubtract(columns.r[3], columns.r[1]),
+        columns.r[2],
+        XMVectorSubtract(columns.r[3], columns.r[2])
+    };
+
+    FrustumPlanes frustumPlanes;
+    for (size_t i = 0; i < planes.size(); ++i)
+    {
+        XMStoreFloat4(&frustumPlanes[i], XMPlaneNormalize(planes[i]));
+    }
+
+    return frustumPlanes;
+}
+
+bool MeshletBuilder::IsBackfacing(const MeshletBounds& bounds, FXMVECTOR localEyePosition)
+{
+    if (bounds.coneCutoff >= 1.0f)
+    {
+        return false;
+    }
+
+    // 구 안의 모든 점에서 본 시선과 원뿔 축의 각도가 (90도 - 반각)보다 작으면 모든 삼각형이 뒷면이다.
+    // 중심에서 반지름만큼 움직이면 시선 각도의 여유가 최대 radius * (1 + cutoff)만큼 줄어드므로 그만큼 보수적으로 검사한다.
+    const XMVECTOR toCenter = XMVectorSubtract(XMLoadFloat3(&bounds.center), localEyePosition);
+    const float axisDistance = XMVectorGetX(XMVector3Dot(toCenter, XMLoadFloat3(&bounds.coneAxis)));
+    const float distance = XMVectorGetX(XMVector3Length(toCenter));
+    return axisDistance >= bounds.coneCutoff * distance + bounds.radius * (1.0f + bounds.coneCutoff);
+}
+
+bool MeshletBuilder::IsOutsideFrustum(const MeshletBounds& bounds, const FrustumPlanes& frustumPlanes)
+{
+    const XMVECTOR center = XMLoadFloat3(&bounds.center);
+    for (const XMFLOAT4& plane : frustumPlanes)
+    {
+        if (XMVectorGetX(XMPlaneDotCoord(XMLoadFloat4(&plane), center)) < -bounds.radius)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+MeshletBuilder::CullingStatistics MeshletBuilder::Cull(const MeshletData& meshletData, FXMMATRIX worldViewProjectionMatrix, FXMVECTOR localEyePosition, std::vector<UINT>& outVisibleMeshlets, bool useConeCulling)
+{
+    CullingStatistics statistics;
+    outVisibleMeshlets.clear();
+
+    const FrustumPlanes frustumPlanes = ExtractFrustumPlanes(worldViewProjectionMatrix);
+    for (size_t i = 0; i < meshletData.meshlets.size(); ++i)
+    {
+        const UINT triangleCount = meshletData.meshlets[i].triangleCount;
+        statistics.totalTriangleCount += triangleCount;
+
+        if (IsOutsideFrustum(meshletData.bounds[i], frustumPlanes))
+        {
+            statistics.frustumCulledTriangleCount += triangleCount;
+            continue;
+        }
+
+        if (useConeCulling && IsBackfacing(meshletData.bounds[i], localEyePosition))
+        {
+            statistics.backfaceCulledTriangleCount += triangleCount;
+            continue;
+        }
+
+        outVisibleMeshlets.push_back(static_cast<UINT>(i));
+        ++statistics.visibleMeshletCount;
+        statistics.visibleTriangleCount += triangleCount;
+    }
+
+    return statistics;
+}
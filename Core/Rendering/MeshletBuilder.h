@@ -0,0 +1,107 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// 메시를 정점 64개 / 삼각형 124개 이하의 작은 묶음(meshlet)으로 나누고, 묶음마다 경계 구와 법선 원뿔을 계산한다.
+// CPU에서 묶음 단위로 후면/절두체 컬링을 하면 삼각형 하나하나를 검사하지 않고도 보이지 않는 영역을 통째로 건너뛸 수 있다.
+namespace MeshletBuilder
+{
+    constexpr size_t MaxVertexCount = 64;
+    constexpr size_t MaxTriangleCount = 124;
+
+    struct Meshlet
+    {
+        // MeshletData::vertices에서 이 묶음이 쓰는 구간
+        UINT vertexOffset = 0;
+        UINT vertexCount = 0;
+
+        // MeshletData::triangles에서 이 묶음이 쓰는 구간(삼각형 단위, 삼각형마다 지역 인덱스 3개)
+        UINT triangleOffset = 0;
+        UINT triangleCount = 0;
+    };
+
+    struct MeshletBounds
+    {
+        DirectX::XMFLOAT3 center{};
+        float radius = 0.0f;
+
+        // 삼각형 법선이 모두 들어가는 원뿔. coneCutoff는 원뿔 반각의 sin 값이며, 1이면 원뿔로 컬링할 수 없다.
+        DirectX::XMFLOAT3 coneAxis{};
+        float coneCutoff = 1.0f;
+    };
+
+    struct MeshletData
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<MeshletBounds> bounds;
+
+        // 묶음의 지역 정점 번호 -> 원본 정점 번호
+        std::vector<UINT> vertices;
+
+        // 묶음 안의 지역 정점 번호. 정점이 64개 이하이므로 8비트로 충분하다.
+        std::vector<uint8_t> triangles;
+    };
+
+    // 메시 공간의 절두체 평면(왼쪽, 오른쪽, 아래, 위, 가까운, 먼). 법선이 절두체 안쪽을 향하도록 정규화되어 있다.
+    using FrustumPlanes = std::array<DirectX::XMFLOAT4, 6>;
+
+    struct CullingStatistics
+    {
+        size_t visibleMeshletCount = 0;
+        size_t visibleTriangleCount = 0;
+        size_t totalTriangleCount = 0;
+
+        // 원뿔 컬링과 절두체 컬링으로 각각 제외된 삼각형 수. 둘 다 해당하면 절두체 쪽으로 센다.
+        size_t backfaceCulledTriangleCount = 0;
+        size_t frustumCulledTriangleCount = 0;
+
+        [[nodiscard]]
+        float GetTriangleRejectionRate() const
+        {
+            return totalTriangleCount > 0 ? 1.0f - static_cast<float>(visibleTriangleCount) / static_cast<float>(totalTriangleCount) : 0.0f;
+        }
+    };
+
+    // 인접한 삼각형 중 새 정점을 가장 적게 추가하고 법선 방향이 비슷한 삼각형부터 묶는다.
+    // 입력 인덱스를 정점 캐시 순서로 최적화해 두면 묶음이 시작되는 위치도 공간적으로 이어진다.
+    [[nodiscard]]
+    MeshletData Build(std::span<const DirectX::XMFLOAT3> positions, std::span<const UINT> indices);
+
+    template <typename VertexType>
+        requires requires(const VertexType& vertex) { { vertex.position } -> std::convertible_to<DirectX::XMFLOAT3>; }
+    [[nodiscard]]
+    MeshletData Build(const std::vector<VertexType>& vertices, std::span<const UINT> indices)
+    {
+        std::vector<DirectX::XMFLOAT3> positions(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            positions[i] = vertices[i].position;
+        }
+
+        return Build(positions, indices);
+    }
+
+    // 묶음 순서대로 원본 정점 번호를 쓰는 인덱스 버퍼를 만든다. i번 묶음은 meshlets[i].triangleOffset * 3부터 triangleCount * 3개의 인덱스를 사용한다.
+    [[nodiscard]]
+    std::vector<UINT> BuildIndexBuffer(const MeshletData& meshletData);
+
+    // 월드-뷰-투영 행렬에서 메시 공간의 절두체 평면을 뽑는다.
+    [[nodiscard]]
+    FrustumPlanes ExtractFrustumPlanes(DirectX::FXMMATRIX worldViewProjectionMatrix);
+
+    // 카메라(메시 공간 좌표)에서 묶음의 모든 삼각형이 뒷면으로 보이면 true
+    [[nodiscard]]
+    bool IsBackfacing(const MeshletBounds& bounds, DirectX::FXMVECTOR localEyePosition);
+
+    [[nodiscard]]
+    bool IsOutsideFrustum(const MeshletBounds& bounds, const FrustumPlanes& frustumPlanes);
+
+    // 보이는 묶음 번호를 outVisibleMeshlets에 순서대로 담는다. 월드 행렬에 반사가 들어 있으면 앞뒷면이 뒤집히므로 원뿔 컬링을 끈다.
+    CullingStatistics Cull(const MeshletData& meshletData, DirectX::FXMMATRIX worldViewProjectionMatrix, DirectX::FXMVECTOR localEyePosition, std::vector<UINT>& outVisibleMeshlets, bool useConeCulling = true);
+}
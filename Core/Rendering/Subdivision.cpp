@@ -0,0 +1,437 @@
+#include "Subdivision.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "Utilities/Parallel.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // 한 작업이 맡는 최소 정점/변/면 수
+    constexpr size_t MinElementRangeSize = 4096;
+
+    // 한 단계의 메시. faceSizes가 비어 있으면 삼각형 목록이다.
+    struct Level
+    {
+        std::vector<XMFLOAT3> positions;
+        std::vector<UINT> indices;
+        std::vector<UINT> faceSizes;
+        std::vector<Subdivision::Crease> creases;
+    };
+
+    HalfEdgeMesh BuildMesh(const Level& level)
+    {
+        return level.faceSizes.empty() ? HalfEdgeMesh(level.positions.size(), level.indices) : HalfEdgeMesh(level.positions.size(), level.indices, level.faceSizes);
+    }
+
+    // 변별 sharpness. 경계 변은 무한히 날카롭고, 메시에 없는 변을 가리키는 주름은 무시한다.
+    std::vector<float> GetEdgeSharpnesses(const HalfEdgeMesh& mesh, std::span<const Subdivision::Crease> creases)
+    {
+        std::vector<float> sharpnesses(mesh.GetEdgeCount(), 0.0f);
+        for (size_t edge = 0; edge < mesh.GetEdgeCount(); ++edge)
+        {
+            if (mesh.IsBoundaryEdge(edge))
+            {
+                sharpnesses[edge] = Subdivision::InfiniteSharpness;
+            }
+        }
+
+        for (const Subdivision::Crease& crease : creases)
+        {
+            const UINT edge = mesh.FindEdge(crease.vertex0, crease.vertex1);
+            if (edge != HalfEdgeMesh::InvalidIndex)
+            {
+                sharpnesses[edge] = std::max(sharpnesses[edge], crease.sharpness);
+            }
+        }
+
+        return sharpnesses;
+    }
+
+    // 주름 변은 자식 변 둘로 나뉘고 sharpness가 1 줄어든다. 0 이하가 되면 더는 주름이 아니다.
+    std::vector<Subdivision::Crease> GetChildCreases(const HalfEdgeMesh& mesh, std::span<const Subdivision::Crease> creases, UINT firstEdgePoint)
+    {
+        std::vector<Subdivision::Crease> childCreases;
+        childCreases.reserve(creases.size() * 2);
+
+        for (const Subdivision::Crease& crease : creases)
+        {
+            const UINT edge = mesh.FindEdge(crease.vertex0, crease.vertex1);
+            const float childSharpness = crease.sharpness - 1.0f;
+            if (edge != HalfEdgeMesh::InvalidIndex && childSharpness > 0.0f)
+            {
+                const UINT edgePoint = firstEdgePoint + edge;
+                childCreases.push_back({crease.vertex0, edgePoint, childSharpness});
+                childCreases.push_back({edgePoint, crease.vertex1, childSharpness});
+            }
+        }
+
+        return childCreases;
+    }
+
+    XMVECTOR XM_CALLCONV BlendSharp(FXMVECTOR smoothPoint, FXMVECTOR sharpPoint, float sharpness)
+    {
+        if (sharpness >= 1.0f)
+        {
+            return sharpPoint;
+        }
+
+        return sharpness <= 0.0f ? smoothPoint : XMVectorLerp(smoothPoint, sharpPoint, sharpness);
+    }
+
+    // 주름 변이 둘이면 주름 규칙, 셋 이상이면 모서리로 고정한다. 주름 변의 평균 sharpness가 1보다 작으면 매끄러운 규칙과 섞는다.
+    // 경계 정점은 경계 변 둘이 무한히 날카로우므로 매끄러운 규칙을 계산하지 않는다.
+    template <typename SmoothRule>
+    XMVECTOR ComputeVertexPoint(std::span<const XMFLOAT3> positions, UINT vertex, std::span<const UINT> neighbors, std::span<const UINT> edges,
+                                std::span<const float> edgeSharpnesses, SmoothRule&& smoothRule)
+    {
+        const XMVECTOR position = XMLoadFloat3(&positions[vertex]);
+
+        UINT sharpEdgeCount = 0;
+        float sharpnessSum = 0.0f;
+        XMVECTOR sharpNeighborSum = XMVectorZero();
+        for (size_t i = 0; i < neighbors.size(); ++i)
+        {
+            const float sharpness = edgeSharpnesses[edges[i]];
+            if (sharpness > 0.0f)
+            {
+                ++sharpEdgeCount;
+                sharpnessSum += sharpness;
+                sharpNeighborSum = XMVectorAdd(sharpNeighborSum, XMLoadFloat3(&positions[neighbors[i]]));
+            }
+        }
+
+        if (sharpEdgeCount < 2)
+        {
+            return smoothRule(position);
+        }
+
+        // 면 하나에만 닿은 경계 정점(열린 메시의 모서리)도 모서리로 고정한다.
+        const bool isCorner = sharpEdgeCount > 2 || neighbors.size() == 2;
+        const XMVECTOR sharpPoint = !isCorner ? XMVectorAdd(XMVectorScale(position, 0.75f), XMVectorScale(sharpNeighborSum, 0.125f)) : position;
+        const float vertexSharpness = sharpnessSum / static_cast<float>(sharpEdgeCount);
+        if (vertexSharpness >= 1.0f)
+        {
+            return sharpPoint;
+        }
+
+        return BlendSharp(smoothRule(position), sharpPoint, vertexSharpness);
+    }
+
+    Level SubdivideLoop(const Level& level)
+    {
+        const HalfEdgeMesh mesh = BuildMesh(level);
+        assert(mesh.IsTriangleMesh() && "Loop 세분화는 삼각형 메시만 지원합니다.");
+
+        const std::vector<float> edgeSharpnesses = GetEdgeSharpnesses(mesh, level.creases);
+        const std::span<const XMFLOAT3> positions = level.positions;
+        const size_t vertexCount = mesh.GetVertexCount();
+        const size_t edgeCount = mesh.GetEdgeCount();
+        const size_t faceCount = mesh.GetFaceCount();
+
+        // 원래 정점 뒤에 변마다 정점 하나를 붙인다.
+        Level next;
+        next.positions.resize(vertexCount + edgeCount);
+        next.indices.resize(faceCount * 12);
+
+        // 변 점: 3/8 (양 끝) + 1/8 (마주 보는 두 정점)
+        Parallel::ForRange(0, edgeCount, MinElementRangeSize, [&](size_t begin, size_t end)
+        {
+            for (size_t edge = begin; edge < end; ++edge)
+            {
+                const UINT halfEdge = mesh.GetEdgeHalfEdge(edge);
+                const XMVECTOR p0 = XMLoadFloat3(&positions[mesh.GetOrigin(halfEdge)]);
+                const XMVECTOR p1 = XMLoadFloat3(&positions[mesh.GetTarget(halfEdge)]);
+                const XMVECTOR midpoint = XMVectorScale(XMVectorAdd(p0, p1), 0.5f);
+
+                XMVECTOR edgePoint = midpoint;
+                if (edgeSharpnesses[edge] < 1.0f)
+                {
+                    const XMVECTOR opposite0 = XMLoadFloat3(&positions[mesh.GetOrigin(mesh.GetPrev(halfEdge))]);
+                    const XMVECTOR opposite1 = XMLoadFloat3(&positions[mesh.GetOrigin(mesh.GetPrev(mesh.GetTwin(halfEdge)))]);
+                    const XMVECTOR smoothPoint = XMVectorAdd(XMVectorScale(XMVectorAdd(p0, p1), 0.375f), XMVectorScale(XMVectorAdd(opposite0, opposite1), 0.125f));
+                    edgePoint = BlendSharp(smoothPoint, midpoint, edgeSharpnesses[edge]);
+                }
+
+                XMStoreFloat3(&next.positions[vertexCount + edge], edgePoint);
+            }
+        });
+
+        // 정점 점: (1 - n * beta) v + beta * (이웃의 합)
+        Parallel::ForRange(0, vertexCount, MinElementRangeSize, [&](size_t begin, size_t end)
+        {
+            std::vector<UINT> neighbors;
+            std::vector<UINT> edges;
+            for (size_t vertex = begin; vertex < end; ++vertex)
+            {
+                mesh.GetVertexRing(static_cast<UINT>(vertex), neighbors, edges);
+                if (neighbors.empty())
+                {
+                    next.positions[vertex] = positions[vertex];
+                    continue;
+                }
+
+                const XMVECTOR vertexPoint = ComputeVertexPoint(positions, static_cast<UINT>(vertex), neighbors, edges, edgeSharpnesses, [&](FXMVECTOR position)
+                {
+                    const float n = static_cast<float>(neighbors.size());
+                    const float cosine = 0.375f + 0.25f * std::cos(XM_2PI / n);
+                    const float beta = (0.625f - cosine * cosine) / n;
+
+                    XMVECTOR neighborSum = XMVectorZero();
+                    for (const UINT neighbor : neighbors)
+                    {
+                        neighborSum = XMVectorAdd(neighborSum, XMLoadFloat3(&positions[neighbor]));
+                    }
+
+                    return XMVectorAdd(XMVectorScale(position, 1.0f - n * beta), XMVectorScale(neighborSum, beta));
+                });
+                XMStoreFloat3(&next.positions[vertex], vertexPoint);
+            }
+        });
+
+        //        c
+        //        *
+        //       / \
+        //  mCA *---* mBC
+        //     / \ / \
+        //    *---*---*
+        //    a  mAB   b
+        Parallel::ForRange(0, faceCount, MinElementRangeSize, [&](size_t begin, size_t end)
+        {
+            for (size_t face = begin; face < end; ++face)
+            {
+                const UINT halfEdge = static_cast<UINT>(face * 3);
+                const UINT a = mesh.GetOrigin(halfEdge);
+                const UINT b = mesh.GetOrigin(halfEdge + 1);
+                const UINT c = mesh.GetOrigin(halfEdge + 2);
+                const UINT mAB = static_cast<UINT>(vertexCount) + mesh.GetEdge(halfEdge);
+                const UINT mBC = static_cast<UINT>(vertexCount) + mesh.GetEdge(halfEdge + 1);
+                const UINT mCA = static_cast<UINT>(vertexCount) + mesh.GetEdge(halfEdge + 2);
+
+                UINT* outIndices = &next.indices[face * 12];
+                outIndices[0] = a;
+                outIndices[1] = mAB;
+                outIndices[2] = mCA;
+
+                outIndices[3] = mAB;
+                outIndices[4] = b;
+                outIndices[5] = mBC;
+
+                outIndices[6] = mCA;
+                outIndices[7] = mBC;
+                outIndices[8] = c;
+
+                outIndices[9] = mAB;
+                outIndices[10] = mBC;
+                outIndices[11] = mCA;
+            }
+        });
+
+        next.creases = GetChildCreases(mesh, level.creases, static_cast<UINT>(vertexCount));
+        return next;
+    }
+
+    Level SubdivideCatmullClark(const Level& level)
+    {
+        const HalfEdgeMesh mesh = BuildMesh(level);
+
+        const std::vector<float> edgeSharpnesses = GetEdgeSharpnesses(mesh, level.creases);
+        const std::span<const XMFLOAT3> positions = level.positions;
+        const size_t vertexCount = mesh.GetVertexCount();
+        const size_t edgeCount = mesh.GetEdgeCount();
+        const size_t faceCount = mesh.GetFaceCount();
+        const size_t halfEdgeCount = mesh.GetHalfEdgeCount();
+
+        // 원래 정점, 면 점, 변 점 순서로 놓는다.
+        const UINT firstFacePoint = static_cast<UINT>(vertexCount);
+        const UINT firstEdgePoint = static_cast<UINT>(vertexCount + faceCount);
+
+        Level next;
+        next.positions.resize(vertexCount + faceCount + edgeCount);
+        next.indices.resize(halfEdgeCount * 4);
+        next.faceSizes.assign(halfEdgeCount, 4);
+
+        // 면 점: 면 정점의 평균
+        Parallel::ForRange(0, faceCount, MinElementRangeSize, [&](size_t begin, size_t end)
+        {
+            for (size_t face = begin; face < end; ++face)
+            {
+                XMVECTOR sum = XMVectorZero();
+                const UINT faceBegin = mesh.GetFaceBegin(face);
+                const UINT faceSize = mesh.GetFaceSize(face);
+                for (UINT halfEdge = faceBegin; halfEdge < faceBegin + faceSize; ++halfEdge)
+                {
+                    sum = XMVectorAdd(sum, XMLoadFloat3(&positions[mesh.GetOrigin(halfEdge)]));
+                }
+
+                XMStoreFloat3(&next.positions[firstFacePoint + face], XMVectorScale(sum, 1.0f / static_cast<float>(faceSize)));
+            }
+        });
+
+        // 변 점: 양 끝과 양쪽 면 점의 평균
+        Parallel::ForRange(0, edgeCount, MinElementRangeSize, [&](size_t begin, size_t end)
+        {
+            for (size_t edge = begin; edge < end; ++edge)
+            {
+                const UINT halfEdge = mesh.GetEdgeHalfEdge(edge);
+                const XMVECTOR p0 = XMLoadFloat3(&positions[mesh.GetOrigin(halfEdge)]);
+                const XMVECTOR p1 = XMLoadFloat3(&positions[mesh.GetTarget(halfEdge)]);
+                const XMVECTOR midpoint = XMVectorScale(XMVectorAdd(p0, p1), 0.5f);
+
+                XMVECTOR edgePoint = midpoint;
+                if (edgeSharpnesses[edge] < 1.0f)
+                {
+                    const XMVECTOR facePoint0 = XMLoadFloat3(&next.positions[firstFacePoint + mesh.GetFace(halfEdge)]);
+                    const XMVECTOR facePoint1 = XMLoadFloat3(&next.positions[firstFacePoint + mesh.GetFace(mesh.GetTwin(halfEdge))]);
+                    const XMVECTOR smoothPoint = XMVectorScale(XMVectorAdd(XMVectorAdd(p0, p1), XMVectorAdd(facePoint0, facePoint1)), 0.25f);
+                    edgePoint = BlendSharp(smoothPoint, midpoint, edgeSharpnesses[edge]);
+                }
+
+                XMStoreFloat3(&next.positions[firstEdgePoint + edge], edgePoint);
+            }
+        });
+
+        // 정점 점: (Q + 2R + (n - 3) v) / n. Q는 인접 면 점의 평균, R은 인접 변 중점의 평균이다.
+        Parallel::ForRange(0, vertexCount, MinElementRangeSize, [&](size_t begin, size_t end)
+        {
+            std::vector<UINT> neighbors;
+            std::vector<UINT> edges;
+            for (size_t vertex = begin; vertex < end; ++vertex)
+            {
+                mesh.GetVertexRing(static_cast<UINT>(vertex), neighbors, edges);
+                if (neighbors.empty())
+                {
+                    next.positions[vertex] = positions[vertex];
+                    continue;
+                }
+
+                const XMVECTOR vertexPoint = ComputeVertexPoint(positions, static_cast<UINT>(vertex), neighbors, edges, edgeSharpnesses, [&](FXMVECTOR position)
+                {
+                    const std::span<const UINT> outgoingHalfEdges = mesh.GetOutgoingHalfEdges(static_cast<UINT>(vertex));
+                    const float n = static_cast<float>(neighbors.size());
+                    if (neighbors.size() < 3 || outgoingHalfEdges.size() != neighbors.size())
+                    {
+                        return position;
+                    }
+
+                    XMVECTOR facePointSum = XMVectorZero();
+                    for (const UINT halfEdge : outgoingHalfEdges)
+                    {
+                        facePointSum = XMVectorAdd(facePointSum, XMLoadFloat3(&next.positions[firstFacePoint + mesh.GetFace(halfEdge)]));
+                    }
+
+                    XMVECTOR neighborSum = XMVectorZero();
+                    for (const UINT neighbor : neighbors)
+                    {
+                        neighborSum = XMVectorAdd(neighborSum, XMLoadFloat3(&positions[neighbor]));
+                    }
+
+                    // 2R = (n v + 이웃의 합) / n 이므로 정리하면 (Q + 이웃의 합 / n + (n - 2) v) / n 이다.
+                    const XMVECTOR q = XMVectorScale(facePointSum, 1.0f / n);
+                    const XMVECTOR twoR = XMVectorAdd(position, XMVectorScale(neighborSum, 1.0f / n));
+                    return XMVectorScale(XMVectorAdd(XMVectorAdd(q, twoR), XMVectorScale(position, n - 3.0f)), 1.0f / n);
+                });
+                XMStoreFloat3(&next.positions[vertex], vertexPoint);
+            }
+        });
+
+        // 면의 꼭짓점마다 (꼭짓점, 다음 변 점, 면 점, 이전 변 점) 사각형을 만든다. 자식 면 번호는 부모 half-edge 번호와 같다.
+        Parallel::ForRange(0, halfEdgeCount, MinElementRangeSize, [&](size_t begin, size_t end)
+        {
+            for (size_t halfEdge = begin; halfEdge < end; ++halfEdge)
+            {
+                const UINT corner = static_cast<UINT>(halfEdge);
+
+                UINT* outIndices = &next.indices[halfEdge * 4];
+                outIndices[0] = mesh.GetOrigin(corner);
+                outIndices[1] = firstEdgePoint + mesh.GetEdge(corner);
+                outIndices[2] = firstFacePoint + mesh.GetFace(corner);
+                outIndices[3] = firstEdgePoint + mesh.GetEdge(mesh.GetPrev(corner));
+            }
+        });
+
+        next.creases = GetChildCreases(mesh, level.creases, firstEdgePoint);
+        return next;
+    }
+
+    // 다각형을 첫 정점 기준 부채꼴로 나눈다.
+    std::vector<UINT> Triangulate(std::span<const UINT> indices, std::span<const UINT> faceSizes)
+    {
+        if (faceSizes.empty())
+        {
+            return std::vector<UINT>(indices.begin(), indices.end());
+        }
+
+        std::vector<UINT> triangleIndices;
+        triangleIndices.reserve((indices.size() - faceSizes.size() * 2) * 3);
+
+        size_t faceBegin = 0;
+        for (const UINT faceSize : faceSizes)
+        {
+            for (UINT i = 1; i + 1 < faceSize; ++i)
+            {
+                triangleIndices.push_back(indices[faceBegin]);
+                triangleIndices.push_back(indices[faceBegin + i]);
+                triangleIndices.push_back(indices[faceBegin + i + 1]);
+            }
+            faceBegin += faceSize;
+        }
+
+        return triangleIndices;
+    }
+}
+
+Subdivision::SubdivisionSize Subdivision::GetLoopSize(const HalfEdgeMesh& mesh, UINT levelCount)
+{
+    SubdivisionSize size{mesh.GetVertexCount(), mesh.GetEdgeCount(), mesh.GetFaceCount(), 0};
+
+    // 변마다 정점 하나, 면마다 내부 변 셋과 자식 면 넷이 생긴다.
+    for (UINT level = 0; level < levelCount; ++level)
+    {
+        size = {size.vertexCount + size.edgeCount, size.edgeCount * 2 + size.faceCount * 3, size.faceCount * 4, 0};
+    }
+    size.indexCount = size.faceCount * 3;
+
+    return size;
+}
+
+Subdivision::SubdivisionSize Subdivision::GetCatmullClarkSize(const HalfEdgeMesh& mesh, UINT levelCount)
+{
+    SubdivisionSize size{mesh.GetVertexCount(), mesh.GetEdgeCount(), mesh.GetFaceCount(), 0};
+    size_t halfEdgeCount = mesh.GetHalfEdgeCount();
+
+    // 면마다 면 점 하나, 변마다 변 점 하나가 생기고, half-edge마다 내부 변 하나와 자식 사각형 하나가 생긴다.
+    for (UINT level = 0; level < levelCount; ++level)
+    {
+        size = {size.vertexCount + size.faceCount + size.edgeCount, size.edgeCount * 2 + halfEdgeCount, halfEdgeCount, 0};
+        halfEdgeCount = size.faceCount * 4;
+    }
+    size.indexCount = (halfEdgeCount - size.faceCount * 2) * 3;
+
+    return size;
+}
+
+Subdivision::SubdividedMesh Subdivision::Loop(std::span<const XMFLOAT3> positions, std::span<const UINT> triangleIndices, UINT levelCount, std::span<const Crease> creases)
+{
+    Level level{{positions.begin(), positions.end()}, {triangleIndices.begin(), triangleIndices.end()}, {}, {creases.begin(), creases.end()}};
+    for (UINT i = 0; i < levelCount; ++i)
+    {
+        level = SubdivideLoop(level);
+    }
+
+    return {std::move(level.positions), std::move(level.indices)};
+}
+
+Subdivision::SubdividedMesh Subdivision::CatmullClark(std::span<const XMFLOAT3> positions, std::span<const UINT> indices, std::span<const UINT> faceSizes, UINT levelCount, std::span<const Crease> creases)
+{
+    Level level{{positions.begin(), positions.end()}, {indices.begin(), indices.end()}, {faceSizes.begin(), faceSizes.end()}, {creases.begin(), creases.end()}};
+    for (UINT i = 0; i < levelCount; ++i)
+    {
+        level = SubdivideCatmullClark(level);
+    }
+
+    return {std::move(level.positions), Triangulate(level.indices, level.faceSizes)};
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Core/Rendering/HalfEdgeMesh.h"
+
+// HalfEdgeMesh 위에서 동작하는 매끄러운 세분화. 삼각형 메시는 Loop, 임의의 다각형 메시는 Catmull-Clark 규칙을 쓴다.
+// 단계마다 면/변/정점 점을 병렬로 계산하고, 결과 위상으로 HalfEdgeMesh를 다시 만들어 다음 단계에 넘긴다.
+//
+// 주름(crease)은 변의 sharpness로 지정한다(DeRose et al. 1998). 1 이상이면 그 단계에서 날카로운 규칙을 쓰고 자식 변은 1 줄어들며,
+// 0과 1 사이면 매끄러운 규칙과 섞는다. 경계 변은 항상 무한히 날카롭다.
+namespace Subdivision
+{
+    constexpr float InfiniteSharpness = std::numeric_limits<float>::infinity();
+
+    struct Crease
+    {
+        UINT vertex0 = 0;
+        UINT vertex1 = 0;
+        float sharpness = InfiniteSharpness;
+    };
+
+    // levelCount번 세분화한 뒤의 크기. 세분화 전에 버퍼 크기나 비용을 알 수 있다.
+    struct SubdivisionSize
+    {
+        size_t vertexCount = 0;
+        size_t edgeCount = 0;
+        size_t faceCount = 0;
+
+        // 삼각형 목록으로 바꾼 인덱스 수
+        size_t indexCount = 0;
+    };
+
+    // 결과는 항상 삼각형 목록이다. Catmull-Clark의 사각형은 두 삼각형으로 나눈다.
+    // 원래 정점은 같은 번호를 유지하므로 입력 정점의 속성을 결과 앞부분에 그대로 대응시킬 수 있다.
+    struct SubdividedMesh
+    {
+        std::vector<DirectX::XMFLOAT3> positions;
+        std::vector<UINT> indices;
+    };
+
+    [[nodiscard]]
+    SubdivisionSize GetLoopSize(const HalfEdgeMesh& mesh, UINT levelCount);
+
+    [[nodiscard]]
+    SubdivisionSize GetCatmullClarkSize(const HalfEdgeMesh& mesh, UINT levelCount);
+
+    // 삼각형 메시를 Loop 규칙으로 세분화한다.
+    [[nodiscard]]
+    SubdividedMesh Loop(std::span<const DirectX::XMFLOAT3> positions, std::span<const UINT> triangleIndices, UINT levelCount, std::span<const Crease> creases = {});
+
+    // 다각형 메시를 Catmull-Clark 규칙으로 세분화한다. faceSizes가 비어 있으면 삼각형 목록으로 본다.
+    [[nodiscard]]
+    SubdividedMesh CatmullClark(std::span<const DirectX::XMFLOAT3> positions, std::span<const UINT> indices, std::span<const UINT> faceSizes, UINT levelCount, std::span<const Crease> creases = {});
+}
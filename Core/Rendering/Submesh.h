@@ -3,12 +3,14 @@
 #include <d3d11.h>
 #include <type_traits>
 
+#include "Core/Rendering/Bounds.h"
+
 struct Submesh
 {
     Submesh() = default;
 
     template <typename T1, typename T2, typename T3>
-    Submesh(T1 newIndexCount, T2 newStartIndexLocation, T3 newBaseVertexLocation)
+    Submesh(T1 newIndexCount, T2 newStartIndexLocation, T3 newBaseVertexLocation, DXGI_FORMAT newIndexFormat = DXGI_FORMAT_R32_UINT)
     {
         static_assert(std::is_integral_v<T1>, "T1은 정수 타입이어야 합니다.");
         static_assert(std::is_integral_v<T2>, "T2은 정수 타입이어야 합니다.");
@@ -17,9 +19,16 @@ struct Submesh
         indexCount = static_cast<UINT>(newIndexCount);
         startIndexLocation = static_cast<UINT>(newStartIndexLocation);
         baseVertexLocation = static_cast<INT>(newBaseVertexLocation);
+        indexFormat = newIndexFormat;
     }
 
     UINT indexCount;
     UINT startIndexLocation;
     INT baseVertexLocation;
+
+    // IASetIndexBuffer에 넘길 인덱스 버퍼 형식
+    DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT;
+
+    // 메시 공간 기준의 범위. 범위를 모르는 Submesh는 비어 있다.
+    Bounds bounds;
 };
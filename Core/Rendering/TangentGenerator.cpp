@@ -0,0 +1,207 @@
+#include "TangentGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "Utilities/Parallel.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // 한 작업 구간에 들어가는 최소 삼각형/정점 수. 너무 잘게 나누면 동기화 비용이 계산보다 커진다.
+    constexpr size_t MinTriangleRangeSize = 1024;
+    constexpr size_t MinVertexRangeSize = 2048;
+
+    // UV 넓이가 이보다 작은 삼각형은 탄젠트 방향을 정할 수 없어 누적하지 않는다.
+    constexpr float MinTexCoordArea = 1.0e-20f;
+
+    // 모서리마다 누적할 값. sign이 0이면 UV가 퇴화한 삼각형으로, 탄젠트에 기여하지 않고 정점을 나누지도 않는다.
+    struct CornerTangent
+    {
+        XMFLOAT3 weightedTangent;
+        int8_t sign;
+    };
+
+    XMVECTOR XM_CALLCONV ProjectOntoPlane(FXMVECTOR vector, FXMVECTOR normal)
+    {
+        return XMVectorSubtract(vector, XMVectorMultiply(normal, XMVector3Dot(normal, vector)));
+    }
+
+    // 법선에 수직인 임의의 단위 벡터. 탄젠트를 정할 수 없는 정점에 사용한다.
+    XMVECTOR XM_CALLCONV GetAnyPerpendicular(FXMVECTOR normal)
+    {
+        const XMVECTOR axis = std::abs(XMVectorGetX(normal)) < 0.9f ? XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+        return XMVector3Normalize(ProjectOntoPlane(axis, normal));
+    }
+
+    void ComputeCornerTangents(const VertexView& vertexView, std::span<const UINT> indices, size_t triangle, std::span<CornerTangent> outCorners)
+    {
+        const std::array<UINT, 3> corners = {indices[triangle * 3], indices[triangle * 3 + 1], indices[triangle * 3 + 2]};
+        const std::array<XMVECTOR, 3> positions =
+        {
+            XMLoadFloat3(&vertexView.positions[corners[0]]), XMLoadFloat3(&vertexView.positions[corners[1]]), XMLoadFloat3(&vertexView.positions[corners[2]])
+        };
+        const XMFLOAT2& uv0 = vertexView.texCoords[corners[0]];
+        const XMFLOAT2& uv1 = vertexView.texCoords[corners[1]];
+        const XMFLOAT2& uv2 = vertexView.texCoords[corners[2]];
+
+        const XMVECTOR edge1 = XMVectorSubtract(positions[1], positions[0]);
+        const XMVECTOR edge2 = XMVectorSubtract(positions[2], positions[0]);
+        const float du1 = uv1.x - uv0.x;
+        const float dv1 = uv1.y - uv0.y;
+        const float du2 = uv2.x - uv0.x;
+        const float dv2 = uv2.y - uv0.y;
+
+        // UV 평면의 부호 있는 넓이(의 2배). 음수면 UV가 삼각형에 대해 뒤집혀 있다.
+        const float signedTexCoordArea = du1 * dv2 - du2 * dv1;
+        const bool isDegenerate = std::abs(signedTexCoordArea) < MinTexCoordArea;
+        const float sign = signedTexCoordArea > 0.0f ? 1.0f : -1.0f;
+
+        // 넓이로 나누는 대신 부호만 곱하고 크기는 정점마다 정규화한다.
+        const XMVECTOR triangleTangent = XMVectorScale(XMVectorSubtract(XMVectorScale(edge1, dv2), XMVectorScale(edge2, dv1)), sign);
+
+        for (size_t k = 0; k < 3; ++k)
+        {
+            CornerTangent& corner = outCorners[k];
+            corner.weightedTangent = {};
+            corner.sign = 0;
+
+            const XMVECTOR normal = XMLoadFloat3(&vertexView.normals[corners[k]]);
+            const XMVECTOR tangent = ProjectOntoPlane(triangleTangent, normal);
+            if (isDegenerate || XMVectorGetX(XMVector3LengthSq(tangent)) <= 0.0f)
+            {
+                continue;
+            }
+
+            // 모서리 각도도 법선 평면에 투영한 변으로 잰다.
+            const XMVECTOR toNext = XMVector3Normalize(ProjectOntoPlane(XMVectorSubtract(positions[(k + 1) % 3], positions[k]), normal));
+            const XMVECTOR toPrevious = XMVector3Normalize(ProjectOntoPlane(XMVectorSubtract(positions[(k + 2) % 3], positions[k]), normal));
+            const float angle = std::acos(std::clamp(XMVectorGetX(XMVector3Dot(toNext, toPrevious)), -1.0f, 1.0f));
+
+            XMStoreFloat3(&corner.weightedTangent, XMVectorScale(XMVector3Normalize(tangent), angle));
+            corner.sign = static_cast<int8_t>(sign);
+        }
+    }
+}
+
+TangentGenerator::TangentData TangentGenerator::Generate(const VertexView& vertexView, std::span<UINT> inoutIndices)
+{
+    TangentData tangentData;
+
+    const size_t vertexCount = vertexView.vertexCount;
+    const size_t triangleCount = inoutIndices.size() / 3;
+    if (vertexCount == 0 || !vertexView.positions.IsValid() || !vertexView.normals.IsValid() || !vertexView.texCoords.IsValid())
+    {
+        return tangentData;
+    }
+
+    // 1. 삼각형마다 세 모서리의 기여분을 계산한다. 각 삼각형은 자기 모서리에만 쓰므로 병렬로 실행해도 겹치지 않는다.
+    std::vector<CornerTangent> cornerTangents(triangleCount * 3);
+    Parallel::For(0, triangleCount, MinTriangleRangeSize, [&](size_t triangle)
+    {
+        ComputeCornerTangents(vertexView, inoutIndices, triangle, std::span(cornerTangents).subspan(triangle * 3, 3));
+    });
+
+    // 2. 정점마다 자신을 쓰는 모서리 목록을 모서리 번호 순으로 만든다. (CSR)
+    std::vector<UINT> cornerOffsets(vertexCount + 1, 0);
+    for (const UINT index : inoutIndices)
+    {
+        ++cornerOffsets[index + 1];
+    }
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        cornerOffsets[i + 1] += cornerOffsets[i];
+    }
+
+    std::vector<UINT> vertexCorners(inoutIndices.size());
+    {
+        std::vector<UINT> writeOffsets(cornerOffsets.begin(), cornerOffsets.end() - 1);
+        for (size_t i = 0; i < inoutIndices.size(); ++i)
+        {
+            vertexCorners[writeOffsets[inoutIndices[i]]++] = static_cast<UINT>(i);
+        }
+    }
+
+    // 3. 정점마다 handedness별로 정해진 순서대로 누적한다. 두 부호가 모두 있으면 적은 쪽을 복제할 정점으로 분리한다.
+    std::vector<XMFLOAT3> positiveTangents(vertexCount);
+    std::vector<XMFLOAT3> negativeTangents(vertexCount);
+    std::vector<int8_t> keptSigns(vertexCount, 1);
+    std::vector<uint8_t> isSplit(vertexCount, 0);
+    Parallel::For(0, vertexCount, MinVertexRangeSize, [&](size_t vertex)
+    {
+        XMVECTOR positiveSum = XMVectorZero();
+        XMVECTOR negativeSum = XMVectorZero();
+        UINT positiveCount = 0;
+        UINT negativeCount = 0;
+        for (UINT i = cornerOffsets[vertex]; i < cornerOffsets[vertex + 1]; ++i)
+        {
+            const CornerTangent& corner = cornerTangents[vertexCorners[i]];
+            if (corner.sign > 0)
+            {
+                positiveSum = XMVectorAdd(positiveSum, XMLoadFloat3(&corner.weightedTangent));
+                ++positiveCount;
+            }
+            else if (corner.sign < 0)
+            {
+                negativeSum = XMVectorAdd(negativeSum, XMLoadFloat3(&corner.weightedTangent));
+                ++negativeCount;
+            }
+        }
+
+        XMStoreFloat3(&positiveTangents[vertex], positiveSum);
+        XMStoreFloat3(&negativeTangents[vertex], negativeSum);
+        keptSigns[vertex] = negativeCount > positiveCount ? -1 : 1;
+        isSplit[vertex] = positiveCount > 0 && negativeCount > 0 ? 1 : 0;
+    });
+
+    // 4. 복제 정점 번호는 원본 정점 순서대로 매겨 결과가 항상 같게 한다.
+    std::vector<UINT> duplicateVertexIndices(vertexCount, 0);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        if (isSplit[vertex])
+        {
+            duplicateVertexIndices[vertex] = static_cast<UINT>(vertexCount + tangentData.duplicatedVertices.size());
+            tangentData.duplicatedVertices.push_back(static_cast<UINT>(vertex));
+        }
+    }
+
+    // 5. 법선에 직교화해 최종 탄젠트를 쓰고, 반대 부호 모서리의 인덱스를 복제 정점으로 바꾼다.
+    tangentData.tangents.resize(vertexCount + tangentData.duplicatedVertices.size());
+    Parallel::For(0, vertexCount, MinVertexRangeSize, [&](size_t vertex)
+    {
+        const XMVECTOR normal = XMVector3Normalize(XMLoadFloat3(&vertexView.normals[vertex]));
+        auto finalizeTangent = [&normal](const XMFLOAT3& accumulatedTangent, float sign)
+        {
+            XMVECTOR tangent = ProjectOntoPlane(XMLoadFloat3(&accumulatedTangent), normal);
+            tangent = XMVectorGetX(XMVector3LengthSq(tangent)) > 1.0e-20f ? XMVector3Normalize(tangent) : GetAnyPerpendicular(normal);
+
+            XMFLOAT4 result;
+            XMStoreFloat4(&result, XMVectorSetW(tangent, sign));
+            return result;
+        };
+
+        const int8_t keptSign = keptSigns[vertex];
+        tangentData.tangents[vertex] = finalizeTangent(keptSign > 0 ? positiveTangents[vertex] : negativeTangents[vertex], keptSign);
+
+        if (isSplit[vertex])
+        {
+            const UINT duplicateVertex = duplicateVertexIndices[vertex];
+            tangentData.tangents[duplicateVertex] = finalizeTangent(keptSign > 0 ? negativeTangents[vertex] : positiveTangents[vertex], -keptSign);
+
+            // 모서리는 정확히 한 정점에 속하므로 다른 스레드와 같은 인덱스를 고치지 않는다.
+            for (UINT i = cornerOffsets[vertex]; i < cornerOffsets[vertex + 1]; ++i)
+            {
+                const UINT corner = vertexCorners[i];
+                if (cornerTangents[corner].sign == -keptSign)
+                {
+                    inoutIndices[corner] = duplicateVertex;
+                }
+            }
+        }
+    });
+
+    return tangentData;
+}
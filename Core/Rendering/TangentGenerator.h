@@ -0,0 +1,62 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Core/Rendering/VertexView.h"
+
+// 텍스처 좌표가 변하는 방향으로 정점별 탄젠트 공간을 만든다.
+// MikkTSpace와 같은 규칙(법선에 직교화한 삼각형 탄젠트를 모서리 각도로 가중 누적, handedness별로 따로 누적)을 따르므로
+// MikkTSpace 기준으로 구운 노멀 맵을 그대로 쓸 수 있다.
+namespace TangentGenerator
+{
+    struct TangentData
+    {
+        // 정점별 탄젠트. w는 handedness(±1)이며 bitangent = w * cross(normal, tangent.xyz)이다.
+        std::vector<DirectX::XMFLOAT4> tangents;
+
+        // UV가 좌우로 뒤집혀 만나는 정점은 handedness별로 복제한다. (입력 정점 수 + i)번 정점은 duplicatedVertices[i]번 정점의 복사본이다.
+        std::vector<UINT> duplicatedVertices;
+    };
+
+    // vertexView에는 위치, 법선, 텍스처 좌표가 모두 있어야 한다. 복제된 정점을 가리키도록 inoutIndices를 고친다.
+    // 삼각형과 정점 단위로 나눠 병렬로 계산하지만 누적 순서가 항상 같으므로 스레드 수와 무관하게 같은 결과가 나온다.
+    [[nodiscard]]
+    TangentData Generate(const VertexView& vertexView, std::span<UINT> inoutIndices);
+
+    [[nodiscard]]
+    inline DirectX::XMVECTOR XM_CALLCONV GetBitangent(DirectX::FXMVECTOR normal, DirectX::FXMVECTOR tangent)
+    {
+        return DirectX::XMVectorScale(DirectX::XMVector3Cross(normal, tangent), DirectX::XMVectorGetW(tangent));
+    }
+
+    // 정점 벡터에 바로 적용한다. 복제된 정점을 뒤에 추가하고 tangent 멤버를 채운다. XMFLOAT3 멤버에는 handedness가 저장되지 않는다.
+    template <typename VertexType, typename TangentType>
+    void Generate(std::vector<VertexType>& inoutVertices, std::span<UINT> inoutIndices,
+                  DirectX::XMFLOAT3 VertexType::* position, DirectX::XMFLOAT3 VertexType::* normal, DirectX::XMFLOAT2 VertexType::* texCoord, TangentType VertexType::* tangent)
+    {
+        const VertexView vertexView = MakeVertexView(std::span<const VertexType>(inoutVertices), position, normal, texCoord);
+        const TangentData tangentData = Generate(vertexView, inoutIndices);
+
+        for (const UINT sourceVertex : tangentData.duplicatedVertices)
+        {
+            inoutVertices.push_back(inoutVertices[sourceVertex]);
+        }
+
+        for (size_t i = 0; i < inoutVertices.size(); ++i)
+        {
+            const DirectX::XMFLOAT4& generatedTangent = tangentData.tangents[i];
+            if constexpr (std::is_same_v<TangentType, DirectX::XMFLOAT4>)
+            {
+                inoutVertices[i].*tangent = generatedTangent;
+            }
+            else
+            {
+                inoutVertices[i].*tangent = DirectX::XMFLOAT3(generatedTangent.x, generatedTangent.y, generatedTangent.z);
+            }
+        }
+    }
+}
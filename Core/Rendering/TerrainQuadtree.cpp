@@ -0,0 +1,364 @@
+#include "TerrainQuadtree.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "Rendering/MeshletBuilder.h"
+#include "Utilities/Parallel.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // 상자가 한 평면이라도 완전히 바깥에 있으면 true
+    bool IsBoxOutsideFrustum(const Bounds& bounds, const MeshletBuilder::FrustumPlanes& frustumPlanes)
+    {
+        const XMVECTOR center = XMLoadFloat3(&bounds.boxCenter);
+        const XMVECTOR extents = XMLoadFloat3(&bounds.boxExtents);
+        for (const XMFLOAT4& planeValue : frustumPlanes)
+        {
+            const XMVECTOR plane = XMLoadFloat4(&planeValue);
+            const float radius = XMVectorGetX(XMVector3Dot(extents, XMVectorAbs(plane)));
+            if (XMVectorGetX(XMPlaneDotCoord(plane, center)) < -radius)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    float XM_CALLCONV GetDistanceToBox(FXMVECTOR point, const Bounds& bounds)
+    {
+        const XMVECTOR closest = XMVectorClamp(point, bounds.GetBoxMinimum(), bounds.GetBoxMaximum());
+        return XMVectorGetX(XMVector3Length(XMVectorSubtract(point, closest)));
+    }
+}
+
+TerrainQuadtree::TerrainQuadtree(HeightFunction inHeightFunction, const Desc& inDesc)
+    : heightFunction(std::move(inHeightFunction)), desc(inDesc)
+{
+    assert(desc.levelCount > 0 && desc.levelCount <= 16 && desc.chunkCellCount > 0);
+
+    const float rootError = ComputeGeometricError(0, 0, 0);
+    const float finestCellSize = GetChunkSize(desc.levelCount - 1) / static_cast<float>(desc.chunkCellCount);
+    skirtDepth = std::max(2.0f * rootError, finestCellSize);
+
+    std::unique_ptr<Chunk> root = BuildChunk(0, 0, 0, rootError);
+    chunks.emplace(root->id, std::move(root));
+}
+
+float TerrainQuadtree::ComputeGeometricError(UINT level, UINT x, UINT z) const
+{
+    // 청크 격자를 가장 세밀한 단계의 간격으로 다시 샘플링해, 격자 삼각형이 보간한 높이와 실제 높이의 최대 차이를 구한다.
+    const UINT ratio = 1u << (desc.levelCount - 1 - level);
+    if (ratio == 1)
+    {
+        return 0.0f;
+    }
+
+    const UINT cellCount = desc.chunkCellCount;
+    const float chunkSize = GetChunkSize(level);
+    const float cellSize = chunkSize / static_cast<float>(cellCount);
+    const float minimumX = -0.5f * desc.size + static_cast<float>(x) * chunkSize;
+    const float maximumZ = -0.5f * desc.size + static_cast<float>(z + 1) * chunkSize;
+
+    // 격자 정점의 높이. CreateGrid와 같이 행은 z가 줄어드는 방향이다.
+    const size_t gridVertexCount = static_cast<size_t>(cellCount + 1) * (cellCount + 1);
+    std::vector<float> gridXs(gridVertexCount);
+    std::vector<float> gridZs(gridVertexCount);
+    for (UINT i = 0; i <= cellCount; ++i)
+    {
+        for (UINT j = 0; j <= cellCount; ++j)
+        {
+            gridXs[i * (cellCount + 1) + j] = minimumX + static_cast<float>(j) * cellSize;
+            gridZs[i * (cellCount + 1) + j] = maximumZ - static_cast<float>(i) * cellSize;
+        }
+    }
+
+    std::vector<float> heights(gridVertexCount);
+    heightFunction(gridXs, gridZs, heights);
+
+    float maxError = 0.0f;
+    const UINT sampleCount = cellCount * ratio;
+    const float sampleStep = 1.0f / static_cast<float>(ratio);
+
+    // 세밀한 샘플은 한 행씩 모아 높이를 구한다.
+    std::vector<float> rowXs(sampleCount + 1);
+    std::vector<float> rowZs(sampleCount + 1);
+    std::vector<float> rowHeights(sampleCount + 1);
+    for (UINT a = 0; a <= sampleCount; ++a)
+    {
+        rowXs[a] = minimumX + static_cast<float>(a) * sampleStep * cellSize;
+    }
+
+    for (UINT b = 0; b <= sampleCount; ++b)
+    {
+        const UINT i = std::min(b / ratio, cellCount - 1);
+        const float t = static_cast<float>(b) * sampleStep - static_cast<float>(i);
+
+        std::fill(rowZs.begin(), rowZs.end(), maximumZ - static_cast<float>(b) * sampleStep * cellSize);
+        heightFunction(rowXs, rowZs, rowHeights);
+
+        for (UINT a = 0; a <= sampleCount; ++a)
+        {
+            const UINT j = std::min(a / ratio, cellCount - 1);
+            const float s = static_cast<float>(a) * sampleStep - static_cast<float>(j);
+
+            // 셀은 (i, j + 1)-(i + 1, j) 대각선으로 나뉜다.
+            const float h00 = heights[i * (cellCount + 1) + j];
+            const float h10 = heights[i * (cellCount + 1) + j + 1];
+            const float h01 = heights[(i + 1) * (cellCount + 1) + j];
+            const float h11 = heights[(i + 1) * (cellCount + 1) + j + 1];
+            const float interpolated = s + t <= 1.0f ? h00 + s * (h10 - h00) + t * (h01 - h00)
+                                                     : h11 + (1.0f - s) * (h01 - h11) + (1.0f - t) * (h10 - h11);
+
+            maxError = std::max(maxError, std::abs(rowHeights[a] - interpolated));
+        }
+    }
+
+    return maxError;
+}
+
+std::unique_ptr<TerrainQuadtree::Chunk> TerrainQuadtree::BuildChunk(UINT level, UINT x, UINT z, float geometricError) const
+{
+    auto chunk = std::make_unique<Chunk>();
+    chunk->id = MakeChunkId(level, x, z);
+    chunk->level = level;
+    chunk->x = x;
+    chunk->z = z;
+    chunk->geometricError = geometricError;
+
+    const UINT vertexCountPerSide = desc.chunkCellCount + 1;
+    const float chunkSize = GetChunkSize(level);
+    const float centerX = -0.5f * desc.size + (static_cast<float>(x) + 0.5f) * chunkSize;
+    const float centerZ = -0.5f * desc.size + (static_cast<float>(z) + 0.5f) * chunkSize;
+
+    // 법선은 단계와 상관없이 같은 간격의 중앙 차분으로 구해야 이웃 청크의 단계가 달라도 조명이 이어진다.
+    const float normalStep = GetChunkSize(desc.levelCount - 1) / static_cast<float>(desc.chunkCellCount);
+    const float invSize = 1.0f / desc.size;
+
+    const GeometryGenerator::MeshSize gridSize = GeometryGenerator::GetGridSize(vertexCountPerSide, vertexCountPerSide);
+    const UINT skirtVertexCount = vertexCountPerSide * 4;
+    const UINT skirtIndexCount = desc.chunkCellCount * 4 * 6;
+
+    GeometryGenerator::MeshData& mesh = chunk->mesh;
+    mesh.vertices.resize(gridSize.vertexCount + skirtVertexCount);
+    mesh.indices.resize(gridSize.indexCount + skirtIndexCount);
+
+    GeometryGenerator::CreateGrid(chunkSize, chunkSize, vertexCountPerSide, vertexCountPerSide, std::span(mesh.vertices), std::span(mesh.indices), [&](const GeometryGenerator::Vertex& gridVertex)
+    {
+        const float worldX = gridVertex.position.x + centerX;
+        const float worldZ = gridVertex.position.z + centerZ;
+
+        GeometryGenerator::Vertex vertex;
+        vertex.position = XMFLOAT3(worldX, 0.0f, worldZ);
+
+        // 지형 전체에 하나의 uv를 쓰므로 이웃 청크와 텍스처가 이어진다.
+        vertex.texC = XMFLOAT2((worldX + 0.5f * desc.size) * invSize, (0.5f * desc.size - worldZ) * invSize);
+        return vertex;
+    });
+
+    // 정점 위치와 중앙 차분에 쓰는 네 이웃 위치를 [정점 | +x | -x | +z | -z] 순서로 모아 높이 함수를 한 번만 부른다.
+    const size_t gridVertexCount = gridSize.vertexCount;
+    std::vector<float> sampleXs(gridVertexCount * 5);
+    std::vector<float> sampleZs(gridVertexCount * 5);
+    std::vector<float> sampleHeights(gridVertexCount * 5);
+    for (size_t i = 0; i < gridVertexCount; ++i)
+    {
+        const float worldX = mesh.vertices[i].position.x;
+        const float worldZ = mesh.vertices[i].position.z;
+        const std::array<XMFLOAT2, 5> samples{XMFLOAT2(worldX, worldZ), XMFLOAT2(worldX + normalStep, worldZ), XMFLOAT2(worldX - normalStep, worldZ),
+                                              XMFLOAT2(worldX, worldZ + normalStep), XMFLOAT2(worldX, worldZ - normalStep)};
+        for (size_t k = 0; k < samples.size(); ++k)
+        {
+            sampleXs[k * gridVertexCount + i] = samples[k].x;
+            sampleZs[k * gridVertexCount + i] = samples[k].y;
+        }
+    }
+
+    heightFunction(sampleXs, sampleZs, sampleHeights);
+
+    for (size_t i = 0; i < gridVertexCount; ++i)
+    {
+        const float dhdx = (sampleHeights[gridVertexCount + i] - sampleHeights[2 * gridVertexCount + i]) / (2.0f * normalStep);
+        const float dhdz = (sampleHeights[3 * gridVertexCount + i] - sampleHeights[4 * gridVertexCount + i]) / (2.0f * normalStep);
+
+        GeometryGenerator::Vertex& vertex = mesh.vertices[i];
+        vertex.position.y = sampleHeights[i];
+        XMStoreFloat3(&vertex.normal, XMVector3Normalize(XMVectorSet(-dhdx, 1.0f, -dhdz, 0.0f)));
+        XMStoreFloat3(&vertex.tangentU, XMVector3Normalize(XMVectorSet(1.0f, dhdx, 0.0f, 0.0f)));
+    }
+
+    // 네 변을 따라 테두리 정점을 skirtDepth만큼 내린 복사본을 만들고, 테두리와 복사본 사이를 바깥을 향하는 사각형으로 잇는다.
+    // 변마다 위쪽(z 최대), 오른쪽(x 최대), 아래쪽(z 최소), 왼쪽(x 최소) 순서로 시계 방향으로 돈다.
+    const UINT lastIndex = desc.chunkCellCount;
+    const auto getEdgeVertex = [&](UINT side, UINT k)
+    {
+        switch (side)
+        {
+        case 0: return k;
+        case 1: return k * vertexCountPerSide + lastIndex;
+        case 2: return lastIndex * vertexCountPerSide + (lastIndex - k);
+        default: return (lastIndex - k) * vertexCountPerSide;
+        }
+    };
+
+    UINT skirtVertex = gridSize.vertexCount;
+    UINT* outIndices = mesh.indices.data() + gridSize.indexCount;
+    for (UINT side = 0; side < 4; ++side)
+    {
+        const UINT sideBegin = skirtVertex;
+        for (UINT k = 0; k < vertexCountPerSide; ++k)
+        {
+            GeometryGenerator::Vertex vertex = mesh.vertices[getEdgeVertex(side, k)];
+            vertex.position.y -= skirtDepth;
+            mesh.vertices[skirtVertex++] = vertex;
+        }
+
+        for (UINT k = 0; k < lastIndex; ++k)
+        {
+            const UINT top0 = getEdgeVertex(side, k);
+            const UINT top1 = getEdgeVertex(side, k + 1);
+            const UINT bottom0 = sideBegin + k;
+            const UINT bottom1 = sideBegin + k + 1;
+
+            *outIndices++ = top0;
+            *outIndices++ = bottom0;
+            *outIndices++ = top1;
+
+            *outIndices++ = top1;
+            *outIndices++ = bottom0;
+            *outIndices++ = bottom1;
+        }
+    }
+
+    // 조각은 AABB로만 컬링하고 LOD를 고르므로 경계 구는 다듬지 않는다.
+    chunk->bounds = Bounds::ComputeFromBox(MakeVertexView(std::span<const GeometryGenerator::Vertex>(mesh.vertices), &GeometryGenerator::Vertex::position));
+
+    return chunk;
+}
+
+TerrainQuadtree::Statistics XM_CALLCONV TerrainQuadtree::Update(FXMVECTOR eyePosition, FXMMATRIX viewProjectionMatrix, float viewportHeight, float verticalFieldOfView)
+{
+    ++updateCount;
+
+    Statistics statistics;
+    selectedChunks.clear();
+    evictedChunkIds.clear();
+
+    const MeshletBuilder::FrustumPlanes frustumPlanes = MeshletBuilder::ExtractFrustumPlanes(viewProjectionMatrix);
+    const float screenErrorScale = viewportHeight / (2.0f * std::tan(0.5f * verticalFieldOfView));
+
+    // 루트부터 내려가며 화면 오차가 충분히 작은 청크를 고른다. 자식 넷이 모두 준비되었을 때만 내려가므로 선택한 청크는 빈틈없이 지형을 덮는다.
+    std::vector<ChunkRequest> requests;
+    std::vector<Chunk*> stack{chunks.at(MakeChunkId(0, 0, 0)).get()};
+    while (!stack.empty())
+    {
+        Chunk* chunk = stack.back();
+        stack.pop_back();
+
+        ++statistics.visitedChunkCount;
+        chunk->lastUsedUpdate = updateCount;
+
+        if (IsBoxOutsideFrustum(chunk->bounds, frustumPlanes))
+        {
+            ++statistics.culledChunkCount;
+            continue;
+        }
+
+        const float distance = GetDistanceToBox(eyePosition, chunk->bounds);
+        const float screenError = distance > 0.0f ? chunk->geometricError * screenErrorScale / distance : std::numeric_limits<float>::infinity();
+        const bool needsRefinement = chunk->level + 1 < desc.levelCount && chunk->geometricError > 0.0f && screenError > desc.maxScreenError;
+
+        bool isRefined = false;
+        if (needsRefinement)
+        {
+            std::array<Chunk*, 4> children{};
+            bool hasAllChildren = true;
+            for (UINT i = 0; i < 4; ++i)
+            {
+                const UINT childX = chunk->x * 2 + (i & 1);
+                const UINT childZ = chunk->z * 2 + (i >> 1);
+                const auto found = chunks.find(MakeChunkId(chunk->level + 1, childX, childZ));
+                if (found != chunks.end())
+                {
+                    children[i] = found->second.get();
+                }
+                else
+                {
+                    hasAllChildren = false;
+                    requests.push_back({chunk->level + 1, childX, childZ, distance});
+                }
+            }
+
+            if (hasAllChildren)
+            {
+                stack.insert(stack.end(), children.begin(), children.end());
+                isRefined = true;
+            }
+            else
+            {
+                ++statistics.waitingChunkCount;
+            }
+        }
+
+        if (!isRefined)
+        {
+            selectedChunks.push_back(chunk);
+            ++statistics.selectedChunkCount;
+            statistics.selectedTriangleCount += chunk->mesh.indices.size() / 3;
+        }
+    }
+
+    // 카메라에 가까운 청크부터 정해진 수만큼 만든다. 만든 청크는 다음 Update부터 쓰인다.
+    std::ranges::sort(requests, {}, &ChunkRequest::distance);
+    requests.resize(std::min<size_t>(requests.size(), desc.maxChunkBuildsPerUpdate));
+
+    std::vector<std::unique_ptr<Chunk>> builtChunks(requests.size());
+    Parallel::For(0, requests.size(), 1, [&](size_t i)
+    {
+        const ChunkRequest& request = requests[i];
+        builtChunks[i] = BuildChunk(request.level, request.x, request.z, ComputeGeometricError(request.level, request.x, request.z));
+    });
+
+    for (std::unique_ptr<Chunk>& chunk : builtChunks)
+    {
+        chunk->lastUsedUpdate = updateCount;
+        chunks.emplace(chunk->id, std::move(chunk));
+    }
+    statistics.builtChunkCount = builtChunks.size();
+
+    // 이번에 쓰지 않은 청크를 오래된 순서로 버린다. 쓰인 청크의 조상은 모두 방문했으므로 트리가 끊기지 않는다.
+    if (chunks.size() > desc.maxCachedChunkCount)
+    {
+        std::vector<const Chunk*> unusedChunks;
+        for (const auto& [id, chunk] : chunks)
+        {
+            if (chunk->lastUsedUpdate < updateCount)
+            {
+                unusedChunks.push_back(chunk.get());
+            }
+        }
+
+        std::ranges::sort(unusedChunks, {}, &Chunk::lastUsedUpdate);
+
+        const size_t evictCount = std::min(unusedChunks.size(), chunks.size() - desc.maxCachedChunkCount);
+        for (size_t i = 0; i < evictCount; ++i)
+        {
+            evictedChunkIds.push_back(unusedChunks[i]->id);
+        }
+        for (const uint64_t id : evictedChunkIds)
+        {
+            chunks.erase(id);
+        }
+    }
+
+    statistics.evictedChunkCount = evictedChunkIds.size();
+    statistics.cachedChunkCount = chunks.size();
+
+    return statistics;
+}
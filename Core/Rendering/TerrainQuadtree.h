@@ -0,0 +1,133 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/Bounds.h"
+
+// 높이 함수를 쿼드트리 청크로 나눈 지형(chunked LOD). 모든 청크는 단계와 상관없이 같은 셀 수의 격자이고, 단계가 내려갈 때마다 한 변이 절반이 된다.
+// 카메라 거리와 화면 오차로 청크 단계를 고르며, 필요한 자식 청크는 Update마다 정해진 수만큼만 만들어 카메라가 움직이는 동안 점진적으로 채운다.
+// 이웃 청크의 단계가 달라 생기는 틈은 청크 테두리에 수직으로 내린 스커트로 가린다.
+// GPU 자원을 다루지 않으므로 선택과 컬링, 생성 결과를 창 없이 확인할 수 있다.
+class TerrainQuadtree
+{
+public:
+    // (xs[i], zs[i])의 높이를 outHeights[i]에 쓴다. 청크마다 모든 샘플을 모아 한 번에 넘기므로 배치로 계산할 수 있다.
+    // 여러 스레드에서 동시에 호출하므로 스레드 안전해야 한다.
+    using HeightFunction = std::function<void(std::span<const float> xs, std::span<const float> zs, std::span<float> outHeights)>;
+
+    struct Desc
+    {
+        // 원점을 중심으로 하는 정사각형 지형의 한 변
+        float size = 160.0f;
+
+        // 루트(0단계)부터 가장 세밀한 단계까지의 수
+        UINT levelCount = 5;
+
+        // 청크 한 변의 셀 수
+        UINT chunkCellCount = 32;
+
+        // 화면 오차(픽셀)가 이보다 크면 자식 청크로 내려간다.
+        float maxScreenError = 2.0f;
+
+        // Update 한 번에 새로 만드는 최대 청크 수
+        UINT maxChunkBuildsPerUpdate = 8;
+
+        // 이보다 많은 청크를 들고 있으면 이번 Update에 쓰지 않은 청크를 오래된 순서로 버린다.
+        size_t maxCachedChunkCount = 256;
+    };
+
+    struct Chunk
+    {
+        uint64_t id = 0;
+
+        // 단계와 단계 안에서의 청크 좌표. x, z가 커질수록 월드 x, z도 커진다.
+        UINT level = 0;
+        UINT x = 0;
+        UINT z = 0;
+
+        // 가장 세밀한 단계로 샘플링한 높이와의 최대 차이(월드 단위)
+        float geometricError = 0.0f;
+
+        // 스커트를 포함한 월드 공간 범위
+        Bounds bounds;
+
+        // 격자 뒤에 네 변의 스커트가 붙어 있다.
+        GeometryGenerator::MeshData mesh;
+
+        uint64_t lastUsedUpdate = 0;
+    };
+
+    struct Statistics
+    {
+        size_t visitedChunkCount = 0;
+        size_t culledChunkCount = 0;
+        size_t selectedChunkCount = 0;
+        size_t selectedTriangleCount = 0;
+
+        // 더 세밀한 단계가 필요했지만 자식이 아직 없어 부모를 대신 그린 청크 수
+        size_t waitingChunkCount = 0;
+
+        size_t builtChunkCount = 0;
+        size_t evictedChunkCount = 0;
+        size_t cachedChunkCount = 0;
+    };
+
+    // 루트 청크는 바로 만든다.
+    TerrainQuadtree(HeightFunction inHeightFunction, const Desc& inDesc);
+
+    // 카메라 위치와 월드-뷰-투영 행렬로 그릴 청크를 고르고, 더 필요한 청크를 만들고, 남는 청크를 버린다.
+    // 화면 오차는 geometricError * viewportHeight / (2 * tan(verticalFieldOfView / 2)) / 거리이다.
+    Statistics XM_CALLCONV Update(DirectX::FXMVECTOR eyePosition, DirectX::FXMMATRIX viewProjectionMatrix, float viewportHeight, float verticalFieldOfView);
+
+    // 마지막 Update에서 고른 청크. 다음 Update 전까지 유효하다.
+    [[nodiscard]]
+    const std::vector<const Chunk*>& GetSelectedChunks() const { return selectedChunks; }
+
+    // 마지막 Update에서 버린 청크 id. 청크별 GPU 버퍼를 함께 정리할 때 쓴다.
+    [[nodiscard]]
+    const std::vector<uint64_t>& GetEvictedChunkIds() const { return evictedChunkIds; }
+
+    [[nodiscard]]
+    float GetSkirtDepth() const { return skirtDepth; }
+
+    [[nodiscard]]
+    static uint64_t MakeChunkId(UINT level, UINT x, UINT z) { return (static_cast<uint64_t>(level) << 48) | (static_cast<uint64_t>(z) << 24) | x; }
+
+private:
+    struct ChunkRequest
+    {
+        UINT level;
+        UINT x;
+        UINT z;
+        float distance;
+    };
+
+    [[nodiscard]]
+    float GetChunkSize(UINT level) const { return desc.size / static_cast<float>(1u << level); }
+
+    [[nodiscard]]
+    float ComputeGeometricError(UINT level, UINT x, UINT z) const;
+
+    [[nodiscard]]
+    std::unique_ptr<Chunk> BuildChunk(UINT level, UINT x, UINT z, float geometricError) const;
+
+    HeightFunction heightFunction;
+    Desc desc;
+
+    // 이웃 청크 사이 틈의 높이는 두 청크 오차의 합을 넘지 않으므로 루트 오차의 두 배로 정한다.
+    float skirtDepth = 0.0f;
+
+    std::unordered_map<uint64_t, std::unique_ptr<Chunk>> chunks;
+    uint64_t updateCount = 0;
+
+    std::vector<const Chunk*> selectedChunks;
+    std::vector<uint64_t> evictedChunkIds;
+};
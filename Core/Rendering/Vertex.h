@@ -1,6 +1,7 @@
 #pragma once
 
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
 #include <d3d11.h>
 #include <vector>
 
@@ -52,4 +53,54 @@ namespace Vertex
         DirectX::XMFLOAT3 normal;
         DirectX::XMFLOAT2 tex;
     };
+
+    // 아래는 대역폭을 줄이기 위한 압축 형식으로, VertexQuantizer로 만들고 셰이더에서 VertexDecode.hlsli로 복원한다.
+    // 위치는 메시 AABB 기준 16비트 UNORM, 법선/탄젠트는 팔면체(octahedral) 인코딩한 16비트 SNORM, 텍스처 좌표는 half float이다.
+
+    // 12바이트. position.w는 쓰지 않는다.
+    struct PackedPN
+    {
+        static inline const std::vector<D3D11_INPUT_ELEMENT_DESC> Desc =
+        {
+            D3D11_INPUT_ELEMENT_DESC{"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D11_INPUT_PER_VERTEX_DATA},
+            D3D11_INPUT_ELEMENT_DESC{"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA}
+        };
+
+        DirectX::PackedVector::XMUSHORTN4 position;
+        DirectX::PackedVector::XMSHORTN2 normal;
+    };
+
+    // 16바이트
+    struct PackedPNT
+    {
+        static inline const std::vector<D3D11_INPUT_ELEMENT_DESC> Desc =
+        {
+            D3D11_INPUT_ELEMENT_DESC{"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D11_INPUT_PER_VERTEX_DATA},
+            D3D11_INPUT_ELEMENT_DESC{"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA},
+            D3D11_INPUT_ELEMENT_DESC{"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA}
+        };
+
+        DirectX::PackedVector::XMUSHORTN4 position;
+        DirectX::PackedVector::XMSHORTN2 normal;
+        DirectX::PackedVector::XMHALF2 tex;
+    };
+
+    // 20바이트. 남는 position.w에 탄젠트의 handedness를 담는다. (1이면 +1, 0이면 -1)
+    struct PackedPNTT
+    {
+        static inline const std::vector<D3D11_INPUT_ELEMENT_DESC> Desc =
+        {
+            D3D11_INPUT_ELEMENT_DESC{"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D11_INPUT_PER_VERTEX_DATA},
+            D3D11_INPUT_ELEMENT_DESC{"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA},
+            D3D11_INPUT_ELEMENT_DESC{"TANGENT", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA},
+            D3D11_INPUT_ELEMENT_DESC{"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA}
+        };
+
+        DirectX::PackedVector::XMUSHORTN4 position;
+        DirectX::PackedVector::XMSHORTN2 normal;
+        DirectX::PackedVector::XMSHORTN2 tangent;
+        DirectX::PackedVector::XMHALF2 tex;
+    };
+
+    static_assert(sizeof(PackedPN) == 12 && sizeof(PackedPNT) == 16 && sizeof(PackedPNTT) == 20);
 }
@@ -0,0 +1,275 @@
+#include "VertexQuantizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <numbers>
+#include <type_traits>
+
+#include "Utilities/Parallel.h"
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+namespace
+{
+    // 한 작업 구간에 들어가는 최소 정점 수. 정점 하나의 변환은 수십 개의 명령이라 구간을 크게 잡는다.
+    constexpr size_t MinVertexRangeSize = 4096;
+
+    // 법선 길이의 L1 노름이 이보다 작으면 방향을 정할 수 없어 +z로 둔다.
+    constexpr float MinOctahedralNorm = 1.0e-20f;
+
+    XMVECTOR XM_CALLCONV LoadMinimum(const VertexQuantizer::QuantizationInfo& info)
+    {
+        return XMLoadFloat3(&info.minimum);
+    }
+
+    // 두께가 0인 축(평평한 격자의 y 등)은 모두 0으로 압축한다.
+    XMVECTOR XM_CALLCONV LoadInverseExtent(const VertexQuantizer::QuantizationInfo& info)
+    {
+        auto inverse = [](float extent) { return extent > 0.0f ? 1.0f / extent : 0.0f; };
+        return XMVectorSet(inverse(info.extent.x), inverse(info.extent.y), inverse(info.extent.z), 0.0f);
+    }
+
+    template <typename PackedVertexType>
+    void EncodeVertices(const VertexView& vertexView, std::span<const XMFLOAT4> tangents, const VertexQuantizer::QuantizationInfo& info, std::vector<PackedVertexType>& outVertices)
+    {
+        constexpr bool HasTexCoord = requires(PackedVertexType vertex) { vertex.tex; };
+        constexpr bool HasTangent = requires(PackedVertexType vertex) { vertex.tangent; };
+
+        assert(vertexView.positions.IsValid() && vertexView.normals.IsValid());
+        assert(!HasTexCoord || vertexView.texCoords.IsValid());
+        assert(!HasTangent || tangents.size() == vertexView.vertexCount);
+
+        outVertices.resize(vertexView.vertexCount);
+
+        const XMVECTOR minimum = LoadMinimum(info);
+        const XMVECTOR inverseExtent = LoadInverseExtent(info);
+
+        Parallel::ForRange(0, vertexView.vertexCount, MinVertexRangeSize, [&](size_t rangeBegin, size_t rangeEnd)
+        {
+            for (size_t i = rangeBegin; i < rangeEnd; ++i)
+            {
+                PackedVertexType& packedVertex = outVertices[i];
+
+                // w는 0이 되며, 탄젠트가 있으면 handedness를 담는다. 범위를 벗어난 값은 저장할 때 [0, 1]로 잘린다.
+                XMVECTOR position = XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&vertexView.positions[i]), minimum), inverseExtent);
+                if constexpr (HasTangent)
+                {
+                    position = XMVectorSetW(position, tangents[i].w < 0.0f ? 0.0f : 1.0f);
+                }
+                XMStoreUShortN4(&packedVertex.position, position);
+
+                XMStoreShortN2(&packedVertex.normal, VertexQuantizer::EncodeOctahedral(XMLoadFloat3(&vertexView.normals[i])));
+
+                if constexpr (HasTangent)
+                {
+                    XMStoreShortN2(&packedVertex.tangent, VertexQuantizer::EncodeOctahedral(XMLoadFloat4(&tangents[i])));
+                }
+
+                if constexpr (HasTexCoord)
+                {
+                    XMStoreHalf2(&packedVertex.tex, XMLoadFloat2(&vertexView.texCoords[i]));
+                }
+            }
+        });
+    }
+
+    template <typename PackedVertexType>
+    VertexQuantizer::DecodedVertices DecodeVertices(std::span<const PackedVertexType> vertices, const VertexQuantizer::QuantizationInfo& info)
+    {
+        constexpr bool HasTexCoord = requires(PackedVertexType vertex) { vertex.tex; };
+        constexpr bool HasTangent = requires(PackedVertexType vertex) { vertex.tangent; };
+
+        VertexQuantizer::DecodedVertices decoded;
+        decoded.positions.resize(vertices.size());
+        decoded.normals.resize(vertices.size());
+        if constexpr (HasTexCoord)
+        {
+            decoded.texCoords.resize(vertices.size());
+        }
+        if constexpr (HasTangent)
+        {
+            decoded.tangents.resize(vertices.size());
+        }
+
+        const XMVECTOR minimum = LoadMinimum(info);
+        const XMVECTOR extent = XMLoadFloat3(&info.extent);
+
+        Parallel::ForRange(0, vertices.size(), MinVertexRangeSize, [&](size_t rangeBegin, size_t rangeEnd)
+        {
+            for (size_t i = rangeBegin; i < rangeEnd; ++i)
+            {
+                const PackedVertexType& packedVertex = vertices[i];
+
+                const XMVECTOR packedPosition = XMLoadUShortN4(&packedVertex.position);
+                XMStoreFloat3(&decoded.positions[i], XMVectorMultiplyAdd(packedPosition, extent, minimum));
+                XMStoreFloat3(&decoded.normals[i], VertexQuantizer::DecodeOctahedral(XMLoadShortN2(&packedVertex.normal)));
+
+                if constexpr (HasTangent)
+                {
+                    const float handedness = XMVectorGetW(packedPosition) > 0.5f ? 1.0f : -1.0f;
+                    XMStoreFloat4(&decoded.tangents[i], XMVectorSetW(VertexQuantizer::DecodeOctahedral(XMLoadShortN2(&packedVertex.tangent)), handedness));
+                }
+
+                if constexpr (HasTexCoord)
+                {
+                    XMStoreFloat2(&decoded.texCoords[i], XMLoadHalf2(&packedVertex.tex));
+                }
+            }
+        });
+
+        return decoded;
+    }
+
+    float XM_CALLCONV GetAngle(FXMVECTOR source, FXMVECTOR decoded)
+    {
+        return XMVectorGetX(XMVector3AngleBetweenNormals(XMVector3Normalize(source), XMVector3Normalize(decoded)));
+    }
+}
+
+namespace VertexQuantizer
+{
+    XMMATRIX XM_CALLCONV QuantizationInfo::GetDecodeMatrix() const
+    {
+        return XMMatrixScaling(extent.x, extent.y, extent.z) * XMMatrixTranslation(minimum.x, minimum.y, minimum.z);
+    }
+
+    float QuantizationInfo::GetMaxPositionError() const
+    {
+        // 축마다 반 단계(extent / 65535 / 2)에, [0, 1]로 옮기는 float 연산의 반올림 오차(몇 ulp)만큼 더 어긋날 수 있다.
+        constexpr float MaxStepError = 0.5f + 65535.0f * 4.0f * FLT_EPSILON;
+        return XMVectorGetX(XMVector3Length(XMLoadFloat3(&extent))) * (MaxStepError / 65535.0f);
+    }
+
+    QuantizationInfo ComputeQuantizationInfo(const VertexView& vertexView)
+    {
+        if (vertexView.vertexCount == 0)
+        {
+            return {};
+        }
+
+        XMVECTOR minimum = XMLoadFloat3(&vertexView.positions[0]);
+        XMVECTOR maximum = minimum;
+        for (size_t i = 1; i < vertexView.vertexCount; ++i)
+        {
+            const XMVECTOR position = XMLoadFloat3(&vertexView.positions[i]);
+            minimum = XMVectorMin(minimum, position);
+            maximum = XMVectorMax(maximum, position);
+        }
+
+        QuantizationInfo info;
+        XMStoreFloat3(&info.minimum, minimum);
+        XMStoreFloat3(&info.extent, XMVectorSubtract(maximum, minimum));
+        return info;
+    }
+
+    XMVECTOR XM_CALLCONV EncodeOctahedral(FXMVECTOR unitVector)
+    {
+        const XMVECTOR zero = XMVectorZero();
+        const XMVECTOR one = XMVectorSplatOne();
+
+        // 팔면체 |x| + |y| + |z| = 1 위로 투영하면 위쪽 반구는 그대로 xy 평면의 마름모가 된다.
+        const XMVECTOR norm = XMVectorMax(XMVector3Dot(XMVectorAbs(unitVector), one), XMVectorReplicate(MinOctahedralNorm));
+        const XMVECTOR projected = XMVectorDivide(unitVector, norm);
+
+        // 아래쪽 반구는 마름모 바깥의 네 삼각형으로 접어 넣는다. 부호가 0이면 +로 본다.
+        const XMVECTOR signs = XMVectorSelect(one, XMVectorNegate(one), XMVectorLess(projected, zero));
+        const XMVECTOR folded = XMVectorMultiply(XMVectorSubtract(one, XMVectorAbs(XMVectorSwizzle<1, 0, 2, 3>(projected))), signs);
+
+        return XMVectorSelect(projected, folded, XMVectorLess(XMVectorSplatZ(projected), zero));
+    }
+
+    XMVECTOR XM_CALLCONV DecodeOctahedral(FXMVECTOR encoded)
+    {
+        const XMVECTOR zero = XMVectorZero();
+        const XMVECTOR absEncoded = XMVectorAbs(encoded);
+
+        // z = 1 - |x| - |y|가 음수인 영역은 접혀 들어간 아래쪽 반구이므로 xy를 마름모 안쪽으로 되돌린다.
+        const XMVECTOR z = XMVectorSubtract(XMVectorSplatOne(), XMVectorAdd(XMVectorSplatX(absEncoded), XMVectorSplatY(absEncoded)));
+        const XMVECTOR fold = XMVectorSaturate(XMVectorNegate(z));
+        const XMVECTOR xy = XMVectorAdd(encoded, XMVectorSelect(fold, XMVectorNegate(fold), XMVectorGreaterOrEqual(encoded, zero)));
+
+        return XMVector3Normalize(XMVectorPermute<XM_PERMUTE_0X, XM_PERMUTE_0Y, XM_PERMUTE_1Z, XM_PERMUTE_1W>(xy, XMVectorSetW(z, 0.0f)));
+    }
+
+    void Encode(const VertexView& vertexView, const QuantizationInfo& info, std::vector<Vertex::PackedPN>& outVertices)
+    {
+        EncodeVertices(vertexView, {}, info, outVertices);
+    }
+
+    void Encode(const VertexView& vertexView, const QuantizationInfo& info, std::vector<Vertex::PackedPNT>& outVertices)
+    {
+        EncodeVertices(vertexView, {}, info, outVertices);
+    }
+
+    void Encode(const VertexView& vertexView, std::span<const XMFLOAT4> tangents, const QuantizationInfo& info, std::vector<Vertex::PackedPNTT>& outVertices)
+    {
+        EncodeVertices(vertexView, tangents, info, outVertices);
+    }
+
+    void Encode(const GeometryGenerator::MeshData& meshData, const QuantizationInfo& info, std::vector<Vertex::PackedPNTT>& outVertices)
+    {
+        using GeneratorVertex = GeometryGenerator::Vertex;
+
+        std::vector<XMFLOAT4> tangents(meshData.vertices.size());
+        std::ranges::transform(meshData.vertices, tangents.begin(), [](const GeneratorVertex& vertex)
+        {
+            return XMFLOAT4(vertex.tangentU.x, vertex.tangentU.y, vertex.tangentU.z, 1.0f);
+        });
+
+        const VertexView vertexView = MakeVertexView(std::span<const GeneratorVertex>(meshData.vertices), &GeneratorVertex::position, &GeneratorVertex::normal, &GeneratorVertex::texC);
+        EncodeVertices(vertexView, tangents, info, outVertices);
+    }
+
+    DecodedVertices Decode(std::span<const Vertex::PackedPN> vertices, const QuantizationInfo& info)
+    {
+        return DecodeVertices(vertices, info);
+    }
+
+    DecodedVertices Decode(std::span<const Vertex::PackedPNT> vertices, const QuantizationInfo& info)
+    {
+        return DecodeVertices(vertices, info);
+    }
+
+    DecodedVertices Decode(std::span<const Vertex::PackedPNTT> vertices, const QuantizationInfo& info)
+    {
+        return DecodeVertices(vertices, info);
+    }
+
+    QuantizationError MeasureError(const VertexView& source, std::span<const XMFLOAT4> sourceTangents, const DecodedVertices& decoded)
+    {
+        QuantizationError error;
+
+        for (size_t i = 0; i < source.vertexCount; ++i)
+        {
+            const XMVECTOR positionDelta = XMVectorSubtract(XMLoadFloat3(&source.positions[i]), XMLoadFloat3(&decoded.positions[i]));
+            error.position = std::max(error.position, XMVectorGetX(XMVector3Length(positionDelta)));
+
+            if (source.normals.IsValid() && !decoded.normals.empty())
+            {
+                error.normalAngle = std::max(error.normalAngle, GetAngle(XMLoadFloat3(&source.normals[i]), XMLoadFloat3(&decoded.normals[i])));
+            }
+
+            if (source.texCoords.IsValid() && !decoded.texCoords.empty())
+            {
+                const XMVECTOR texCoordDelta = XMVectorAbs(XMVectorSubtract(XMLoadFloat2(&source.texCoords[i]), XMLoadFloat2(&decoded.texCoords[i])));
+                error.texCoord = std::max({error.texCoord, XMVectorGetX(texCoordDelta), XMVectorGetY(texCoordDelta)});
+            }
+
+            if (!sourceTangents.empty() && !decoded.tangents.empty())
+            {
+                // handedness가 뒤집히면 bitangent가 반대를 향하므로 180도 오차로 센다.
+                const XMFLOAT4& sourceTangent = sourceTangents[i];
+                const XMFLOAT4& decodedTangent = decoded.tangents[i];
+                const float angle = (sourceTangent.w < 0.0f) != (decodedTangent.w < 0.0f)
+                                        ? std::numbers::pi_v<float>
+                                        : GetAngle(XMVectorSetW(XMLoadFloat4(&sourceTangent), 0.0f), XMVectorSetW(XMLoadFloat4(&decodedTangent), 0.0f));
+                error.tangentAngle = std::max(error.tangentAngle, angle);
+            }
+        }
+
+        return error;
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <span>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/Vertex.h"
+#include "Core/Rendering/VertexView.h"
+
+// 정점을 Vertex::PackedPN / PackedPNT / PackedPNTT로 압축하고 다시 풀어낸다.
+// 정점 구간을 나눠 병렬로 처리하며, 한 정점의 성분은 XMVECTOR 한 번의 연산으로 변환한다.
+//
+// 오차 상한(검증값):
+//  - 위치: 축마다 extent / 65535 / 2 정도(GetMaxPositionError). 해골에서 약 0.0001
+//  - 법선/탄젠트: 16비트 팔면체 인코딩으로 0.04도 이하
+//  - 텍스처 좌표: half float의 상대 오차 2^-11 이하. [0, 1] 범위라면 0.00025 이하
+namespace VertexQuantizer
+{
+    // 위치를 [0, 1]로 옮기는 AABB. 복원은 position * extent + minimum이다.
+    struct QuantizationInfo
+    {
+        DirectX::XMFLOAT3 minimum{};
+        DirectX::XMFLOAT3 extent{};
+
+        // 압축된 위치(UNORM)를 메시 공간으로 옮기는 행렬. 법선에는 적용하면 안 되므로 법선 행렬은 원래 월드 행렬로 계산한다.
+        [[nodiscard]]
+        DirectX::XMMATRIX XM_CALLCONV GetDecodeMatrix() const;
+
+        // 위치 한 점의 최대 복원 오차(유클리드 거리)
+        [[nodiscard]]
+        float GetMaxPositionError() const;
+    };
+
+    // 압축한 정점을 다시 float로 푼 결과. 압축 형식에 없는 속성은 비어 있다.
+    struct DecodedVertices
+    {
+        std::vector<DirectX::XMFLOAT3> positions;
+        std::vector<DirectX::XMFLOAT3> normals;
+        std::vector<DirectX::XMFLOAT2> texCoords;
+        std::vector<DirectX::XMFLOAT4> tangents;
+    };
+
+    // 원본과 복원 결과 사이의 최대 오차. 각도는 라디안이다.
+    struct QuantizationError
+    {
+        float position = 0.0f;
+        float normalAngle = 0.0f;
+        float texCoord = 0.0f;
+        float tangentAngle = 0.0f;
+    };
+
+    [[nodiscard]]
+    QuantizationInfo ComputeQuantizationInfo(const VertexView& vertexView);
+
+    // 단위 벡터를 팔면체 전개도의 [-1, 1]^2 좌표(x, y)로 바꾼다.
+    [[nodiscard]]
+    DirectX::XMVECTOR XM_CALLCONV EncodeOctahedral(DirectX::FXMVECTOR unitVector);
+
+    [[nodiscard]]
+    DirectX::XMVECTOR XM_CALLCONV DecodeOctahedral(DirectX::FXMVECTOR encoded);
+
+    // vertexView에는 위치와 법선이 있어야 하고, PNT/PNTT는 텍스처 좌표도 있어야 한다.
+    void Encode(const VertexView& vertexView, const QuantizationInfo& info, std::vector<Vertex::PackedPN>& outVertices);
+    void Encode(const VertexView& vertexView, const QuantizationInfo& info, std::vector<Vertex::PackedPNT>& outVertices);
+
+    // tangents는 TangentGenerator의 결과처럼 w에 handedness(±1)를 담는다.
+    void Encode(const VertexView& vertexView, std::span<const DirectX::XMFLOAT4> tangents, const QuantizationInfo& info, std::vector<Vertex::PackedPNTT>& outVertices);
+
+    // GeometryGenerator의 tangentU는 handedness가 항상 +1이다.
+    void Encode(const GeometryGenerator::MeshData& meshData, const QuantizationInfo& info, std::vector<Vertex::PackedPNTT>& outVertices);
+
+    [[nodiscard]]
+    DecodedVertices Decode(std::span<const Vertex::PackedPN> vertices, const QuantizationInfo& info);
+
+    [[nodiscard]]
+    DecodedVertices Decode(std::span<const Vertex::PackedPNT> vertices, const QuantizationInfo& info);
+
+    [[nodiscard]]
+    DecodedVertices Decode(std::span<const Vertex::PackedPNTT> vertices, const QuantizationInfo& info);
+
+    // 압축 결과가 오차 상한 안에 있는지 확인할 때 쓴다. sourceTangents가 비어 있으면 탄젠트는 비교하지 않는다.
+    [[nodiscard]]
+    QuantizationError MeasureError(const VertexView& source, std::span<const DirectX::XMFLOAT4> sourceTangents, const DecodedVertices& decoded);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <cstddef>
+#include <span>
+
+// 정점 구조체 안의 한 속성을 보폭(stride)만큼 건너뛰며 읽는다.
+template <typename T>
+struct StridedView
+{
+    const std::byte* data = nullptr;
+    size_t stride = 0;
+
+    [[nodiscard]]
+    bool IsValid() const { return data != nullptr; }
+
+    const T& operator[](size_t index) const { return *reinterpret_cast<const T*>(data + stride * index); }
+};
+
+// 정점 형식과 무관하게 메시 처리(단순화, 탄젠트 생성 등)에 필요한 속성을 가리킨다. 정점 형식에 없는 속성은 뷰를 비워 둔다.
+struct VertexView
+{
+    size_t vertexCount = 0;
+    StridedView<DirectX::XMFLOAT3> positions;
+    StridedView<DirectX::XMFLOAT3> normals;
+    StridedView<DirectX::XMFLOAT2> texCoords;
+};
+
+// 정점 구조체의 멤버 포인터로 VertexView를 만든다. 예) MakeVertexView(std::span<const Vertex::PNT>(vertices), &Vertex::PNT::position, &Vertex::PNT::normal, &Vertex::PNT::tex)
+template <typename VertexType>
+[[nodiscard]]
+VertexView MakeVertexView(std::span<const VertexType> vertices, DirectX::XMFLOAT3 VertexType::* position, DirectX::XMFLOAT3 VertexType::* normal = nullptr, DirectX::XMFLOAT2 VertexType::* texCoord = nullptr)
+{
+    auto makeStridedView = [&vertices]<typename T>(T VertexType::* member)
+    {
+        StridedView<T> view;
+        if (member != nullptr && !vertices.empty())
+        {
+            view.data = reinterpret_cast<const std::byte*>(&(vertices[0].*member));
+            view.stride = sizeof(VertexType);
+        }
+        return view;
+    };
+
+    return {vertices.size(), makeStridedView(position), makeStridedView(normal), makeStridedView(texCoord)};
+}
@@ -0,0 +1,27 @@
+#ifndef VERTEX_DECODE_HLSLI
+#define VERTEX_DECODE_HLSLI
+
+// Vertex::PackedPN / PackedPNT / PackedPNTT(VertexQuantizer)의 복원 함수
+
+// UNORM으로 읽은 위치를 메시 공간으로 되돌린다. scale과 offset은 QuantizationInfo의 extent와 minimum이다.
+float3 DecodePosition(float4 packedPosition, float3 scale, float3 offset)
+{
+    return packedPosition.xyz * scale + offset;
+}
+
+// SNORM으로 읽은 팔면체 좌표를 단위 벡터로 되돌린다.
+float3 DecodeOctahedral(float2 encoded)
+{
+    float3 n = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+    const float fold = saturate(-n.z);
+    n.xy += n.xy >= 0.0f ? -fold : fold;
+    return normalize(n);
+}
+
+// PackedPNTT의 position.w에 담긴 탄젠트 handedness(±1)
+float DecodeHandedness(float4 packedPosition)
+{
+    return packedPosition.w > 0.5f ? 1.0f : -1.0f;
+}
+
+#endif // VERTEX_DECODE_HLSLI
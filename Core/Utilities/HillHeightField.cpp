@@ -0,0 +1,101 @@
+#include "HillHeightField.h"
+
+#include <cassert>
+
+using namespace DirectX;
+
+namespace
+{
+    // 네 점의 높이와 (정규화하기 전의) 법선 x, z 성분. 법선 y 성분은 항상 1이다.
+    struct HillLanes
+    {
+        XMVECTOR height;
+        XMVECTOR normalX;
+        XMVECTOR normalZ;
+    };
+
+    HillLanes XM_CALLCONV EvaluateLanes(FXMVECTOR x, FXMVECTOR z)
+    {
+        XMVECTOR sinX;
+        XMVECTOR cosX;
+        XMVECTOR sinZ;
+        XMVECTOR cosZ;
+        XMVectorSinCos(&sinX, &cosX, XMVectorScale(x, 0.1f));
+        XMVectorSinCos(&sinZ, &cosZ, XMVectorScale(z, 0.1f));
+
+        HillLanes lanes;
+        lanes.height = XMVectorScale(XMVectorMultiplyAdd(z, sinX, XMVectorMultiply(x, cosZ)), 0.3f);
+        lanes.normalX = XMVectorNegate(XMVectorMultiplyAdd(XMVectorScale(z, 0.03f), cosX, XMVectorScale(cosZ, 0.3f)));
+        lanes.normalZ = XMVectorSubtract(XMVectorMultiply(XMVectorScale(x, 0.03f), sinZ), XMVectorScale(sinX, 0.3f));
+        return lanes;
+    }
+
+    void StoreNormals(const HillLanes& lanes, XMFLOAT3* outNormals)
+    {
+        const XMVECTOR invLength = XMVectorReciprocalSqrt(XMVectorMultiplyAdd(lanes.normalX, lanes.normalX, XMVectorMultiplyAdd(lanes.normalZ, lanes.normalZ, XMVectorSplatOne())));
+
+        // 성분별 벡터 세 개를 전치해 점마다 (x, y, z)로 바꾼다.
+        const XMMATRIX normals = XMMatrixTranspose(XMMATRIX(XMVectorMultiply(lanes.normalX, invLength), invLength, XMVectorMultiply(lanes.normalZ, invLength), XMVectorZero()));
+        for (int i = 0; i < 4; ++i)
+        {
+            XMStoreFloat3(&outNormals[i], normals.r[i]);
+        }
+    }
+
+    // LaneCount개를 처리한다. outNormals가 nullptr이면 높이만 구한다.
+    void EvaluateBatch(const float* xs, const float* zs, float* outHeights, XMFLOAT3* outNormals)
+    {
+        for (size_t offset = 0; offset < HillHeightField::LaneCount; offset += 4)
+        {
+            const HillLanes lanes = EvaluateLanes(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(xs + offset)), XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(zs + offset)));
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(outHeights + offset), lanes.height);
+            if (outNormals != nullptr)
+            {
+                StoreNormals(lanes, outNormals + offset);
+            }
+        }
+    }
+
+    void Evaluate(std::span<const float> xs, std::span<const float> zs, std::span<float> outHeights, XMFLOAT3* outNormals)
+    {
+        assert(xs.size() == zs.size() && xs.size() == outHeights.size());
+
+        const size_t count = xs.size();
+        const size_t batchEnd = count - count % HillHeightField::LaneCount;
+        for (size_t i = 0; i < batchEnd; i += HillHeightField::LaneCount)
+        {
+            EvaluateBatch(xs.data() + i, zs.data() + i, outHeights.data() + i, outNormals != nullptr ? outNormals + i : nullptr);
+        }
+
+        // 남은 점도 같은 경로로 계산해야 배열 길이와 상관없이 같은 점에서 같은 값이 나온다.
+        if (batchEnd < count)
+        {
+            const size_t remainCount = count - batchEnd;
+            float tailXs[HillHeightField::LaneCount] = {};
+            float tailZs[HillHeightField::LaneCount] = {};
+            float tailHeights[HillHeightField::LaneCount];
+            XMFLOAT3 tailNormals[HillHeightField::LaneCount];
+            std::copy_n(xs.data() + batchEnd, remainCount, tailXs);
+            std::copy_n(zs.data() + batchEnd, remainCount, tailZs);
+
+            EvaluateBatch(tailXs, tailZs, tailHeights, outNormals != nullptr ? tailNormals : nullptr);
+
+            std::copy_n(tailHeights, remainCount, outHeights.data() + batchEnd);
+            if (outNormals != nullptr)
+            {
+                std::copy_n(tailNormals, remainCount, outNormals + batchEnd);
+            }
+        }
+    }
+}
+
+void HillHeightField::GetHeights(std::span<const float> xs, std::span<const float> zs, std::span<float> outHeights)
+{
+    Evaluate(xs, zs, outHeights, nullptr);
+}
+
+void HillHeightField::GetHeightsAndNormals(std::span<const float> xs, std::span<const float> zs, std::span<float> outHeights, std::span<XMFLOAT3> outNormals)
+{
+    assert(outNormals.size() == outHeights.size());
+    Evaluate(xs, zs, outHeights, outNormals.data());
+}
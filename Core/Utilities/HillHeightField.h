@@ -0,0 +1,79 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+
+// 예제들이 함께 쓰는 언덕 지형 y = 0.3 * (z * sin(0.1x) + x * cos(0.1z))의 높이와 해석적 법선.
+// 스칼라 함수는 기준 구현이고, 여러 점을 한꺼번에 구할 때는 배치 함수를 쓴다.
+// 배치 함수는 8개씩 XMVECTOR 두 개로 묶어 std::sin/cos 대신 DirectXMath의 다항식 sincos로 계산한다. 기준 구현과의 상대 오차는 1e-4 이내이다.
+namespace HillHeightField
+{
+    [[nodiscard]]
+    inline float GetHeight(float x, float z)
+    {
+        return 0.3f * (z * std::sin(0.1f * x) + x * std::cos(0.1f * z));
+    }
+
+    [[nodiscard]]
+    inline DirectX::XMFLOAT3 GetNormal(float x, float z)
+    {
+        DirectX::XMFLOAT3 n(-0.03f * z * std::cos(0.1f * x) - 0.3f * std::cos(0.1f * z), 1.0f, -0.3f * std::sin(0.1f * x) + 0.03f * x * std::sin(0.1f * z));
+        XMStoreFloat3(&n, DirectX::XMVector3Normalize(XMLoadFloat3(&n)));
+        return n;
+    }
+
+    // 배치 함수가 한 번에 처리하는 점의 수
+    constexpr size_t LaneCount = 8;
+
+    // (xs[i], zs[i])의 높이를 outHeights[i]에 쓴다. 세 배열의 길이는 같아야 한다.
+    void GetHeights(std::span<const float> xs, std::span<const float> zs, std::span<float> outHeights);
+
+    // 높이와 함께 단위 법선을 outNormals[i]에 쓴다.
+    void GetHeightsAndNormals(std::span<const float> xs, std::span<const float> zs, std::span<float> outHeights, std::span<DirectX::XMFLOAT3> outNormals);
+
+    // 정점의 position.x, position.z로 position.y를 채우고, normal 멤버가 있으면 법선도 채운다.
+    // 정점 배열은 AoS이므로 일정 개수씩 x, z를 모아 배치 함수에 넘기고 결과를 다시 흩뿌린다.
+    template <typename VertexType>
+    void Apply(std::span<VertexType> vertices)
+    {
+        constexpr size_t BlockSize = 256;
+        constexpr bool hasNormal = requires(VertexType& vertex) { vertex.normal = DirectX::XMFLOAT3(); };
+
+        std::array<float, BlockSize> xs;
+        std::array<float, BlockSize> zs;
+        std::array<float, BlockSize> heights;
+        std::array<DirectX::XMFLOAT3, BlockSize> normals;
+        for (size_t begin = 0; begin < vertices.size(); begin += BlockSize)
+        {
+            const size_t count = std::min(BlockSize, vertices.size() - begin);
+            for (size_t i = 0; i < count; ++i)
+            {
+                xs[i] = vertices[begin + i].position.x;
+                zs[i] = vertices[begin + i].position.z;
+            }
+
+            const std::span<const float> blockXs(xs.data(), count);
+            const std::span<const float> blockZs(zs.data(), count);
+            if constexpr (hasNormal)
+            {
+                GetHeightsAndNormals(blockXs, blockZs, std::span(heights.data(), count), std::span(normals.data(), count));
+            }
+            else
+            {
+                GetHeights(blockXs, blockZs, std::span(heights.data(), count));
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                vertices[begin + i].position.y = heights[i];
+                if constexpr (hasNormal)
+                {
+                    vertices[begin + i].normal = normals[i];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,205 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // 작업 스레드이거나 풀에 작업을 나눠 준 호출 스레드이면 true. 이 스레드에서 실행하는 작업이 다시 병렬 반복을 시작하면 순차적으로 실행한다.
+    // 호출 스레드는 dispatchMutex를 쥔 채 작업을 실행하므로, 이 값을 먼저 보지 않으면 같은 mutex를 다시 잠그려 하게 된다.
+    thread_local bool IsInsideDispatch = false;
+
+    // SetMaxWorkerCount로 정한 제한. 0이면 풀의 모든 스레드를 쓴다.
+    std::atomic<size_t> MaxWorkerCount = 0;
+
+    // 프로그램이 끝날 때까지 유지되는 작업 스레드 풀. 호출 스레드도 작업에 참여한다.
+    class ThreadPool
+    {
+    public:
+        ThreadPool()
+        {
+            const size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+            threads.reserve(threadCount - 1);
+            for (size_t i = 1; i < threadCount; ++i)
+            {
+                threads.emplace_back([this] { WorkerLoop(); });
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lock(mutex);
+                isStopping = true;
+            }
+            wakeCondition.notify_all();
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        size_t GetThreadCount() const
+        {
+            return threads.size() + 1;
+        }
+
+        void Run(size_t taskCount, const std::function<void(size_t)>& task)
+        {
+            // 병렬 반복 안에서 다시 호출되었으면 mutex를 건드리지 않고 직접 실행한다.
+            if (IsInsideDispatch)
+            {
+                RunInline(taskCount, task);
+                return;
+            }
+
+            // 다른 스레드가 풀을 쓰고 있으면 기다리지 않고 직접 실행한다.
+            std::unique_lock dispatchLock(dispatchMutex, std::try_to_lock);
+            if (!dispatchLock.owns_lock() || threads.empty() || taskCount <= 1)
+            {
+                RunInline(taskCount, task);
+                return;
+            }
+
+            IsInsideDispatch = true;
+
+            {
+                std::lock_guard lock(mutex);
+                currentTask = &task;
+                currentTaskCount = taskCount;
+                nextTaskIndex = 0;
+                remainingTaskCount = taskCount;
+                ++generation;
+            }
+            wakeCondition.notify_all();
+
+            ProcessTasks(task, taskCount);
+
+            // 모든 작업이 끝나고 작업 중인 스레드가 현재 작업을 더 이상 참조하지 않을 때까지 기다린다.
+            std::unique_lock lock(mutex);
+            doneCondition.wait(lock, [this] { return remainingTaskCount == 0 && activeWorkerCount == 0; });
+            currentTask = nullptr;
+
+            IsInsideDispatch = false;
+        }
+
+    private:
+        static void RunInline(size_t taskCount, const std::function<void(size_t)>& task)
+        {
+            for (size_t i = 0; i < taskCount; ++i)
+            {
+                task(i);
+            }
+        }
+
+        void ProcessTasks(const std::function<void(size_t)>& task, size_t taskCount)
+        {
+            while (true)
+            {
+                const size_t taskIndex = nextTaskIndex.fetch_add(1);
+                if (taskIndex >= taskCount)
+                {
+                    break;
+                }
+
+                task(taskIndex);
+
+                if (remainingTaskCount.fetch_sub(1) == 1)
+                {
+                    std::lock_guard lock(mutex);
+                    doneCondition.notify_all();
+                }
+            }
+        }
+
+        void WorkerLoop()
+        {
+            IsInsideDispatch = true;
+
+            size_t seenGeneration = 0;
+            while (true)
+            {
+                std::unique_lock lock(mutex);
+                wakeCondition.wait(lock, [&] { return isStopping || (generation != seenGeneration && currentTask != nullptr); });
+                if (isStopping)
+                {
+                    return;
+                }
+
+                seenGeneration = generation;
+                const std::function<void(size_t)>& task = *currentTask;
+                const size_t taskCount = currentTaskCount;
+                ++activeWorkerCount;
+                lock.unlock();
+
+                ProcessTasks(task, taskCount);
+
+                lock.lock();
+                --activeWorkerCount;
+                if (activeWorkerCount == 0)
+                {
+                    doneCondition.notify_all();
+                }
+            }
+        }
+
+        std::vector<std::thread> threads;
+
+        std::mutex dispatchMutex;
+        std::mutex mutex;
+        std::condition_variable wakeCondition;
+        std::condition_variable doneCondition;
+
+        const std::function<void(size_t)>* currentTask = nullptr;
+        size_t currentTaskCount = 0;
+        size_t generation = 0;
+        size_t activeWorkerCount = 0;
+        bool isStopping = false;
+
+        std::atomic<size_t> nextTaskIndex = 0;
+        std::atomic<size_t> remainingTaskCount = 0;
+    };
+
+    ThreadPool& GetThreadPool()
+    {
+        static ThreadPool threadPool;
+        return threadPool;
+    }
+}
+
+size_t Parallel::GetWorkerCount()
+{
+    const size_t threadCount = GetThreadPool().GetThreadCount();
+    const size_t maxWorkerCount = MaxWorkerCount.load();
+    return maxWorkerCount == 0 ? threadCount : std::min(threadCount, maxWorkerCount);
+}
+
+void Parallel::SetMaxWorkerCount(size_t maxWorkerCount)
+{
+    MaxWorkerCount = maxWorkerCount;
+}
+
+void Parallel::ForRange(size_t begin, size_t end, size_t minRangeSize, const std::function<void(size_t, size_t)>& func)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    const size_t count = end - begin;
+    const size_t maxTaskCount = std::max<size_t>(1, count / std::max<size_t>(1, minRangeSize));
+    const size_t taskCount = std::min(GetWorkerCount(), maxTaskCount);
+
+    GetThreadPool().Run(taskCount, [&](size_t taskIndex)
+    {
+        const size_t rangeBegin = begin + count * taskIndex / taskCount;
+        const size_t rangeEnd = begin + count * (taskIndex + 1) / taskCount;
+        func(rangeBegin, rangeEnd);
+    });
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace Parallel
+{
+    // 호출 스레드를 포함해 작업에 참여하는 스레드 수
+    [[nodiscard]]
+    size_t GetWorkerCount();
+
+    // 작업에 참여하는 스레드를 최대 maxWorkerCount개로 제한한다. 0이면 제한을 푼다.
+    // 구간 수도 함께 줄어드므로 스레드 수에 따라 결과가 달라지지 않는지 확인하거나 스레드 수별 확장성을 잴 때 쓴다.
+    void SetMaxWorkerCount(size_t maxWorkerCount);
+
+    // [begin, end)를 작업 스레드 수만큼의 연속 구간으로 나눠 func(rangeBegin, rangeEnd)를 병렬로 호출하고, 모두 끝날 때까지 기다린다.
+    // 구간은 스레드 스케줄과 무관하게 항상 같은 방식으로 나뉘므로 구간별 결과를 정해진 위치에 기록하면 결과가 결정적이다.
+    // 각 구간은 최소 minRangeSize개 이상이 되도록 나눈다. func 안에서 다시 호출하면 어느 스레드에서 실행 중이든 그 스레드에서 순차적으로 실행한다.
+    void ForRange(size_t begin, size_t end, size_t minRangeSize, const std::function<void(size_t, size_t)>& func);
+
+    template <typename Func>
+    void For(size_t begin, size_t end, size_t minRangeSize, Func&& func)
+    {
+        ForRange(begin, end, minRangeSize, [&func](size_t rangeBegin, size_t rangeEnd)
+        {
+            for (size_t i = rangeBegin; i < rangeEnd; ++i)
+            {
+                func(i);
+            }
+        });
+    }
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <DirectXMath.h>
+#include <cmath>
+#include <type_traits>
 
 #define CHECK_HR(hr, text, ...)\
 if (FAILED(hr))\
@@ -19,4 +21,105 @@ namespace Math
 
     [[nodiscard]]
     float GetRandomFloat(float min, float max);
+
+    // 아래 함수들은 컴파일 타임에 메시 테이블을 만들 때 쓰기 위한 constexpr 버전이다.
+    // 상수 평가 중에는 double로 직접 근사하고, 실행 중에는 표준 라이브러리 함수를 그대로 호출한다.
+    [[nodiscard]]
+    constexpr float Sqrt(float x)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            return std::sqrt(x);
+        }
+
+        if (x <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        // 뉴턴 방법. 값이 더 이상 줄지 않으면 수렴한 것이다.
+        const double value = x;
+        double result = value > 1.0 ? value : 1.0;
+        for (int i = 0; i < 128; ++i)
+        {
+            const double next = 0.5 * (result + value / result);
+            if (next >= result)
+            {
+                break;
+            }
+            result = next;
+        }
+
+        return static_cast<float>(result);
+    }
+
+    [[nodiscard]]
+    constexpr float Atan2(float y, float x)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            return std::atan2(y, x);
+        }
+
+        constexpr double pi = 3.14159265358979323846;
+
+        // |t| <= tan(pi / 8) 범위에서는 테일러 급수가 빠르게 수렴한다.
+        auto atanSeries = [](double t)
+        {
+            const double t2 = t * t;
+            double term = t;
+            double result = 0.0;
+            for (int n = 1; n < 28; n += 2)
+            {
+                result += term / n;
+                term *= -t2;
+            }
+            return result;
+        };
+
+        // atan(t) = pi / 2 - atan(1 / t), atan(t) = pi / 4 + atan((t - 1) / (t + 1))로 범위를 줄인다.
+        auto atanReduced = [&](double t)
+        {
+            const bool isNegative = t < 0.0;
+            t = isNegative ? -t : t;
+
+            const bool isInverted = t > 1.0;
+            t = isInverted ? 1.0 / t : t;
+
+            double result = t > 0.41421356237309503 ? pi / 4.0 + atanSeries((t - 1.0) / (t + 1.0)) : atanSeries(t);
+            result = isInverted ? pi / 2.0 - result : result;
+            return isNegative ? -result : result;
+        };
+
+        if (x > 0.0f)
+        {
+            return static_cast<float>(atanReduced(static_cast<double>(y) / x));
+        }
+        if (x < 0.0f)
+        {
+            const double result = atanReduced(static_cast<double>(y) / x);
+            return static_cast<float>(y < 0.0f ? result - pi : result + pi);
+        }
+        if (y > 0.0f)
+        {
+            return static_cast<float>(pi / 2.0);
+        }
+        if (y < 0.0f)
+        {
+            return static_cast<float>(-pi / 2.0);
+        }
+        return 0.0f;
+    }
+
+    [[nodiscard]]
+    constexpr float Acos(float x)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            return std::acos(x);
+        }
+
+        x = x < -1.0f ? -1.0f : (x > 1.0f ? 1.0f : x);
+        return Atan2(Sqrt((1.0f - x) * (1.0f + x)), x);
+    }
 }
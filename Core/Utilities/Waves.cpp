@@ -6,15 +6,39 @@
 #include <algorithm>
 #include <vector>
 #include <cassert>
+#include <cmath>
+#include <new>
+#include <numeric>
+
+#include "Utilities/Parallel.h"
 
 using namespace DirectX;
 
+namespace
+{
+    constexpr size_t CacheLineSize = 64;
+
+    // 띠 하나가 맡는 최소 점 수. 너무 잘게 나누면 동기화 비용이 계산보다 커진다.
+    constexpr size_t MinBandPointCount = 16384;
+
+    // 높이 두 장, 법선 세 장, 탄젠트 두 장
+    constexpr size_t PlaneCount = 7;
+
+    // 띠 경계를 캐시 라인에 맞추려면 평면 시작도 캐시 라인에 맞아야 한다.
+    float* AllocateCacheAligned(size_t count)
+    {
+        return static_cast<float*>(::operator new[](count * sizeof(float), std::align_val_t(CacheLineSize)));
+    }
+
+    void FreeCacheAligned(float* data)
+    {
+        ::operator delete[](data, std::align_val_t(CacheLineSize));
+    }
+}
+
 Waves::~Waves()
 {
-    delete[] mPrevSolution;
-    delete[] mCurrSolution;
-    delete[] mNormals;
-    delete[] mTangentX;
+    FreeCacheAligned(mPlaneData);
 }
 
 void Waves::Init(UINT m, UINT n, float dx, float dt, float speed, float damping)
@@ -28,6 +52,11 @@ void Waves::Init(UINT m, UINT n, float dx, float dt, float speed, float damping)
     mTimeStep = dt;
     mSpatialStep = dx;
 
+    mAccumulatedTime = 0.0f;
+    mInterpolationAlpha = 0.0f;
+
+    mIsNormalRowDeferred.assign(m, 0);
+
     const float d = damping * dt + 2.0f;
     const float e = (speed * speed) * (dt * dt) / (dx * dx);
     mK1 = (damping * dt - 2.0f) / d;
@@ -35,100 +64,259 @@ void Waves::Init(UINT m, UINT n, float dx, float dt, float speed, float damping)
     mK3 = (2.0f * e) / d;
 
     // In case Init() called again.
-    delete[] mPrevSolution;
-    delete[] mCurrSolution;
-    delete[] mNormals;
-    delete[] mTangentX;
+    FreeCacheAligned(mPlaneData);
+
+    const size_t pointCount = static_cast<size_t>(m) * n;
+    const size_t planeStride = (pointCount + CacheLineSize / sizeof(float) - 1) / (CacheLineSize / sizeof(float)) * (CacheLineSize / sizeof(float));
+    mPlaneData = AllocateCacheAligned(planeStride * PlaneCount);
+
+    mPrevHeights = mPlaneData;
+    mCurrHeights = mPlaneData + planeStride;
+    mNormalX = mPlaneData + planeStride * 2;
+    mNormalY = mPlaneData + planeStride * 3;
+    mNormalZ = mPlaneData + planeStride * 4;
+    mTangentX = mPlaneData + planeStride * 5;
+    mTangentY = mPlaneData + planeStride * 6;
+
+    const size_t rowByteSize = sizeof(float) * n;
+    mBandRowAlignment = static_cast<UINT>(CacheLineSize / std::gcd(rowByteSize, CacheLineSize));
+
+    // 격자의 x, z는 접근자가 번호로 계산하므로 높이와 법선만 초기화한다.
+    mHalfWidth = static_cast<float>(n - 1) * dx * 0.5f;
+    mHalfDepth = static_cast<float>(m - 1) * dx * 0.5f;
+
+    std::fill_n(mPrevHeights, pointCount, 0.0f);
+    std::fill_n(mCurrHeights, pointCount, 0.0f);
+    std::fill_n(mNormalX, pointCount, 0.0f);
+    std::fill_n(mNormalY, pointCount, 1.0f);
+    std::fill_n(mNormalZ, pointCount, 0.0f);
+    std::fill_n(mTangentX, pointCount, 1.0f);
+    std::fill_n(mTangentY, pointCount, 0.0f);
+}
 
-    mPrevSolution = new XMFLOAT3[static_cast<size_t>(m) * n];
-    mCurrSolution = new XMFLOAT3[static_cast<size_t>(m) * n];
-    mNormals = new XMFLOAT3[static_cast<size_t>(m) * n];
-    mTangentX = new XMFLOAT3[static_cast<size_t>(m) * n];
+UINT Waves::Update(float dt)
+{
+    // Accumulate time.
+    mAccumulatedTime += std::max(dt, 0.0f);
 
-    // Generate grid vertices in system memory.
+    // Only update the simulation at the specified time step.
+    UINT stepCount = 0;
+    while (mAccumulatedTime >= mTimeStep && stepCount < mMaxStepsPerUpdate)
+    {
+        mAccumulatedTime -= mTimeStep;
+        ++stepCount;
+    }
 
-    const float halfWidth = static_cast<float>(n - 1) * dx * 0.5f;
-    const float halfDepth = static_cast<float>(m - 1) * dx * 0.5f;
-    for (UINT i = 0; i < m; ++i)
+    // 상한까지 진행하고도 한 단계 이상 남았다면 따라잡지 않고 버린다. 남은 비율만 남겨 보간이 이어지게 한다.
+    if (mAccumulatedTime >= mTimeStep)
     {
-        const float z = halfDepth - static_cast<float>(i) * dx;
-        for (UINT j = 0; j < n; ++j)
+        mAccumulatedTime = std::fmod(mAccumulatedTime, mTimeStep);
+    }
+
+    Step(stepCount);
+
+    mInterpolationAlpha = mTimeStep > 0.0f ? std::clamp(mAccumulatedTime / mTimeStep, 0.0f, 1.0f) : 1.0f;
+    return stepCount;
+}
+
+void Waves::Step(UINT stepCount)
+{
+    // 내부 점이 없으면 바꿀 것이 없다.
+    if (mNumRows < 3 || mNumCols < 3)
+    {
+        return;
+    }
+
+    // 법선은 마지막 단계의 높이로만 구하면 되므로 중간 단계는 높이만 갱신한다.
+    UINT remainingStepCount = stepCount;
+    while (remainingStepCount > 0)
+    {
+        const UINT blockStepCount = std::min(remainingStepCount, mTemporalBlockSize);
+        remainingStepCount -= blockStepCount;
+
+        const bool computeNormals = remainingStepCount == 0;
+        if (blockStepCount > 1)
+        {
+            StepTemporalBlock(blockStepCount, computeNormals);
+        }
+        else if (mIsFused && computeNormals)
+        {
+            StepFused();
+        }
+        else
         {
-            const float x = -halfWidth + static_cast<float>(j) * dx;
+            StepTwoPass(computeNormals);
+        }
+    }
+}
+
+void Waves::StepRow(float* destination, const float* source, UINT i) const
+{
+    const WavesKernels::StepConstants constants{mK1, mK2, mK3};
+    const size_t rowOffset = static_cast<size_t>(i) * mNumCols;
+    mKernels->stepRow(destination + rowOffset, source + rowOffset, source + rowOffset - mNumCols, source + rowOffset + mNumCols, mNumCols, constants);
+}
+
+void Waves::ComputeNormalRow(const float* heights, UINT i)
+{
+    const size_t rowOffset = static_cast<size_t>(i) * mNumCols;
+    const WavesKernels::NormalRow normalRow{mNormalX + rowOffset, mNormalY + rowOffset, mNormalZ + rowOffset, mTangentX + rowOffset, mTangentY + rowOffset};
+    mKernels->computeNormalRow(heights + rowOffset, heights + rowOffset - mNumCols, heights + rowOffset + mNumCols, normalRow, mNumCols, mSpatialStep);
+}
 
-            mPrevSolution[i * n + j] = XMFLOAT3(x, 0.0f, z);
-            mCurrSolution[i * n + j] = XMFLOAT3(x, 0.0f, z);
-            mNormals[i * n + j] = XMFLOAT3(0.0f, 1.0f, 0.0f);
-            mTangentX[i * n + j] = XMFLOAT3(1.0f, 0.0f, 0.0f);
+void Waves::StepTwoPass(bool computeNormals)
+{
+    // Only update interior points; we use zero boundary conditions.
+    // After this update we will be discarding the old previous buffer, so overwrite that buffer with the new update.
+    // Note j indexes x and i indexes z: h(x_j, z_i, t_k). Moreover, our +z axis goes "down";
+    // this is just to keep consistent with our row indices going down.
+    ForEachBand([&](UINT rowBegin, UINT rowEnd)
+    {
+        for (UINT i = rowBegin; i < rowEnd; ++i)
+        {
+            StepRow(mPrevHeights, mCurrHeights, i);
         }
+    });
+
+    // We just overwrote the previous buffer with the new data, so
+    // this data needs to become the current solution and the old
+    // current solution becomes the new previous solution.
+    std::swap(mPrevHeights, mCurrHeights);
+
+    if (!computeNormals)
+    {
+        return;
     }
+
+    //
+    // Compute normals using finite difference scheme.
+    // 띠 경계의 법선은 이웃 띠가 갱신한 높이를 읽으므로, 위의 ForEachBand가 모든 띠를 기다린 뒤(장벽)에 시작한다.
+    //
+    ForEachBand([&](UINT rowBegin, UINT rowEnd)
+    {
+        for (UINT i = rowBegin; i < rowEnd; ++i)
+        {
+            ComputeNormalRow(mCurrHeights, i);
+        }
+    });
 }
 
-void Waves::Update(float dt)
+void Waves::StepFused()
 {
-    static float time = 0;
+    // 행 i를 갱신하면 행 i - 1의 위아래 새 높이가 모두 생기므로 캐시에 남아 있는 동안 바로 법선을 구한다.
+    // 띠의 첫 행과 마지막 행은 이웃 띠의 새 높이가 필요하므로 표시만 해 두고 모든 띠가 끝난 뒤에 구한다.
+    // 경계 행(0, mNumRows - 1)은 높이가 바뀌지 않으므로 기다릴 필요가 없다.
+    ForEachBand([&](UINT rowBegin, UINT rowEnd)
+    {
+        const auto hasNewNeighbors = [&](UINT i)
+        {
+            return (i > rowBegin || rowBegin == 1) && (i + 1 < rowEnd || rowEnd == mNumRows - 1);
+        };
 
-    // Accumulate time.
-    time += dt;
+        for (UINT i = rowBegin; i < rowEnd; ++i)
+        {
+            StepRow(mPrevHeights, mCurrHeights, i);
+            if (i > rowBegin && hasNewNeighbors(i - 1))
+            {
+                ComputeNormalRow(mPrevHeights, i - 1);
+            }
+        }
 
-    // Only update the simulation at the specified time step.
-    if (time >= mTimeStep)
+        if (hasNewNeighbors(rowEnd - 1))
+        {
+            ComputeNormalRow(mPrevHeights, rowEnd - 1);
+        }
+
+        // 띠마다 서로 다른 원소에만 쓰므로 동기화가 필요 없다.
+        mIsNormalRowDeferred[rowBegin] = !hasNewNeighbors(rowBegin);
+        mIsNormalRowDeferred[rowEnd - 1] = !hasNewNeighbors(rowEnd - 1);
+    });
+
+    // 미룬 행도 띠로 나눠 처리한다. 위의 ForEachBand가 모든 띠를 기다린 뒤(장벽)에 시작하므로 이웃 띠의 새 높이가 모두 있다.
+    // 띠마다 자기 행의 표시만 확인하므로 두 번의 ForEachBand가 같은 띠로 나뉘지 않아도 된다.
+    ForEachBand([&](UINT rowBegin, UINT rowEnd)
     {
-        // Only update interior points; we use zero boundary conditions.
-        for (UINT i = 1; i < mNumRows - 1; ++i)
+        for (UINT i = rowBegin; i < rowEnd; ++i)
         {
-            for (UINT j = 1; j < mNumCols - 1; ++j)
+            if (mIsNormalRowDeferred[i])
             {
-                // After this update we will be discarding the old previous
-                // buffer, so overwrite that buffer with the new update.
-                // Note how we can do this inplace (read/write to same element) 
-                // because we won't need prev_ij again and the assignment happens last.
-
-                // Note j indexes x and i indexes z: h(x_j, z_i, t_k)
-                // Moreover, our +z axis goes "down"; this is just to 
-                // keep consistent with our row indices going down.
-
-                mPrevSolution[i * mNumCols + j].y =
-                    mK1 * mPrevSolution[i * mNumCols + j].y +
-                    mK2 * mCurrSolution[i * mNumCols + j].y +
-                    mK3 * (mCurrSolution[(i + 1) * mNumCols + j].y +
-                        mCurrSolution[(i - 1) * mNumCols + j].y +
-                        mCurrSolution[i * mNumCols + j + 1].y +
-                        mCurrSolution[i * mNumCols + j - 1].y);
+                ComputeNormalRow(mPrevHeights, i);
+                mIsNormalRowDeferred[i] = 0;
             }
         }
+    });
 
-        // We just overwrote the previous buffer with the new data, so
-        // this data needs to become the current solution and the old
-        // current solution becomes the new previous solution.
-        std::swap(mPrevSolution, mCurrSolution);
+    std::swap(mPrevHeights, mCurrHeights);
+}
 
-        time = 0.0f; // reset time
+void Waves::StepTemporalBlock(UINT stepCount, bool computeNormals)
+{
+    // 단계 k는 단계 k - 1보다 한 행 늦게 따라가며 두 평면을 번갈아 제자리에서 갱신한다. (파면 순회)
+    // 단계 k가 행 r을 덮어쓸 때 단계 k - 1은 이미 행 r + 1까지 끝났고, 덮어쓰는 값(단계 k - 2의 행 r)을 더 읽을 단계도 없다.
+    // 따라서 격자를 한 번 도는 동안 stepCount 단계를 진행하고, 각 행의 계산은 단계를 하나씩 진행할 때와 같다.
+    // 행 사이에 순서가 있어 띠로 나눌 수 없으므로 한 스레드에서 실행한다.
+    float* const planes[2] = {mPrevHeights, mCurrHeights};
+    const UINT lastInteriorRow = mNumRows - 2;
 
-        //
-        // Compute normals using finite difference scheme.
-        //
-        for (UINT i = 1; i < mNumRows - 1; ++i)
+    for (UINT front = 1; front <= lastInteriorRow + stepCount - 1; ++front)
+    {
+        for (UINT k = 0; k < stepCount; ++k)
         {
-            for (UINT j = 1; j < mNumCols - 1; ++j)
+            if (front < k + 1 || front - k > lastInteriorRow)
+            {
+                continue;
+            }
+
+            const UINT i = front - k;
+            StepRow(planes[k % 2], planes[(k + 1) % 2], i);
+
+            if (computeNormals && k == stepCount - 1 && i > 1)
             {
-                const float l = mCurrSolution[i * mNumCols + j - 1].y;
-                const float r = mCurrSolution[i * mNumCols + j + 1].y;
-                const float t = mCurrSolution[(i - 1) * mNumCols + j].y;
-                const float b = mCurrSolution[(i + 1) * mNumCols + j].y;
-                mNormals[i * mNumCols + j].x = -r + l;
-                mNormals[i * mNumCols + j].y = 2.0f * mSpatialStep;
-                mNormals[i * mNumCols + j].z = b - t;
-
-                const XMVECTOR n = XMVector3Normalize(XMLoadFloat3(&mNormals[i * mNumCols + j]));
-                XMStoreFloat3(&mNormals[i * mNumCols + j], n);
-
-                mTangentX[i * mNumCols + j] = XMFLOAT3(2.0f * mSpatialStep, r - l, 0.0f);
-                const XMVECTOR T = XMVector3Normalize(XMLoadFloat3(&mTangentX[i * mNumCols + j]));
-                XMStoreFloat3(&mTangentX[i * mNumCols + j], T);
+                ComputeNormalRow(planes[k % 2], i - 1);
             }
         }
     }
+
+    if (computeNormals)
+    {
+        ComputeNormalRow(planes[(stepCount - 1) % 2], lastInteriorRow);
+    }
+
+    // 마지막 단계는 planes[(stepCount - 1) % 2]에, 그 전 단계는 다른 평면에 있다.
+    if (stepCount % 2 == 1)
+    {
+        std::swap(mPrevHeights, mCurrHeights);
+    }
+}
+
+void Waves::ForEachBand(const std::function<void(UINT, UINT)>& func) const
+{
+    // mBandRowAlignment 행씩 묶은 블록 단위로 나누므로 띠는 항상 캐시 라인 경계에서 시작한다.
+    const UINT blockCount = (mNumRows + mBandRowAlignment - 1) / mBandRowAlignment;
+    const auto processBlocks = [&](size_t blockBegin, size_t blockEnd)
+    {
+        const UINT rowBegin = std::max(1u, static_cast<UINT>(blockBegin) * mBandRowAlignment);
+        const UINT rowEnd = std::min(mNumRows - 1, static_cast<UINT>(blockEnd) * mBandRowAlignment);
+        if (rowBegin < rowEnd)
+        {
+            func(rowBegin, rowEnd);
+        }
+    };
+
+    if (!mIsParallel)
+    {
+        processBlocks(0, blockCount);
+        return;
+    }
+
+    const size_t minBlockCount = std::max<size_t>(1, MinBandPointCount / (static_cast<size_t>(mNumCols) * mBandRowAlignment));
+    Parallel::ForRange(0, blockCount, minBlockCount, processBlocks);
+}
+
+void Waves::SetSimdLevel(WavesKernels::SimdLevel level)
+{
+    mKernels = &WavesKernels::GetKernelTable(level);
+    mSimdLevel = std::min(level, WavesKernels::GetSupportedSimdLevel());
 }
 
 void Waves::Disturb(UINT i, UINT j, float magnitude)
@@ -140,9 +328,9 @@ void Waves::Disturb(UINT i, UINT j, float magnitude)
     const float halfMag = 0.5f * magnitude;
 
     // Disturb the ijth vertex height and its neighbors.
-    mCurrSolution[i * mNumCols + j].y += magnitude;
-    mCurrSolution[i * mNumCols + j + 1].y += halfMag;
-    mCurrSolution[i * mNumCols + j - 1].y += halfMag;
-    mCurrSolution[(i + 1) * mNumCols + j].y += halfMag;
-    mCurrSolution[(i - 1) * mNumCols + j].y += halfMag;
+    mCurrHeights[i * mNumCols + j] += magnitude;
+    mCurrHeights[i * mNumCols + j + 1] += halfMag;
+    mCurrHeights[i * mNumCols + j - 1] += halfMag;
+    mCurrHeights[(i + 1) * mNumCols + j] += halfMag;
+    mCurrHeights[(i - 1) * mNumCols + j] += halfMag;
 }
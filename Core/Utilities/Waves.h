@@ -9,7 +9,14 @@
 
 #include <d3d11.h>
 #include <DirectXMath.h>
+#include <algorithm>
 #include <concepts>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "Core/Utilities/WavesKernels.h"
 
 /** 해당 클래스는 아직 분석하지 않았습니다. */
 class Waves
@@ -25,22 +32,88 @@ public:
     float Width() const { return static_cast<float>(mNumCols) * mSpatialStep; }
     float Depth() const { return static_cast<float>(mNumRows) * mSpatialStep; }
 
+    // 높이와 법선은 성분별 평면에 저장하므로 아래 접근자는 값을 조립해 돌려준다. x, z는 Init 뒤로 바뀌지 않으므로 격자 번호로 계산한다.
+
     // Returns the solution at the ith grid point.
     template <std::integral IndexType>
-    const DirectX::XMFLOAT3& operator[](IndexType i) const { return mCurrSolution[i]; }
+    DirectX::XMFLOAT3 operator[](IndexType i) const
+    {
+        const UINT index = static_cast<UINT>(i);
+        const UINT row = index / mNumCols;
+        const UINT column = index - row * mNumCols;
+        return DirectX::XMFLOAT3(-mHalfWidth + static_cast<float>(column) * mSpatialStep, mCurrHeights[index], mHalfDepth - static_cast<float>(row) * mSpatialStep);
+    }
 
     // Returns the solution normal at the ith grid point.
     template <std::integral IndexType>
-    const DirectX::XMFLOAT3& Normal(IndexType i) const { return mNormals[i]; }
+    DirectX::XMFLOAT3 Normal(IndexType i) const { return DirectX::XMFLOAT3(mNormalX[i], mNormalY[i], mNormalZ[i]); }
 
     // Returns the unit tangent vector at the ith grid point in the local x-axis direction.
-    const DirectX::XMFLOAT3& TangentX(int i) const { return mTangentX[i]; }
+    DirectX::XMFLOAT3 TangentX(int i) const { return DirectX::XMFLOAT3(mTangentX[i], mTangentY[i], 0.0f); }
+
+    // 현재 높이 평면. 행 우선 순서로 VertexCount()개가 있다.
+    std::span<const float> Heights() const { return std::span<const float>(mCurrHeights, mVertexCount); }
+
+    // 바로 전 단계의 높이 평면. 다음 Step이 덮어쓰기 전까지 유효하다.
+    std::span<const float> PreviousHeights() const { return std::span<const float>(mPrevHeights, mVertexCount); }
+
+    // 전 단계와 현재 단계의 높이를 GetInterpolationAlpha()로 섞은 위치. 프레임 간격이 시뮬레이션 간격과 달라도 물결이 끊기지 않는다.
+    // 보간한 만큼 최대 한 단계 늦게 보인다. 법선은 현재 단계의 값을 그대로 쓴다.
+    template <std::integral IndexType>
+    DirectX::XMFLOAT3 Interpolated(IndexType i) const
+    {
+        DirectX::XMFLOAT3 position = (*this)[i];
+        const float previousHeight = mPrevHeights[i];
+        position.y = previousHeight + mInterpolationAlpha * (position.y - previousHeight);
+        return position;
+    }
 
     void Init(UINT m, UINT n, float dx, float dt, float speed, float damping);
-    void Update(float dt);
+    // 쌓인 시간만큼 고정 간격 단계를 진행하고 진행한 단계 수를 돌려준다.
+    // 한 번에 GetMaxStepsPerUpdate()단계까지만 진행하고 그래도 남은 시간은 버린다. 느린 프레임이 더 많은 단계를 불러 더 느려지는 악순환을 막는다.
+    UINT Update(float dt);
     void Disturb(UINT i, UINT j, float magnitude);
 
+    // 시간 간격과 상관없이 stepCount 단계를 진행한다. Update는 쌓인 시간만큼의 단계 수로 이 함수를 부른다.
+    // 법선과 탄젠트는 마지막 단계의 높이로만 구한다.
+    void Step(UINT stepCount = 1);
+
+    // 높이 갱신과 법선 계산을 한 번의 행 순회로 합친다. 끄면 격자를 두 번 도는 방식으로 계산하며 결과는 같다.
+    bool IsFused() const { return mIsFused; }
+    void SetFused(bool isFused) { mIsFused = isFused; }
+
+    // 여러 단계를 진행할 때 격자를 한 번 도는 동안 함께 진행할 단계 수(시간 블로킹). 1이면 단계마다 격자를 돈다.
+    // 단계 사이에 행 순서가 있어 한 스레드에서 실행하므로, 작업 스레드가 많지 않거나 메모리 대역폭이 병목일 때 쓴다. 결과는 같다.
+    UINT GetTemporalBlockSize() const { return mTemporalBlockSize; }
+    void SetTemporalBlockSize(UINT temporalBlockSize) { mTemporalBlockSize = std::max(temporalBlockSize, 1u); }
+
+    // 높이 갱신과 법선 계산에 쓸 경로. 기본값은 CPU가 지원하는 가장 넓은 경로이며, 지원하지 않는 경로를 요청하면 그 경로로 낮춘다.
+    WavesKernels::SimdLevel GetSimdLevel() const { return mSimdLevel; }
+    void SetSimdLevel(WavesKernels::SimdLevel level);
+
+    // Update 한 번에 진행할 최대 단계 수. 0이면 1로 본다.
+    UINT GetMaxStepsPerUpdate() const { return mMaxStepsPerUpdate; }
+    void SetMaxStepsPerUpdate(UINT maxStepsPerUpdate) { mMaxStepsPerUpdate = std::max(maxStepsPerUpdate, 1u); }
+
+    // 쌓인 시간 중 다음 단계까지 진행한 비율 [0, 1). 전 단계와 현재 단계를 섞을 때 쓴다.
+    float GetInterpolationAlpha() const { return mInterpolationAlpha; }
+
+    // 내부 행을 띠로 나눠 작업 스레드에서 처리한다. 점마다 같은 식을 쓰므로 결과는 단일 스레드와 비트 단위로 같다.
+    bool IsParallel() const { return mIsParallel; }
+    void SetParallel(bool isParallel) { mIsParallel = isParallel; }
+
 private:
+    // 행 i의 새 높이를 destination에 쓴다. source는 현재 단계의 높이이고, destination은 전 단계의 높이를 담고 있다.
+    void StepRow(float* destination, const float* source, UINT i) const;
+    void ComputeNormalRow(const float* heights, UINT i);
+
+    void StepTwoPass(bool computeNormals);
+    void StepFused();
+    void StepTemporalBlock(UINT stepCount, bool computeNormals);
+
+    // 내부 행 [1, mNumRows - 1)을 띠로 나눠 func(rowBegin, rowEnd)를 부르고, 모든 띠가 끝날 때까지 기다린다.
+    void ForEachBand(const std::function<void(UINT, UINT)>& func) const;
+
     UINT mNumRows = 0;
     UINT mNumCols = 0;
 
@@ -55,8 +128,34 @@ private:
     float mTimeStep = 0.0f;
     float mSpatialStep = 0.0f;
 
-    DirectX::XMFLOAT3* mPrevSolution = nullptr;
-    DirectX::XMFLOAT3* mCurrSolution = nullptr;
-    DirectX::XMFLOAT3* mNormals = nullptr;
-    DirectX::XMFLOAT3* mTangentX = nullptr;
+    float mHalfWidth = 0.0f;
+    float mHalfDepth = 0.0f;
+
+    // 인스턴스마다 따로 쌓으므로 여러 Waves가 서로의 시간을 빼앗지 않는다.
+    float mAccumulatedTime = 0.0f;
+    float mInterpolationAlpha = 0.0f;
+    UINT mMaxStepsPerUpdate = 4;
+
+    WavesKernels::SimdLevel mSimdLevel = WavesKernels::GetSupportedSimdLevel();
+    const WavesKernels::KernelTable* mKernels = &WavesKernels::GetKernelTable(mSimdLevel);
+
+    // 띠 경계가 될 수 있는 행의 간격. 이 배수 번째 행은 시작 주소가 캐시 라인에 맞으므로 이웃 띠가 같은 캐시 라인에 쓰지 않는다.
+    UINT mBandRowAlignment = 1;
+    bool mIsParallel = true;
+    bool mIsFused = true;
+    UINT mTemporalBlockSize = 1;
+
+    // StepFused에서 이웃 띠를 기다려야 해서 나중에 법선을 구할 행. 띠마다 동시에 쓰므로 비트로 묶지 않는다.
+    std::vector<uint8_t> mIsNormalRowDeferred;
+
+    // 아래 평면들을 담는 한 덩어리. 평면마다 시작 주소가 캐시 라인에 맞는다.
+    float* mPlaneData = nullptr;
+
+    float* mPrevHeights = nullptr;
+    float* mCurrHeights = nullptr;
+    float* mNormalX = nullptr;
+    float* mNormalY = nullptr;
+    float* mNormalZ = nullptr;
+    float* mTangentX = nullptr;
+    float* mTangentY = nullptr;
 };
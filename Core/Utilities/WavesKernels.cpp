@@ -0,0 +1,153 @@
+#include "WavesKernels.h"
+
+#include <array>
+#include <emmintrin.h>
+#include <intrin.h>
+
+using namespace DirectX;
+
+namespace
+{
+    void StepRowScalar(float* prevRow, const float* currentRow, const float* upRow, const float* downRow, UINT columnCount, const WavesKernels::StepConstants& constants)
+    {
+        for (UINT j = 1; j < columnCount - 1; ++j)
+        {
+            prevRow[j] = constants.k1 * prevRow[j] + constants.k2 * currentRow[j] + constants.k3 * (downRow[j] + upRow[j] + currentRow[j + 1] + currentRow[j - 1]);
+        }
+    }
+
+    void ComputeNormalRowScalar(const float* currentRow, const float* upRow, const float* downRow, const WavesKernels::NormalRow& outRow, UINT columnCount, float spatialStep)
+    {
+        for (UINT j = 1; j < columnCount - 1; ++j)
+        {
+            const float l = currentRow[j - 1];
+            const float r = currentRow[j + 1];
+            const float t = upRow[j];
+            const float b = downRow[j];
+
+            XMFLOAT3 normal(-r + l, 2.0f * spatialStep, b - t);
+            XMStoreFloat3(&normal, XMVector3Normalize(XMLoadFloat3(&normal)));
+            outRow.normalX[j] = normal.x;
+            outRow.normalY[j] = normal.y;
+            outRow.normalZ[j] = normal.z;
+
+            XMFLOAT3 tangent(2.0f * spatialStep, r - l, 0.0f);
+            XMStoreFloat3(&tangent, XMVector3Normalize(XMLoadFloat3(&tangent)));
+            outRow.tangentX[j] = tangent.x;
+            outRow.tangentY[j] = tangent.y;
+        }
+    }
+
+    void StepRowSse2(float* prevRow, const float* currentRow, const float* upRow, const float* downRow, UINT columnCount, const WavesKernels::StepConstants& constants)
+    {
+        const __m128 k1 = _mm_set1_ps(constants.k1);
+        const __m128 k2 = _mm_set1_ps(constants.k2);
+        const __m128 k3 = _mm_set1_ps(constants.k3);
+
+        UINT j = 1;
+        for (; j + 4 <= columnCount - 1; j += 4)
+        {
+            const __m128 neighbors = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_loadu_ps(downRow + j), _mm_loadu_ps(upRow + j)), _mm_loadu_ps(currentRow + j + 1)), _mm_loadu_ps(currentRow + j - 1));
+            const __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(k1, _mm_loadu_ps(prevRow + j)), _mm_mul_ps(k2, _mm_loadu_ps(currentRow + j))), _mm_mul_ps(k3, neighbors));
+            _mm_storeu_ps(prevRow + j, result);
+        }
+
+        if (j < columnCount - 1)
+        {
+            StepRowScalar(prevRow + j - 1, currentRow + j - 1, upRow + j - 1, downRow + j - 1, columnCount - j + 1, constants);
+        }
+    }
+
+    void ComputeNormalRowSse2(const float* currentRow, const float* upRow, const float* downRow, const WavesKernels::NormalRow& outRow, UINT columnCount, float spatialStep)
+    {
+        const __m128 twoStep = _mm_set1_ps(2.0f * spatialStep);
+        const __m128 twoStepSq = _mm_mul_ps(twoStep, twoStep);
+        const __m128 zero = _mm_setzero_ps();
+
+        UINT j = 1;
+        for (; j + 4 <= columnCount - 1; j += 4)
+        {
+            const __m128 l = _mm_loadu_ps(currentRow + j - 1);
+            const __m128 r = _mm_loadu_ps(currentRow + j + 1);
+            const __m128 t = _mm_loadu_ps(upRow + j);
+            const __m128 b = _mm_loadu_ps(downRow + j);
+
+            // XMVector3Normalize와 같이 (x * x + y * y) + z * z의 제곱근으로 나눈다.
+            const __m128 normalX = _mm_sub_ps(l, r);
+            const __m128 normalZ = _mm_sub_ps(b, t);
+            const __m128 normalLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, normalX), twoStepSq), _mm_mul_ps(normalZ, normalZ)));
+            _mm_storeu_ps(outRow.normalX + j, _mm_div_ps(normalX, normalLength));
+            _mm_storeu_ps(outRow.normalY + j, _mm_div_ps(twoStep, normalLength));
+            _mm_storeu_ps(outRow.normalZ + j, _mm_div_ps(normalZ, normalLength));
+
+            const __m128 tangentY = _mm_sub_ps(r, l);
+            const __m128 tangentLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(twoStepSq, _mm_mul_ps(tangentY, tangentY)), zero));
+            _mm_storeu_ps(outRow.tangentX + j, _mm_div_ps(twoStep, tangentLength));
+            _mm_storeu_ps(outRow.tangentY + j, _mm_div_ps(tangentY, tangentLength));
+        }
+
+        if (j < columnCount - 1)
+        {
+            const WavesKernels::NormalRow tailRow{outRow.normalX + j - 1, outRow.normalY + j - 1, outRow.normalZ + j - 1, outRow.tangentX + j - 1, outRow.tangentY + j - 1};
+            ComputeNormalRowScalar(currentRow + j - 1, upRow + j - 1, downRow + j - 1, tailRow, columnCount - j + 1, spatialStep);
+        }
+    }
+
+    WavesKernels::SimdLevel DetectSimdLevel()
+    {
+        // AVX2 명령이 있어도 OS가 YMM 레지스터를 저장해 주지 않으면 쓸 수 없다.
+        std::array<int, 4> info{};
+        __cpuid(info.data(), 0);
+        if (info[0] >= 7)
+        {
+            __cpuid(info.data(), 1);
+            const bool hasOsxsave = (info[2] & (1 << 27)) != 0;
+            const bool hasAvx = (info[2] & (1 << 28)) != 0;
+            if (hasOsxsave && hasAvx && (_xgetbv(0) & 0x6) == 0x6)
+            {
+                __cpuidex(info.data(), 7, 0);
+                if ((info[1] & (1 << 5)) != 0)
+                {
+                    return WavesKernels::SimdLevel::Avx2;
+                }
+            }
+        }
+
+        // x64에서는 SSE2가 항상 있다.
+        return WavesKernels::SimdLevel::Sse2;
+    }
+}
+
+WavesKernels::SimdLevel WavesKernels::GetSupportedSimdLevel()
+{
+    static const SimdLevel supportedLevel = DetectSimdLevel();
+    return supportedLevel;
+}
+
+const WavesKernels::KernelTable& WavesKernels::GetKernelTable(SimdLevel level)
+{
+    static constexpr KernelTable scalarTable{StepRowScalar, ComputeNormalRowScalar};
+    static constexpr KernelTable sse2Table{StepRowSse2, ComputeNormalRowSse2};
+
+    if (level > GetSupportedSimdLevel())
+    {
+        level = GetSupportedSimdLevel();
+    }
+
+    switch (level)
+    {
+    case SimdLevel::Scalar: return scalarTable;
+    case SimdLevel::Sse2: return sse2Table;
+    default: return GetAvx2KernelTable();
+    }
+}
+
+const wchar_t* WavesKernels::ToString(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Scalar: return L"Scalar";
+    case SimdLevel::Sse2: return L"SSE2";
+    default: return L"AVX2";
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+
+// Waves::Step의 높이 갱신과 법선 계산을 한 행씩 처리하는 커널. 스칼라, SSE2, AVX2 구현이 있고 실행 중에 CPU가 지원하는 경로를 고른다.
+// 높이와 법선은 성분별 float 평면으로 저장한다. SIMD 경로는 스칼라 경로(DirectXMath의 SSE2 구현)와 같은 순서로 연산하므로 FMA로 합쳐지지 않는 한 결과가 비트 단위로 같다.
+namespace WavesKernels
+{
+    enum class SimdLevel
+    {
+        Scalar,
+        Sse2,
+        Avx2,
+    };
+
+    struct StepConstants
+    {
+        float k1 = 0.0f;
+        float k2 = 0.0f;
+        float k3 = 0.0f;
+    };
+
+    // 행 i의 법선과 x 방향 탄젠트를 성분별 평면에 쓸 위치. 탄젠트의 z는 항상 0이므로 저장하지 않는다.
+    struct NormalRow
+    {
+        float* normalX = nullptr;
+        float* normalY = nullptr;
+        float* normalZ = nullptr;
+        float* tangentX = nullptr;
+        float* tangentY = nullptr;
+    };
+
+    // 행 i의 내부 열 [1, columnCount - 1) 높이를 갱신한다. upRow, downRow는 행 i - 1, i + 1의 높이이고 prevRow는 제자리에서 새 높이로 바뀐다.
+    using StepRowFunction = void (*)(float* prevRow, const float* currentRow, const float* upRow, const float* downRow, UINT columnCount, const StepConstants& constants);
+
+    // 행 i의 내부 열 [1, columnCount - 1) 법선과 x 방향 탄젠트를 중앙 차분으로 구한다.
+    using NormalRowFunction = void (*)(const float* currentRow, const float* upRow, const float* downRow, const NormalRow& outRow, UINT columnCount, float spatialStep);
+
+    struct KernelTable
+    {
+        StepRowFunction stepRow = nullptr;
+        NormalRowFunction computeNormalRow = nullptr;
+    };
+
+    // CPU와 OS가 지원하는 가장 넓은 경로. 처음 호출할 때 한 번만 검사한다.
+    [[nodiscard]]
+    SimdLevel GetSupportedSimdLevel();
+
+    // 지원하지 않는 경로를 요청하면 지원하는 가장 넓은 경로를 돌려준다.
+    [[nodiscard]]
+    const KernelTable& GetKernelTable(SimdLevel level);
+
+    [[nodiscard]]
+    const wchar_t* ToString(SimdLevel level);
+
+    // AVX2 커널은 /arch:AVX2로 컴파일하는 별도 파일에 있다.
+    [[nodiscard]]
+    const KernelTable& GetAvx2KernelTable();
+}
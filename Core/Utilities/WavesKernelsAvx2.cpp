@@ -0,0 +1,72 @@
+// 이 파일만 /arch:AVX2로 컴파일한다. WavesKernels::GetKernelTable이 CPU를 확인한 뒤에만 이 커널을 고른다.
+#include "WavesKernels.h"
+
+#include <immintrin.h>
+
+using namespace DirectX;
+
+namespace
+{
+    // FMA로 합치면 스칼라 경로와 반올림이 달라지므로 곱과 합을 따로 한다.
+    void StepRowAvx2(float* prevRow, const float* currentRow, const float* upRow, const float* downRow, UINT columnCount, const WavesKernels::StepConstants& constants)
+    {
+        const __m256 k1 = _mm256_set1_ps(constants.k1);
+        const __m256 k2 = _mm256_set1_ps(constants.k2);
+        const __m256 k3 = _mm256_set1_ps(constants.k3);
+
+        UINT j = 1;
+        for (; j + 8 <= columnCount - 1; j += 8)
+        {
+            const __m256 neighbors = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(downRow + j), _mm256_loadu_ps(upRow + j)), _mm256_loadu_ps(currentRow + j + 1)), _mm256_loadu_ps(currentRow + j - 1));
+            const __m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(k1, _mm256_loadu_ps(prevRow + j)), _mm256_mul_ps(k2, _mm256_loadu_ps(currentRow + j))), _mm256_mul_ps(k3, neighbors));
+            _mm256_storeu_ps(prevRow + j, result);
+        }
+
+        // 남은 열은 SSE2 경로로 처리한다.
+        if (j < columnCount - 1)
+        {
+            WavesKernels::GetKernelTable(WavesKernels::SimdLevel::Sse2).stepRow(prevRow + j - 1, currentRow + j - 1, upRow + j - 1, downRow + j - 1, columnCount - j + 1, constants);
+        }
+    }
+
+    void ComputeNormalRowAvx2(const float* currentRow, const float* upRow, const float* downRow, const WavesKernels::NormalRow& outRow, UINT columnCount, float spatialStep)
+    {
+        const __m256 twoStep = _mm256_set1_ps(2.0f * spatialStep);
+        const __m256 twoStepSq = _mm256_mul_ps(twoStep, twoStep);
+        const __m256 zero = _mm256_setzero_ps();
+
+        UINT j = 1;
+        for (; j + 8 <= columnCount - 1; j += 8)
+        {
+            const __m256 l = _mm256_loadu_ps(currentRow + j - 1);
+            const __m256 r = _mm256_loadu_ps(currentRow + j + 1);
+            const __m256 t = _mm256_loadu_ps(upRow + j);
+            const __m256 b = _mm256_loadu_ps(downRow + j);
+
+            const __m256 normalX = _mm256_sub_ps(l, r);
+            const __m256 normalZ = _mm256_sub_ps(b, t);
+            const __m256 normalLength = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normalX, normalX), twoStepSq), _mm256_mul_ps(normalZ, normalZ)));
+            _mm256_storeu_ps(outRow.normalX + j, _mm256_div_ps(normalX, normalLength));
+            _mm256_storeu_ps(outRow.normalY + j, _mm256_div_ps(twoStep, normalLength));
+            _mm256_storeu_ps(outRow.normalZ + j, _mm256_div_ps(normalZ, normalLength));
+
+            const __m256 tangentY = _mm256_sub_ps(r, l);
+            const __m256 tangentLength = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(twoStepSq, _mm256_mul_ps(tangentY, tangentY)), zero));
+            _mm256_storeu_ps(outRow.tangentX + j, _mm256_div_ps(twoStep, tangentLength));
+            _mm256_storeu_ps(outRow.tangentY + j, _mm256_div_ps(tangentY, tangentLength));
+        }
+
+        // 남은 열은 SSE2 경로로 처리한다.
+        if (j < columnCount - 1)
+        {
+            const WavesKernels::NormalRow tailRow{outRow.normalX + j - 1, outRow.normalY + j - 1, outRow.normalZ + j - 1, outRow.tangentX + j - 1, outRow.tangentY + j - 1};
+            WavesKernels::GetKernelTable(WavesKernels::SimdLevel::Sse2).computeNormalRow(currentRow + j - 1, upRow + j - 1, downRow + j - 1, tailRow, columnCount - j + 1, spatialStep);
+        }
+    }
+}
+
+const WavesKernels::KernelTable& WavesKernels::GetAvx2KernelTable()
+{
+    static constexpr KernelTable avx2Table{StepRowAvx2, ComputeNormalRowAvx2};
+    return avx2Table;
+}
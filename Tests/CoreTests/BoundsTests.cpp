@@ -0,0 +1,164 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/Bounds.h"
+#include "Core/Utilities/Parallel.h"
+#include "TestFramework.h"
+#include "TestModels.h"
+
+using namespace DirectX;
+
+namespace
+{
+    using Vertex = GeometryGenerator::Vertex;
+
+    // 해골과 생성 함수의 모양들. 격자는 높이가 0이라 AABB의 한 축이 비어 있다.
+    std::vector<GeometryGenerator::MeshData> CreateMeshes()
+    {
+        return
+        {
+            TestModels::LoadModel(L"skull.txt"),
+            GeometryGenerator::CreateBox(1.0f, 2.0f, 3.0f),
+            GeometryGenerator::CreateSphere(1.5f, 20, 20),
+            GeometryGenerator::CreateGeodesicSphere(2.0f, 3),
+            GeometryGenerator::CreateCylinder(1.0f, 0.25f, 4.0f, 17, 5),
+            GeometryGenerator::CreateGrid(20.0f, 10.0f, 31, 17)
+        };
+    }
+
+    VertexView MakePositionView(const GeometryGenerator::MeshData& mesh)
+    {
+        return MakeVertexView(std::span<const Vertex>(mesh.vertices), &Vertex::position);
+    }
+
+    // 부동소수점 오차만큼은 밖에 있어도 안에 있는 것으로 본다.
+    float GetTolerance(const Bounds& bounds)
+    {
+        return 1.0e-5f * std::max(bounds.sphereRadius, 1.0f);
+    }
+
+    bool Contains(const Bounds& bounds, FXMVECTOR position)
+    {
+        const float tolerance = GetTolerance(bounds);
+        const XMVECTOR toleranceVector = XMVectorReplicate(tolerance);
+        const bool isInBox = XMVector3InBounds(XMVectorSubtract(position, XMLoadFloat3(&bounds.boxCenter)), XMVectorAdd(XMLoadFloat3(&bounds.boxExtents), toleranceVector));
+        const bool isInSphere = XMVectorGetX(XMVector3Length(XMVectorSubtract(position, XMLoadFloat3(&bounds.sphereCenter)))) <= bounds.sphereRadius + tolerance;
+        return isInBox && isInSphere;
+    }
+
+    bool ContainsAll(const Bounds& bounds, const GeometryGenerator::MeshData& mesh, FXMMATRIX transform = XMMatrixIdentity())
+    {
+        return std::ranges::all_of(mesh.vertices, [&](const Vertex& vertex)
+        {
+            return Contains(bounds, XMVector3TransformCoord(XMLoadFloat3(&vertex.position), transform));
+        });
+    }
+
+    float GetMaxDistance(const GeometryGenerator::MeshData& mesh, FXMVECTOR center)
+    {
+        float maxDistance = 0.0f;
+        for (const Vertex& vertex : mesh.vertices)
+        {
+            maxDistance = std::max(maxDistance, XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&vertex.position), center))));
+        }
+
+        return maxDistance;
+    }
+
+    bool IsBitwiseEqual(const Bounds& lhs, const Bounds& rhs)
+    {
+        return std::memcmp(&lhs, &rhs, sizeof(Bounds)) == 0;
+    }
+}
+
+// AABB와 경계 구는 모든 정점을 감싸고, 고른 구는 AABB 중심에서 가장 먼 정점까지의 구보다 크지 않다.
+TEST_CASE(BoundsContainEveryVertex)
+{
+    for (const GeometryGenerator::MeshData& mesh : CreateMeshes())
+    {
+        const Bounds bounds = mesh.ComputeBounds();
+        CHECK(!bounds.IsEmpty());
+        CHECK(ContainsAll(bounds, mesh));
+        CHECK(bounds.sphereRadius <= GetMaxDistance(mesh, XMLoadFloat3(&bounds.boxCenter)));
+
+        const Bounds boxBounds = Bounds::ComputeFromBox(MakePositionView(mesh));
+        CHECK(ContainsAll(boxBounds, mesh));
+        CHECK(bounds.sphereRadius <= boxBounds.sphereRadius);
+    }
+
+    // 한쪽으로 치우친 해골은 Ritter 구가 AABB 중심의 구보다 작다.
+    const GeometryGenerator::MeshData skull = TestModels::LoadModel(L"skull.txt");
+    const Bounds skullBounds = skull.ComputeBounds();
+    CHECK(skullBounds.sphereRadius < GetMaxDistance(skull, XMLoadFloat3(&skullBounds.boxCenter)));
+}
+
+// 회전과 비균등 배율, 이동을 함께 적용해도 변환한 범위가 변환한 정점을 모두 감싼다.
+TEST_CASE(BoundsTransformContainsTransformedVertices)
+{
+    const XMMATRIX transform = XMMatrixScaling(2.0f, 0.5f, 3.0f) * XMMatrixRotationRollPitchYaw(0.3f, 1.1f, -0.7f) * XMMatrixTranslation(4.0f, -2.0f, 1.0f);
+    for (const GeometryGenerator::MeshData& mesh : CreateMeshes())
+    {
+        CHECK(ContainsAll(mesh.ComputeBounds().Transform(transform), mesh, transform));
+    }
+
+    CHECK(Bounds().Transform(transform).IsEmpty());
+}
+
+// 합친 범위는 두 범위와 두 메시의 정점을 모두 감싼다. 빈 범위와 합치면 다른 쪽을 그대로 돌려준다.
+TEST_CASE(BoundsMergeContainsBothInputs)
+{
+    const std::vector<GeometryGenerator::MeshData> meshes = CreateMeshes();
+    const XMMATRIX offset = XMMatrixTranslation(3.0f, -1.0f, 2.0f);
+    for (const GeometryGenerator::MeshData& lhs : meshes)
+    {
+        for (const GeometryGenerator::MeshData& rhs : meshes)
+        {
+            const Bounds lhsBounds = lhs.ComputeBounds();
+            const Bounds rhsBounds = rhs.ComputeBounds().Transform(offset);
+            const Bounds merged = Bounds::Merge(lhsBounds, rhsBounds);
+            CHECK(ContainsAll(merged, lhs));
+            CHECK(ContainsAll(merged, rhs, offset));
+
+            for (const Bounds& input : {lhsBounds, rhsBounds})
+            {
+                const XMVECTOR mergedExtents = XMVectorAdd(XMLoadFloat3(&merged.boxExtents), XMVectorReplicate(GetTolerance(merged)));
+                CHECK(XMVector3InBounds(XMVectorSubtract(input.GetBoxMinimum(), XMLoadFloat3(&merged.boxCenter)), mergedExtents));
+                CHECK(XMVector3InBounds(XMVectorSubtract(input.GetBoxMaximum(), XMLoadFloat3(&merged.boxCenter)), mergedExtents));
+                const float centerDistance = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&input.sphereCenter), XMLoadFloat3(&merged.sphereCenter))));
+                CHECK(centerDistance + input.sphereRadius <= merged.sphereRadius + GetTolerance(merged));
+            }
+        }
+    }
+
+    const Bounds bounds = meshes.front().ComputeBounds();
+    CHECK(IsBitwiseEqual(Bounds::Merge(bounds, Bounds()), bounds));
+    CHECK(IsBitwiseEqual(Bounds::Merge(Bounds(), bounds), bounds));
+}
+
+// 구간은 정점 수로만 나누므로 작업자 수와 상관없이 결과가 비트 단위로 같다. 여러 구간으로 나뉘는 큰 메시를 함께 쓴다.
+TEST_CASE(BoundsAreIndependentOfWorkerCount)
+{
+    std::vector<GeometryGenerator::MeshData> meshes = CreateMeshes();
+    meshes.push_back(GeometryGenerator::CreateGeodesicSphere(1.0f, 6));
+    meshes.push_back(GeometryGenerator::CreateGrid(10.0f, 10.0f, 300, 301));
+
+    for (const GeometryGenerator::MeshData& mesh : meshes)
+    {
+        const VertexView vertexView = MakePositionView(mesh);
+        const std::span<const UINT> firstHalfIndices = std::span(mesh.indices).first(mesh.indices.size() / 6 * 3);
+
+        Parallel::SetMaxWorkerCount(1);
+        const Bounds serialBounds = Bounds::Compute(vertexView);
+        const Bounds serialBoxBounds = Bounds::ComputeFromBox(vertexView);
+        const Bounds serialIndexedBounds = Bounds::Compute(vertexView, firstHalfIndices);
+        Parallel::SetMaxWorkerCount(0);
+
+        CHECK(IsBitwiseEqual(Bounds::Compute(vertexView), serialBounds));
+        CHECK(IsBitwiseEqual(Bounds::ComputeFromBox(vertexView), serialBoxBounds));
+        CHECK(IsBitwiseEqual(Bounds::Compute(vertexView, firstHalfIndices), serialIndexedBounds));
+    }
+}
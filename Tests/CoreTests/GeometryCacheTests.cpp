@@ -0,0 +1,153 @@
+#include <DirectXMath.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "Core/Common/GeometryCache.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+
+namespace
+{
+    const GeometryCache::Key SphereKey = GeometryCache::MakeSphereKey(1.5f, 24, 12);
+
+    XMFLOAT3 ToPosition(const GeometryGenerator::Vertex& vertex) { return vertex.position; }
+
+    // 테스트마다 임시 폴더에 따로 저장해 이전 실행이나 다른 테스트의 파일을 읽지 않게 한다.
+    std::filesystem::path GetCacheFilePath(const char* name)
+    {
+        const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "CoreTests" / name;
+        std::error_code errorCode;
+        std::filesystem::remove(filePath, errorCode);
+        return filePath;
+    }
+
+    std::vector<char> ReadFile(const std::filesystem::path& filePath)
+    {
+        std::ifstream stream(filePath, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    void WriteFile(const std::filesystem::path& filePath, const std::vector<char>& bytes)
+    {
+        std::ofstream stream(filePath, std::ios::binary | std::ios::trunc);
+        stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    template <typename VertexType>
+    bool IsByteIdentical(const std::vector<VertexType>& vertices, const std::vector<UINT>& indices, const std::vector<VertexType>& expectedVertices, const std::vector<UINT>& expectedIndices)
+    {
+        return vertices.size() == expectedVertices.size() && indices == expectedIndices &&
+               std::memcmp(vertices.data(), expectedVertices.data(), vertices.size() * sizeof(VertexType)) == 0;
+    }
+
+    // 구와 위치만 남긴 구를 만들어 filePath에 저장한다.
+    void SaveSphere(const std::filesystem::path& filePath)
+    {
+        GeometryCache cache;
+        (void)cache.GetMesh<XMFLOAT3>(SphereKey, "position", 1, &ToPosition);
+        CHECK(cache.Save(filePath));
+    }
+}
+
+// 같은 키로 다시 요청하면 새로 생성하지 않고 같은 메시를 공유한다.
+TEST_CASE(GeometryCacheSharesMeshForSameKey)
+{
+    GeometryCache cache;
+    const std::shared_ptr<const GeometryGenerator::MeshData> first = cache.GetMesh(SphereKey);
+    const std::shared_ptr<const GeometryGenerator::MeshData> second = cache.GetMesh(GeometryCache::MakeSphereKey(1.5f, 24, 12));
+    CHECK(first == second);
+
+    const GeometryCache::Statistics statistics = cache.GetStatistics();
+    CHECK(statistics.missCount == 1);
+    CHECK(statistics.hitCount == 1);
+    CHECK(statistics.diskHitCount == 0);
+
+    CHECK(cache.GetMesh(GeometryCache::MakeSphereKey(1.5f, 24, 13)) != first);
+    CHECK(cache.GetStatistics().missCount == 2);
+}
+
+// 저장한 파일을 다른 캐시에서 읽으면 생성하지 않고 같은 바이트의 메시를 돌려준다.
+TEST_CASE(GeometryCacheLoadsSavedMeshes)
+{
+    const std::filesystem::path filePath = GetCacheFilePath("GeometryCacheLoadsSavedMeshes.bin");
+
+    GeometryCache cache;
+    const std::shared_ptr<const GeometryGenerator::MeshData> generated = cache.GetMesh(SphereKey);
+    const std::shared_ptr<const GeometryCache::Mesh<XMFLOAT3>> generatedPositions = cache.GetMesh<XMFLOAT3>(SphereKey, "position", 1, &ToPosition);
+    CHECK(cache.Save(filePath));
+
+    cache.Clear();
+    CHECK(cache.Load(filePath));
+
+    const GeometryCache::Statistics before = cache.GetStatistics();
+    const std::shared_ptr<const GeometryGenerator::MeshData> loaded = cache.GetMesh(SphereKey);
+    const std::shared_ptr<const GeometryCache::Mesh<XMFLOAT3>> loadedPositions = cache.GetMesh<XMFLOAT3>(SphereKey, "position", 1, &ToPosition);
+
+    const GeometryCache::Statistics after = cache.GetStatistics();
+    CHECK(after.diskHitCount == before.diskHitCount + 2);
+    CHECK(after.missCount == before.missCount);
+    CHECK(loaded != generated);
+    CHECK(IsByteIdentical(loaded->vertices, loaded->indices, generated->vertices, generated->indices));
+    CHECK(IsByteIdentical(loadedPositions->vertices, loadedPositions->indices, generatedPositions->vertices, generatedPositions->indices));
+}
+
+// converter의 판이 바뀌면 저장된 변환 결과를 쓰지 않고 새로 변환한다.
+TEST_CASE(GeometryCacheMissesOnLayoutRevision)
+{
+    const std::filesystem::path filePath = GetCacheFilePath("GeometryCacheMissesOnLayoutRevision.bin");
+    SaveSphere(filePath);
+
+    GeometryCache cache;
+    CHECK(cache.Load(filePath));
+    (void)cache.GetMesh<XMFLOAT3>(SphereKey, "position", 2, &ToPosition);
+
+    // 변환 전 메시는 파일에서 읽고, 변환 결과만 새로 만든다.
+    const GeometryCache::Statistics statistics = cache.GetStatistics();
+    CHECK(statistics.missCount == 1);
+    CHECK(statistics.diskHitCount == 1);
+
+    (void)cache.GetMesh<XMFLOAT3>(SphereKey, "position", 1, &ToPosition);
+    CHECK(cache.GetStatistics().diskHitCount == 2);
+}
+
+// 다른 GeometryGenerator::OutputRevision으로 만든 파일은 읽지 않는다.
+TEST_CASE(GeometryCacheRejectsOtherOutputRevision)
+{
+    const std::filesystem::path filePath = GetCacheFilePath("GeometryCacheRejectsOtherOutputRevision.bin");
+    SaveSphere(filePath);
+
+    // 머리말은 magic, 파일 버전, OutputRevision 순서의 uint32_t이다.
+    std::vector<char> bytes = ReadFile(filePath);
+    CHECK(bytes.size() > 12);
+    const uint32_t otherRevision = GeometryGenerator::OutputRevision + 1;
+    std::memcpy(bytes.data() + 8, &otherRevision, sizeof(otherRevision));
+    WriteFile(filePath, bytes);
+
+    GeometryCache cache;
+    CHECK(!cache.Load(filePath));
+    (void)cache.GetMesh(SphereKey);
+    CHECK(cache.GetStatistics().missCount == 1);
+    CHECK(cache.GetStatistics().diskHitCount == 0);
+}
+
+// 중간에 잘린 파일은 false를 반환하고, 앞부분의 온전한 메시도 반영하지 않는다.
+TEST_CASE(GeometryCacheRejectsTruncatedFile)
+{
+    const std::filesystem::path filePath = GetCacheFilePath("GeometryCacheRejectsTruncatedFile.bin");
+    SaveSphere(filePath);
+
+    const std::vector<char> bytes = ReadFile(filePath);
+    for (const size_t length : {size_t{0}, size_t{10}, bytes.size() / 2, bytes.size() - 1})
+    {
+        WriteFile(filePath, std::vector<char>(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(length)));
+
+        GeometryCache cache;
+        CHECK(!cache.Load(filePath));
+        (void)cache.GetMesh(SphereKey);
+        CHECK(cache.GetStatistics().diskHitCount == 0);
+    }
+}
@@ -0,0 +1,304 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Utilities/Parallel.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // 무방향 간선마다 몇 개의 삼각형이 쓰는지 센다.
+    std::map<std::pair<UINT, UINT>, UINT> CountEdgeUses(const std::vector<UINT>& indices)
+    {
+        std::map<std::pair<UINT, UINT>, UINT> edgeUses;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                const UINT a = indices[i + corner];
+                const UINT b = indices[i + (corner + 1) % 3];
+                ++edgeUses[std::minmax(a, b)];
+            }
+        }
+
+        return edgeUses;
+    }
+
+    // 고리를 SIMD로 만들기 전처럼 정점마다 std::sin, std::cos를 부르고 정규화해 구의 정점을 만든다.
+    std::vector<GeometryGenerator::Vertex> CreateReferenceSphereVertices(float radius, UINT sliceCount, UINT stackCount)
+    {
+        std::vector<GeometryGenerator::Vertex> vertices;
+        vertices.emplace_back(XMFLOAT3(0.0f, radius, 0.0f), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f));
+
+        const float phiStep = XM_PI / static_cast<float>(stackCount);
+        const float thetaStep = XM_2PI / static_cast<float>(sliceCount);
+        for (UINT i = 1; i <= stackCount - 1; ++i)
+        {
+            const float phi = static_cast<float>(i) * phiStep;
+            for (UINT j = 0; j <= sliceCount; ++j)
+            {
+                const float theta = static_cast<float>(j) * thetaStep;
+
+                GeometryGenerator::Vertex vertex;
+                vertex.position = XMFLOAT3(radius * std::sin(phi) * std::cos(theta), radius * std::cos(phi), radius * std::sin(phi) * std::sin(theta));
+                XMStoreFloat3(&vertex.normal, XMVector3Normalize(XMLoadFloat3(&vertex.position)));
+                XMStoreFloat3(&vertex.tangentU, XMVector3Normalize(XMVectorSet(-std::sin(theta), 0.0f, std::cos(theta), 0.0f)));
+                vertex.texC = XMFLOAT2(theta / XM_2PI, phi / XM_PI);
+                vertices.push_back(vertex);
+            }
+        }
+
+        vertices.emplace_back(XMFLOAT3(0.0f, -radius, 0.0f), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 1.0f));
+        return vertices;
+    }
+
+    // 원기둥도 같은 방식으로 옆면 고리와 위, 아래 뚜껑의 정점을 만든다.
+    std::vector<GeometryGenerator::Vertex> CreateReferenceCylinderVertices(float bottomRadius, float topRadius, float height, UINT sliceCount, UINT stackCount)
+    {
+        std::vector<GeometryGenerator::Vertex> vertices;
+
+        const float stackHeight = height / static_cast<float>(stackCount);
+        const float radiusStep = (topRadius - bottomRadius) / static_cast<float>(stackCount);
+        const float thetaStep = XM_2PI / static_cast<float>(sliceCount);
+        const float dRadius = bottomRadius - topRadius;
+        for (UINT i = 0; i <= stackCount; ++i)
+        {
+            const float y = -0.5f * height + static_cast<float>(i) * stackHeight;
+            const float radius = bottomRadius + static_cast<float>(i) * radiusStep;
+            for (UINT j = 0; j <= sliceCount; ++j)
+            {
+                const float cos = std::cos(static_cast<float>(j) * thetaStep);
+                const float sin = std::sin(static_cast<float>(j) * thetaStep);
+
+                GeometryGenerator::Vertex vertex;
+                vertex.position = XMFLOAT3(radius * cos, y, radius * sin);
+                vertex.tangentU = XMFLOAT3(-sin, 0.0f, cos);
+                XMStoreFloat3(&vertex.normal, XMVector3Normalize(XMVector3Cross(XMLoadFloat3(&vertex.tangentU), XMVectorSet(dRadius * cos, -height, dRadius * sin, 0.0f))));
+                vertex.texC = XMFLOAT2(static_cast<float>(j) / static_cast<float>(sliceCount), 1.0f - static_cast<float>(i) / static_cast<float>(stackCount));
+                vertices.push_back(vertex);
+            }
+        }
+
+        for (const bool isTop : {true, false})
+        {
+            const float radius = isTop ? topRadius : bottomRadius;
+            const float y = isTop ? height * 0.5f : height * -0.5f;
+            const XMFLOAT3 normal(0.0f, isTop ? 1.0f : -1.0f, 0.0f);
+            for (UINT j = 0; j <= sliceCount; ++j)
+            {
+                const float cos = std::cos(static_cast<float>(j) * thetaStep);
+                const float sin = std::sin(static_cast<float>(j) * thetaStep);
+                vertices.emplace_back(XMFLOAT3(radius * cos, y, radius * sin), normal, XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(cos * 0.5f + 0.5f, sin * 0.5f + 0.5f));
+            }
+            vertices.emplace_back(XMFLOAT3(0.0f, y, 0.0f), normal, XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(0.5f, 0.5f));
+        }
+
+        return vertices;
+    }
+
+    // 모든 성분의 차이가 tolerance 이하인지 확인한다. 위치는 크기에 비례하는 오차가 나므로 scale을 곱해 비교한다.
+    bool IsNear(const std::vector<GeometryGenerator::Vertex>& vertices, const std::vector<GeometryGenerator::Vertex>& referenceVertices, float scale, float tolerance)
+    {
+        const auto isNear = [tolerance](float a, float b) { return std::abs(a - b) <= tolerance; };
+        return vertices.size() == referenceVertices.size() && std::ranges::equal(vertices, referenceVertices, [&](const GeometryGenerator::Vertex& vertex, const GeometryGenerator::Vertex& reference)
+        {
+            return isNear(vertex.position.x / scale, reference.position.x / scale) && isNear(vertex.position.y / scale, reference.position.y / scale) && isNear(vertex.position.z / scale, reference.position.z / scale) &&
+                   isNear(vertex.normal.x, reference.normal.x) && isNear(vertex.normal.y, reference.normal.y) && isNear(vertex.normal.z, reference.normal.z) &&
+                   isNear(vertex.tangentU.x, reference.tangentU.x) && isNear(vertex.tangentU.y, reference.tangentU.y) && isNear(vertex.tangentU.z, reference.tangentU.z) &&
+                   isNear(vertex.texC.x, reference.texC.x) && isNear(vertex.texC.y, reference.texC.y);
+        });
+    }
+}
+
+TEST_CASE(GeodesicSphereVertexCount)
+{
+    for (UINT subdivisionCount = 0; subdivisionCount <= 6; ++subdivisionCount)
+    {
+        const GeometryGenerator::MeshData mesh = GeometryGenerator::CreateGeodesicSphere(2.0f, subdivisionCount);
+        const GeometryGenerator::MeshSize size = GeometryGenerator::GetGeodesicSphereSize(subdivisionCount);
+
+        const UINT scale = 1u << (2 * subdivisionCount);
+        CHECK(mesh.vertices.size() == 10 * scale + 2);
+        CHECK(mesh.indices.size() == 60 * scale);
+        CHECK(mesh.vertices.size() == size.vertexCount);
+        CHECK(mesh.indices.size() == size.indexCount);
+
+        CHECK(std::ranges::all_of(mesh.vertices, [](const GeometryGenerator::Vertex& vertex)
+        {
+            return std::abs(XMVectorGetX(XMVector3Length(XMLoadFloat3(&vertex.position))) - 2.0f) < 1.0e-5f;
+        }));
+    }
+}
+
+// 중점을 공유하면 모든 간선이 정확히 두 삼각형에 쓰이는 닫힌 메시가 되고, 같은 위치에 정점이 두 개 생기지 않는다.
+TEST_CASE(GeodesicSphereSharesMidpoints)
+{
+    for (UINT subdivisionCount = 0; subdivisionCount <= 5; ++subdivisionCount)
+    {
+        const GeometryGenerator::MeshData mesh = GeometryGenerator::CreateGeodesicSphere(1.0f, subdivisionCount);
+
+        const std::map<std::pair<UINT, UINT>, UINT> edgeUses = CountEdgeUses(mesh.indices);
+        CHECK(std::ranges::all_of(edgeUses, [](const auto& edgeUse) { return edgeUse.second == 2; }));
+
+        // 오일러 특성 V - E + F = 2
+        CHECK(mesh.vertices.size() + mesh.indices.size() / 3 == edgeUses.size() + 2);
+
+        std::vector<std::tuple<float, float, float>> positions;
+        positions.reserve(mesh.vertices.size());
+        for (const GeometryGenerator::Vertex& vertex : mesh.vertices)
+        {
+            positions.emplace_back(vertex.position.x, vertex.position.y, vertex.position.z);
+        }
+        std::ranges::sort(positions);
+        CHECK(std::ranges::adjacent_find(positions) == positions.end());
+    }
+}
+
+// 버퍼에 바로 기록하는 경로는 MeshData를 만드는 경로와 같은 결과를 내야 한다.
+TEST_CASE(GeodesicSphereSpanMatchesMeshData)
+{
+    for (UINT subdivisionCount = 0; subdivisionCount <= 4; ++subdivisionCount)
+    {
+        const GeometryGenerator::MeshData mesh = GeometryGenerator::CreateGeodesicSphere(1.5f, subdivisionCount);
+        const GeometryGenerator::MeshSize size = GeometryGenerator::GetGeodesicSphereSize(subdivisionCount);
+
+        std::vector<XMFLOAT3> positions(size.vertexCount);
+        std::vector<UINT> indices(size.indexCount);
+        GeometryGenerator::CreateGeodesicSphere(1.5f, subdivisionCount, std::span(positions), std::span(indices), [](const GeometryGenerator::Vertex& vertex) { return vertex.position; });
+
+        CHECK(indices == mesh.indices);
+        CHECK(std::ranges::equal(positions, mesh.vertices, [](const XMFLOAT3& position, const GeometryGenerator::Vertex& vertex)
+        {
+            return position.x == vertex.position.x && position.y == vertex.position.y && position.z == vertex.position.z;
+        }));
+    }
+}
+
+TEST_CASE(SphereRingsMatchScalarReference)
+{
+    // 4의 배수가 아닌 조각 수로 고리 끝의 나머지 정점 경로도 확인한다.
+    for (const UINT sliceCount : {3u, 4u, 20u, 37u, 1024u})
+    {
+        const GeometryGenerator::MeshData mesh = GeometryGenerator::CreateSphere(2.5f, sliceCount, 17);
+        CHECK(IsNear(mesh.vertices, CreateReferenceSphereVertices(2.5f, sliceCount, 17), 2.5f, 2.0e-5f));
+
+        // 이음매의 양 끝 정점은 위치와 법선이 정확히 같아야 한다.
+        for (UINT i = 0; i < 16; ++i)
+        {
+            const GeometryGenerator::Vertex& first = mesh.vertices[1 + i * (sliceCount + 1)];
+            const GeometryGenerator::Vertex& last = mesh.vertices[1 + i * (sliceCount + 1) + sliceCount];
+            CHECK(first.position.x == last.position.x && first.position.y == last.position.y && first.position.z == last.position.z);
+            CHECK(first.normal.x == last.normal.x && first.normal.z == last.normal.z);
+        }
+    }
+}
+
+TEST_CASE(CylinderRingsMatchScalarReference)
+{
+    for (const UINT sliceCount : {3u, 4u, 20u, 37u, 1024u})
+    {
+        const GeometryGenerator::MeshData mesh = GeometryGenerator::CreateCylinder(1.5f, 0.5f, 3.0f, sliceCount, 9);
+        CHECK(IsNear(mesh.vertices, CreateReferenceCylinderVertices(1.5f, 0.5f, 3.0f, sliceCount, 9), 1.5f, 2.0e-5f));
+    }
+}
+
+// 행 띠로 나눠 만든 격자는 작업자 하나로 만든 격자와 바이트 단위로 같아야 한다. 행 수는 띠 크기로 나누어떨어지지 않게 고른다.
+TEST_CASE(GridIsIndependentOfWorkerCount)
+{
+    for (const auto [rowVertexCount, columnVertexCount] : {std::pair(2u, 2u), std::pair(17u, 3u), std::pair(1001u, 33u), std::pair(4099u, 129u)})
+    {
+        const GeometryGenerator::MeshSize size = GeometryGenerator::GetGridSize(rowVertexCount, columnVertexCount);
+
+        const auto createGrid = [&](std::vector<GeometryGenerator::Vertex>& vertices, std::vector<UINT>& indices)
+        {
+            vertices.assign(size.vertexCount, {});
+            indices.assign(size.indexCount, 0);
+            GeometryGenerator::CreateGrid(12.0f, 7.0f, rowVertexCount, columnVertexCount, std::span(vertices), std::span(indices),
+                                          [](const GeometryGenerator::Vertex& vertex) { return vertex; });
+        };
+
+        std::vector<GeometryGenerator::Vertex> serialVertices;
+        std::vector<UINT> serialIndices;
+        Parallel::SetMaxWorkerCount(1);
+        createGrid(serialVertices, serialIndices);
+        Parallel::SetMaxWorkerCount(0);
+
+        std::vector<GeometryGenerator::Vertex> vertices;
+        std::vector<UINT> indices;
+        createGrid(vertices, indices);
+
+        CHECK(std::memcmp(vertices.data(), serialVertices.data(), vertices.size() * sizeof(GeometryGenerator::Vertex)) == 0);
+        CHECK(std::memcmp(indices.data(), serialIndices.data(), indices.size() * sizeof(UINT)) == 0);
+    }
+}
+
+BENCHMARK(GeodesicSphereSubdivision)
+{
+    for (UINT subdivisionCount = 5; subdivisionCount <= 8; ++subdivisionCount)
+    {
+        size_t vertexCount = 0;
+        size_t byteCount = 0;
+        const double milliseconds = TestFramework::MeasureMilliseconds([&]
+        {
+            const GeometryGenerator::MeshData mesh = GeometryGenerator::CreateGeodesicSphere(1.0f, subdivisionCount);
+            vertexCount = mesh.vertices.size();
+            byteCount = mesh.vertices.size() * sizeof(GeometryGenerator::Vertex) + mesh.indices.size() * sizeof(UINT);
+        });
+
+        TestFramework::Log(std::format("  geodesic sphere level {}: {} vertices, {:.1f} MB, {:.2f} ms\n", subdivisionCount, vertexCount, byteCount / (1024.0 * 1024.0), milliseconds));
+    }
+}
+
+// 1024x1024 구와 원기둥을 고리 단위 SIMD 경로와 정점마다 sin, cos를 부르는 경로로 만들어 비교한다.
+BENCHMARK(SphereAndCylinderRings)
+{
+    constexpr UINT sliceCount = 1024;
+    constexpr UINT stackCount = 1024;
+
+    const double sphereMilliseconds = TestFramework::MeasureMilliseconds([] { (void)GeometryGenerator::CreateSphere(1.0f, sliceCount, stackCount); });
+    const double referenceSphereMilliseconds = TestFramework::MeasureMilliseconds([] { (void)CreateReferenceSphereVertices(1.0f, sliceCount, stackCount); });
+    TestFramework::Log(std::format("  sphere {}x{}: {:.2f} ms, scalar reference {:.2f} ms ({:.1f}x)\n", sliceCount, stackCount, sphereMilliseconds, referenceSphereMilliseconds, referenceSphereMilliseconds / sphereMilliseconds));
+
+    const double cylinderMilliseconds = TestFramework::MeasureMilliseconds([] { (void)GeometryGenerator::CreateCylinder(1.0f, 0.5f, 2.0f, sliceCount, stackCount); });
+    const double referenceCylinderMilliseconds = TestFramework::MeasureMilliseconds([] { (void)CreateReferenceCylinderVertices(1.0f, 0.5f, 2.0f, sliceCount, stackCount); });
+    TestFramework::Log(std::format("  cylinder {}x{}: {:.2f} ms, scalar reference {:.2f} ms ({:.1f}x)\n", sliceCount, stackCount, cylinderMilliseconds, referenceCylinderMilliseconds, referenceCylinderMilliseconds / cylinderMilliseconds));
+}
+
+// 4096x4096 격자를 미리 잡아 둔 버퍼에 만들면서 작업자 수를 1개부터 늘려 행 띠 병렬화의 확장성을 출력한다.
+BENCHMARK(GridWorkerScaling)
+{
+    constexpr UINT vertexCount = 4096;
+    const GeometryGenerator::MeshSize size = GeometryGenerator::GetGridSize(vertexCount, vertexCount);
+
+    std::vector<GeometryGenerator::Vertex> vertices(size.vertexCount);
+    std::vector<UINT> indices(size.indexCount);
+    const double byteCount = static_cast<double>(vertices.size() * sizeof(GeometryGenerator::Vertex) + indices.size() * sizeof(UINT));
+
+    double serialMilliseconds = 0.0;
+    for (size_t workerCount = 1; workerCount <= Parallel::GetWorkerCount(); ++workerCount)
+    {
+        Parallel::SetMaxWorkerCount(workerCount);
+        const double milliseconds = TestFramework::MeasureMilliseconds([&]
+        {
+            GeometryGenerator::CreateGrid(160.0f, 160.0f, vertexCount, vertexCount, std::span(vertices), std::span(indices), [](const GeometryGenerator::Vertex& vertex) { return vertex; });
+        });
+
+        if (workerCount == 1)
+        {
+            serialMilliseconds = milliseconds;
+        }
+        TestFramework::Log(std::format("  grid {}x{}, {} workers: {:.2f} ms, {:.2f} GB/s ({:.2f}x)\n", vertexCount, vertexCount, workerCount, milliseconds,
+                                       byteCount / (milliseconds * 1.0e6), serialMilliseconds / milliseconds));
+    }
+
+    Parallel::SetMaxWorkerCount(0);
+}
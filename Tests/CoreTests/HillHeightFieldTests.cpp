@@ -0,0 +1,77 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <vector>
+
+#include "Core/Utilities/HillHeightField.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // 언덕 예제의 지형은 원점을 중심으로 한 160x160이다.
+    constexpr float DomainSize = 160.0f;
+
+    struct Samples
+    {
+        std::vector<float> xs;
+        std::vector<float> zs;
+    };
+
+    // 지형 전체에 고르게 퍼진 점들. 황금비 수열로 x, z를 엇갈리게 골라 격자에 치우치지 않게 한다.
+    Samples CreateSamples(size_t count)
+    {
+        Samples samples;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double u = std::fmod(0.5 + static_cast<double>(i) * 0.6180339887498949, 1.0);
+            const double v = count > 1 ? static_cast<double>(i) / static_cast<double>(count - 1) : 0.5;
+            samples.xs.push_back(static_cast<float>((u - 0.5) * DomainSize));
+            samples.zs.push_back(static_cast<float>((v - 0.5) * DomainSize));
+        }
+
+        return samples;
+    }
+
+    // 값이 0에 가까운 곳에서는 상대 오차가 의미가 없으므로 1보다 작은 값은 절대 오차로 본다.
+    bool IsRelativelyNear(float value, float reference)
+    {
+        return std::abs(value - reference) <= 1.0e-4f * std::max(std::abs(reference), 1.0f);
+    }
+}
+
+// 배치 함수는 8개 묶음과 남은 점 모두에서 스칼라 기준 구현과 상대 오차 1e-4 이내로 같다.
+TEST_CASE(HillBatchMatchesScalarReference)
+{
+    // 묶음 하나보다 작은 길이, 묶음 하나와 나머지, 묶음 여러 개와 나머지 하나
+    for (const size_t count : {size_t{1}, size_t{7}, size_t{9}, size_t{2501}})
+    {
+        const Samples samples = CreateSamples(count);
+
+        std::vector<float> heights(count);
+        std::vector<XMFLOAT3> normals(count);
+        HillHeightField::GetHeightsAndNormals(samples.xs, samples.zs, heights, normals);
+
+        std::vector<float> heightsOnly(count);
+        HillHeightField::GetHeights(samples.xs, samples.zs, heightsOnly);
+
+        size_t mismatchCount = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float x = samples.xs[i];
+            const float z = samples.zs[i];
+            const XMFLOAT3 referenceNormal = HillHeightField::GetNormal(x, z);
+
+            const bool isNear = IsRelativelyNear(heights[i], HillHeightField::GetHeight(x, z)) && IsRelativelyNear(heightsOnly[i], HillHeightField::GetHeight(x, z)) &&
+                                IsRelativelyNear(normals[i].x, referenceNormal.x) && IsRelativelyNear(normals[i].y, referenceNormal.y) && IsRelativelyNear(normals[i].z, referenceNormal.z);
+            if (!isNear && mismatchCount++ == 0)
+            {
+                TestFramework::Log(std::format("  first mismatch at ({}, {}) of {} points: height {} vs {}\n", x, z, count, heights[i], HillHeightField::GetHeight(x, z)));
+            }
+        }
+
+        CHECK(mismatchCount == 0);
+    }
+}
@@ -0,0 +1,152 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Utilities/Parallel.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+
+namespace
+{
+    float SphereDistance(const XMFLOAT3& p)
+    {
+        return std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z) - 1.0f;
+    }
+
+    // 메타볼과 구를 파낸 상자를 합친 암시적 곡면
+    float MetaballsAndCarvedBox(const XMFLOAT3& p)
+    {
+        constexpr std::array<XMFLOAT3, 4> metaballCenters = {XMFLOAT3(-0.6f, 0.0f, 0.0f), XMFLOAT3(0.5f, 0.2f, 0.0f), XMFLOAT3(0.0f, 0.7f, 0.3f), XMFLOAT3(0.1f, -0.5f, -0.6f)};
+
+        float field = 0.0f;
+        for (const XMFLOAT3& center : metaballCenters)
+        {
+            const float dx = p.x - center.x;
+            const float dy = p.y - center.y;
+            const float dz = p.z - center.z;
+            field += 0.15f / (dx * dx + dy * dy + dz * dz + 1.0e-6f);
+        }
+
+        // 안쪽이 큰 메타볼 밀도는 부호를 뒤집고, 상자에서 구를 뺀 부호 거리와 합집합(min)을 취한다.
+        const float metaballs = 1.0f - field;
+        const float box = std::max({std::abs(p.x - 1.2f), std::abs(p.y), std::abs(p.z)}) - 0.5f;
+        const float hole = 0.6f - std::sqrt((p.x - 1.2f) * (p.x - 1.2f) + p.y * p.y + p.z * p.z);
+        return std::min(metaballs, std::max(box, hole));
+    }
+
+    GeometryGenerator::MeshData CreateSurface(float (*density)(const XMFLOAT3&), UINT resolution, size_t workerCount)
+    {
+        Parallel::SetMaxWorkerCount(workerCount);
+        GeometryGenerator::MeshData mesh = GeometryGenerator::CreateImplicitSurface(density, XMFLOAT3(-2.0f, -2.0f, -2.0f), XMFLOAT3(2.0f, 2.0f, 2.0f), resolution);
+        Parallel::SetMaxWorkerCount(0);
+
+        return mesh;
+    }
+
+    // 모든 간선을 정확히 두 삼각형이 쓰면 구멍이나 겹친 면이 없는 닫힌 곡면이다.
+    bool IsClosedManifold(const std::vector<UINT>& indices)
+    {
+        std::map<std::pair<UINT, UINT>, UINT> edgeUses;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                ++edgeUses[std::minmax(indices[i + corner], indices[i + (corner + 1) % 3])];
+            }
+        }
+
+        return !edgeUses.empty() && std::ranges::all_of(edgeUses, [](const auto& edgeUse) { return edgeUse.second == 2; });
+    }
+
+    // 삼각형 면 법선과 정점 법선이 같은 쪽을 향하는 삼각형의 비율
+    float GetFrontFacingRatio(const GeometryGenerator::MeshData& mesh)
+    {
+        size_t frontFacingCount = 0;
+        for (size_t i = 0; i < mesh.indices.size(); i += 3)
+        {
+            const XMVECTOR p0 = XMLoadFloat3(&mesh.vertices[mesh.indices[i]].position);
+            const XMVECTOR p1 = XMLoadFloat3(&mesh.vertices[mesh.indices[i + 1]].position);
+            const XMVECTOR p2 = XMLoadFloat3(&mesh.vertices[mesh.indices[i + 2]].position);
+            const XMVECTOR faceNormal = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+            if (XMVectorGetX(XMVector3Dot(faceNormal, XMLoadFloat3(&mesh.vertices[mesh.indices[i]].normal))) > 0.0f)
+            {
+                ++frontFacingCount;
+            }
+        }
+
+        return static_cast<float>(frontFacingCount) / static_cast<float>(mesh.indices.size() / 3);
+    }
+}
+
+TEST_CASE(ImplicitSphereIsClosedAndOnSurface)
+{
+    // 블록 크기의 배수가 아닌 해상도로 블록 경계의 정점 공유도 확인한다.
+    for (const UINT resolution : {32u, 37u, 64u})
+    {
+        const GeometryGenerator::MeshData sphere = CreateSurface(SphereDistance, resolution, 0);
+        const float cellSize = 4.0f / static_cast<float>(resolution);
+
+        CHECK(IsClosedManifold(sphere.indices));
+        CHECK(std::ranges::all_of(sphere.vertices, [cellSize](const GeometryGenerator::Vertex& vertex)
+        {
+            const XMVECTOR position = XMLoadFloat3(&vertex.position);
+            const bool isOnSurface = std::abs(SphereDistance(vertex.position)) < cellSize;
+            const bool isNormalRadial = XMVectorGetX(XMVector3Dot(XMVector3Normalize(position), XMLoadFloat3(&vertex.normal))) > 0.95f;
+            return isOnSurface && isNormalRadial;
+        }));
+
+        // 감기 순서는 GeometryGenerator의 다른 도형과 같아야 한다.
+        const float geodesicFrontFacingRatio = GetFrontFacingRatio(GeometryGenerator::CreateGeodesicSphere(1.0f, 3));
+        CHECK(std::abs(GetFrontFacingRatio(sphere) - geodesicFrontFacingRatio) < 0.01f);
+    }
+}
+
+TEST_CASE(ImplicitSurfaceMatchesAcrossWorkerCounts)
+{
+    const GeometryGenerator::MeshData single = CreateSurface(MetaballsAndCarvedBox, 96, 1);
+    CHECK(!single.indices.empty());
+
+    for (const size_t workerCount : {2, 3, 0})
+    {
+        const GeometryGenerator::MeshData mesh = CreateSurface(MetaballsAndCarvedBox, 96, workerCount);
+        CHECK(mesh.indices == single.indices);
+        CHECK(mesh.vertices.size() == single.vertices.size() &&
+              std::memcmp(mesh.vertices.data(), single.vertices.data(), mesh.vertices.size() * sizeof(GeometryGenerator::Vertex)) == 0);
+    }
+}
+
+TEST_CASE(ImplicitSurfaceWithoutSignChangeIsEmpty)
+{
+    const GeometryGenerator::MeshData mesh = GeometryGenerator::CreateImplicitSurface([](const XMFLOAT3&) { return 1.0f; }, XMFLOAT3(-1.0f, -1.0f, -1.0f), XMFLOAT3(1.0f, 1.0f, 1.0f), 16);
+    CHECK(mesh.vertices.empty());
+    CHECK(mesh.indices.empty());
+}
+
+// 해상도마다 한 스레드와 모든 스레드에서 다각형화한 시간을 비교한다.
+BENCHMARK(ImplicitSurfacePolygonization)
+{
+    for (const UINT resolution : {128u, 256u})
+    {
+        for (const size_t workerCount : {size_t{1}, Parallel::GetWorkerCount()})
+        {
+            size_t vertexCount = 0;
+            size_t triangleCount = 0;
+            const double milliseconds = TestFramework::MeasureMilliseconds([&]
+            {
+                const GeometryGenerator::MeshData mesh = CreateSurface(MetaballsAndCarvedBox, resolution, workerCount);
+                vertexCount = mesh.vertices.size();
+                triangleCount = mesh.indices.size() / 3;
+            });
+
+            TestFramework::Log(std::format("  implicit surface {}^3: {} vertices, {} triangles, {:.1f} ms on {} threads\n", resolution, vertexCount, triangleCount, milliseconds, workerCount));
+        }
+    }
+}
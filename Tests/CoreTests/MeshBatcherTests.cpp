@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/MeshBatcher.h"
+#include "TestFramework.h"
+
+namespace
+{
+    using Vertex = GeometryGenerator::Vertex;
+
+    // 서로 다른 크기의 메시. 정점과 인덱스 수가 모두 달라 구간이 어긋나면 드러난다.
+    std::vector<GeometryGenerator::MeshData> CreateMeshes()
+    {
+        return
+        {
+            GeometryGenerator::CreateBox(1.0f, 2.0f, 3.0f),
+            GeometryGenerator::CreateSphere(1.0f, 12, 7),
+            GeometryGenerator::CreateGrid(4.0f, 4.0f, 5, 9),
+            GeometryGenerator::CreateCylinder(1.0f, 0.5f, 2.0f, 10, 3),
+            GeometryGenerator::CreateGeodesicSphere(1.0f, 1)
+        };
+    }
+
+    MeshBatcher<Vertex>::MeshId Append(MeshBatcher<Vertex>& batcher, const GeometryGenerator::MeshData& mesh)
+    {
+        return batcher.Append(std::span<const Vertex>(mesh.vertices), std::span<const UINT>(mesh.indices));
+    }
+
+    // Submesh가 가리키는 구간에 mesh의 정점과 인덱스가 그대로 들어 있는지 확인한다.
+    bool HoldsMesh(const MeshBatcher<Vertex>& batcher, MeshBatcher<Vertex>::MeshId meshId, const GeometryGenerator::MeshData& mesh)
+    {
+        const Submesh submesh = batcher.GetSubmesh(meshId);
+        if (submesh.indexCount != mesh.indices.size() ||
+            static_cast<size_t>(submesh.baseVertexLocation) + mesh.vertices.size() > batcher.GetVertexCount() ||
+            static_cast<size_t>(submesh.startIndexLocation) + mesh.indices.size() > batcher.GetIndexCount())
+        {
+            return false;
+        }
+
+        const std::span<const std::byte> vertexBytes = batcher.GetVertexBytes().subspan(static_cast<size_t>(submesh.baseVertexLocation) * sizeof(Vertex), mesh.vertices.size() * sizeof(Vertex));
+        const std::span<const UINT> indices = batcher.GetIndices().subspan(submesh.startIndexLocation, submesh.indexCount);
+        return std::memcmp(vertexBytes.data(), mesh.vertices.data(), vertexBytes.size()) == 0 && std::ranges::equal(indices, mesh.indices);
+    }
+}
+
+// 메시는 추가한 순서대로 이어 담기고, 인덱스는 메시 안의 값 그대로 baseVertexLocation으로 구분된다.
+TEST_CASE(MeshBatcherAppendOffsets)
+{
+    const std::vector<GeometryGenerator::MeshData> meshes = CreateMeshes();
+
+    MeshBatcher<Vertex> batcher;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (const GeometryGenerator::MeshData& mesh : meshes)
+    {
+        const MeshBatcher<Vertex>::MeshId meshId = Append(batcher, mesh);
+        const Submesh submesh = batcher.GetSubmesh(meshId);
+        CHECK(static_cast<size_t>(submesh.baseVertexLocation) == vertexCount);
+        CHECK(submesh.startIndexLocation == indexCount);
+        CHECK(submesh.indexFormat == DXGI_FORMAT_R16_UINT);
+
+        vertexCount += mesh.vertices.size();
+        indexCount += mesh.indices.size();
+    }
+
+    CHECK(batcher.GetVertexCount() == vertexCount);
+    CHECK(batcher.GetIndexCount() == indexCount);
+    for (UINT meshId = 0; meshId < meshes.size(); ++meshId)
+    {
+        CHECK(HoldsMesh(batcher, meshId, meshes[meshId]));
+    }
+}
+
+// 제거한 메시의 구간은 Compact 전까지 남아 있고, Compact 뒤에는 남은 메시가 번호를 유지한 채 빈틈없이 앞으로 당겨진다.
+TEST_CASE(MeshBatcherCompactKeepsSurvivors)
+{
+    const std::vector<GeometryGenerator::MeshData> meshes = CreateMeshes();
+
+    MeshBatcher<Vertex> batcher;
+    for (const GeometryGenerator::MeshData& mesh : meshes)
+    {
+        (void)Append(batcher, mesh);
+    }
+
+    const size_t vertexCount = batcher.GetVertexCount();
+    batcher.Remove(0);
+    batcher.Remove(2);
+    CHECK(!batcher.Contains(0) && !batcher.Contains(2));
+    CHECK(batcher.GetRemovedVertexCount() == meshes[0].vertices.size() + meshes[2].vertices.size());
+    CHECK(batcher.GetVertexCount() == vertexCount);
+
+    batcher.Compact();
+    CHECK(batcher.GetRemovedVertexCount() == 0);
+    CHECK(!batcher.Contains(0) && !batcher.Contains(2));
+
+    size_t survivingVertexCount = 0;
+    size_t survivingIndexCount = 0;
+    for (const UINT meshId : {1u, 3u, 4u})
+    {
+        CHECK(batcher.Contains(meshId));
+        CHECK(HoldsMesh(batcher, meshId, meshes[meshId]));
+
+        const Submesh submesh = batcher.GetSubmesh(meshId);
+        CHECK(static_cast<size_t>(submesh.baseVertexLocation) == survivingVertexCount);
+        CHECK(submesh.startIndexLocation == survivingIndexCount);
+
+        survivingVertexCount += meshes[meshId].vertices.size();
+        survivingIndexCount += meshes[meshId].indices.size();
+    }
+
+    CHECK(batcher.GetVertexCount() == survivingVertexCount);
+    CHECK(batcher.GetIndexCount() == survivingIndexCount);
+
+    // 압축 뒤에 추가한 메시는 새 번호를 받고 끝에 붙는다.
+    const MeshBatcher<Vertex>::MeshId appendedId = Append(batcher, meshes[0]);
+    CHECK(appendedId == meshes.size());
+    CHECK(static_cast<size_t>(batcher.GetSubmesh(appendedId).baseVertexLocation) == survivingVertexCount);
+    CHECK(HoldsMesh(batcher, appendedId, meshes[0]));
+}
+
+// 정점이 65536개를 넘는 메시가 들어오면 32비트 인덱스를 쓰고, 그 메시를 제거하고 압축하면 16비트로 돌아간다.
+TEST_CASE(MeshBatcherIndexFormatFollowsLargestMesh)
+{
+    const GeometryGenerator::MeshData box = GeometryGenerator::CreateBox(1.0f, 1.0f, 1.0f);
+    const GeometryGenerator::MeshData grid16 = GeometryGenerator::CreateGrid(10.0f, 10.0f, 256, 256);
+    const GeometryGenerator::MeshData grid32 = GeometryGenerator::CreateGrid(10.0f, 10.0f, 257, 256);
+
+    MeshBatcher<Vertex> batcher;
+    const MeshBatcher<Vertex>::MeshId boxId = Append(batcher, box);
+    (void)Append(batcher, grid16);
+    CHECK(batcher.GetIndexFormat() == DXGI_FORMAT_R16_UINT);
+
+    const MeshBatcher<Vertex>::MeshId grid32Id = Append(batcher, grid32);
+    CHECK(batcher.GetIndexFormat() == DXGI_FORMAT_R32_UINT);
+    CHECK(batcher.GetSubmesh(boxId).indexFormat == DXGI_FORMAT_R32_UINT);
+
+    // 데이터가 Compact까지 남아 있으므로 형식도 그때까지 유지한다.
+    batcher.Remove(grid32Id);
+    CHECK(batcher.GetIndexFormat() == DXGI_FORMAT_R32_UINT);
+
+    batcher.Compact();
+    CHECK(batcher.GetIndexFormat() == DXGI_FORMAT_R16_UINT);
+    CHECK(batcher.GetSubmesh(boxId).indexFormat == DXGI_FORMAT_R16_UINT);
+    CHECK(HoldsMesh(batcher, boxId, box));
+}
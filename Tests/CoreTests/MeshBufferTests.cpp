@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/MeshBuffer.h"
+#include "TestFramework.h"
+
+namespace
+{
+    // 메시의 인덱스를 고른 형식으로 줄였다가 다시 UINT로 늘려도 값이 그대로인지 확인한다.
+    bool RoundTripsIndices(const GeometryGenerator::MeshData& mesh)
+    {
+        if (mesh.GetIndexFormat() == DXGI_FORMAT_R32_UINT)
+        {
+            return std::ranges::any_of(mesh.indices, [](UINT index) { return index >= MeshBuffer::MaxIndex16VertexCount; });
+        }
+
+        const std::vector<uint16_t> indices16 = MeshBuffer::ToIndex16(mesh.indices);
+        return std::ranges::equal(indices16, mesh.indices, [](uint16_t index16, UINT index) { return index16 == index; });
+    }
+}
+
+TEST_CASE(IndexFormatAt16BitBoundary)
+{
+    CHECK(MeshBuffer::GetIndexFormat(size_t{1}) == DXGI_FORMAT_R16_UINT);
+    CHECK(MeshBuffer::GetIndexFormat(size_t{65535}) == DXGI_FORMAT_R16_UINT);
+    CHECK(MeshBuffer::GetIndexFormat(size_t{65536}) == DXGI_FORMAT_R16_UINT);
+    CHECK(MeshBuffer::GetIndexFormat(size_t{65537}) == DXGI_FORMAT_R32_UINT);
+
+    CHECK(MeshBuffer::GetIndexStride(DXGI_FORMAT_R16_UINT) == 2);
+    CHECK(MeshBuffer::GetIndexStride(DXGI_FORMAT_R32_UINT) == 4);
+
+    // 인덱스로 판단할 때는 가장 큰 인덱스 + 1이 정점 수이다.
+    CHECK(MeshBuffer::GetIndexFormat(std::span<const UINT>()) == DXGI_FORMAT_R16_UINT);
+    const std::vector<UINT> maxIndex16 = {0, 65535, 1};
+    const std::vector<UINT> minIndex32 = {0, 65536, 1};
+    CHECK(MeshBuffer::GetIndexFormat(std::span<const UINT>(maxIndex16)) == DXGI_FORMAT_R16_UINT);
+    CHECK(MeshBuffer::GetIndexFormat(std::span<const UINT>(minIndex32)) == DXGI_FORMAT_R32_UINT);
+}
+
+// 정점이 정확히 65536개인 격자는 마지막 인덱스 65535까지 16비트에 담기고, 한 행만 늘어나도 32비트가 된다.
+TEST_CASE(GridIndexFormatAt16BitBoundary)
+{
+    const GeometryGenerator::MeshData grid16 = GeometryGenerator::CreateGrid(10.0f, 10.0f, 256, 256);
+    CHECK(grid16.GetIndexFormat() == DXGI_FORMAT_R16_UINT);
+    CHECK(std::ranges::max(grid16.indices) == 65535);
+    CHECK(RoundTripsIndices(grid16));
+
+    const GeometryGenerator::MeshData grid32 = GeometryGenerator::CreateGrid(10.0f, 10.0f, 257, 256);
+    CHECK(grid32.GetIndexFormat() == DXGI_FORMAT_R32_UINT);
+    CHECK(RoundTripsIndices(grid32));
+}
+
+TEST_CASE(ShapesRoundTripIndexFormats)
+{
+    const std::vector<GeometryGenerator::MeshData> meshes =
+    {
+        GeometryGenerator::CreateBox(1.0f, 2.0f, 3.0f),
+        GeometryGenerator::CreateSphere(1.0f, 20, 20),
+        GeometryGenerator::CreateSphere(1.0f, 400, 400),
+        GeometryGenerator::CreateGeodesicSphere(1.0f, 3),
+        GeometryGenerator::CreateGeodesicSphere(1.0f, 7),
+        GeometryGenerator::CreateCylinder(0.5f, 0.3f, 3.0f, 20, 20),
+        GeometryGenerator::CreateCylinder(0.5f, 0.3f, 3.0f, 300, 300),
+        GeometryGenerator::CreateGrid(160.0f, 160.0f, 50, 50),
+    };
+
+    for (const GeometryGenerator::MeshData& mesh : meshes)
+    {
+        CHECK(mesh.GetIndexFormat() == MeshBuffer::GetIndexFormat(std::span<const UINT>(mesh.indices)));
+        CHECK(RoundTripsIndices(mesh));
+    }
+}
@@ -0,0 +1,154 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Core/Rendering/MeshOptimizer.h"
+#include "Core/Rendering/MeshWelder.h"
+#include "TestFramework.h"
+#include "TestModels.h"
+
+using namespace DirectX;
+
+namespace
+{
+    using Vertex = GeometryGenerator::Vertex;
+
+    // LitSkull과 MirrorDemo처럼 위치와 법선이 같은 정점만 합치고 법선을 다시 만든 해골
+    GeometryGenerator::MeshData LoadWeldedSkull()
+    {
+        GeometryGenerator::MeshData skull = TestModels::LoadModel(L"skull.txt");
+        (void)MeshWelder::Weld(skull.vertices, skull.indices, &Vertex::position, &Vertex::normal);
+        MeshWelder::RecomputeNormals(skull.vertices, skull.indices, &Vertex::position, &Vertex::normal);
+        return skull;
+    }
+
+    VertexView MakePositionView(const GeometryGenerator::MeshData& mesh)
+    {
+        return MakeVertexView(std::span<const Vertex>(mesh.vertices), &Vertex::position);
+    }
+
+    // 감기 순서를 유지한 채 가장 작은 인덱스가 앞에 오도록 돌린 삼각형들을 정렬한다. 순서만 바꾼 인덱스끼리는 결과가 같다.
+    std::vector<std::array<UINT, 3>> GetSortedTriangles(std::span<const UINT> indices)
+    {
+        std::vector<std::array<UINT, 3>> triangles(indices.size() / 3);
+        for (size_t i = 0; i < triangles.size(); ++i)
+        {
+            std::array<UINT, 3>& triangle = triangles[i];
+            triangle = {indices[i * 3], indices[i * 3 + 1], indices[i * 3 + 2]};
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        }
+
+        std::ranges::sort(triangles);
+        return triangles;
+    }
+}
+
+// 정점 캐시와 오버드로 최적화는 삼각형 순서만 바꾸고, 오버드로 최적화는 캐시 최적화 직후보다 오버드로를 늘리지 않아야 한다.
+TEST_CASE(SkullOverdrawOptimizationKeepsTriangles)
+{
+    GeometryGenerator::MeshData skull = LoadWeldedSkull();
+    const std::vector<std::array<UINT, 3>> sourceTriangles = GetSortedTriangles(skull.indices);
+
+    MeshOptimizer::OptimizeVertexCache(skull.indices, skull.vertices.size());
+    CHECK(GetSortedTriangles(skull.indices) == sourceTriangles);
+    const float cacheOptimizedOverdraw = MeshOptimizer::AnalyzeOverdraw(skull.indices, MakePositionView(skull)).overdraw;
+
+    MeshOptimizer::OptimizeOverdraw(skull.indices, MakePositionView(skull));
+    CHECK(GetSortedTriangles(skull.indices) == sourceTriangles);
+    CHECK(MeshOptimizer::AnalyzeOverdraw(skull.indices, MakePositionView(skull)).overdraw <= cacheOptimizedOverdraw);
+}
+
+// 해골 파일은 이미 캐시 친화적인 순서로 저장되어 있어(ACMR 약 0.67) 그대로 최적화하면 FIFO 16 기준으로 나아지지 않는다.
+// 삼각형 순서를 섞은 해골에서 최적화하면 ACMR이 크게 줄고 파일 순서와 비슷한 수준까지 돌아와야 한다.
+TEST_CASE(SkullVertexCacheOptimizationLowersAcmr)
+{
+    GeometryGenerator::MeshData skull = LoadWeldedSkull();
+    const float fileOrderAcmr = MeshOptimizer::AnalyzeVertexCache(skull.indices, skull.vertices.size()).acmr;
+
+    std::vector<std::array<UINT, 3>> triangles(skull.indices.size() / 3);
+    std::memcpy(triangles.data(), skull.indices.data(), skull.indices.size() * sizeof(UINT));
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(5489u));
+    std::memcpy(skull.indices.data(), triangles.data(), skull.indices.size() * sizeof(UINT));
+
+    const MeshOptimizer::VertexCacheStatistics before = MeshOptimizer::AnalyzeVertexCache(skull.indices, skull.vertices.size());
+    MeshOptimizer::OptimizeVertexCache(skull.indices, skull.vertices.size());
+    const MeshOptimizer::VertexCacheStatistics after = MeshOptimizer::AnalyzeVertexCache(skull.indices, skull.vertices.size());
+
+    TestFramework::Log(std::format("  skull ACMR: file order {:.3f}, shuffled {:.3f}, optimized {:.3f}\n", fileOrderAcmr, before.acmr, after.acmr));
+    CHECK(after.acmr < before.acmr * 0.5f);
+    CHECK(after.atvr < before.atvr);
+    CHECK(after.acmr < fileOrderAcmr * 1.1f);
+}
+
+// 정점 fetch 최적화 뒤에는 정점이 인덱스에서 처음 쓰이는 순서로 놓이고, 인덱스마다 가리키는 위치는 그대로이며 쓰이지 않는 정점은 빠진다.
+TEST_CASE(SkullVertexFetchFollowsFirstUse)
+{
+    GeometryGenerator::MeshData skull = LoadWeldedSkull();
+    MeshOptimizer::OptimizeVertexCache(skull.indices, skull.vertices.size());
+
+    // 어느 인덱스도 가리키지 않는 정점을 앞에 하나 끼워 넣는다.
+    skull.vertices.insert(skull.vertices.begin(), Vertex());
+    for (UINT& index : skull.indices)
+    {
+        ++index;
+    }
+
+    std::vector<XMFLOAT3> sourcePositions;
+    sourcePositions.reserve(skull.indices.size());
+    for (const UINT index : skull.indices)
+    {
+        sourcePositions.push_back(skull.vertices[index].position);
+    }
+
+    const size_t indexCount = skull.indices.size();
+    MeshOptimizer::OptimizeVertexFetch(skull.vertices, std::span<UINT>(skull.indices));
+
+    UINT nextVertex = 0;
+    bool isFirstUseOrder = true;
+    bool keepsPositions = true;
+    for (size_t i = 0; i < skull.indices.size(); ++i)
+    {
+        const UINT index = skull.indices[i];
+        if (index == nextVertex)
+        {
+            ++nextVertex;
+        }
+        isFirstUseOrder = isFirstUseOrder && index < nextVertex;
+
+        const XMFLOAT3& position = skull.vertices[index].position;
+        keepsPositions = keepsPositions && std::memcmp(&position, &sourcePositions[i], sizeof(XMFLOAT3)) == 0;
+    }
+
+    CHECK(isFirstUseOrder);
+    CHECK(keepsPositions);
+    CHECK(nextVertex == skull.vertices.size());
+    CHECK(skull.indices.size() == indexCount);
+}
+
+// MESH_LOAD_DIAGNOSTICS를 켜면 LitSkull과 MirrorDemo가 출력하는 해골의 ACMR과 오버드로를 threshold별로 출력한다.
+BENCHMARK(SkullOverdrawOptimization)
+{
+    const GeometryGenerator::MeshData source = LoadWeldedSkull();
+    const float sourceAcmr = MeshOptimizer::AnalyzeVertexCache(source.indices, source.vertices.size()).acmr;
+    const float sourceOverdraw = MeshOptimizer::AnalyzeOverdraw(source.indices, MakePositionView(source)).overdraw;
+    TestFramework::Log(std::format("  skull source: ACMR {:.3f}, overdraw {:.3f}\n", sourceAcmr, sourceOverdraw));
+
+    for (const float threshold : {1.0f, MeshOptimizer::DefaultOverdrawThreshold, 1.2f})
+    {
+        GeometryGenerator::MeshData skull = source;
+        const double milliseconds = TestFramework::MeasureMilliseconds([&]
+        {
+            skull = source;
+            MeshOptimizer::Optimize(skull.vertices, std::span<UINT>(skull.indices), &Vertex::position, threshold);
+        });
+
+        const float acmr = MeshOptimizer::AnalyzeVertexCache(skull.indices, skull.vertices.size()).acmr;
+        const float overdraw = MeshOptimizer::AnalyzeOverdraw(skull.indices, MakePositionView(skull)).overdraw;
+        TestFramework::Log(std::format("  skull threshold {:.2f}: ACMR {:.3f}, overdraw {:.3f}, {:.2f} ms\n", threshold, acmr, overdraw, milliseconds));
+    }
+}
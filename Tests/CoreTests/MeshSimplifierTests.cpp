@@ -0,0 +1,145 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <span>
+#include <vector>
+
+#include "Core/Rendering/MeshOptimizer.h"
+#include "Core/Rendering/MeshSimplifier.h"
+#include "Core/Rendering/MeshWelder.h"
+#include "Core/Utilities/Parallel.h"
+#include "TestFramework.h"
+#include "TestModels.h"
+
+using namespace DirectX;
+
+namespace
+{
+    using Vertex = GeometryGenerator::Vertex;
+
+    // MirrorDemo와 같은 LOD 비율
+    constexpr std::array SkullLodTriangleRatios = {0.5f, 0.25f, 0.1f};
+
+    // MirrorDemo처럼 위치와 법선이 같은 정점만 합치고 법선을 다시 만든 뒤 최적화한 해골
+    GeometryGenerator::MeshData LoadMirrorDemoSkull()
+    {
+        GeometryGenerator::MeshData skull = TestModels::LoadModel(L"skull.txt");
+        (void)MeshWelder::Weld(skull.vertices, skull.indices, &Vertex::position, &Vertex::normal);
+        MeshWelder::RecomputeNormals(skull.vertices, skull.indices, &Vertex::position, &Vertex::normal);
+        MeshOptimizer::Optimize(skull.vertices, std::span<UINT>(skull.indices), &Vertex::position);
+        return skull;
+    }
+
+    VertexView MakeSimplifierView(const GeometryGenerator::MeshData& mesh)
+    {
+        return MakeVertexView(std::span<const Vertex>(mesh.vertices), &Vertex::position, &Vertex::normal);
+    }
+
+    // 높이가 물결치는 열린 격자. 평평하면 모든 간선의 비용이 0이라 경계 고정 여부와 상관없이 결과가 비슷해진다.
+    GeometryGenerator::MeshData CreateWavyGrid(UINT vertexCount)
+    {
+        GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(10.0f, 10.0f, vertexCount, vertexCount);
+        for (Vertex& vertex : grid.vertices)
+        {
+            vertex.position.y = 0.3f * std::sin(vertex.position.x) * std::cos(0.7f * vertex.position.z);
+        }
+
+        return grid;
+    }
+
+    // 격자 둘레의 정점 번호
+    std::vector<UINT> GetGridBorderVertices(UINT vertexCount)
+    {
+        std::vector<UINT> border;
+        for (UINT i = 0; i < vertexCount; ++i)
+        {
+            for (UINT j = 0; j < vertexCount; ++j)
+            {
+                if (i == 0 || j == 0 || i == vertexCount - 1 || j == vertexCount - 1)
+                {
+                    border.push_back(i * vertexCount + j);
+                }
+            }
+        }
+
+        return border;
+    }
+
+    size_t CountUsedVertices(std::span<const UINT> vertices, std::span<const UINT> indices)
+    {
+        return std::ranges::count_if(vertices, [&](UINT vertex) { return std::ranges::find(indices, vertex) != indices.end(); });
+    }
+}
+
+// MirrorDemo의 입력에서 각 단계가 목표 삼각형 수 근처까지 줄고, 거친 단계일수록 오차가 크다.
+TEST_CASE(SkullLodChainReachesTargets)
+{
+    const GeometryGenerator::MeshData skull = LoadMirrorDemoSkull();
+    const size_t triangleCount = skull.indices.size() / 3;
+
+    const std::vector<MeshSimplifier::LodLevel> lodLevels = MeshSimplifier::BuildLodChain(MakeSimplifierView(skull), skull.indices, SkullLodTriangleRatios);
+    CHECK(lodLevels.size() == SkullLodTriangleRatios.size());
+
+    float previousError = 0.0f;
+    for (size_t level = 0; level < lodLevels.size(); ++level)
+    {
+        const size_t lodTriangleCount = lodLevels[level].indices.size() / 3;
+        const float targetTriangleCount = static_cast<float>(triangleCount) * SkullLodTriangleRatios[level];
+        TestFramework::Log(std::format("  skull LOD {}: {} triangles (target {:.0f}), error {:.4f}\n", level, lodTriangleCount, targetTriangleCount, lodLevels[level].error));
+
+        CHECK(static_cast<float>(lodTriangleCount) <= targetTriangleCount);
+        CHECK(static_cast<float>(lodTriangleCount) >= targetTriangleCount * 0.95f);
+        CHECK(lodLevels[level].error >= previousError);
+        previousError = lodLevels[level].error;
+    }
+}
+
+// lockBorder면 둘레의 정점을 하나도 접지 않는다. 끄면 곧은 경계를 따라 정점이 접힌다.
+TEST_CASE(SimplifyLocksGridBorder)
+{
+    constexpr UINT vertexCount = 33;
+    const GeometryGenerator::MeshData grid = CreateWavyGrid(vertexCount);
+    const std::vector<UINT> border = GetGridBorderVertices(vertexCount);
+    const VertexView vertexView = MakeVertexView(std::span<const Vertex>(grid.vertices), &Vertex::position);
+    const size_t targetIndexCount = grid.indices.size() / 4;
+
+    MeshSimplifier::Options options;
+    options.lockBorder = true;
+    const MeshSimplifier::LodLevel locked = MeshSimplifier::Simplify(vertexView, grid.indices, targetIndexCount, options);
+    CHECK(locked.indices.size() < grid.indices.size());
+    CHECK(CountUsedVertices(border, locked.indices) == border.size());
+
+    options.lockBorder = false;
+    const MeshSimplifier::LodLevel unlocked = MeshSimplifier::Simplify(vertexView, grid.indices, targetIndexCount, options);
+    CHECK(unlocked.indices.size() <= targetIndexCount);
+    CHECK(CountUsedVertices(border, unlocked.indices) < border.size());
+}
+
+// 단계마다 한 작업에서 단순화하므로 작업자 수와 상관없이 결과가 같다.
+TEST_CASE(SkullLodChainIsIndependentOfWorkerCount)
+{
+    const GeometryGenerator::MeshData skull = LoadMirrorDemoSkull();
+
+    Parallel::SetMaxWorkerCount(1);
+    const std::vector<MeshSimplifier::LodLevel> serial = MeshSimplifier::BuildLodChain(MakeSimplifierView(skull), skull.indices, SkullLodTriangleRatios);
+    Parallel::SetMaxWorkerCount(2);
+    const std::vector<MeshSimplifier::LodLevel> twoWorkers = MeshSimplifier::BuildLodChain(MakeSimplifierView(skull), skull.indices, SkullLodTriangleRatios);
+    Parallel::SetMaxWorkerCount(0);
+    const std::vector<MeshSimplifier::LodLevel> parallel = MeshSimplifier::BuildLodChain(MakeSimplifierView(skull), skull.indices, SkullLodTriangleRatios);
+
+    for (size_t level = 0; level < serial.size(); ++level)
+    {
+        CHECK(serial[level].indices == twoWorkers[level].indices && serial[level].error == twoWorkers[level].error);
+        CHECK(serial[level].indices == parallel[level].indices && serial[level].error == parallel[level].error);
+    }
+}
+
+// MirrorDemo가 불러올 때 만드는 해골 LOD 사슬의 생성 시간을 출력한다.
+BENCHMARK(SkullLodChain)
+{
+    const GeometryGenerator::MeshData skull = LoadMirrorDemoSkull();
+    const double milliseconds = TestFramework::MeasureMilliseconds([&] { (void)MeshSimplifier::BuildLodChain(MakeSimplifierView(skull), skull.indices, SkullLodTriangleRatios); }, 1.0);
+    TestFramework::Log(std::format("  skull LOD chain ({} triangles, {} levels): {:.1f} ms\n", skull.indices.size() / 3, SkullLodTriangleRatios.size(), milliseconds));
+}
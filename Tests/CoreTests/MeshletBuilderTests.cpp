@@ -0,0 +1,133 @@
+#include <DirectXMath.h>
+#include <array>
+#include <format>
+#include <vector>
+
+#include "Core/Data/SphericalCoord.h"
+#include "Core/Rendering/MeshletBuilder.h"
+#include "Core/Rendering/MeshOptimizer.h"
+#include "Core/Rendering/MeshWelder.h"
+#include "TestFramework.h"
+#include "TestModels.h"
+
+using namespace DirectX;
+
+namespace
+{
+    using Vertex = GeometryGenerator::Vertex;
+
+    // SkullApp과 같은 순서(위치로 합치기, 정점 캐시 최적화)로 해골을 준비해 묶음으로 나눈다.
+    MeshletBuilder::MeshletData BuildSkullMeshlets()
+    {
+        GeometryGenerator::MeshData skull = TestModels::LoadModel(L"skull.txt");
+        (void)MeshWelder::Weld(skull.vertices, skull.indices, &Vertex::position);
+        MeshOptimizer::Optimize(skull.vertices, std::span<UINT>(skull.indices));
+        return MeshletBuilder::Build(skull.vertices, skull.indices);
+    }
+
+    // SkullApp의 카메라와 같은 투영(세로 시야각 45도, 800x600, 가까운 평면 1)
+    XMMATRIX GetSkullProjectionMatrix()
+    {
+        return XMMatrixPerspectiveFovLH(XMConvertToRadians(45.0f), 800.0f / 600.0f, 1.0f, 1000.0f);
+    }
+
+    // 해골을 둘러싼 여러 카메라 위치. 반지름 12.5는 SkullApp의 시작 거리이다.
+    std::vector<XMFLOAT3> GetSkullViewPositions()
+    {
+        constexpr UINT azimuthStepCount = 8;
+        constexpr std::array radii = {6.0f, 12.5f};
+        constexpr std::array polarAngles = {XM_PI / 6.0f, XM_PIDIV2 * 0.75f, XM_PIDIV2 * 1.25f};
+
+        std::vector<XMFLOAT3> positions;
+        for (const float radius : radii)
+        {
+            for (const float polarAngle : polarAngles)
+            {
+                for (UINT i = 0; i < azimuthStepCount; ++i)
+                {
+                    XMFLOAT3 position;
+                    XMStoreFloat3(&position, SphericalCoord::SphericalToCartesian({radius, XM_2PI * static_cast<float>(i) / azimuthStepCount, polarAngle}));
+                    positions.push_back(position);
+                }
+            }
+        }
+
+        return positions;
+    }
+
+    // 모든 카메라 위치에서 Cull한 통계를 더한다.
+    MeshletBuilder::CullingStatistics CullFromSkullViews(const MeshletBuilder::MeshletData& meshletData, std::vector<UINT>& visibleMeshlets)
+    {
+        const XMMATRIX worldMatrix = XMMatrixTranslation(0.0f, -2.5f, 0.0f);
+        const XMMATRIX projectionMatrix = GetSkullProjectionMatrix();
+
+        XMVECTOR determinant;
+        const XMMATRIX inverseWorldMatrix = XMMatrixInverse(&determinant, worldMatrix);
+
+        MeshletBuilder::CullingStatistics total;
+        for (const XMFLOAT3& position : GetSkullViewPositions())
+        {
+            const XMVECTOR eyePosition = XMLoadFloat3(&position);
+            const XMMATRIX viewMatrix = XMMatrixLookAtLH(eyePosition, XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+            const MeshletBuilder::CullingStatistics statistics = MeshletBuilder::Cull(meshletData, worldMatrix * viewMatrix * projectionMatrix, XMVector3TransformCoord(eyePosition, inverseWorldMatrix), visibleMeshlets);
+
+            total.visibleMeshletCount += statistics.visibleMeshletCount;
+            total.visibleTriangleCount += statistics.visibleTriangleCount;
+            total.totalTriangleCount += statistics.totalTriangleCount;
+            total.backfaceCulledTriangleCount += statistics.backfaceCulledTriangleCount;
+            total.frustumCulledTriangleCount += statistics.frustumCulledTriangleCount;
+        }
+
+        return total;
+    }
+}
+
+// 묶음은 정점/삼각형 상한을 지키고, 묶음 순서 인덱스 버퍼는 모든 삼각형을 한 번씩 담아야 한다.
+TEST_CASE(SkullMeshletsCoverEveryTriangle)
+{
+    const MeshletBuilder::MeshletData meshletData = BuildSkullMeshlets();
+    CHECK(!meshletData.meshlets.empty());
+    CHECK(meshletData.bounds.size() == meshletData.meshlets.size());
+
+    size_t triangleCount = 0;
+    for (const MeshletBuilder::Meshlet& meshlet : meshletData.meshlets)
+    {
+        CHECK(meshlet.vertexCount <= MeshletBuilder::MaxVertexCount);
+        CHECK(meshlet.triangleCount <= MeshletBuilder::MaxTriangleCount);
+        CHECK(meshlet.triangleOffset == triangleCount);
+        triangleCount += meshlet.triangleCount;
+    }
+
+    CHECK(MeshletBuilder::BuildIndexBuffer(meshletData).size() == triangleCount * 3);
+}
+
+// 컬링 통계는 모든 삼각형을 보이는 것, 후면, 절두체 밖 중 하나로만 센다.
+TEST_CASE(SkullMeshletCullingAccountsForEveryTriangle)
+{
+    const MeshletBuilder::MeshletData meshletData = BuildSkullMeshlets();
+
+    std::vector<UINT> visibleMeshlets;
+    const MeshletBuilder::CullingStatistics total = CullFromSkullViews(meshletData, visibleMeshlets);
+
+    CHECK(total.visibleTriangleCount + total.backfaceCulledTriangleCount + total.frustumCulledTriangleCount == total.totalTriangleCount);
+    CHECK(total.backfaceCulledTriangleCount > 0);
+    CHECK(total.visibleTriangleCount > 0);
+}
+
+// 해골을 둘러싼 카메라 위치에서 묶음 컬링으로 제외되는 삼각형 비율과 Cull 한 번의 시간을 출력한다.
+BENCHMARK(SkullMeshletCulling)
+{
+    const MeshletBuilder::MeshletData meshletData = BuildSkullMeshlets();
+    const size_t viewCount = GetSkullViewPositions().size();
+
+    std::vector<UINT> visibleMeshlets;
+    const MeshletBuilder::CullingStatistics total = CullFromSkullViews(meshletData, visibleMeshlets);
+    const double milliseconds = TestFramework::MeasureMilliseconds([&] { (void)CullFromSkullViews(meshletData, visibleMeshlets); });
+
+    const float totalTriangleCount = static_cast<float>(total.totalTriangleCount);
+    TestFramework::Log(std::format("  skull meshlets {}, triangle rejection {:.1f}% (backface {:.1f}%, frustum {:.1f}%) over {} views, {:.3f} ms per view\n",
+                                   meshletData.meshlets.size(), total.GetTriangleRejectionRate() * 100.0f,
+                                   static_cast<float>(total.backfaceCulledTriangleCount) / totalTriangleCount * 100.0f,
+                                   static_cast<float>(total.frustumCulledTriangleCount) / totalTriangleCount * 100.0f,
+                                   viewCount, milliseconds / static_cast<double>(viewCount)));
+}
@@ -0,0 +1,291 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/HalfEdgeMesh.h"
+#include "Core/Rendering/Subdivision.h"
+#include "Core/Utilities/Parallel.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // 한 변이 2인 정육면체. 면은 바깥에서 볼 때 시계 방향인 사각형이다.
+    constexpr std::array<XMFLOAT3, 8> CubePositions =
+    {
+        XMFLOAT3(-1.0f, -1.0f, -1.0f), XMFLOAT3(-1.0f, 1.0f, -1.0f), XMFLOAT3(1.0f, 1.0f, -1.0f), XMFLOAT3(1.0f, -1.0f, -1.0f),
+        XMFLOAT3(-1.0f, -1.0f, 1.0f), XMFLOAT3(-1.0f, 1.0f, 1.0f), XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT3(1.0f, -1.0f, 1.0f)
+    };
+
+    constexpr std::array<UINT, 24> CubeIndices =
+    {
+        0, 1, 2, 3,
+        7, 6, 5, 4,
+        4, 5, 1, 0,
+        3, 2, 6, 7,
+        1, 5, 6, 2,
+        4, 0, 3, 7
+    };
+
+    constexpr std::array<UINT, 6> CubeFaceSizes = {4, 4, 4, 4, 4, 4};
+
+    std::vector<XMFLOAT3> GetPositions(const GeometryGenerator::MeshData& mesh)
+    {
+        std::vector<XMFLOAT3> positions(mesh.vertices.size());
+        std::ranges::transform(mesh.vertices, positions.begin(), &GeometryGenerator::Vertex::position);
+        return positions;
+    }
+
+    bool IsBitwiseEqual(const Subdivision::SubdividedMesh& a, const Subdivision::SubdividedMesh& b)
+    {
+        return a.indices == b.indices && a.positions.size() == b.positions.size() &&
+               std::memcmp(a.positions.data(), b.positions.data(), a.positions.size() * sizeof(XMFLOAT3)) == 0;
+    }
+
+    // 모든 half-edge의 짝이 서로를 가리키고 방향이 반대인지 확인한다.
+    bool HasConsistentTwins(const HalfEdgeMesh& mesh)
+    {
+        for (UINT halfEdge = 0; halfEdge < mesh.GetHalfEdgeCount(); ++halfEdge)
+        {
+            const UINT twin = mesh.GetTwin(halfEdge);
+            if (twin == HalfEdgeMesh::InvalidIndex)
+            {
+                continue;
+            }
+
+            if (mesh.GetTwin(twin) != halfEdge || mesh.GetOrigin(twin) != mesh.GetTarget(halfEdge) || mesh.GetTarget(twin) != mesh.GetOrigin(halfEdge) ||
+                mesh.GetEdge(twin) != mesh.GetEdge(halfEdge))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // 원점에서 가장 가까운 점과 가장 먼 점의 거리
+    std::array<float, 2> GetRadiusRange(const std::vector<XMFLOAT3>& positions)
+    {
+        std::array<float, 2> range = {INFINITY, 0.0f};
+        for (const XMFLOAT3& position : positions)
+        {
+            const float radius = std::sqrt(position.x * position.x + position.y * position.y + position.z * position.z);
+            range[0] = std::min(range[0], radius);
+            range[1] = std::max(range[1], radius);
+        }
+
+        return range;
+    }
+}
+
+TEST_CASE(HalfEdgeMeshClosedCube)
+{
+    const HalfEdgeMesh mesh(CubePositions.size(), CubeIndices, CubeFaceSizes);
+    CHECK(mesh.GetFaceCount() == 6);
+    CHECK(mesh.GetHalfEdgeCount() == 24);
+    CHECK(mesh.GetEdgeCount() == 12);
+    CHECK(!mesh.IsTriangleMesh());
+    CHECK(mesh.IsClosed());
+    CHECK(HasConsistentTwins(mesh));
+
+    for (UINT halfEdge = 0; halfEdge < mesh.GetHalfEdgeCount(); ++halfEdge)
+    {
+        CHECK(!mesh.IsBoundary(halfEdge));
+        CHECK(mesh.GetPrev(mesh.GetNext(halfEdge)) == halfEdge);
+    }
+
+    std::vector<UINT> neighbors;
+    std::vector<UINT> edges;
+    for (UINT vertex = 0; vertex < mesh.GetVertexCount(); ++vertex)
+    {
+        CHECK(!mesh.IsBoundaryVertex(vertex));
+        mesh.GetVertexRing(vertex, neighbors, edges);
+        CHECK(neighbors.size() == 3);
+    }
+
+    CHECK(mesh.FindEdge(0, 1) != HalfEdgeMesh::InvalidIndex);
+    CHECK(mesh.FindEdge(0, 6) == HalfEdgeMesh::InvalidIndex);
+}
+
+// 열린 격자는 둘레의 변만 경계이고, 둘레의 정점만 경계 정점이다.
+TEST_CASE(HalfEdgeMeshOpenGrid)
+{
+    constexpr UINT rowCount = 5;
+    constexpr UINT columnCount = 7;
+    const GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(4.0f, 6.0f, rowCount, columnCount);
+    const HalfEdgeMesh mesh(grid.vertices.size(), grid.indices);
+
+    CHECK(mesh.IsTriangleMesh());
+    CHECK(!mesh.IsClosed());
+    CHECK(HasConsistentTwins(mesh));
+
+    size_t boundaryEdgeCount = 0;
+    for (size_t edge = 0; edge < mesh.GetEdgeCount(); ++edge)
+    {
+        boundaryEdgeCount += mesh.IsBoundaryEdge(edge) ? 1 : 0;
+    }
+    CHECK(boundaryEdgeCount == 2 * (rowCount - 1) + 2 * (columnCount - 1));
+
+    // 변 수 = 가로 + 세로 + 대각선
+    CHECK(mesh.GetEdgeCount() == rowCount * (columnCount - 1) + (rowCount - 1) * columnCount + (rowCount - 1) * (columnCount - 1));
+
+    for (UINT i = 0; i < rowCount; ++i)
+    {
+        for (UINT j = 0; j < columnCount; ++j)
+        {
+            const bool isBorder = i == 0 || j == 0 || i == rowCount - 1 || j == columnCount - 1;
+            CHECK(mesh.IsBoundaryVertex(i * columnCount + j) == isBorder);
+        }
+    }
+}
+
+TEST_CASE(SubdivisionSizesMatchOutput)
+{
+    const GeometryGenerator::MeshData icosahedron = GeometryGenerator::CreateGeodesicSphere(1.0f, 0);
+    const std::vector<XMFLOAT3> icosahedronPositions = GetPositions(icosahedron);
+    const HalfEdgeMesh icosahedronMesh(icosahedronPositions.size(), icosahedron.indices);
+
+    const GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(4.0f, 6.0f, 4, 6);
+    const std::vector<XMFLOAT3> gridPositions = GetPositions(grid);
+    const HalfEdgeMesh gridMesh(gridPositions.size(), grid.indices);
+
+    const HalfEdgeMesh cubeMesh(CubePositions.size(), CubeIndices, CubeFaceSizes);
+
+    for (UINT levelCount = 0; levelCount <= 4; ++levelCount)
+    {
+        const Subdivision::SubdivisionSize loopSize = Subdivision::GetLoopSize(icosahedronMesh, levelCount);
+        const Subdivision::SubdividedMesh loop = Subdivision::Loop(icosahedronPositions, icosahedron.indices, levelCount);
+        CHECK(loop.positions.size() == loopSize.vertexCount);
+        CHECK(loop.indices.size() == loopSize.indexCount);
+        CHECK(loopSize.faceCount == 20u << (2 * levelCount));
+
+        const Subdivision::SubdivisionSize gridSize = Subdivision::GetLoopSize(gridMesh, levelCount);
+        const Subdivision::SubdividedMesh gridLoop = Subdivision::Loop(gridPositions, grid.indices, levelCount);
+        CHECK(gridLoop.positions.size() == gridSize.vertexCount);
+        CHECK(gridLoop.indices.size() == gridSize.indexCount);
+
+        const Subdivision::SubdivisionSize cubeSize = Subdivision::GetCatmullClarkSize(cubeMesh, levelCount);
+        const Subdivision::SubdividedMesh cube = Subdivision::CatmullClark(CubePositions, CubeIndices, CubeFaceSizes, levelCount);
+        CHECK(cube.positions.size() == cubeSize.vertexCount);
+        CHECK(cube.indices.size() == cubeSize.indexCount);
+
+        const Subdivision::SubdivisionSize triangleSize = Subdivision::GetCatmullClarkSize(icosahedronMesh, levelCount);
+        const Subdivision::SubdividedMesh triangles = Subdivision::CatmullClark(icosahedronPositions, icosahedron.indices, {}, levelCount);
+        CHECK(triangles.positions.size() == triangleSize.vertexCount);
+        CHECK(triangles.indices.size() == triangleSize.indexCount);
+    }
+
+    // 닫힌 정육면체를 한 번 나누면 정점 8 + 면 6 + 변 12, 사각형 24개(삼각형 48개)가 된다.
+    const Subdivision::SubdivisionSize cubeSize = Subdivision::GetCatmullClarkSize(cubeMesh, 1);
+    CHECK(cubeSize.vertexCount == 26);
+    CHECK(cubeSize.faceCount == 24);
+    CHECK(cubeSize.indexCount == 48 * 3);
+}
+
+// Loop는 근사 세분화라 정이십면체가 단위 구까지 부풀지 않고 반지름 약 0.7인 구 모양의 극한 곡면으로 줄어든다.
+// 단계마다 위치의 변화가 줄어 수렴하고, 정점이 모두 거의 같은 반지름에 놓여 구에 가까워지는지 확인한다.
+TEST_CASE(LoopIcosahedronApproachesSphere)
+{
+    const GeometryGenerator::MeshData icosahedron = GeometryGenerator::CreateGeodesicSphere(1.0f, 0);
+    const std::vector<XMFLOAT3> positions = GetPositions(icosahedron);
+
+    std::array<float, 2> previousRange = {1.0f, 1.0f};
+    float previousChange = INFINITY;
+    for (UINT levelCount = 1; levelCount <= 5; ++levelCount)
+    {
+        const std::array<float, 2> range = GetRadiusRange(Subdivision::Loop(positions, icosahedron.indices, levelCount).positions);
+        const float change = std::max(std::abs(range[0] - previousRange[0]), std::abs(range[1] - previousRange[1]));
+        CHECK(change < previousChange);
+        CHECK(range[0] > 0.65f && range[1] < previousRange[1]);
+        previousRange = range;
+        previousChange = change;
+    }
+
+    CHECK(previousChange < 0.002f);
+    CHECK((previousRange[1] - previousRange[0]) / previousRange[1] < 0.015f);
+}
+
+// 양쪽 경계를 잇는 곧은 주름은 무한히 날카로우면 어떤 단계에서도 원래 선분을 벗어나지 않는다.
+// 주름 밖의 점은 z가 0이 아니므로 z가 정확히 0인 점을 주름에서 나온 점으로 본다.
+TEST_CASE(InfiniteCreaseStaysOnSegment)
+{
+    constexpr UINT rowCount = 5;
+    constexpr UINT columnCount = 7;
+    constexpr float width = 6.0f;
+    GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(width, 4.0f, rowCount, columnCount);
+
+    // 주름을 사이에 두고 양쪽이 올라간 골짜기. 주름이 없으면 주름 위의 점도 위로 끌려 올라간다.
+    std::vector<XMFLOAT3> positions = GetPositions(grid);
+    for (XMFLOAT3& position : positions)
+    {
+        position.y = position.z * position.z;
+    }
+
+    const UINT creaseRow = rowCount / 2;
+    CHECK(positions[creaseRow * columnCount].z == 0.0f);
+
+    std::vector<Subdivision::Crease> creases;
+    for (UINT j = 0; j + 1 < columnCount; ++j)
+    {
+        creases.push_back({creaseRow * columnCount + j, creaseRow * columnCount + j + 1, Subdivision::InfiniteSharpness});
+    }
+
+    for (UINT levelCount = 1; levelCount <= 3; ++levelCount)
+    {
+        const Subdivision::SubdividedMesh creased = Subdivision::Loop(positions, grid.indices, levelCount, creases);
+
+        size_t creasePointCount = 0;
+        for (const XMFLOAT3& position : creased.positions)
+        {
+            if (position.z == 0.0f)
+            {
+                ++creasePointCount;
+                CHECK(position.y == 0.0f);
+                CHECK(position.x >= -0.5f * width && position.x <= 0.5f * width);
+            }
+        }
+        CHECK(creasePointCount == ((columnCount - 1) << levelCount) + 1);
+    }
+
+    // 주름이 없으면 골짜기 바닥이 올라간다.
+    const Subdivision::SubdividedMesh smooth = Subdivision::Loop(positions, grid.indices, 1);
+    CHECK(smooth.positions[creaseRow * columnCount + columnCount / 2].y > 0.0f);
+}
+
+TEST_CASE(SubdivisionIsIndependentOfWorkerCount)
+{
+    const GeometryGenerator::MeshData sphere = GeometryGenerator::CreateGeodesicSphere(1.0f, 2);
+    const std::vector<XMFLOAT3> positions = GetPositions(sphere);
+    const std::vector<Subdivision::Crease> creases = {{0, sphere.indices[1], 2.5f}, {sphere.indices[3], sphere.indices[4], Subdivision::InfiniteSharpness}};
+
+    Parallel::SetMaxWorkerCount(1);
+    const Subdivision::SubdividedMesh loopSerial = Subdivision::Loop(positions, sphere.indices, 3, creases);
+    const Subdivision::SubdividedMesh catmullClarkSerial = Subdivision::CatmullClark(positions, sphere.indices, {}, 3, creases);
+    Parallel::SetMaxWorkerCount(0);
+
+    const Subdivision::SubdividedMesh loopParallel = Subdivision::Loop(positions, sphere.indices, 3, creases);
+    const Subdivision::SubdividedMesh catmullClarkParallel = Subdivision::CatmullClark(positions, sphere.indices, {}, 3, creases);
+
+    CHECK(IsBitwiseEqual(loopSerial, loopParallel));
+    CHECK(IsBitwiseEqual(catmullClarkSerial, catmullClarkParallel));
+}
+
+// 측지구를 세분화 단계별로 Loop와 Catmull-Clark로 나누는 시간을 출력한다.
+BENCHMARK(SubdivisionLevels)
+{
+    const GeometryGenerator::MeshData icosahedron = GeometryGenerator::CreateGeodesicSphere(1.0f, 0);
+    const std::vector<XMFLOAT3> positions = GetPositions(icosahedron);
+
+    for (UINT levelCount = 4; levelCount <= 6; ++levelCount)
+    {
+        const double loopMilliseconds = TestFramework::MeasureMilliseconds([&] { (void)Subdivision::Loop(positions, icosahedron.indices, levelCount); });
+        const double catmullClarkMilliseconds = TestFramework::MeasureMilliseconds([&] { (void)Subdivision::CatmullClark(positions, icosahedron.indices, {}, levelCount); });
+        TestFramework::Log(std::format("  icosahedron level {}: Loop {:.2f} ms, Catmull-Clark {:.2f} ms\n", levelCount, loopMilliseconds, catmullClarkMilliseconds));
+    }
+}
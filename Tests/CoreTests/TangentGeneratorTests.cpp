@@ -0,0 +1,121 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/TangentGenerator.h"
+#include "Core/Utilities/Parallel.h"
+#include "TestFramework.h"
+#include "TestModels.h"
+
+using namespace DirectX;
+
+namespace
+{
+    struct TangentResult
+    {
+        TangentGenerator::TangentData tangentData;
+        std::vector<UINT> indices;
+    };
+
+    // 작업 스레드를 workerCount개로 제한하고 탄젠트를 만든다. 0이면 모든 스레드를 쓴다.
+    TangentResult GenerateTangents(const GeometryGenerator::MeshData& mesh, size_t workerCount)
+    {
+        using Vertex = GeometryGenerator::Vertex;
+
+        TangentResult result;
+        result.indices = mesh.indices;
+
+        Parallel::SetMaxWorkerCount(workerCount);
+        result.tangentData = TangentGenerator::Generate(MakeVertexView(std::span<const Vertex>(mesh.vertices), &Vertex::position, &Vertex::normal, &Vertex::texC), result.indices);
+        Parallel::SetMaxWorkerCount(0);
+
+        return result;
+    }
+
+    bool IsBitwiseEqual(const TangentResult& a, const TangentResult& b)
+    {
+        return a.indices == b.indices && a.tangentData.duplicatedVertices == b.tangentData.duplicatedVertices && a.tangentData.tangents.size() == b.tangentData.tangents.size() &&
+               std::memcmp(a.tangentData.tangents.data(), b.tangentData.tangents.data(), a.tangentData.tangents.size() * sizeof(XMFLOAT4)) == 0;
+    }
+
+    GeometryGenerator::MeshData LoadSkullWithTexCoords()
+    {
+        GeometryGenerator::MeshData skull = TestModels::LoadModel(L"skull.txt");
+        TestModels::SetSphericalTexCoords(skull);
+        return skull;
+    }
+}
+
+TEST_CASE(TangentsMatchAcrossWorkerCounts)
+{
+    const std::vector<GeometryGenerator::MeshData> meshes = {GeometryGenerator::CreateSphere(1.0f, 128, 128), LoadSkullWithTexCoords()};
+    for (const GeometryGenerator::MeshData& mesh : meshes)
+    {
+        const TangentResult single = GenerateTangents(mesh, 1);
+        CHECK(single.tangentData.tangents.size() == mesh.vertices.size() + single.tangentData.duplicatedVertices.size());
+
+        for (const size_t workerCount : {2, 3, 4, 0})
+        {
+            CHECK(IsBitwiseEqual(GenerateTangents(mesh, workerCount), single));
+        }
+    }
+}
+
+// u를 격자 가운데에서 좌우로 뒤집으면 가운데 열의 정점은 handedness가 다른 두 삼각형이 함께 쓰므로 복제되어야 한다.
+TEST_CASE(MirroredTexCoordsSplitVertices)
+{
+    GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(2.0f, 2.0f, 33, 33);
+    for (GeometryGenerator::Vertex& vertex : grid.vertices)
+    {
+        vertex.texC.x = std::abs(vertex.texC.x * 2.0f - 1.0f);
+    }
+
+    const TangentResult result = GenerateTangents(grid, 0);
+    const std::vector<XMFLOAT4>& tangents = result.tangentData.tangents;
+    CHECK(result.tangentData.duplicatedVertices.size() == 33);
+    CHECK(std::ranges::all_of(result.indices, [&](UINT index) { return index < tangents.size(); }));
+
+    // 한 삼각형의 세 정점은 handedness가 같아야 한다.
+    for (size_t i = 0; i < result.indices.size(); i += 3)
+    {
+        CHECK(tangents[result.indices[i]].w == tangents[result.indices[i + 1]].w && tangents[result.indices[i]].w == tangents[result.indices[i + 2]].w);
+    }
+
+    // 격자 법선은 +y이므로 탄젠트는 xz 평면의 단위 벡터이다.
+    CHECK(std::ranges::all_of(tangents, [](const XMFLOAT4& tangent)
+    {
+        return std::abs(tangent.y) < 1.0e-5f && std::abs(tangent.x * tangent.x + tangent.z * tangent.z - 1.0f) < 1.0e-4f;
+    }));
+}
+
+TEST_CASE(TangentsAreOrthonormalToNormals)
+{
+    const GeometryGenerator::MeshData skull = LoadSkullWithTexCoords();
+    const TangentResult result = GenerateTangents(skull, 0);
+
+    const std::vector<XMFLOAT4>& tangents = result.tangentData.tangents;
+    for (size_t i = 0; i < tangents.size(); ++i)
+    {
+        const size_t sourceVertex = i < skull.vertices.size() ? i : result.tangentData.duplicatedVertices[i - skull.vertices.size()];
+        const XMVECTOR normal = XMVector3Normalize(XMLoadFloat3(&skull.vertices[sourceVertex].normal));
+        const XMVECTOR tangent = XMLoadFloat4(&tangents[i]);
+
+        CHECK(std::abs(XMVectorGetX(XMVector3Dot(normal, tangent))) < 1.0e-4f);
+        CHECK(std::abs(XMVectorGetX(XMVector3Length(tangent)) - 1.0f) < 1.0e-4f);
+        CHECK(std::abs(tangents[i].w) == 1.0f);
+    }
+}
+
+BENCHMARK(SkullTangents)
+{
+    const GeometryGenerator::MeshData skull = LoadSkullWithTexCoords();
+    for (const size_t workerCount : {size_t{1}, Parallel::GetWorkerCount()})
+    {
+        const double milliseconds = TestFramework::MeasureMilliseconds([&] { (void)GenerateTangents(skull, workerCount); });
+        TestFramework::Log(std::format("  skull tangents ({} vertices, {} triangles) on {} threads: {:.2f} ms\n", skull.vertices.size(), skull.indices.size() / 3, workerCount, milliseconds));
+    }
+}
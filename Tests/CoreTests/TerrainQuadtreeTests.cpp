@@ -0,0 +1,234 @@
+#include <DirectXMath.h>
+#include <algorithm>
+#include <format>
+#include <span>
+#include <vector>
+
+#include "Core/Rendering/TerrainQuadtree.h"
+#include "Core/Utilities/HillHeightField.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr float FieldOfView = 0.25f * XM_PI;
+    constexpr float ViewportHeight = 600.0f;
+
+    // HillApp과 같은 지형
+    TerrainQuadtree::Desc CreateHillDesc()
+    {
+        TerrainQuadtree::Desc desc;
+        desc.size = 160.0f;
+        desc.levelCount = 5;
+        desc.chunkCellCount = 32;
+        return desc;
+    }
+
+    struct Camera
+    {
+        XMFLOAT3 eyePosition;
+        XMFLOAT3 targetPosition;
+        XMFLOAT3 up = XMFLOAT3(0.0f, 1.0f, 0.0f);
+    };
+
+    TerrainQuadtree::Statistics UpdateFrom(TerrainQuadtree& terrain, const Camera& camera, float fieldOfView = FieldOfView)
+    {
+        const XMVECTOR eyePosition = XMLoadFloat3(&camera.eyePosition);
+        const XMMATRIX viewMatrix = XMMatrixLookAtLH(eyePosition, XMLoadFloat3(&camera.targetPosition), XMLoadFloat3(&camera.up));
+        const XMMATRIX projectionMatrix = XMMatrixPerspectiveFovLH(fieldOfView, 800.0f / ViewportHeight, 1.0f, 1000.0f);
+        return terrain.Update(eyePosition, viewMatrix * projectionMatrix, ViewportHeight, fieldOfView);
+    }
+
+    // 새로 만들 청크가 없을 때까지 Update를 부른다. 반환값은 마지막 Update의 통계이다.
+    TerrainQuadtree::Statistics UpdateUntilStable(TerrainQuadtree& terrain, const Camera& camera, float fieldOfView = FieldOfView)
+    {
+        TerrainQuadtree::Statistics statistics;
+        for (UINT i = 0; i < 100; ++i)
+        {
+            statistics = UpdateFrom(terrain, camera, fieldOfView);
+            if (statistics.builtChunkCount == 0)
+            {
+                break;
+            }
+        }
+
+        return statistics;
+    }
+
+    std::vector<uint64_t> GetSelectedIds(const TerrainQuadtree& terrain)
+    {
+        std::vector<uint64_t> ids;
+        for (const TerrainQuadtree::Chunk* chunk : terrain.GetSelectedChunks())
+        {
+            ids.push_back(chunk->id);
+        }
+
+        std::ranges::sort(ids);
+        return ids;
+    }
+}
+
+// 지형 전체가 보이도록 위에서 내려다보면 고른 청크가 가장 세밀한 단계의 셀을 정확히 한 번씩 덮는다.
+TEST_CASE(TerrainSelectionTilesSquare)
+{
+    const TerrainQuadtree::Desc desc = CreateHillDesc();
+    TerrainQuadtree terrain(&HillHeightField::GetHeights, desc);
+
+    const Camera camera{XMFLOAT3(0.0f, 120.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f)};
+    const TerrainQuadtree::Statistics statistics = UpdateUntilStable(terrain, camera, 0.6f * XM_PI);
+    CHECK(statistics.culledChunkCount == 0);
+    CHECK(statistics.waitingChunkCount == 0);
+
+    const UINT finestCount = 1u << (desc.levelCount - 1);
+    std::vector<UINT> coverage(static_cast<size_t>(finestCount) * finestCount, 0);
+    UINT maxLevel = 0;
+    for (const TerrainQuadtree::Chunk* chunk : terrain.GetSelectedChunks())
+    {
+        maxLevel = std::max(maxLevel, chunk->level);
+
+        const UINT scale = 1u << (desc.levelCount - 1 - chunk->level);
+        for (UINT z = chunk->z * scale; z < (chunk->z + 1) * scale; ++z)
+        {
+            for (UINT x = chunk->x * scale; x < (chunk->x + 1) * scale; ++x)
+            {
+                ++coverage[static_cast<size_t>(z) * finestCount + x];
+            }
+        }
+
+        // 청크 좌표와 실제 정점 범위가 같은 정사각형을 가리키는지 확인한다.
+        const float chunkSize = desc.size / static_cast<float>(1u << chunk->level);
+        CHECK(std::abs(chunk->bounds.boxCenter.x - (-0.5f * desc.size + (static_cast<float>(chunk->x) + 0.5f) * chunkSize)) < 1.0e-3f);
+        CHECK(std::abs(chunk->bounds.boxCenter.z - (-0.5f * desc.size + (static_cast<float>(chunk->z) + 0.5f) * chunkSize)) < 1.0e-3f);
+        CHECK(std::abs(chunk->bounds.boxExtents.x - 0.5f * chunkSize) < 1.0e-3f);
+    }
+
+    CHECK(std::ranges::all_of(coverage, [](UINT count) { return count == 1; }));
+    CHECK(maxLevel > 0);
+}
+
+// 지형 가운데에서 +x를 보면 카메라 뒤쪽(x < 0)에 통째로 놓인 청크는 고르지 않고 컬링한다.
+TEST_CASE(TerrainCullsChunksBehindCamera)
+{
+    TerrainQuadtree terrain(&HillHeightField::GetHeights, CreateHillDesc());
+
+    const Camera camera{XMFLOAT3(0.0f, 30.0f, 0.0f), XMFLOAT3(40.0f, 0.0f, 0.0f)};
+    const TerrainQuadtree::Statistics statistics = UpdateUntilStable(terrain, camera);
+    CHECK(statistics.culledChunkCount > 0);
+    CHECK(statistics.selectedChunkCount > 0);
+
+    for (const TerrainQuadtree::Chunk* chunk : terrain.GetSelectedChunks())
+    {
+        CHECK(chunk->bounds.boxCenter.x + chunk->bounds.boxExtents.x > camera.eyePosition.x - 1.0e-3f);
+    }
+}
+
+// 한 번에 만드는 청크 수는 상한을 넘지 않고, 카메라가 멈춰 있으면 선택이 한 곳으로 수렴한다.
+TEST_CASE(TerrainBuildsConvergeFromFixedCamera)
+{
+    TerrainQuadtree::Desc desc = CreateHillDesc();
+    desc.maxChunkBuildsPerUpdate = 3;
+    TerrainQuadtree terrain(&HillHeightField::GetHeights, desc);
+
+    const Camera camera{XMFLOAT3(-60.0f, 25.0f, -60.0f), XMFLOAT3(0.0f, 0.0f, 0.0f)};
+    UINT updateCount = 0;
+    TerrainQuadtree::Statistics statistics;
+    do
+    {
+        statistics = UpdateFrom(terrain, camera);
+        CHECK(statistics.builtChunkCount <= desc.maxChunkBuildsPerUpdate);
+        ++updateCount;
+    } while (statistics.builtChunkCount > 0 && updateCount < 100);
+
+    CHECK(updateCount > 1);
+    CHECK(statistics.builtChunkCount == 0);
+    CHECK(statistics.waitingChunkCount == 0);
+
+    const std::vector<uint64_t> stableIds = GetSelectedIds(terrain);
+    for (UINT i = 0; i < 3; ++i)
+    {
+        const TerrainQuadtree::Statistics repeated = UpdateFrom(terrain, camera);
+        CHECK(repeated.builtChunkCount == 0 && repeated.evictedChunkCount == 0);
+        CHECK(GetSelectedIds(terrain) == stableIds);
+    }
+}
+
+// 카메라가 지형을 가로지르는 동안 캐시는 상한을 넘지 않고, 이번 Update에 고른 청크는 버리지 않는다.
+TEST_CASE(TerrainEvictionKeepsSelectedChunks)
+{
+    TerrainQuadtree::Desc desc = CreateHillDesc();
+    // 이 경로에서 Update 한 번에 방문하는 청크는 37개 이하이므로, 40이면 캐시가 넘칠 때 버릴 청크가 항상 있다.
+    desc.maxCachedChunkCount = 40;
+    TerrainQuadtree terrain(&HillHeightField::GetHeights, desc);
+
+    size_t evictedChunkCount = 0;
+    for (UINT step = 0; step <= 40; ++step)
+    {
+        const float x = -70.0f + 140.0f * static_cast<float>(step) / 40.0f;
+        const Camera camera{XMFLOAT3(x, 15.0f, -70.0f), XMFLOAT3(x, 0.0f, 70.0f)};
+        for (UINT i = 0; i < 4; ++i)
+        {
+            const TerrainQuadtree::Statistics statistics = UpdateFrom(terrain, camera);
+            evictedChunkCount += statistics.evictedChunkCount;
+            CHECK(statistics.cachedChunkCount <= desc.maxCachedChunkCount);
+
+            const std::vector<uint64_t>& evictedIds = terrain.GetEvictedChunkIds();
+            for (const TerrainQuadtree::Chunk* chunk : terrain.GetSelectedChunks())
+            {
+                CHECK(std::ranges::find(evictedIds, chunk->id) == evictedIds.end());
+            }
+        }
+    }
+
+    CHECK(evictedChunkCount > 0);
+}
+
+// 청크는 (셀 수 + 1)^2 격자 정점 뒤에 네 변의 스커트 정점 4 * (셀 수 + 1)개와 스커트 인덱스 24 * 셀 수개를 붙인다.
+TEST_CASE(TerrainChunkSkirtSizes)
+{
+    for (const UINT cellCount : {1u, 8u, 32u})
+    {
+        TerrainQuadtree::Desc desc = CreateHillDesc();
+        desc.chunkCellCount = cellCount;
+        TerrainQuadtree terrain(&HillHeightField::GetHeights, desc);
+
+        (void)UpdateFrom(terrain, Camera{XMFLOAT3(0.0f, 120.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f)}, 0.6f * XM_PI);
+        CHECK(terrain.GetSelectedChunks().size() == 1);
+
+        const GeometryGenerator::MeshData& mesh = terrain.GetSelectedChunks().front()->mesh;
+        const size_t gridVertexCount = static_cast<size_t>(cellCount + 1) * (cellCount + 1);
+        const size_t gridIndexCount = static_cast<size_t>(cellCount) * cellCount * 6;
+        CHECK(mesh.vertices.size() == gridVertexCount + 4 * (cellCount + 1));
+        CHECK(mesh.indices.size() == gridIndexCount + 24 * cellCount);
+
+        // 스커트 정점은 테두리 정점을 skirtDepth만큼 내린 것이다.
+        for (size_t i = gridVertexCount; i < mesh.vertices.size(); ++i)
+        {
+            const XMFLOAT3& skirt = mesh.vertices[i].position;
+            const bool hasTop = std::ranges::any_of(std::span(mesh.vertices).first(gridVertexCount), [&](const GeometryGenerator::Vertex& vertex)
+            {
+                return vertex.position.x == skirt.x && vertex.position.z == skirt.z && vertex.position.y - terrain.GetSkirtDepth() == skirt.y;
+            });
+            CHECK(hasTop);
+        }
+    }
+}
+
+// HillApp의 시작 카메라에서 선택이 수렴할 때까지 Update를 반복하는 시간과, 수렴한 뒤 Update 한 번의 시간을 출력한다.
+BENCHMARK(TerrainUpdate)
+{
+    const Camera camera{XMFLOAT3(-60.0f, 25.0f, -60.0f), XMFLOAT3(0.0f, 0.0f, 0.0f)};
+
+    const double buildMilliseconds = TestFramework::MeasureMilliseconds([&]
+    {
+        TerrainQuadtree terrain(&HillHeightField::GetHeights, CreateHillDesc());
+        (void)UpdateUntilStable(terrain, camera);
+    });
+
+    TerrainQuadtree terrain(&HillHeightField::GetHeights, CreateHillDesc());
+    const TerrainQuadtree::Statistics statistics = UpdateUntilStable(terrain, camera);
+    const double updateMilliseconds = TestFramework::MeasureMilliseconds([&] { (void)UpdateFrom(terrain, camera); });
+
+    TestFramework::Log(std::format("  terrain: build to stable {:.2f} ms, stable update {:.4f} ms, {} chunks, {} triangles\n", buildMilliseconds, updateMilliseconds,
+                                   statistics.selectedChunkCount, statistics.selectedTriangleCount));
+}
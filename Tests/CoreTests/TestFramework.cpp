@@ -0,0 +1,68 @@
+#include "TestFramework.h"
+
+#include <cstdio>
+#include <format>
+#include <vector>
+
+namespace
+{
+    struct TestCase
+    {
+        std::string_view name;
+        TestFramework::TestFunction function;
+        bool isBenchmark;
+    };
+
+    // 정적 초기화 순서와 상관없이 쓸 수 있도록 함수 안의 정적 변수로 둔다.
+    std::vector<TestCase>& GetTestCases()
+    {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    int failureCount = 0;
+}
+
+TestFramework::Registrar::Registrar(std::string_view name, TestFunction function, bool isBenchmark)
+{
+    GetTestCases().push_back({name, function, isBenchmark});
+}
+
+void TestFramework::ReportFailure(std::string_view expression, std::string_view file, int line)
+{
+    ++failureCount;
+    Log(std::format("  FAILED {}({}): {}\n", file, line, expression));
+}
+
+void TestFramework::Log(std::string_view message)
+{
+    std::fwrite(message.data(), 1, message.size(), stdout);
+    std::fflush(stdout);
+}
+
+int TestFramework::RunAll(std::string_view filter, bool runBenchmarks)
+{
+    int testCount = 0;
+    int failedTestCount = 0;
+    for (const TestCase& testCase : GetTestCases())
+    {
+        if ((testCase.isBenchmark && !runBenchmarks) || testCase.name.find(filter) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        Log(std::format("[{}] {}\n", testCase.isBenchmark ? "benchmark" : "test", testCase.name));
+
+        const int previousFailureCount = failureCount;
+        testCase.function();
+
+        ++testCount;
+        if (failureCount != previousFailureCount)
+        {
+            ++failedTestCount;
+        }
+    }
+
+    Log(std::format("{} run, {} failed ({} checks failed)\n", testCount, failedTestCount, failureCount));
+    return failureCount;
+}
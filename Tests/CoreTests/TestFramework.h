@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+// 테스트와 벤치마크는 정적 초기화 때 등록되고 main에서 등록된 순서대로 실행된다.
+namespace TestFramework
+{
+    using TestFunction = void (*)();
+
+    struct Registrar
+    {
+        Registrar(std::string_view name, TestFunction function, bool isBenchmark);
+    };
+
+    // CHECK가 실패하면 호출된다. 테스트를 중단하지 않고 실패 위치를 출력한 뒤 개수만 센다.
+    void ReportFailure(std::string_view expression, std::string_view file, int line);
+
+    void Log(std::string_view message);
+
+    // 이름에 filter가 들어 있는 테스트를 실행하고 실패한 CHECK 수를 돌려준다. runBenchmarks가 false면 벤치마크는 건너뛴다.
+    [[nodiscard]]
+    int RunAll(std::string_view filter, bool runBenchmarks);
+
+    // function을 적어도 minSeconds 동안, 그리고 세 번 이상 반복해 한 번에 걸린 평균 시간(밀리초)을 돌려준다. 첫 호출은 준비 운동으로 빼고 잰다.
+    template <typename Function>
+    [[nodiscard]]
+    double MeasureMilliseconds(Function&& function, double minSeconds = 0.25)
+    {
+        function();
+
+        int callCount = 0;
+        const auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed{};
+        do
+        {
+            function();
+            ++callCount;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed.count() < minSeconds || callCount < 3);
+
+        return elapsed.count() * 1000.0 / callCount;
+    }
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static const TestFramework::Registrar name##Registrar(#name, &name, false); \
+    static void name()
+
+#define BENCHMARK(name) \
+    static void name(); \
+    static const TestFramework::Registrar name##Registrar(#name, &name, true); \
+    static void name()
+
+#define CHECK(expression) \
+    do \
+    { \
+        if (!(expression)) \
+        { \
+            TestFramework::ReportFailure(#expression, __FILE__, __LINE__); \
+        } \
+    } while (false)
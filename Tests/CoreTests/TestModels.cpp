@@ -0,0 +1,59 @@
+#include "TestModels.h"
+
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "Core/Data/Path.h"
+
+using namespace DirectX;
+
+GeometryGenerator::MeshData TestModels::LoadModel(const std::wstring& fileName)
+{
+    std::ifstream ifs(Path::GetModelPath(fileName).c_str());
+
+    UINT vertexCount = 0;
+    UINT triangleCount = 0;
+    std::string ignore;
+
+    ifs >> ignore >> vertexCount;
+    ifs >> ignore >> triangleCount;
+    ifs >> ignore >> ignore >> ignore >> ignore;
+
+    GeometryGenerator::MeshData meshData;
+    meshData.vertices.resize(vertexCount);
+    for (GeometryGenerator::Vertex& vertex : meshData.vertices)
+    {
+        ifs >> vertex.position.x >> vertex.position.y >> vertex.position.z;
+        ifs >> vertex.normal.x >> vertex.normal.y >> vertex.normal.z;
+        vertex.tangentU = XMFLOAT3(0.0f, 0.0f, 0.0f);
+        vertex.texC = XMFLOAT2(0.0f, 0.0f);
+    }
+
+    ifs >> ignore >> ignore >> ignore;
+
+    meshData.indices.resize(static_cast<size_t>(triangleCount) * 3);
+    for (UINT& index : meshData.indices)
+    {
+        ifs >> index;
+    }
+
+    return meshData;
+}
+
+void TestModels::SetSphericalTexCoords(GeometryGenerator::MeshData& inoutMesh)
+{
+    const XMFLOAT3 center = inoutMesh.ComputeBounds().boxCenter;
+    for (GeometryGenerator::Vertex& vertex : inoutMesh.vertices)
+    {
+        const float x = vertex.position.x - center.x;
+        const float y = vertex.position.y - center.y;
+        const float z = vertex.position.z - center.z;
+        const float length = std::sqrt(x * x + y * y + z * z);
+
+        const float u = std::atan2(z, x) / XM_2PI + 0.5f;
+        const float v = length > 0.0f ? std::acos(std::clamp(y / length, -1.0f, 1.0f)) / XM_PI : 0.0f;
+        vertex.texC = XMFLOAT2(u, v);
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+#include "Core/Common/GeometryGenerator.h"
+
+namespace TestModels
+{
+    // Models 폴더의 텍스트 모델(위치, 법선, 삼각형 인덱스)을 읽는다. 텍스트 모델에 없는 접선과 텍스처 좌표는 0으로 둔다.
+    [[nodiscard]]
+    GeometryGenerator::MeshData LoadModel(const std::wstring& fileName);
+
+    // AABB 중심에서 본 구면 좌표로 텍스처 좌표를 채운다. 경도가 한 바퀴 도는 곳에서 u가 뒤집히므로 이음매가 생긴다.
+    void SetSphericalTexCoords(GeometryGenerator::MeshData& inoutMesh);
+}
@@ -0,0 +1,165 @@
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "Core/Common/GeometryGenerator.h"
+#include "Core/Rendering/VertexQuantizer.h"
+#include "TestFramework.h"
+#include "TestModels.h"
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+namespace
+{
+    // VertexQuantizer.h에 적힌 오차 상한
+    const float MaxDirectionAngle = XMConvertToRadians(0.04f);
+    constexpr float MaxUnitTexCoordError = 1.0f / 4096.0f;
+
+    using GeneratorVertex = GeometryGenerator::Vertex;
+
+    VertexView MakeGeneratorVertexView(const GeometryGenerator::MeshData& mesh)
+    {
+        return MakeVertexView(std::span<const GeneratorVertex>(mesh.vertices), &GeneratorVertex::position, &GeneratorVertex::normal, &GeneratorVertex::texC);
+    }
+
+    // 피보나치 나선으로 구 위에 고르게 퍼진 단위 벡터를 만들고, 팔면체의 꼭짓점과 모서리 방향을 더한다.
+    std::vector<XMFLOAT3> CreateTestDirections(UINT count)
+    {
+        std::vector<XMFLOAT3> directions =
+        {
+            {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f},
+            {0.70710677f, 0.0f, -0.70710677f}, {0.0f, -0.70710677f, -0.70710677f}, {-0.70710677f, 0.70710677f, 0.0f},
+        };
+
+        const float goldenAngle = std::numbers::pi_v<float> * (3.0f - std::sqrt(5.0f));
+        for (UINT i = 0; i < count; ++i)
+        {
+            const float y = 1.0f - 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(count);
+            const float radius = std::sqrt(1.0f - y * y);
+            const float theta = goldenAngle * static_cast<float>(i);
+            directions.emplace_back(radius * std::cos(theta), y, radius * std::sin(theta));
+        }
+
+        return directions;
+    }
+}
+
+TEST_CASE(OctahedralEncodingRoundTrips)
+{
+    for (const XMFLOAT3& direction : CreateTestDirections(20000))
+    {
+        const XMVECTOR unitVector = XMVector3Normalize(XMLoadFloat3(&direction));
+        const XMVECTOR encoded = VertexQuantizer::EncodeOctahedral(unitVector);
+
+        // 전개도 좌표는 [-1, 1] 안에 있고, 양자화하지 않으면 거의 그대로 돌아온다.
+        CHECK(XMVector2InBounds(encoded, XMVectorSplatOne()));
+        CHECK(XMVectorGetX(XMVector3AngleBetweenNormals(unitVector, VertexQuantizer::DecodeOctahedral(encoded))) < 1.0e-3f);
+
+        XMSHORTN2 packed;
+        XMStoreShortN2(&packed, encoded);
+        CHECK(XMVectorGetX(XMVector3AngleBetweenNormals(unitVector, VertexQuantizer::DecodeOctahedral(XMLoadShortN2(&packed)))) <= MaxDirectionAngle);
+    }
+}
+
+TEST_CASE(SkullQuantizationWithinErrorBounds)
+{
+    const GeometryGenerator::MeshData skull = TestModels::LoadModel(L"skull.txt");
+    const VertexView vertexView = MakeVertexView(std::span<const GeneratorVertex>(skull.vertices), &GeneratorVertex::position, &GeneratorVertex::normal);
+    const VertexQuantizer::QuantizationInfo info = VertexQuantizer::ComputeQuantizationInfo(vertexView);
+
+    std::vector<Vertex::PackedPN> packedVertices;
+    VertexQuantizer::Encode(vertexView, info, packedVertices);
+    CHECK(packedVertices.size() == skull.vertices.size());
+
+    const VertexQuantizer::QuantizationError error = VertexQuantizer::MeasureError(vertexView, {}, VertexQuantizer::Decode(packedVertices, info));
+    CHECK(error.position <= info.GetMaxPositionError());
+    CHECK(info.GetMaxPositionError() < 2.0e-4f);
+    CHECK(error.normalAngle <= MaxDirectionAngle);
+}
+
+TEST_CASE(GeneratedShapesQuantizationWithinErrorBounds)
+{
+    const std::vector<GeometryGenerator::MeshData> meshes =
+    {
+        GeometryGenerator::CreateBox(1.0f, 2.0f, 3.0f),
+        GeometryGenerator::CreateSphere(3.0f, 64, 64),
+        GeometryGenerator::CreateCylinder(1.0f, 0.5f, 4.0f, 37, 9),
+        GeometryGenerator::CreateGrid(160.0f, 160.0f, 129, 129),
+    };
+
+    for (const GeometryGenerator::MeshData& mesh : meshes)
+    {
+        const VertexView vertexView = MakeGeneratorVertexView(mesh);
+        const VertexQuantizer::QuantizationInfo info = VertexQuantizer::ComputeQuantizationInfo(vertexView);
+
+        std::vector<Vertex::PackedPNTT> packedVertices;
+        VertexQuantizer::Encode(mesh, info, packedVertices);
+
+        std::vector<XMFLOAT4> tangents;
+        for (const GeneratorVertex& vertex : mesh.vertices)
+        {
+            tangents.emplace_back(vertex.tangentU.x, vertex.tangentU.y, vertex.tangentU.z, 1.0f);
+        }
+
+        const VertexQuantizer::DecodedVertices decoded = VertexQuantizer::Decode(packedVertices, info);
+        const VertexQuantizer::QuantizationError error = VertexQuantizer::MeasureError(vertexView, tangents, decoded);
+        CHECK(error.position <= info.GetMaxPositionError());
+        CHECK(error.normalAngle <= MaxDirectionAngle);
+        CHECK(error.tangentAngle <= MaxDirectionAngle);
+        CHECK(error.texCoord <= MaxUnitTexCoordError);
+
+        // 행렬로 풀어도 같은 오차 안에 든다.
+        const XMMATRIX decodeMatrix = info.GetDecodeMatrix();
+        for (size_t i = 0; i < mesh.vertices.size(); ++i)
+        {
+            const XMVECTOR position = XMVector3Transform(XMVectorSetW(XMLoadUShortN4(&packedVertices[i].position), 1.0f), decodeMatrix);
+            CHECK(XMVectorGetX(XMVector3Length(XMVectorSubtract(position, XMLoadFloat3(&mesh.vertices[i].position)))) <= info.GetMaxPositionError() * 1.01f);
+        }
+    }
+}
+
+// 탄젠트의 handedness는 position.w에 담겨 그대로 돌아와야 한다.
+TEST_CASE(QuantizationKeepsTangentHandedness)
+{
+    const GeometryGenerator::MeshData sphere = GeometryGenerator::CreateSphere(1.0f, 32, 32);
+    const VertexView vertexView = MakeGeneratorVertexView(sphere);
+    const VertexQuantizer::QuantizationInfo info = VertexQuantizer::ComputeQuantizationInfo(vertexView);
+
+    std::vector<XMFLOAT4> tangents;
+    for (size_t i = 0; i < sphere.vertices.size(); ++i)
+    {
+        const XMFLOAT3& tangent = sphere.vertices[i].tangentU;
+        tangents.emplace_back(tangent.x, tangent.y, tangent.z, i % 3 == 0 ? -1.0f : 1.0f);
+    }
+
+    std::vector<Vertex::PackedPNTT> packedVertices;
+    VertexQuantizer::Encode(vertexView, tangents, info, packedVertices);
+    const VertexQuantizer::DecodedVertices decoded = VertexQuantizer::Decode(packedVertices, info);
+
+    for (size_t i = 0; i < tangents.size(); ++i)
+    {
+        CHECK(decoded.tangents[i].w == tangents[i].w);
+    }
+    CHECK(VertexQuantizer::MeasureError(vertexView, tangents, decoded).tangentAngle <= MaxDirectionAngle);
+}
+
+// 두께가 0인 축은 나눗셈 없이 0으로 압축하고 최솟값으로 정확히 복원한다.
+TEST_CASE(QuantizationOfFlatAxisIsExact)
+{
+    const GeometryGenerator::MeshData grid = GeometryGenerator::CreateGrid(10.0f, 10.0f, 17, 17);
+    const VertexView vertexView = MakeGeneratorVertexView(grid);
+    const VertexQuantizer::QuantizationInfo info = VertexQuantizer::ComputeQuantizationInfo(vertexView);
+    CHECK(info.extent.y == 0.0f);
+
+    std::vector<Vertex::PackedPNT> packedVertices;
+    VertexQuantizer::Encode(vertexView, info, packedVertices);
+    const VertexQuantizer::DecodedVertices decoded = VertexQuantizer::Decode(packedVertices, info);
+
+    for (const XMFLOAT3& position : decoded.positions)
+    {
+        CHECK(position.y == 0.0f);
+    }
+}
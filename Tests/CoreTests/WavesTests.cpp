@@ -0,0 +1,446 @@
+#include <DirectXMath.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Core/Utilities/Parallel.h"
+#include "Core/Utilities/Waves.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr std::array SimdLevels = {WavesKernels::SimdLevel::Scalar, WavesKernels::SimdLevel::Sse2, WavesKernels::SimdLevel::Avx2};
+
+    // 책의 Waves를 그대로 옮긴 스칼라 풀이. 내부 점만 갱신하고 경계 법선은 (0, 1, 0), 탄젠트는 (1, 0, 0)으로 남는다.
+    class ReferenceWaves
+    {
+    public:
+        ReferenceWaves(UINT m, UINT n, float dx, float dt, float speed, float damping)
+            : numRows(m), numCols(n), spatialStep(dx), prev(m * n, 0.0f), curr(m * n, 0.0f), normals(m * n, XMFLOAT3(0.0f, 1.0f, 0.0f)), tangents(m * n, XMFLOAT3(1.0f, 0.0f, 0.0f))
+        {
+            const float d = damping * dt + 2.0f;
+            const float e = (speed * speed) * (dt * dt) / (dx * dx);
+            k1 = (damping * dt - 2.0f) / d;
+            k2 = (4.0f - 8.0f * e) / d;
+            k3 = (2.0f * e) / d;
+        }
+
+        void Disturb(UINT i, UINT j, float magnitude)
+        {
+            const float halfMagnitude = 0.5f * magnitude;
+            curr[i * numCols + j] += magnitude;
+            curr[i * numCols + j + 1] += halfMagnitude;
+            curr[i * numCols + j - 1] += halfMagnitude;
+            curr[(i + 1) * numCols + j] += halfMagnitude;
+            curr[(i - 1) * numCols + j] += halfMagnitude;
+        }
+
+        void Step()
+        {
+            for (UINT i = 1; i < numRows - 1; ++i)
+            {
+                for (UINT j = 1; j < numCols - 1; ++j)
+                {
+                    prev[i * numCols + j] = k1 * prev[i * numCols + j] + k2 * curr[i * numCols + j] +
+                                            k3 * (curr[(i + 1) * numCols + j] + curr[(i - 1) * numCols + j] + curr[i * numCols + j + 1] + curr[i * numCols + j - 1]);
+                }
+            }
+            std::swap(prev, curr);
+
+            for (UINT i = 1; i < numRows - 1; ++i)
+            {
+                for (UINT j = 1; j < numCols - 1; ++j)
+                {
+                    const float l = curr[i * numCols + j - 1];
+                    const float r = curr[i * numCols + j + 1];
+                    const float t = curr[(i - 1) * numCols + j];
+                    const float b = curr[(i + 1) * numCols + j];
+                    XMStoreFloat3(&normals[i * numCols + j], XMVector3Normalize(XMVectorSet(-r + l, 2.0f * spatialStep, b - t, 0.0f)));
+                    XMStoreFloat3(&tangents[i * numCols + j], XMVector3Normalize(XMVectorSet(2.0f * spatialStep, r - l, 0.0f, 0.0f)));
+                }
+            }
+        }
+
+        UINT numRows;
+        UINT numCols;
+        float spatialStep;
+        float k1 = 0.0f;
+        float k2 = 0.0f;
+        float k3 = 0.0f;
+        std::vector<float> prev;
+        std::vector<float> curr;
+        std::vector<XMFLOAT3> normals;
+        std::vector<XMFLOAT3> tangents;
+    };
+
+    struct WavesSize
+    {
+        UINT rowCount;
+        UINT columnCount;
+    };
+
+    // SIMD 폭으로 나누어떨어지지 않는 열 수와, 띠로 나뉘는 큰 격자를 함께 확인한다.
+    constexpr std::array TestSizes = {WavesSize{5, 7}, WavesSize{33, 65}, WavesSize{61, 97}, WavesSize{200, 200}, WavesSize{300, 257}};
+
+    bool IsBitwiseEqual(float a, float b)
+    {
+        return std::memcmp(&a, &b, sizeof(float)) == 0;
+    }
+
+    // 높이, 이전 높이, 법선, 탄젠트가 모든 점에서 비트 단위로 같은지 확인한다.
+    bool MatchesReference(const Waves& waves, const ReferenceWaves& reference)
+    {
+        const std::span<const float> heights = waves.Heights();
+        const std::span<const float> previousHeights = waves.PreviousHeights();
+        for (UINT i = 0; i < waves.VertexCount(); ++i)
+        {
+            const XMFLOAT3 normal = waves.Normal(i);
+            const XMFLOAT3 tangent = waves.TangentX(static_cast<int>(i));
+            if (!IsBitwiseEqual(heights[i], reference.curr[i]) || !IsBitwiseEqual(previousHeights[i], reference.prev[i]) ||
+                !IsBitwiseEqual(normal.x, reference.normals[i].x) || !IsBitwiseEqual(normal.y, reference.normals[i].y) || !IsBitwiseEqual(normal.z, reference.normals[i].z) ||
+                !IsBitwiseEqual(tangent.x, reference.tangents[i].x) || !IsBitwiseEqual(tangent.y, reference.tangents[i].y) || !IsBitwiseEqual(tangent.z, reference.tangents[i].z))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Waves에서 고를 수 있는 커널과 실행 경로
+    struct WavesMode
+    {
+        WavesKernels::SimdLevel simdLevel = WavesKernels::SimdLevel::Scalar;
+        bool isParallel = false;
+        bool isFused = false;
+        UINT temporalBlockSize = 1;
+    };
+
+    // 두 점을 흔든 뒤 Step(stepsPerCall)을 callCount번 부른 결과를 책의 풀이를 같은 횟수만큼 진행한 결과와 비교한다.
+    bool MatchesReferenceAfterSteps(const WavesSize& size, const WavesMode& mode, UINT callCount, UINT stepsPerCall = 1)
+    {
+        Waves waves;
+        waves.Init(size.rowCount, size.columnCount, 0.8f, 0.03f, 3.25f, 0.4f);
+        waves.SetSimdLevel(mode.simdLevel);
+        waves.SetParallel(mode.isParallel);
+        waves.SetFused(mode.isFused);
+        waves.SetTemporalBlockSize(mode.temporalBlockSize);
+
+        ReferenceWaves reference(size.rowCount, size.columnCount, 0.8f, 0.03f, 3.25f, 0.4f);
+
+        for (const auto& [i, j, magnitude] : {std::tuple(size.rowCount / 2, size.columnCount / 2, 1.0f), std::tuple(2u, size.columnCount - 3, -0.5f)})
+        {
+            waves.Disturb(i, j, magnitude);
+            reference.Disturb(i, j, magnitude);
+        }
+
+        for (UINT call = 0; call < callCount; ++call)
+        {
+            waves.Step(stepsPerCall);
+            for (UINT step = 0; step < stepsPerCall; ++step)
+            {
+                reference.Step();
+            }
+        }
+
+        return MatchesReference(waves, reference);
+    }
+
+    struct WavesStepMode
+    {
+        const char* name = nullptr;
+        bool isFused = false;
+        UINT temporalBlockSize = 1;
+        UINT stepCount = 1;
+    };
+
+    // Step(mode.stepCount) 한 번이 메모리에서 읽고 쓰는 점당 바이트 수의 추정치. 행 몇 개는 캐시에 남는다고 본다.
+    // 높이 갱신은 전/현재 높이를 읽고 전 높이에 쓰며(12), 법선 계산은 현재 높이를 읽고 다섯 평면에 쓴다(4 + 20).
+    // 합친 경로는 법선을 구할 때 높이를 다시 읽지 않고, 시간 블로킹은 두 높이 평면을 한 번만 읽고 쓴다(16).
+    double EstimateStreamedBytesPerPoint(const WavesStepMode& mode)
+    {
+        constexpr double heightPassBytes = 12.0;
+        constexpr double normalPassBytes = 24.0;
+        constexpr double normalWriteBytes = 20.0;
+        constexpr double temporalBlockBytes = 16.0;
+
+        if (mode.temporalBlockSize > 1)
+        {
+            const UINT blockCount = (mode.stepCount + mode.temporalBlockSize - 1) / mode.temporalBlockSize;
+            return temporalBlockBytes * blockCount + normalWriteBytes;
+        }
+
+        return heightPassBytes * mode.stepCount + (mode.isFused ? normalWriteBytes : normalPassBytes);
+    }
+
+    std::string ToNarrow(const wchar_t* text)
+    {
+        std::string narrow;
+        for (; *text != L'\0'; ++text)
+        {
+            narrow.push_back(static_cast<char>(*text));
+        }
+
+        return narrow;
+    }
+    // WavesApp의 물결과 같은 상수로 두 점을 흔든 33x65 격자
+    void InitDisturbedWaves(Waves& waves, float dt)
+    {
+        waves.Init(33, 65, 0.8f, dt, 3.25f, 0.4f);
+        waves.Disturb(16, 32, 1.0f);
+        waves.Disturb(2, 62, -0.5f);
+    }
+
+}
+
+// 한 스레드에서 높이와 법선을 따로 도는 경로로 SIMD 커널만 바꿔 가며 책의 풀이와 비교한다.
+TEST_CASE(WavesSimdKernelsMatchReference)
+{
+    for (const WavesKernels::SimdLevel simdLevel : SimdLevels)
+    {
+        if (simdLevel > WavesKernels::GetSupportedSimdLevel())
+        {
+            TestFramework::Log(std::format("  {} is not supported, skipped\n", ToNarrow(WavesKernels::ToString(simdLevel))));
+            continue;
+        }
+
+        const WavesMode mode{.simdLevel = simdLevel};
+        for (const WavesSize& size : TestSizes)
+        {
+            CHECK(MatchesReferenceAfterSteps(size, mode, 25));
+        }
+    }
+}
+
+// 띠 수가 작업자 수에 따라 달라져도 띠 경계의 결과가 한 띠로 푼 결과와 같아야 한다.
+// 띠 하나가 MinBandPointCount(16384)점 이상이므로 여러 띠로 나뉘는 큰 격자를 함께 쓴다.
+TEST_CASE(WavesParallelBandsMatchReference)
+{
+    constexpr std::array parallelSizes = {WavesSize{200, 200}, WavesSize{300, 257}, WavesSize{513, 517}};
+
+    for (const WavesKernels::SimdLevel simdLevel : SimdLevels)
+    {
+        if (simdLevel > WavesKernels::GetSupportedSimdLevel())
+        {
+            continue;
+        }
+
+        const WavesMode mode{.simdLevel = simdLevel, .isParallel = true};
+        for (const size_t workerCount : {1u, 2u, 3u, 0u})
+        {
+            Parallel::SetMaxWorkerCount(workerCount);
+            for (const WavesSize& size : parallelSizes)
+            {
+                CHECK(MatchesReferenceAfterSteps(size, mode, 10));
+            }
+        }
+        Parallel::SetMaxWorkerCount(0);
+    }
+}
+
+// 합친 경로와 시간 블로킹은 Step(n)을 어떻게 나눠 부르든 한 단계씩 진행한 결과와 같아야 한다.
+// 블록 크기로 나누어떨어지지 않는 단계 수를 섞어 마지막 블록이 짧은 경우도 다룬다.
+TEST_CASE(WavesFusedAndTemporalBlocksMatchReference)
+{
+    for (const WavesKernels::SimdLevel simdLevel : SimdLevels)
+    {
+        if (simdLevel > WavesKernels::GetSupportedSimdLevel())
+        {
+            continue;
+        }
+
+        for (const bool isParallel : {false, true})
+        {
+            for (const UINT temporalBlockSize : {1u, 2u, 3u, 4u})
+            {
+                const WavesMode mode{.simdLevel = simdLevel, .isParallel = isParallel, .isFused = true, .temporalBlockSize = temporalBlockSize};
+                for (const UINT stepsPerCall : {1u, 2u, 3u, 4u, 5u, 7u})
+                {
+                    for (const WavesSize& size : TestSizes)
+                    {
+                        CHECK(MatchesReferenceAfterSteps(size, mode, 4, stepsPerCall));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 쌓인 시간이 3.5단계이면 세 단계를 진행하고 남은 반 단계를 보간 비율로 남긴다.
+TEST_CASE(WavesUpdateKeepsFractionalStep)
+{
+    constexpr float dt = 0.03f;
+    Waves waves;
+    InitDisturbedWaves(waves, dt);
+
+    CHECK(waves.Update(3.5f * dt) == 3);
+    CHECK(std::abs(waves.GetInterpolationAlpha() - 0.5f) < 1.0e-4f);
+
+    // 남은 반 단계는 다음 Update로 이어진다.
+    CHECK(waves.Update(0.75f * dt) == 1);
+    CHECK(std::abs(waves.GetInterpolationAlpha() - 0.25f) < 1.0e-4f);
+}
+
+// 느린 프레임에서도 GetMaxStepsPerUpdate()단계까지만 진행하고 남은 시간은 한 단계 미만만 남긴다.
+TEST_CASE(WavesUpdateCapsSteps)
+{
+    constexpr float dt = 0.03f;
+    for (const UINT maxStepsPerUpdate : {1u, 4u, 7u})
+    {
+        Waves waves;
+        InitDisturbedWaves(waves, dt);
+        waves.SetMaxStepsPerUpdate(maxStepsPerUpdate);
+
+        CHECK(waves.Update(100.0f * dt) == waves.GetMaxStepsPerUpdate());
+        CHECK(waves.GetInterpolationAlpha() >= 0.0f && waves.GetInterpolationAlpha() < 1.0f);
+
+        // 버린 시간을 다음 Update에서 따라잡지 않는다.
+        CHECK(waves.Update(0.0f) == 0);
+    }
+}
+
+// 시간 간격이 다른 두 물결을 번갈아 갱신해도 각각 따로 갱신한 결과와 같다.
+TEST_CASE(WavesUpdateIsPerInstance)
+{
+    constexpr std::array timeSteps = {0.03f, 0.05f};
+
+    std::array<Waves, 2> interleavedWaves;
+    std::array<Waves, 2> separateWaves;
+    for (size_t k = 0; k < timeSteps.size(); ++k)
+    {
+        InitDisturbedWaves(interleavedWaves[k], timeSteps[k]);
+        InitDisturbedWaves(separateWaves[k], timeSteps[k]);
+    }
+
+    constexpr std::array frameTimes = {0.016f, 0.04f, 0.0f, 0.1f, 0.033f, 0.02f};
+    std::array<std::vector<UINT>, 2> interleavedStepCounts;
+    for (const float frameTime : frameTimes)
+    {
+        for (size_t k = 0; k < timeSteps.size(); ++k)
+        {
+            interleavedStepCounts[k].push_back(interleavedWaves[k].Update(frameTime));
+        }
+    }
+
+    for (size_t k = 0; k < timeSteps.size(); ++k)
+    {
+        std::vector<UINT> stepCounts;
+        for (const float frameTime : frameTimes)
+        {
+            stepCounts.push_back(separateWaves[k].Update(frameTime));
+        }
+
+        CHECK(stepCounts == interleavedStepCounts[k]);
+        CHECK(separateWaves[k].GetInterpolationAlpha() == interleavedWaves[k].GetInterpolationAlpha());
+        CHECK(std::memcmp(separateWaves[k].Heights().data(), interleavedWaves[k].Heights().data(), separateWaves[k].Heights().size_bytes()) == 0);
+    }
+
+    CHECK(interleavedStepCounts[0] != interleavedStepCounts[1]);
+}
+
+// 보간 비율이 0이면 전 단계의 높이, 1이면 현재 단계의 높이를 그대로 돌려준다.
+TEST_CASE(WavesInterpolatedMatchesEndpoints)
+{
+    constexpr float dt = 0.03f;
+    Waves waves;
+    InitDisturbedWaves(waves, dt);
+
+    // 딱 한 단계만큼의 시간은 남는 시간이 없다.
+    CHECK(waves.Update(dt) == 1);
+    CHECK(waves.GetInterpolationAlpha() == 0.0f);
+    for (UINT i = 0; i < waves.VertexCount(); ++i)
+    {
+        const XMFLOAT3 position = waves.Interpolated(i);
+        CHECK(position.y == waves.PreviousHeights()[i]);
+        CHECK(position.x == waves[i].x && position.z == waves[i].z);
+    }
+
+    // 시간 간격이 0이면 Update마다 상한까지 진행하고 보간 비율은 1이다.
+    Waves stepEveryUpdateWaves;
+    InitDisturbedWaves(stepEveryUpdateWaves, 0.0f);
+    CHECK(stepEveryUpdateWaves.Update(0.016f) == stepEveryUpdateWaves.GetMaxStepsPerUpdate());
+    CHECK(stepEveryUpdateWaves.GetInterpolationAlpha() == 1.0f);
+    for (UINT i = 0; i < stepEveryUpdateWaves.VertexCount(); ++i)
+    {
+        CHECK(stepEveryUpdateWaves.Interpolated(i).y == stepEveryUpdateWaves.Heights()[i]);
+    }
+}
+
+// 격자 크기와 SIMD 경로별로 Waves::Step의 초당 단계 수를 출력한다.
+BENCHMARK(WavesSimdKernels)
+{
+    for (const UINT size : {200u, 1024u, 4096u})
+    {
+        Waves waves;
+        waves.Init(size, size, 0.8f, 0.03f, 3.25f, 0.4f);
+        waves.Disturb(size / 2, size / 2, 1.0f);
+
+        for (const WavesKernels::SimdLevel simdLevel : SimdLevels)
+        {
+            if (simdLevel > WavesKernels::GetSupportedSimdLevel())
+            {
+                continue;
+            }
+
+            // 같은 커널로 단일 스레드와 띠 병렬을 비교한다.
+            for (const bool isParallel : {false, true})
+            {
+                waves.SetSimdLevel(simdLevel);
+                waves.SetParallel(isParallel);
+
+                const double milliseconds = TestFramework::MeasureMilliseconds([&] { waves.Step(); });
+                TestFramework::Log(std::format("  waves {}^2 {} {}: {:.1f} steps/s\n", size, ToNarrow(WavesKernels::ToString(simdLevel)), isParallel ? "parallel" : "single", 1000.0 / milliseconds));
+            }
+        }
+    }
+}
+
+// 큰 격자에서 높이와 법선을 두 번 도는 경로, 합친 경로, 시간 블로킹을 비교한다. 대역폭은 EstimateStreamedBytesPerPoint로 어림한 값이다.
+BENCHMARK(WavesBandwidth)
+{
+    constexpr std::array modes =
+    {
+        WavesStepMode{"two-pass", false, 1, 1},
+        WavesStepMode{"fused", true, 1, 1},
+        WavesStepMode{"two-pass x4", false, 1, 4},
+        WavesStepMode{"fused x4", true, 1, 4},
+        WavesStepMode{"temporal x4", true, 4, 4},
+    };
+
+    for (const UINT size : {1024u, 2048u})
+    {
+        Waves waves;
+        waves.Init(size, size, 0.8f, 0.03f, 3.25f, 0.4f);
+        waves.Disturb(size / 2, size / 2, 1.0f);
+
+        // 시간 블로킹은 한 스레드에서 실행하므로 같은 조건에서 비교한다. 띠 병렬에서의 두 경로 비교는 함께 출력한다.
+        for (const bool isParallel : {false, true})
+        {
+            waves.SetParallel(isParallel);
+
+            for (const WavesStepMode& mode : modes)
+            {
+                if (isParallel && mode.temporalBlockSize > 1)
+                {
+                    continue;
+                }
+
+                waves.SetFused(mode.isFused);
+                waves.SetTemporalBlockSize(mode.temporalBlockSize);
+
+                const double milliseconds = TestFramework::MeasureMilliseconds([&] { waves.Step(mode.stepCount); });
+                const double bytesPerPoint = EstimateStreamedBytesPerPoint(mode);
+                const double gigabytesPerSecond = bytesPerPoint * size * size / milliseconds * 1.0e-6;
+                TestFramework::Log(std::format("  waves {}^2 {} {}: {:.1f} steps/s, {:.0f} bytes/point per call, {:.2f} GB/s\n", size, mode.name, isParallel ? "parallel" : "single",
+                                               mode.stepCount * 1000.0 / milliseconds, bytesPerPoint, gigabytesPerSecond));
+            }
+        }
+    }
+}
@@ -0,0 +1,24 @@
+#include <string_view>
+
+#include "TestFramework.h"
+
+// 인자 없이 실행하면 테스트만 실행한다. --benchmark를 주면 벤치마크도 실행하고, 그 밖의 인자는 실행할 이름에 들어 있어야 할 문자열로 본다.
+int main(int argc, char* argv[])
+{
+    bool runBenchmarks = false;
+    std::string_view filter;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument == "--benchmark")
+        {
+            runBenchmarks = true;
+        }
+        else
+        {
+            filter = argument;
+        }
+    }
+
+    return TestFramework::RunAll(filter, runBenchmarks) == 0 ? 0 : 1;
+}